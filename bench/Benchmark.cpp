@@ -0,0 +1,261 @@
+#pragma region PCH
+#include "pch.hpp"
+#pragma endregion
+
+#pragma region STD_LIBS
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <ctime>
+#include <string>
+#include <utility>
+#include <vector>
+#pragma endregion
+
+#pragma region FMT_LIB
+#include <fmt/base.h>
+#include <fmt/color.h>
+#include <fmt/format.h>
+#pragma endregion
+
+#pragma region JSON_LIB
+#include <nlohmann/json.hpp>
+#pragma endregion
+
+#pragma region MY_FILES_CORE_LIB
+#include <AllocStats.hpp>
+#include <ThreadPool.hpp>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "Benchmark.hpp"
+#pragma endregion
+
+using Milliseconds = std::chrono::duration<double, std::milli>;
+
+static constexpr const char* BENCH_SIZE_NAMES[] = { "tiny", "small", "medium", "large", "very-large" };
+
+const char* getBenchSizeName(const BenchSize size)
+{
+    return BENCH_SIZE_NAMES[static_cast<size_t>(size)];
+}
+
+bool parseBenchSize(const std::string& name, BenchSize& size)
+{
+    for (size_t i = 0ull; i < std::size(BENCH_SIZE_NAMES); ++i) {
+        if (name == BENCH_SIZE_NAMES[i]) {
+            size = static_cast<BenchSize>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+double BenchmarkResult::getVerticesPerSecond() const
+{
+    return medianMs > 0.0 ? (double)run.vertices * 1000.0 / medianMs : 0.0;
+}
+
+double BenchmarkResult::getTrianglesPerSecond() const
+{
+    return medianMs > 0.0 ? (double)run.triangles * 1000.0 / medianMs : 0.0;
+}
+
+double BenchmarkResult::getBytesPerSecond() const
+{
+    return medianMs > 0.0 ? (double)run.bytes * 1000.0 / medianMs : 0.0;
+}
+
+static double getMedian(std::vector<double> values)
+{
+    if (values.empty()) return 0.0;
+
+    std::sort(values.begin(), values.end());
+    const size_t count = values.size();
+    return count % 2ull == 1ull ? values[count / 2ull] : (values[count / 2ull - 1ull] + values[count / 2ull]) * .5;
+}
+
+nlohmann::ordered_json BenchmarkResult::toJson() const
+{
+    nlohmann::ordered_json j;
+    j["suite"] = suite;
+    j["name"] = name;
+    j["params"] = params;
+    j["repetitions"] = repetitions;
+    j["medianMs"] = medianMs;
+    j["minMs"] = minMs;
+    j["meanMs"] = meanMs;
+    j["stddevMs"] = stddevMs;
+    j["calibrationMs"] = calibrationMs;
+    j["vertices"] = run.vertices;
+    j["triangles"] = run.triangles;
+    j["verticesPerSecond"] = getVerticesPerSecond();
+    j["trianglesPerSecond"] = getTrianglesPerSecond();
+    j["bytes"] = run.bytes;
+    j["bytesPerSecond"] = getBytesPerSecond();
+
+    nlohmann::ordered_json phases = nlohmann::ordered_json::object();
+    for (const auto& [phase, ms] : phasesMs) phases[phase] = ms;
+    j["phasesMs"] = std::move(phases);
+
+    if (AllocScope::isEnabled()) {
+        j["allocations"] = alloc.count;
+        j["allocationsPerVertex"] = run.vertices > 0ull ? (double)alloc.count / (double)run.vertices : 0.0;
+        j["allocatedBytes"] = alloc.bytes;
+        j["peakBytes"] = alloc.peakBytes;
+    }
+    else {
+        j["allocations"] = nullptr;
+        j["allocationsPerVertex"] = nullptr;
+        j["allocatedBytes"] = nullptr;
+        j["peakBytes"] = nullptr;
+    }
+    return j;
+}
+
+void BenchmarkTimer::stop()
+{
+    if (!_running) return;
+
+    const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    _alloc = _allocScope->stop();
+    _allocScope.reset();
+    _elapsedMs = std::chrono::duration_cast<Milliseconds>(end - _startTime).count();
+    _running = false;
+}
+
+void BenchmarkTimer::_start()
+{
+    _allocScope.emplace();
+    _running = true;
+    _startTime = std::chrono::steady_clock::now();
+}
+
+BenchmarkRunner::BenchmarkRunner(const BenchmarkOptions& options) : _options(options) {}
+
+const BenchmarkOptions& BenchmarkRunner::getOptions() const
+{
+    return _options;
+}
+
+bool BenchmarkRunner::isSizeEnabled(const BenchSize size) const
+{
+    return static_cast<uint8_t>(size) <= static_cast<uint8_t>(_options.maxSize);
+}
+
+bool BenchmarkRunner::isSelected(const std::string& name) const
+{
+    if (!_options.names.empty() && std::find(_options.names.begin(), _options.names.end(), name) == _options.names.end()) return false;
+    if (_options.filters.empty()) return true;
+
+    return std::any_of(_options.filters.begin(), _options.filters.end(), [&](const std::string& filter) { return name.find(filter) != std::string::npos; });
+}
+
+void BenchmarkRunner::setCalibration(const Calibration& calibration)
+{
+    _calibration = calibration;
+}
+
+double BenchmarkRunner::getCalibrationMs() const
+{
+    std::vector<double> times;
+    times.reserve(_results.size());
+    for (const BenchmarkResult& result : _results) times.push_back(result.calibrationMs);
+    return getMedian(std::move(times));
+}
+
+bool BenchmarkRunner::run(const std::string& suite, const std::string& name, const nlohmann::ordered_json& params, const Body& body)
+{
+    if (!isSelected(name)) return false;
+
+    if (_options.listOnly) {
+        fmt::print("{}\n", name);
+        return false;
+    }
+
+    // Warm up caches, thread pool and allocator
+    {
+        BenchmarkTimer timer;
+        timer._start();
+        body(timer);
+        timer.stop();
+    }
+
+    BenchmarkResult result;
+    result.suite = suite;
+    result.name = name;
+    result.params = params;
+
+    const double calibrationBeforeMs = _calibration ? _calibration() : 0.0;
+
+    std::vector<double> times;
+    std::vector<std::pair<std::string, std::vector<double>>> phases;
+    double totalMs = 0.0;
+    while (times.size() < _options.maxRepetitions && (times.size() < _options.minRepetitions || totalMs < _options.minTimeMs)) {
+        BenchmarkTimer timer;
+        timer._start();
+        result.run = body(timer);
+        timer.stop();
+
+        times.push_back(timer._elapsedMs);
+        totalMs += timer._elapsedMs;
+        result.alloc = timer._alloc;
+
+        for (const auto& [phase, ms] : result.run.phases.getSummary()) {
+            auto it = std::find_if(phases.begin(), phases.end(), [&](const auto& entry) { return entry.first == phase; });
+            if (it == phases.end()) phases.emplace_back(phase, std::vector<double>{ ms });
+            else it->second.push_back(ms);
+        }
+    }
+
+    // Average of calibrations before and after follows speed changes during benchmark
+    if (_calibration) result.calibrationMs = (calibrationBeforeMs + _calibration()) * .5;
+
+    const size_t count = times.size();
+    result.repetitions = count;
+    result.minMs = *std::min_element(times.begin(), times.end());
+    result.medianMs = getMedian(times);
+    result.meanMs = totalMs / (double)count;
+    for (auto& [phase, values] : phases) result.phasesMs.emplace_back(phase, getMedian(std::move(values)));
+    result.run.phases.clear();
+
+    double variance = 0.0;
+    for (const double time : times) variance += (time - result.meanMs) * (time - result.meanMs);
+    result.stddevMs = count > 1ull ? std::sqrt(variance / (double)(count - 1ull)) : 0.0;
+
+    fmt::print("{:<64} {:>10.3f}ms {:>10.2f}M vert/s {:>10.2f}M tri/s {:>10.2f} MB/s", name, result.medianMs,
+        result.getVerticesPerSecond() / 1e6, result.getTrianglesPerSecond() / 1e6, result.getBytesPerSecond() / (1024.0 * 1024.0));
+    if (AllocScope::isEnabled()) fmt::print(" {:>10} KB peak", result.alloc.peakBytes / 1024ull);
+    fmt::print("\n");
+
+    _results.push_back(std::move(result));
+    return true;
+}
+
+const std::vector<BenchmarkResult>& BenchmarkRunner::getResults() const
+{
+    return _results;
+}
+
+nlohmann::ordered_json BenchmarkRunner::toJson() const
+{
+    const std::time_t now = std::time(nullptr);
+    char date[32] = {};
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+    nlohmann::ordered_json report;
+    report["version"] = SHAPES_GENERATOR_VERSION;
+    report["date"] = date;
+    report["debug"] = std::string(DEBUG) == "1";
+    report["allocStats"] = AllocScope::isEnabled();
+    report["threads"] = ThreadPool::get().getThreadsCount();
+    report["maxSize"] = getBenchSizeName(_options.maxSize);
+    report["minTimeMs"] = _options.minTimeMs;
+    report["calibrationMs"] = getCalibrationMs();
+
+    nlohmann::ordered_json benchmarks = nlohmann::ordered_json::array();
+    for (const BenchmarkResult& result : _results) benchmarks.push_back(result.toJson());
+    report["benchmarks"] = std::move(benchmarks);
+    return report;
+}
\ No newline at end of file
@@ -0,0 +1,135 @@
+#pragma once
+
+#pragma region STD_LIBS
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+#pragma endregion
+
+#pragma region JSON_LIB
+#include <nlohmann/json.hpp>
+#pragma endregion
+
+#pragma region MY_FILES_CORE_LIB
+#include <AllocStats.hpp>
+#include <GenerationStats.hpp>
+#pragma endregion
+
+// Parameter grid levels, every suite maps them to its own shape parameters
+enum class BenchSize : uint8_t {
+	TINY       = 0,
+	SMALL      = 1,
+	MEDIUM     = 2,
+	LARGE      = 3,
+	VERY_LARGE = 4
+};
+
+const char* getBenchSizeName(const BenchSize size);
+// Returns false when name is not one of getBenchSizeName() values
+bool parseBenchSize(const std::string& name, BenchSize& size);
+
+struct BenchmarkOptions
+{
+	// Only benchmarks with name containing any of filters are run, all when empty
+	std::vector<std::string> filters;
+	// Only benchmarks with exactly these names are run, all when empty (used to run benchmarks of a baseline)
+	std::vector<std::string> names;
+	BenchSize maxSize = BenchSize::LARGE;
+	// Repetitions continue until both minimums are reached, but never past maxRepetitions
+	double minTimeMs = 200.0;
+	size_t minRepetitions = 3ull;
+	size_t maxRepetitions = 1000ull;
+	// Prints benchmark names without running them
+	bool listOnly = false;
+};
+
+// What one repetition produced
+struct BenchmarkRun
+{
+	size_t vertices = 0ull;
+	size_t triangles = 0ull;
+	// Memory of the produced mesh or size of the produced output
+	size_t bytes = 0ull;
+	// Phases measured inside the repetition (formatting, dedup, ...)
+	GenerationStats phases;
+};
+
+struct BenchmarkResult
+{
+	std::string suite;
+	std::string name;
+	nlohmann::ordered_json params;
+	size_t repetitions = 0ull;
+	double medianMs = 0.0;
+	double minMs = 0.0;
+	double meanMs = 0.0;
+	double stddevMs = 0.0;
+	// Time of the calibration loop measured around benchmark, zero without calibration
+	double calibrationMs = 0.0;
+	BenchmarkRun run;
+	// Median of every phase over repetitions, nested phases are included in their parents
+	std::vector<std::pair<std::string, double>> phasesMs;
+	// Allocations of the last repetition, zeros unless built with SHAPES_GENERATOR_ALLOC_STATS
+	AllocStats alloc;
+
+	double getVerticesPerSecond() const;
+	double getTrianglesPerSecond() const;
+	double getBytesPerSecond() const;
+	nlohmann::ordered_json toJson() const;
+};
+
+// Measures one repetition, started by BenchmarkRunner. Body stops it before untimed cleanup
+class BenchmarkTimer
+{
+public:
+	void stop();
+
+private:
+	friend class BenchmarkRunner;
+
+	void _start();
+
+	std::chrono::steady_clock::time_point _startTime;
+	double _elapsedMs = 0.0;
+	bool _running = false;
+	std::optional<AllocScope> _allocScope;
+	AllocStats _alloc;
+};
+
+class BenchmarkRunner
+{
+public:
+	using Body = std::function<BenchmarkRun(BenchmarkTimer&)>;
+	// Returns time of a fixed loop, which follows changing speed of machine during the run
+	using Calibration = std::function<double()>;
+
+	explicit BenchmarkRunner(const BenchmarkOptions& options);
+
+	const BenchmarkOptions& getOptions() const;
+	// Sizes above maxSize are skipped by suites
+	bool isSizeEnabled(const BenchSize size) const;
+	// True when benchmark passes filters and names, suites use it to skip expensive setup
+	bool isSelected(const std::string& name) const;
+	// Called before every benchmark, results are divided by its time when compared with baseline
+	void setCalibration(const Calibration& calibration);
+	// Median calibration time of all results
+	double getCalibrationMs() const;
+
+	// Runs body once for warm up and then repeatedly, prints and stores result.
+	// Returns false when benchmark was filtered out or only listed
+	bool run(const std::string& suite, const std::string& name, const nlohmann::ordered_json& params, const Body& body);
+
+	const std::vector<BenchmarkResult>& getResults() const;
+	// Report with build information and all results, archived per release
+	nlohmann::ordered_json toJson() const;
+
+private:
+	BenchmarkOptions _options;
+	std::vector<BenchmarkResult> _results;
+	Calibration _calibration;
+};
\ No newline at end of file
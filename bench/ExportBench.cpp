@@ -0,0 +1,182 @@
+#pragma region PCH
+#include "pch.hpp"
+#pragma endregion
+
+#pragma region STD_LIBS
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#pragma endregion
+
+#pragma region FMT_LIB
+#include <fmt/format.h>
+#pragma endregion
+
+#pragma region JSON_LIB
+#include <nlohmann/json.hpp>
+#pragma endregion
+
+#pragma region MY_FILES_CORE_LIB
+#include <GenerationStats.hpp>
+#include <Shape.hpp>
+#include <Sphere.hpp>
+#include <TiledPlane.hpp>
+#include <Torus.hpp>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "Benchmark.hpp"
+#include "ExportBench.hpp"
+#pragma endregion
+
+// Same order as FormatType
+static constexpr const char* FORMAT_NAMES[] = {
+    "CPP_ARRAY_INDICES_STRUCT", "C_ARRAY_INDICES_STRUCT", "CPP_ARRAY_VERTICES_STRUCT", "C_ARRAY_VERTICES_STRUCT",
+    "CPP_ARRAY_INDICES_FLOAT", "C_ARRAY_INDICES_FLOAT", "CPP_ARRAY_VERTICES_FLOAT", "C_ARRAY_VERTICES_FLOAT",
+    "JSON_INDICES", "JSON_VERTICES", "OBJ", "BINARY",
+    "CPP_ARRAY_STRIP_STRUCT", "C_ARRAY_STRIP_STRUCT", "CPP_ARRAY_STRIP_FLOAT", "C_ARRAY_STRIP_FLOAT", "JSON_STRIP", "BINARY_STRIP"
+};
+
+// Smooth torus shares vertices between triangles, flat sphere duplicates them (what OBJ dedup removes)
+static constexpr BenchSize SIZES[] = { BenchSize::SMALL, BenchSize::MEDIUM, BenchSize::LARGE, BenchSize::VERY_LARGE };
+static constexpr unsigned int TORUS_SEGMENTS[][2] = { { 16u, 8u }, { 128u, 64u }, { 512u, 256u }, { 1024u, 512u } };
+static constexpr unsigned int SPHERE_SEGMENTS[][2] = { { 8u, 16u }, { 32u, 64u }, { 128u, 256u }, { 512u, 512u } };
+static constexpr unsigned int TILED_PLANE_SEGMENTS[] = { 64u, 256u, 1024u, 2048u };
+static constexpr FormatType TILED_PLANE_FORMATS[] = { FormatType::BINARY, FormatType::OBJ };
+
+namespace fs = std::filesystem;
+
+// Saved files go to temp directory and are removed after every repetition (outside of measured time)
+static fs::path getSavePath(const FormatType format)
+{
+    return fs::temp_directory_path() / ("shapes_generator_bench" + Shape::getFormatFileExtension(format));
+}
+
+static void runFormats(BenchmarkRunner& runner, const Shape& shape, const BenchSize size, const std::string& label, const nlohmann::ordered_json& params)
+{
+    for (size_t i = 0ull; i < std::size(FORMAT_NAMES); ++i) {
+        const FormatType format = static_cast<FormatType>(i);
+
+        nlohmann::ordered_json benchParams;
+        benchParams["shape"] = shape.getObjectClassName();
+        benchParams["size"] = getBenchSizeName(size);
+        for (const auto& [key, value] : params.items()) benchParams[key] = value;
+        benchParams["format"] = FORMAT_NAMES[i];
+
+        const std::string name = fmt::format("export/{}/{}/{}/{}", shape.getObjectClassName(), getBenchSizeName(size), label, FORMAT_NAMES[i]);
+        runner.run("export", name, benchParams, [&](BenchmarkTimer& timer) {
+            BenchmarkRun run;
+            const std::string text = shape.toString(format, &run.phases);
+            timer.stop();
+
+            run.vertices = shape.getVerticesCount();
+            run.triangles = shape.getIndicesCount() / 3ull;
+            run.bytes = text.size();
+            return run;
+        });
+    }
+}
+
+// Shape::save of streamable formats, formatting overlaps writing to file
+static void runSave(BenchmarkRunner& runner, const Shape& shape, const BenchSize size, const std::string& label, const nlohmann::ordered_json& params)
+{
+    for (size_t i = 0ull; i < std::size(FORMAT_NAMES); ++i) {
+        const FormatType format = static_cast<FormatType>(i);
+        if (!Shape::isStreamable(format)) continue;
+
+        nlohmann::ordered_json benchParams;
+        benchParams["shape"] = shape.getObjectClassName();
+        benchParams["size"] = getBenchSizeName(size);
+        for (const auto& [key, value] : params.items()) benchParams[key] = value;
+        benchParams["format"] = FORMAT_NAMES[i];
+
+        const std::string name = fmt::format("save/{}/{}/{}/{}", shape.getObjectClassName(), getBenchSizeName(size), label, FORMAT_NAMES[i]);
+        runner.run("export", name, benchParams, [&](BenchmarkTimer& timer) {
+            const fs::path path = getSavePath(format);
+
+            BenchmarkRun run;
+            const bool saved = shape.save(path.string(), format, &run.phases);
+            timer.stop();
+
+            run.vertices = shape.getVerticesCount();
+            run.triangles = shape.getIndicesCount() / 3ull;
+            run.bytes = saved ? fs::file_size(path) : 0ull;
+            fs::remove(path);
+            return run;
+        });
+    }
+}
+
+// TiledPlane::save, the plane is generated tile by tile while it is written
+static void runTiledPlaneSave(BenchmarkRunner& runner, const BenchSize size, const unsigned int segments)
+{
+    const ShapeConfig config{};
+    const TiledPlane plane(config, segments, segments, PlaneNormalDir::UP, ValuesRange::HALF_TO_HALF);
+
+    for (const FormatType format : TILED_PLANE_FORMATS) {
+        const char* formatName = FORMAT_NAMES[static_cast<size_t>(format)];
+
+        nlohmann::ordered_json benchParams;
+        benchParams["shape"] = "TiledPlane";
+        benchParams["size"] = getBenchSizeName(size);
+        benchParams["rows"] = segments;
+        benchParams["columns"] = segments;
+        benchParams["format"] = formatName;
+
+        const std::string name = fmt::format("save/TiledPlane/{}/{}x{}/{}", getBenchSizeName(size), segments, segments, formatName);
+        runner.run("export", name, benchParams, [&](BenchmarkTimer& timer) {
+            const fs::path path = getSavePath(format);
+
+            const bool saved = plane.save(path.string(), format);
+            timer.stop();
+
+            const MeshCounts counts = plane.getMeshCounts(format);
+            BenchmarkRun run;
+            run.vertices = counts.vertices;
+            run.triangles = counts.indices / 3ull;
+            run.bytes = saved ? fs::file_size(path) : 0ull;
+            fs::remove(path);
+            return run;
+        });
+    }
+}
+
+void runExportBenchmarks(BenchmarkRunner& runner)
+{
+    // Tangents and bitangents make the largest vertices
+    ShapeConfig config{};
+
+    for (size_t i = 0ull; i < std::size(SIZES); ++i) {
+        const BenchSize size = SIZES[i];
+        if (!runner.isSizeEnabled(size)) break;
+
+        const std::string torusLabel = fmt::format("{}x{}/smooth", TORUS_SEGMENTS[i][0], TORUS_SEGMENTS[i][1]);
+        const std::string sphereLabel = fmt::format("{}x{}/flat", SPHERE_SEGMENTS[i][0], SPHERE_SEGMENTS[i][1]);
+
+        // Shapes are generated only when some of their benchmarks are selected
+        const auto isUsed = [&](const std::string& prefix) {
+            for (const char* format : FORMAT_NAMES) {
+                if (runner.isSelected(fmt::format("export/{}/{}", prefix, format)) || runner.isSelected(fmt::format("save/{}/{}", prefix, format))) return true;
+            }
+            return false;
+        };
+
+        const std::string torusPrefix = fmt::format("{}/{}/{}", Torus::getClassName(), getBenchSizeName(size), torusLabel);
+        if (isUsed(torusPrefix)) {
+            Torus torus(config, TORUS_SEGMENTS[i][0], TORUS_SEGMENTS[i][1], 1.f, .5f, ValuesRange::HALF_TO_HALF, Shading::SMOOTH);
+            const nlohmann::ordered_json torusParams = { { "segments", TORUS_SEGMENTS[i][0] }, { "csSegments", TORUS_SEGMENTS[i][1] }, { "shading", "smooth" } };
+            runFormats(runner, torus, size, torusLabel, torusParams);
+            runSave(runner, torus, size, torusLabel, torusParams);
+        }
+
+        const std::string spherePrefix = fmt::format("{}/{}/{}", Sphere::getClassName(), getBenchSizeName(size), sphereLabel);
+        if (isUsed(spherePrefix)) {
+            Sphere sphere(config, SPHERE_SEGMENTS[i][0], SPHERE_SEGMENTS[i][1], ValuesRange::HALF_TO_HALF, Shading::FLAT);
+            const nlohmann::ordered_json sphereParams = { { "horizontalSegments", SPHERE_SEGMENTS[i][0] }, { "verticalSegments", SPHERE_SEGMENTS[i][1] }, { "shading", "flat" } };
+            runFormats(runner, sphere, size, sphereLabel, sphereParams);
+            runSave(runner, sphere, size, sphereLabel, sphereParams);
+        }
+
+        runTiledPlaneSave(runner, size, TILED_PLANE_SEGMENTS[i]);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,9 @@
+#pragma once
+
+#pragma region MY_FILES
+#include "Benchmark.hpp"
+#pragma endregion
+
+// Shape::toString of every FormatType on representative smooth and flat shaded meshes of growing size,
+// Shape::save of streamable formats on the same meshes and TiledPlane::save of its formats
+void runExportBenchmarks(BenchmarkRunner& runner);
\ No newline at end of file
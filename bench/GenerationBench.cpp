@@ -0,0 +1,152 @@
+#pragma region PCH
+#include "pch.hpp"
+#pragma endregion
+
+#pragma region STD_LIBS
+#include <cstddef>
+#include <string>
+#pragma endregion
+
+#pragma region FMT_LIB
+#include <fmt/format.h>
+#pragma endregion
+
+#pragma region JSON_LIB
+#include <nlohmann/json.hpp>
+#pragma endregion
+
+#pragma region MY_FILES_CORE_LIB
+#include <Cone.hpp>
+#include <Cube.hpp>
+#include <Cylinder.hpp>
+#include <Hexagon.hpp>
+#include <IcoSphere.hpp>
+#include <Plane.hpp>
+#include <Pyramid.hpp>
+#include <Shape.hpp>
+#include <Sphere.hpp>
+#include <Tetrahedron.hpp>
+#include <Torus.hpp>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "Benchmark.hpp"
+#include "GenerationBench.hpp"
+#pragma endregion
+
+struct TangentsVariant
+{
+    const char* name;
+    bool genTangents;
+    bool calcBitangents;
+    bool tangentHandednessPositive;
+};
+
+// Handedness doesn't matter without tangents
+static constexpr TangentsVariant TANGENTS_VARIANTS[] = {
+    { "no-tangents",          false, false, true  },
+    { "tangents",             true,  false, true  },
+    { "tangents-negative",    true,  false, false },
+    { "bitangents",           true,  true,  true  },
+    { "bitangents-negative",  true,  true,  false }
+};
+
+static constexpr BenchSize SIZES[] = { BenchSize::TINY, BenchSize::SMALL, BenchSize::MEDIUM, BenchSize::LARGE, BenchSize::VERY_LARGE };
+static constexpr Shading SHADINGS[] = { Shading::FLAT, Shading::SMOOTH };
+
+// Parameters of every size, very large ones produce a few million vertices
+static constexpr unsigned int PLANE_SEGMENTS[] = { 2u, 16u, 128u, 512u, 2048u };
+static constexpr unsigned int CYLINDER_SEGMENTS[][2] = { { 1u, 3u }, { 4u, 16u }, { 32u, 128u }, { 256u, 512u }, { 512u, 1024u } };
+static constexpr unsigned int CONE_SEGMENTS[] = { 3u, 32u, 1024u, 32768u, 262144u };
+static constexpr unsigned int SPHERE_SEGMENTS[][2] = { { 2u, 3u }, { 8u, 16u }, { 64u, 128u }, { 256u, 512u }, { 512u, 1024u } };
+static constexpr unsigned int ICOSPHERE_SUBDIVISIONS[] = { 0u, 2u, 4u, 6u, 8u };
+static constexpr unsigned int TORUS_SEGMENTS[][2] = { { 3u, 3u }, { 16u, 8u }, { 128u, 64u }, { 512u, 256u }, { 1024u, 512u } };
+static constexpr unsigned int HEXAGON_SEGMENTS[] = { 1u, 8u, 64u, 512u, 4096u };
+
+static const char* getShadingName(const Shading shading)
+{
+    return shading == Shading::FLAT ? "flat" : "smooth";
+}
+
+template<class ShapeType, class... Args>
+static void runShape(BenchmarkRunner& runner, const BenchSize size, const std::string& label, const nlohmann::ordered_json& params, const Args&... args)
+{
+    for (const TangentsVariant& variant : TANGENTS_VARIANTS) {
+        ShapeConfig config{};
+        config.genTangents = variant.genTangents;
+        config.calcBitangents = variant.calcBitangents;
+        config.tangentHandednessPositive = variant.tangentHandednessPositive;
+
+        nlohmann::ordered_json benchParams;
+        benchParams["shape"] = ShapeType::getClassName();
+        benchParams["size"] = getBenchSizeName(size);
+        for (const auto& [key, value] : params.items()) benchParams[key] = value;
+        benchParams["tangents"] = variant.genTangents;
+        benchParams["bitangents"] = variant.calcBitangents;
+        benchParams["handednessPositive"] = variant.tangentHandednessPositive;
+
+        const std::string name = fmt::format("generate/{}/{}/{}/{}", ShapeType::getClassName(), getBenchSizeName(size), label, variant.name);
+        runner.run("generation", name, benchParams, [&](BenchmarkTimer& timer) {
+            ShapeType shape(config, args...);
+            timer.stop();
+
+            BenchmarkRun run;
+            run.vertices = shape.getVerticesCount();
+            run.triangles = shape.getIndicesCount() / 3ull;
+            run.bytes = shape.getMemorySize();
+            return run;
+        });
+    }
+}
+
+void runGenerationBenchmarks(BenchmarkRunner& runner)
+{
+    // Fixed size shapes
+    runShape<Cube>(runner, BenchSize::TINY, "fixed", {}, ValuesRange::HALF_TO_HALF);
+    runShape<Tetrahedron>(runner, BenchSize::TINY, "fixed", {}, ValuesRange::HALF_TO_HALF);
+    runShape<Pyramid>(runner, BenchSize::TINY, "fixed", {}, ValuesRange::HALF_TO_HALF);
+
+    for (size_t i = 0ull; i < std::size(SIZES); ++i) {
+        const BenchSize size = SIZES[i];
+        if (!runner.isSizeEnabled(size)) break;
+
+        const unsigned int planeSegments = PLANE_SEGMENTS[i];
+        runShape<Plane>(runner, size, fmt::format("{}x{}", planeSegments, planeSegments),
+            { { "rows", planeSegments }, { "columns", planeSegments } },
+            planeSegments, planeSegments, PlaneNormalDir::UP, ValuesRange::HALF_TO_HALF);
+
+        runShape<Hexagon>(runner, size, fmt::format("{}", HEXAGON_SEGMENTS[i]),
+            { { "segments", HEXAGON_SEGMENTS[i] } },
+            HEXAGON_SEGMENTS[i], ValuesRange::HALF_TO_HALF);
+
+        for (const Shading shading : SHADINGS) {
+            const std::string shadingName = getShadingName(shading);
+
+            const unsigned int cylinderH = CYLINDER_SEGMENTS[i][0];
+            const unsigned int cylinderV = CYLINDER_SEGMENTS[i][1];
+            runShape<Cylinder>(runner, size, fmt::format("{}x{}/{}", cylinderH, cylinderV, shadingName),
+                { { "horizontalSegments", cylinderH }, { "verticalSegments", cylinderV }, { "shading", shadingName } },
+                cylinderH, cylinderV, ValuesRange::HALF_TO_HALF, shading);
+
+            runShape<Cone>(runner, size, fmt::format("{}/{}", CONE_SEGMENTS[i], shadingName),
+                { { "segments", CONE_SEGMENTS[i] }, { "shading", shadingName } },
+                CONE_SEGMENTS[i], 1.f, 1.f, ValuesRange::HALF_TO_HALF, shading);
+
+            const unsigned int sphereH = SPHERE_SEGMENTS[i][0];
+            const unsigned int sphereV = SPHERE_SEGMENTS[i][1];
+            runShape<Sphere>(runner, size, fmt::format("{}x{}/{}", sphereH, sphereV, shadingName),
+                { { "horizontalSegments", sphereH }, { "verticalSegments", sphereV }, { "shading", shadingName } },
+                sphereH, sphereV, ValuesRange::HALF_TO_HALF, shading);
+
+            runShape<IcoSphere>(runner, size, fmt::format("{}/{}", ICOSPHERE_SUBDIVISIONS[i], shadingName),
+                { { "subdivisions", ICOSPHERE_SUBDIVISIONS[i] }, { "shading", shadingName } },
+                ICOSPHERE_SUBDIVISIONS[i], ValuesRange::HALF_TO_HALF, shading);
+
+            const unsigned int torusSegments = TORUS_SEGMENTS[i][0];
+            const unsigned int torusCsSegments = TORUS_SEGMENTS[i][1];
+            runShape<Torus>(runner, size, fmt::format("{}x{}/{}", torusSegments, torusCsSegments, shadingName),
+                { { "segments", torusSegments }, { "csSegments", torusCsSegments }, { "shading", shadingName } },
+                torusSegments, torusCsSegments, 1.f, .5f, ValuesRange::HALF_TO_HALF, shading);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,9 @@
+#pragma once
+
+#pragma region MY_FILES
+#include "Benchmark.hpp"
+#pragma endregion
+
+// Construction of every shape over the size grid, for both shadings (where supported)
+// and all tangent settings of ShapeConfig
+void runGenerationBenchmarks(BenchmarkRunner& runner);
\ No newline at end of file
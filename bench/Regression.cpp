@@ -0,0 +1,211 @@
+#pragma region PCH
+#include "pch.hpp"
+#pragma endregion
+
+#pragma region STD_LIBS
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#pragma endregion
+
+#pragma region FMT_LIB
+#include <fmt/base.h>
+#include <fmt/color.h>
+#include <fmt/format.h>
+#pragma endregion
+
+#pragma region JSON_LIB
+#include <nlohmann/json.hpp>
+#pragma endregion
+
+#pragma region MY_FILES_CORE_LIB
+#include <AllocStats.hpp>
+#include <ThreadPool.hpp>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "Benchmark.hpp"
+#include "Regression.hpp"
+#pragma endregion
+
+using Milliseconds = std::chrono::duration<double, std::milli>;
+
+static constexpr size_t CALIBRATION_VALUES = 1ull << 20;
+static constexpr size_t CALIBRATION_PASSES = 4ull;
+
+// Keeps result of the calibration loop alive
+static volatile float calibrationSink = 0.f;
+
+double runCalibration(const size_t runs)
+{
+    std::vector<double> times;
+    times.reserve(runs);
+
+    for (size_t run = 0ull; run < runs; ++run) {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        // Fresh 4 MB of floats streamed with integer and float math, like generators and exporters
+        // allocate and fill their buffers
+        std::vector<float> values(CALIBRATION_VALUES, 1.f);
+        uint32_t state = 12345u;
+        for (size_t pass = 0ull; pass < CALIBRATION_PASSES; ++pass) {
+            for (float& value : values) {
+                state = state * 1664525u + 1013904223u;
+                value = value * .999f + std::sqrt((float)(state >> 8u) * (1.f / 16777216.f));
+            }
+        }
+        calibrationSink = calibrationSink + values[state % CALIBRATION_VALUES];
+
+        times.push_back(std::chrono::duration_cast<Milliseconds>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    // Other processes only make runs slower, fastest one is closest to real speed of machine
+    return *std::min_element(times.begin(), times.end());
+}
+
+static double getCalibratedMs(const nlohmann::ordered_json& benchmark)
+{
+    const double calibrationMs = benchmark.value("calibrationMs", 0.0);
+    const double medianMs = benchmark.value("medianMs", 0.0);
+    return calibrationMs > 0.0 ? medianMs / calibrationMs : medianMs;
+}
+
+nlohmann::ordered_json makeBaseline(const std::vector<nlohmann::ordered_json>& reports, const double defaultTolerance)
+{
+    nlohmann::ordered_json baseline = reports.front();
+    baseline["runs"] = reports.size();
+    baseline["tolerance"] = defaultTolerance;
+
+    for (nlohmann::ordered_json& benchmark : baseline["benchmarks"]) {
+        std::vector<nlohmann::ordered_json> runs;
+        for (const nlohmann::ordered_json& report : reports) {
+            for (const nlohmann::ordered_json& other : report["benchmarks"]) {
+                if (other["name"] == benchmark["name"]) runs.push_back(other);
+            }
+        }
+        std::sort(runs.begin(), runs.end(), [](const auto& a, const auto& b) { return getCalibratedMs(a) < getCalibratedMs(b); });
+        benchmark = runs[runs.size() / 2ull];
+
+        double mean = 0.0;
+        for (const nlohmann::ordered_json& run : runs) mean += getCalibratedMs(run) / (double)runs.size();
+        double variance = 0.0;
+        for (const nlohmann::ordered_json& run : runs) variance += (getCalibratedMs(run) - mean) * (getCalibratedMs(run) - mean) / (double)runs.size();
+
+        // Four standard deviations between runs, so noisy benchmarks don't fail randomly. Deviation
+        // within run isn't used, single slow repetitions inflate it while medians ignore them
+        const double variation = mean > 0.0 ? std::sqrt(variance) / mean : 0.0;
+        benchmark["tolerance"] = std::round(std::max(defaultTolerance, 4.0 * variation) * 100.0) / 100.0;
+    }
+    return baseline;
+}
+
+std::vector<std::string> getBaselineNames(const nlohmann::json& baseline)
+{
+    std::vector<std::string> names;
+    if (!baseline.contains("benchmarks") || !baseline["benchmarks"].is_array()) return names;
+
+    for (const nlohmann::json& benchmark : baseline["benchmarks"]) {
+        if (benchmark.contains("name") && benchmark["name"].is_string()) names.push_back(benchmark["name"].get<std::string>());
+    }
+    return names;
+}
+
+struct Comparison
+{
+    std::string name;
+    // Baseline median scaled to speed of this machine
+    double expectedMs = 0.0;
+    double currentMs = 0.0;
+    double change = 0.0;
+    double tolerance = 0.0;
+    bool missing = false;
+};
+
+std::vector<std::string> compareWithBaseline(const BenchmarkRunner& runner, const nlohmann::json& baseline, const double defaultTolerance)
+{
+    const double baselineCalibration = baseline.value("calibrationMs", 0.0);
+    const double currentCalibration = runner.getCalibrationMs();
+    const double scale = baselineCalibration > 0.0 && currentCalibration > 0.0 ? currentCalibration / baselineCalibration : 1.0;
+    const double baselineTolerance = baseline.value("tolerance", defaultTolerance);
+
+    fmt::print("\n[{}] Calibration {:.3f}ms, baseline {:.3f}ms, baseline times are scaled by {:.3f} on average\n",
+        fmt::styled("INFO", fmt::fg(fmt::color::white)), currentCalibration, baselineCalibration, scale);
+
+    const bool isDebug = std::string(DEBUG) == "1";
+    if (baseline.value("debug", false) != isDebug || baseline.value("allocStats", false) != AllocScope::isEnabled()) {
+        fmt::print("[{}] Baseline was made with a different build type or SHAPES_GENERATOR_ALLOC_STATS, results are not comparable\n",
+            fmt::styled("WARN", fmt::fg(fmt::color::yellow)));
+    }
+    if (baseline.value("threads", 0ull) != ThreadPool::get().getThreadsCount()) {
+        fmt::print("[{}] Baseline was made with {} threads, not {}\n", fmt::styled("WARN", fmt::fg(fmt::color::yellow)),
+            baseline.value("threads", 0ull), ThreadPool::get().getThreadsCount());
+    }
+
+    std::vector<Comparison> regressions;
+    std::vector<Comparison> improvements;
+    std::vector<Comparison> missing;
+    size_t compared = 0ull;
+
+    const std::vector<BenchmarkResult>& results = runner.getResults();
+    for (const nlohmann::json& benchmark : baseline["benchmarks"]) {
+        Comparison comparison;
+        comparison.name = benchmark.value("name", std::string());
+        if (!runner.isSelected(comparison.name)) continue;
+
+        comparison.expectedMs = benchmark.value("medianMs", 0.0) * scale;
+        comparison.tolerance = benchmark.value("tolerance", baselineTolerance);
+
+        const auto it = std::find_if(results.begin(), results.end(), [&](const BenchmarkResult& result) { return result.name == comparison.name; });
+        if (it == results.end()) {
+            comparison.missing = true;
+            missing.push_back(comparison);
+            continue;
+        }
+
+        // Speed of machine changes during the run, calibration measured next to benchmark follows it best
+        const double benchmarkCalibration = benchmark.value("calibrationMs", 0.0);
+        if (benchmarkCalibration > 0.0 && it->calibrationMs > 0.0) {
+            comparison.expectedMs = benchmark.value("medianMs", 0.0) * it->calibrationMs / benchmarkCalibration;
+        }
+
+        ++compared;
+        comparison.currentMs = it->medianMs;
+        comparison.change = comparison.expectedMs > 0.0 ? comparison.currentMs / comparison.expectedMs - 1.0 : 0.0;
+        if (comparison.change > comparison.tolerance) regressions.push_back(comparison);
+        else if (comparison.change < -comparison.tolerance) improvements.push_back(comparison);
+    }
+
+    const auto printTable = [](const std::vector<Comparison>& rows, const char* status, const fmt::color color) {
+        for (const Comparison& row : rows) {
+            if (row.missing) {
+                fmt::print("{:<64} {:>12.3f} {:>12} {:>9} {:>9} {}\n", row.name, row.expectedMs, "-", "-", "-", fmt::styled(status, fmt::fg(color)));
+                continue;
+            }
+            fmt::print("{:<64} {:>12.3f} {:>12.3f} {:>+8.1f}% {:>8.1f}% {}\n", row.name, row.expectedMs, row.currentMs,
+                row.change * 100.0, row.tolerance * 100.0, fmt::styled(status, fmt::fg(color)));
+        }
+    };
+
+    std::sort(regressions.begin(), regressions.end(), [](const Comparison& a, const Comparison& b) { return a.change > b.change; });
+    std::sort(improvements.begin(), improvements.end(), [](const Comparison& a, const Comparison& b) { return a.change < b.change; });
+
+    if (!regressions.empty() || !improvements.empty() || !missing.empty()) {
+        fmt::print("\n{:<64} {:>12} {:>12} {:>9} {:>9} {}\n", "Benchmark", "Expected ms", "Current ms", "Change", "Tolerance", "Status");
+        printTable(regressions, "REGRESSED", fmt::color::red);
+        printTable(improvements, "IMPROVED", fmt::color::green);
+        printTable(missing, "MISSING", fmt::color::yellow);
+    }
+
+    const bool passed = regressions.empty();
+    fmt::print("\n[{}] {} compared, {} regressed, {} improved, {} missing\n",
+        fmt::styled(passed ? "OK" : "FAILED", fmt::fg(passed ? fmt::color::green : fmt::color::red)), compared, regressions.size(), improvements.size(), missing.size());
+
+    std::vector<std::string> names;
+    names.reserve(regressions.size());
+    for (const Comparison& regression : regressions) names.push_back(regression.name);
+    return names;
+}
\ No newline at end of file
@@ -0,0 +1,31 @@
+#pragma once
+
+#pragma region STD_LIBS
+#include <cstddef>
+#include <string>
+#include <vector>
+#pragma endregion
+
+#pragma region JSON_LIB
+#include <nlohmann/json.hpp>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "Benchmark.hpp"
+#pragma endregion
+
+// Fastest of runs of a fixed loop which doesn't use the generator. Medians divided by it
+// can be compared between machines of different speed
+double runCalibration(const size_t runs);
+
+// Merges reports of several runs, every benchmark comes from the run with its median calibrated time.
+// Tolerance is defaultTolerance or more for benchmarks with bigger variation between runs
+nlohmann::ordered_json makeBaseline(const std::vector<nlohmann::ordered_json>& reports, const double defaultTolerance);
+
+// Names of benchmarks stored in baseline
+std::vector<std::string> getBaselineNames(const nlohmann::json& baseline);
+
+// Prints table of benchmarks slower or faster than baseline by more than their tolerance
+// (defaultTolerance for benchmarks without one), returns names of regressed benchmarks.
+// Baseline benchmarks not selected by runner are skipped
+std::vector<std::string> compareWithBaseline(const BenchmarkRunner& runner, const nlohmann::json& baseline, const double defaultTolerance);
\ No newline at end of file
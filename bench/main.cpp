@@ -0,0 +1,185 @@
+#pragma region PCH
+#include "pch.hpp"
+#pragma endregion
+
+#pragma region STD_LIBS
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+#pragma endregion
+
+#pragma region FMT_LIB
+#include <fmt/base.h>
+#include <fmt/color.h>
+#pragma endregion
+
+#pragma region JSON_LIB
+#include <nlohmann/json.hpp>
+#pragma endregion
+
+#pragma region MY_FILES_CORE_LIB
+#include <ThreadPool.hpp>
+#pragma endregion
+
+#pragma region MY_FILES_UTILS_LIB
+#include <StringHelpers.hpp>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "Benchmark.hpp"
+#include "ExportBench.hpp"
+#include "GenerationBench.hpp"
+#include "Regression.hpp"
+#pragma endregion
+
+static void printUsage(const char* exeName)
+{
+    fmt::print(
+        "Usage: {} [options]\n"
+        "  --suite <name>        generation, export or all (default)\n"
+        "  --json <path>         write results as JSON\n"
+        "  --filter <text>       run only benchmarks with name containing text, can be repeated\n"
+        "  --max-size <size>     largest size to run: tiny, small, medium, large (default), very-large\n"
+        "  --min-time <ms>       minimum measured time of every benchmark (default 200)\n"
+        "  --repetitions <n>     minimum number of repetitions (default 3)\n"
+        "  --threads <n>         worker threads of the thread pool, 0 uses all (default)\n"
+        "  --list                print benchmark names without running them\n"
+        "  --baseline <path>     run benchmarks of baseline and fail when some is slower than its tolerance\n"
+        "  --save-baseline <path> write results with tolerances as new baseline\n"
+        "  --baseline-runs <n>   runs of all benchmarks merged into new baseline (default 3)\n"
+        "  --tolerance <percent> smallest allowed slowdown of benchmarks (default 25)\n", exeName);
+}
+
+static int printError(const std::string& message)
+{
+    fmt::print(stderr, "[{}] Error: {}\n", fmt::styled("ERROR", fmt::fg(fmt::color::red)), message);
+    return EXIT_FAILURE;
+}
+
+template<class Json>
+static bool saveJson(const std::string& path, const Json& json)
+{
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file.is_open()) return false;
+
+    file << json.dump(4);
+    fmt::print("[{}] Results: {}\n", fmt::styled("PATH", fmt::fg(fmt::color::white)), path);
+    return true;
+}
+
+static void runBenchmarks(BenchmarkRunner& runner, const std::string& suite)
+{
+    if (!runner.getOptions().listOnly) runner.setCalibration([] { return runCalibration(3ull); });
+
+    if (suite == "all" || suite == "generation") runGenerationBenchmarks(runner);
+    if (suite == "all" || suite == "export") runExportBenchmarks(runner);
+}
+
+int main(int argc, char** argv)
+{
+    BenchmarkOptions options;
+    std::string suite = "all";
+    std::string jsonPath;
+    std::string baselinePath;
+    std::string saveBaselinePath;
+    size_t baselineRuns = 3ull;
+    double tolerance = .25;
+    bool minTimeSet = false;
+    bool threadsSet = false;
+    unsigned int threadsCount = 0u;
+
+    const std::vector<std::string> args(argv + 1, argv + argc);
+    for (size_t i = 0ull; i < args.size(); ++i) {
+        const std::string& arg = args[i];
+        if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            return EXIT_SUCCESS;
+        }
+        if (arg == "--list") {
+            options.listOnly = true;
+            continue;
+        }
+
+        if (i + 1ull >= args.size()) return printError(fmt::format("Missing value of '{}'!", arg));
+        const std::string& value = args[++i];
+
+        if (arg == "--suite") {
+            if (value != "all" && value != "generation" && value != "export") return printError(fmt::format("Unknown suite '{}'!", value));
+            suite = value;
+        }
+        else if (arg == "--json") jsonPath = value;
+        else if (arg == "--filter") options.filters.push_back(value);
+        else if (arg == "--max-size") {
+            if (!parseBenchSize(value, options.maxSize)) return printError(fmt::format("Unknown size '{}'!", value));
+        }
+        else if (arg == "--min-time") {
+            options.minTimeMs = utils::parse_float(value, (float)options.minTimeMs);
+            minTimeSet = true;
+        }
+        else if (arg == "--repetitions") options.minRepetitions = std::max(1u, utils::parse_uint(value, (unsigned int)options.minRepetitions));
+        else if (arg == "--threads") {
+            threadsCount = utils::parse_uint(value, threadsCount);
+            threadsSet = true;
+        }
+        else if (arg == "--baseline") baselinePath = value;
+        else if (arg == "--save-baseline") saveBaselinePath = value;
+        else if (arg == "--baseline-runs") baselineRuns = std::max(1u, utils::parse_uint(value, (unsigned int)baselineRuns));
+        else if (arg == "--tolerance") tolerance = std::max(0.f, utils::parse_float(value, (float)(tolerance * 100.0))) / 100.0;
+        else {
+            printUsage(argv[0]);
+            return printError(fmt::format("Unknown argument '{}'!", arg));
+        }
+    }
+    options.maxRepetitions = std::max(options.maxRepetitions, options.minRepetitions);
+
+    // Baseline decides which benchmarks run, filters can only narrow them down
+    nlohmann::json baseline;
+    if (!baselinePath.empty()) {
+        std::ifstream file(baselinePath);
+        if (!file.is_open()) return printError(fmt::format("Could not read '{}'!", baselinePath));
+
+        baseline = nlohmann::json::parse(file, nullptr, false);
+        if (baseline.is_discarded() || !baseline.contains("benchmarks")) return printError(fmt::format("'{}' is not a benchmark baseline!", baselinePath));
+
+        options.names = getBaselineNames(baseline);
+        options.maxSize = BenchSize::VERY_LARGE;
+        if (!minTimeSet) options.minTimeMs = baseline.value("minTimeMs", options.minTimeMs);
+        if (!threadsSet) threadsCount = baseline.value("threads", threadsCount);
+    }
+
+    ThreadPool::setDefaultThreadsCount(threadsCount);
+
+    BenchmarkRunner runner(options);
+    runBenchmarks(runner, suite);
+
+    if (options.listOnly) return EXIT_SUCCESS;
+
+    if (!jsonPath.empty() && !saveJson(jsonPath, runner.toJson())) return printError(fmt::format("Could not write '{}'!", jsonPath));
+    if (!saveBaselinePath.empty()) {
+        // Speed of machine changes between runs too, single run would make too tight tolerances
+        std::vector<nlohmann::ordered_json> reports{ runner.toJson() };
+        for (size_t run = 1ull; run < baselineRuns; ++run) {
+            fmt::print("\n[{}] Baseline run {} of {}\n", fmt::styled("INFO", fmt::fg(fmt::color::white)), run + 1ull, baselineRuns);
+            BenchmarkRunner baselineRunner(options);
+            runBenchmarks(baselineRunner, suite);
+            reports.push_back(baselineRunner.toJson());
+        }
+        if (!saveJson(saveBaselinePath, makeBaseline(reports, tolerance))) return printError(fmt::format("Could not write '{}'!", saveBaselinePath));
+    }
+
+    if (baselinePath.empty()) return EXIT_SUCCESS;
+
+    std::vector<std::string> regressed = compareWithBaseline(runner, baseline, tolerance);
+    if (regressed.empty()) return EXIT_SUCCESS;
+
+    // Busy machine can slow down single benchmark, only repeated regression fails
+    fmt::print("\n[{}] Measuring {} regressed benchmarks again\n", fmt::styled("INFO", fmt::fg(fmt::color::white)), regressed.size());
+    options.names = std::move(regressed);
+    options.filters.clear();
+
+    BenchmarkRunner rerunner(options);
+    runBenchmarks(rerunner, suite);
+    return compareWithBaseline(rerunner, baseline, tolerance).empty() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
\ No newline at end of file
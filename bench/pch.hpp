@@ -0,0 +1,33 @@
+#pragma once
+
+// STANDARD LIBS
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+
+// FROM CPM
+#include <fmt/base.h>
+#include <fmt/color.h>
+#include <fmt/format.h>
+
+#include <nlohmann/json.hpp>
+
+// CORE_LIB
+#include <AllocStats.hpp>
+#include <Cone.hpp>
+#include <Cube.hpp>
+#include <Cylinder.hpp>
+#include <Hexagon.hpp>
+#include <IcoSphere.hpp>
+#include <Plane.hpp>
+#include <Pyramid.hpp>
+#include <Shape.hpp>
+#include <Sphere.hpp>
+#include <Tetrahedron.hpp>
+#include <ThreadPool.hpp>
+#include <Torus.hpp>
\ No newline at end of file
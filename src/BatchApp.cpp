@@ -0,0 +1,891 @@
+#pragma region PCH
+#include "pch.hpp"
+#pragma endregion
+
+#pragma region STD_LIBS
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ratio>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#pragma endregion
+
+#pragma region FMT_LIB
+#include <fmt/base.h>
+#include <fmt/color.h>
+#include <fmt/format.h>
+#pragma endregion
+
+#pragma region JSON_LIB
+#include <nlohmann/json.hpp>
+#pragma endregion
+
+#pragma region MY_FILES_UTILS_LIB
+#include <Config.hpp>
+#include <StringHelpers.hpp>
+#include <SystemFunctions.hpp>
+#pragma endregion
+
+#pragma region MY_FILES_CORE_LIB
+#include <AllocStats.hpp>
+#include <Cone.hpp>
+#include <Cube.hpp>
+#include <Cylinder.hpp>
+#include <Hexagon.hpp>
+#include <IcoSphere.hpp>
+#include <MeshCache.hpp>
+#include <Plane.hpp>
+#include <Pyramid.hpp>
+#include <ResourceEstimate.hpp>
+#include <Shape.hpp>
+#include <Sphere.hpp>
+#include <Tetrahedron.hpp>
+#include <ThreadPool.hpp>
+#include <TiledPlane.hpp>
+#include <Torus.hpp>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "BatchApp.hpp"
+#include "OptimizeHelpers.hpp"
+#pragma endregion
+
+using Milliseconds = std::chrono::duration<double, std::milli>;
+
+static constexpr size_t MAX_SWEEP_VALUES = 100000ull;
+static constexpr size_t MAX_SWEEP_VARIANTS = 10000000ull;
+// Finished results held per thread while an earlier job is still running
+static constexpr size_t BATCH_RESULTS_WINDOW_PER_THREAD = 16ull;
+
+struct BatchItem
+{
+    std::string type;
+    nlohmann::json params = nlohmann::json::object();
+    ValuesRange range = ValuesRange::HALF_TO_HALF;
+    Shading shading = Shading::SMOOTH;
+    ShapeConfig shapeConfig{};
+    FormatType format = FormatType::BINARY;
+    std::string output;
+    // Plane saved tile by tile without building the whole mesh (BINARY and OBJ only)
+    bool tiled = false;
+    // Swept parameter values, e.g. "horizontal8_vertical16" (empty when not swept)
+    std::string variant;
+};
+
+// One manifest entry, swept entries are expanded into variants only when a worker takes them
+struct BatchEntry
+{
+    std::optional<BatchItem> item;
+    std::string error;
+    std::vector<std::pair<std::string, std::vector<nlohmann::json>>> sweep;
+    size_t variantsCount = 1ull;
+    size_t firstJob = 0ull;
+};
+
+struct BatchResult
+{
+    bool success = false;
+    std::string error;
+    std::vector<std::string> warnings;
+    std::string output;
+    Milliseconds generateTime{ 0.0 };
+    Milliseconds optimizeTime{ 0.0 };
+    Milliseconds saveTime{ 0.0 };
+    // Counted only when built with SHAPES_GENERATOR_ALLOC_STATS
+    AllocStats generateAlloc;
+    AllocStats optimizeAlloc;
+    AllocStats saveAlloc;
+    size_t verticesCount = 0ull;
+    size_t indicesCount = 0ull;
+    size_t bytes = 0ull;
+    bool cached = false;
+};
+
+#pragma region PARSE_FUNCTIONS
+// Same order as FormatType
+static const std::vector<std::string> formatNames = {
+    "CPP_ARRAY_INDICES_STRUCT", "C_ARRAY_INDICES_STRUCT", "CPP_ARRAY_VERTICES_STRUCT", "C_ARRAY_VERTICES_STRUCT",
+    "CPP_ARRAY_INDICES_FLOAT", "C_ARRAY_INDICES_FLOAT", "CPP_ARRAY_VERTICES_FLOAT", "C_ARRAY_VERTICES_FLOAT",
+    "JSON_INDICES", "JSON_VERTICES", "OBJ", "BINARY",
+    "CPP_ARRAY_STRIP_STRUCT", "C_ARRAY_STRIP_STRUCT", "CPP_ARRAY_STRIP_FLOAT", "C_ARRAY_STRIP_FLOAT", "JSON_STRIP", "BINARY_STRIP"
+};
+
+static std::string toUpper(std::string value)
+{
+    std::transform(value.begin(), value.end(), value.begin(), [](unsigned char c) { return std::toupper(c); });
+    return value;
+}
+
+static FormatType parseFormatType(const std::string& name)
+{
+    const auto it = std::find(formatNames.begin(), formatNames.end(), toUpper(name));
+    if (it == formatNames.end()) throw std::runtime_error(fmt::format("Unknown format '{}'", name));
+    return static_cast<FormatType>(it - formatNames.begin());
+}
+
+static ValuesRange parseValuesRange(const std::string& name)
+{
+    const std::string value = toUpper(name);
+    if (value == "HALF_TO_HALF") return ValuesRange::HALF_TO_HALF;
+    if (value == "ONE_TO_ONE") return ValuesRange::ONE_TO_ONE;
+    throw std::runtime_error(fmt::format("Unknown range '{}'", name));
+}
+
+static Shading parseShading(const std::string& name)
+{
+    const std::string value = toUpper(name);
+    if (value == "FLAT") return Shading::FLAT;
+    if (value == "SMOOTH") return Shading::SMOOTH;
+    throw std::runtime_error(fmt::format("Unknown shading '{}'", name));
+}
+
+static PlaneNormalDir parsePlaneDirection(const std::string& name)
+{
+    const std::string value = toUpper(name);
+    if (value == "UP") return PlaneNormalDir::UP;
+    if (value == "FRONT") return PlaneNormalDir::FRONT;
+    throw std::runtime_error(fmt::format("Unknown plane direction '{}'", name));
+}
+
+static ShapeConfig parseShapeConfig(const nlohmann::json& j, ShapeConfig config)
+{
+    config.genTangents = j.value("genTangents", config.genTangents);
+    config.calcBitangents = j.value("calcBitangents", config.calcBitangents);
+    config.tangentHandednessPositive = j.value("tangentHandednessPositive", config.tangentHandednessPositive);
+    return config;
+}
+
+// Item values override manifest defaults, which override shapes.config
+static BatchItem parseBatchItem(const nlohmann::json& j, const nlohmann::json& defaults, const ShapeConfig& baseConfig)
+{
+    auto get = [&j, &defaults](const char* key) -> const nlohmann::json* {
+        if (j.contains(key)) return &j[key];
+        if (defaults.contains(key)) return &defaults[key];
+        return nullptr;
+    };
+
+    BatchItem item;
+
+    if (!j.contains("type")) throw std::runtime_error("Missing shape type");
+    item.type = j["type"].get<std::string>();
+
+    if (j.contains("params")) item.params = j["params"];
+    if (const nlohmann::json* value = get("range")) item.range = parseValuesRange(value->get<std::string>());
+    if (const nlohmann::json* value = get("shading")) item.shading = parseShading(value->get<std::string>());
+    if (const nlohmann::json* value = get("format")) item.format = parseFormatType(value->get<std::string>());
+    if (j.contains("output")) item.output = j["output"].get<std::string>();
+    if (j.contains("tiled")) item.tiled = j["tiled"].get<bool>();
+
+    item.shapeConfig = baseConfig;
+    if (defaults.contains("config")) item.shapeConfig = parseShapeConfig(defaults["config"], item.shapeConfig);
+    if (j.contains("config")) item.shapeConfig = parseShapeConfig(j["config"], item.shapeConfig);
+
+    return item;
+}
+#pragma endregion
+
+#pragma region SWEEP_FUNCTIONS
+static std::string sweepValueToString(const nlohmann::json& value)
+{
+    return value.is_string() ? value.get<std::string>() : value.dump();
+}
+
+// Values of one swept parameter: [a, b, c], { "from", "to", "step" } or { "from", "to", "factor" } (both ends included)
+static std::vector<nlohmann::json> parseSweepValues(const std::string& name, const nlohmann::json& j)
+{
+    std::vector<nlohmann::json> values;
+
+    if (j.is_array()) {
+        values.assign(j.begin(), j.end());
+    }
+    else if (j.is_object()) {
+        if (!j.contains("from") || !j.contains("to")) throw std::runtime_error(fmt::format("Sweep of '{}' needs 'from' and 'to'", name));
+
+        const double from = j["from"].get<double>();
+        const double to = j["to"].get<double>();
+        const bool isInteger = j["from"].is_number_integer() && j["to"].is_number_integer() && (!j.contains("step") || j["step"].is_number_integer());
+        // Keeps float steps from missing the last value
+        const double epsilon = std::abs(to) * 1e-6 + 1e-9;
+
+        auto push = [&values, isInteger](const double value) {
+            if (!isInteger) values.emplace_back(value);
+            // Small factors round to the same integer a few times
+            else if (values.empty() || values.back().get<long long>() != std::llround(value)) values.emplace_back(static_cast<long long>(std::llround(value)));
+        };
+
+        if (j.contains("factor")) {
+            const double factor = j["factor"].get<double>();
+            if (factor <= 1.0 || from <= 0.0) throw std::runtime_error(fmt::format("Sweep of '{}' needs 'factor' greater than 1 and positive 'from'", name));
+            for (double value = from; value <= to + epsilon && values.size() <= MAX_SWEEP_VALUES; value *= factor) push(value);
+        }
+        else {
+            const double step = j.value("step", 1.0);
+            if (step <= 0.0) throw std::runtime_error(fmt::format("Sweep of '{}' needs positive 'step'", name));
+            for (size_t k = 0ull; from + k * step <= to + epsilon && values.size() <= MAX_SWEEP_VALUES; ++k) push(from + k * step);
+        }
+    }
+    else {
+        values.push_back(j);
+    }
+
+    if (values.empty()) throw std::runtime_error(fmt::format("Sweep of '{}' has no values", name));
+    if (values.size() > MAX_SWEEP_VALUES) throw std::runtime_error(fmt::format("Sweep of '{}' has more than {} values", name, MAX_SWEEP_VALUES));
+    return values;
+}
+
+static BatchEntry parseBatchEntry(const nlohmann::json& j, const nlohmann::json& defaults, const ShapeConfig& baseConfig)
+{
+    BatchEntry entry;
+    entry.item = parseBatchItem(j, defaults, baseConfig);
+
+    if (!j.contains("sweep")) return entry;
+    if (!j["sweep"].is_object()) throw std::runtime_error("'sweep' has to be an object");
+
+    for (const auto& [name, values] : j["sweep"].items()) {
+        entry.sweep.emplace_back(name, parseSweepValues(name, values));
+
+        const size_t count = entry.sweep.back().second.size();
+        if (entry.variantsCount > MAX_SWEEP_VARIANTS / count) throw std::runtime_error(fmt::format("Sweep has more than {} variants", MAX_SWEEP_VARIANTS));
+        entry.variantsCount *= count;
+    }
+
+    return entry;
+}
+
+// Variant number is decoded like a mixed radix number, last swept parameter changes fastest
+static BatchItem makeVariant(const BatchEntry& entry, size_t variant)
+{
+    BatchItem item = *entry.item;
+    if (entry.sweep.empty()) return item;
+
+    std::vector<std::string> parts(entry.sweep.size());
+    // Swept values without ${name} placeholder in output, file name would be shared between variants
+    std::string missing;
+    for (size_t a = entry.sweep.size(); a-- > 0ull;) {
+        const auto& [name, values] = entry.sweep[a];
+        const nlohmann::json& value = values[variant % values.size()];
+        variant /= values.size();
+
+        item.params[name] = value;
+        parts[a] = name + sweepValueToString(value);
+
+        const std::string placeholder = "${" + name + "}";
+        if (item.output.find(placeholder) == std::string::npos) missing = "_" + parts[a] + missing;
+        else utils::replace_all(item.output, placeholder, sweepValueToString(value));
+    }
+
+    item.variant = parts[0];
+    for (size_t a = 1ull; a < parts.size(); ++a) item.variant += "_" + parts[a];
+
+    if (!item.output.empty() && !missing.empty()) {
+        const std::filesystem::path path(item.output);
+        item.output = (path.parent_path() / (path.stem().string() + missing + path.extension().string())).string();
+    }
+
+    return item;
+}
+#pragma endregion
+
+#pragma region SHAPE_FUNCTIONS
+// Parameters get the same limits as in CLI mode, every adjustment is reported as a warning.
+// Value is read as 64-bit, so huge counts are clamped instead of wrapping around, negative ones are refused
+static unsigned int getUintParam(const nlohmann::json& params, const char* name, const unsigned int defaultValue, const unsigned int minValue, const unsigned int maxValue, std::vector<std::string>& warnings)
+{
+    if (!params.contains(name)) return defaultValue;
+
+    const nlohmann::json& j = params[name];
+    uint64_t value = 0ull;
+    if (j.is_number_unsigned()) {
+        value = j.get<uint64_t>();
+    }
+    else if (j.is_number_integer()) {
+        // Swept integers are signed
+        const int64_t signedValue = j.get<int64_t>();
+        if (signedValue < 0ll) throw std::runtime_error(fmt::format("{} can't be negative ({})", name, signedValue));
+        value = static_cast<uint64_t>(signedValue);
+    }
+    else if (j.is_number_float()) {
+        const double floatValue = j.get<double>();
+        if (!(floatValue >= 0.0)) throw std::runtime_error(fmt::format("{} can't be negative ({})", name, floatValue));
+        value = floatValue >= 18446744073709551615.0 ? UINT64_MAX : static_cast<uint64_t>(floatValue);
+    }
+    else {
+        throw std::runtime_error(fmt::format("{} has to be a number", name));
+    }
+
+    const uint64_t clamped = std::clamp<uint64_t>(value, minValue, maxValue);
+    if (clamped != value) warnings.push_back(fmt::format("{} adjusted from {} to {}", name, value, clamped));
+    return static_cast<unsigned int>(clamped);
+}
+
+static float getFloatParam(const nlohmann::json& params, const char* name, const float defaultValue, std::vector<std::string>& warnings)
+{
+    const float value = params.value(name, defaultValue);
+    if (value > 0.f) return value;
+
+    warnings.push_back(fmt::format("{} adjusted from {} to 1.0", name, value));
+    return 1.f;
+}
+
+// Item over unsigned int indices or memoryBudget (MB, 0 is unlimited) fails before anything is allocated
+template<class ShapeType, class... Args>
+static std::unique_ptr<Shape> generateShape(bool& cached, const BatchItem& item, const unsigned int memoryBudget, const Args&... args)
+{
+    const MeshCounts counts = ShapeType::getMeshCounts(args...);
+    if (!counts.fitsIndexType()) {
+        throw std::runtime_error(fmt::format("More than {} vertices or indices can't be addressed with 32-bit indices", MeshCounts::MAX_VERTICES));
+    }
+
+    const size_t peakBytes = ResourceEstimator::estimatePeak(counts, item.format, item.shapeConfig);
+    if (!ResourceEstimator::fitsBudget(peakBytes, memoryBudget)) {
+        // Streamed format may fit when the chosen one needs the whole file in memory
+        const bool binaryFits = !Shape::isStreamable(item.format) &&
+            ResourceEstimator::fitsBudget(ResourceEstimator::estimatePeak(counts, FormatType::BINARY, item.shapeConfig), memoryBudget);
+        throw std::runtime_error(fmt::format("Estimated memory {} is over budget of {} MB{}", ResourceEstimator::formatBytes(peakBytes), memoryBudget,
+            binaryFits ? ", BINARY format fits it" : ""));
+    }
+
+    auto [shape, fromCache] = MeshCache::get().getOrGenerate<ShapeType>(item.shapeConfig, args...);
+    cached = fromCache;
+    return std::unique_ptr<Shape>(shape);
+}
+
+static std::unique_ptr<Shape> createShape(const BatchItem& item, const unsigned int memoryBudget, std::vector<std::string>& warnings, bool& cached)
+{
+    constexpr unsigned int noLimit = 0x7FFFFFFFu;
+
+    const nlohmann::json& p = item.params;
+    const std::string type = toUpper(item.type);
+
+    if (type == "PLANE") {
+        const unsigned int rows = getUintParam(p, "rows", 2u, 2u, noLimit, warnings);
+        const unsigned int columns = getUintParam(p, "columns", 2u, 2u, noLimit, warnings);
+        const PlaneNormalDir dir = parsePlaneDirection(p.value("direction", std::string("UP")));
+        return generateShape<Plane>(cached, item, memoryBudget, rows, columns, dir, item.range);
+    }
+    if (type == "CUBE") return generateShape<Cube>(cached, item, memoryBudget, item.range);
+    if (type == "TETRAHEDRON") return generateShape<Tetrahedron>(cached, item, memoryBudget, item.range);
+    if (type == "PYRAMID") return generateShape<Pyramid>(cached, item, memoryBudget, item.range);
+    if (type == "CYLINDER") {
+        const unsigned int horizontal = getUintParam(p, "horizontalSegments", 1u, 1u, noLimit, warnings);
+        const unsigned int vertical = getUintParam(p, "verticalSegments", 3u, 3u, noLimit, warnings);
+        return generateShape<Cylinder>(cached, item, memoryBudget, horizontal, vertical, item.range, item.shading);
+    }
+    if (type == "CONE") {
+        const unsigned int segments = getUintParam(p, "segments", 3u, 3u, noLimit, warnings);
+        const float height = getFloatParam(p, "height", 1.f, warnings);
+        const float radius = getFloatParam(p, "radius", 1.f, warnings);
+        return generateShape<Cone>(cached, item, memoryBudget, segments, height, radius, item.range, item.shading);
+    }
+    if (type == "SPHERE") {
+        const unsigned int horizontal = getUintParam(p, "horizontal", 2u, 2u, noLimit, warnings);
+        const unsigned int vertical = getUintParam(p, "vertical", 3u, 3u, noLimit, warnings);
+        return generateShape<Sphere>(cached, item, memoryBudget, horizontal, vertical, item.range, item.shading);
+    }
+    if (type == "ICOSPHERE") {
+        const unsigned int subdivisions = getUintParam(p, "subdivisions", 0u, 0u, IcoSphere::MAX_SUBDIVISIONS, warnings);
+        return generateShape<IcoSphere>(cached, item, memoryBudget, subdivisions, item.range, item.shading);
+    }
+    if (type == "TORUS") {
+        const unsigned int segments = getUintParam(p, "segments", 3u, 3u, noLimit, warnings);
+        const unsigned int csSegments = getUintParam(p, "csSegments", 3u, 3u, noLimit, warnings);
+        const float radius = getFloatParam(p, "radius", 1.f, warnings);
+        const float csRadius = getFloatParam(p, "csRadius", 0.5f, warnings);
+        return generateShape<Torus>(cached, item, memoryBudget, segments, csSegments, radius, csRadius, item.range, item.shading);
+    }
+    if (type == "HEXAGON") {
+        const unsigned int segments = getUintParam(p, "segments", 1u, 1u, noLimit, warnings);
+        return generateShape<Hexagon>(cached, item, memoryBudget, segments, item.range);
+    }
+
+    throw std::runtime_error(fmt::format("Unknown shape type '{}'", item.type));
+}
+
+// Output path of item, its directory is created
+static std::filesystem::path getOutputPath(const BatchItem& item, const std::string& className, const std::filesystem::path& outputDir, const size_t index)
+{
+    // Timestamped names from shapes.config would collide between workers
+    std::string fileName = item.output;
+    if (fileName.empty()) {
+        fileName = fmt::format("{}_{}{}", className, item.variant.empty() ? std::to_string(index) : item.variant, Shape::getFormatFileExtension(item.format));
+    }
+    std::filesystem::path filePath = std::filesystem::path(fileName);
+    if (filePath.is_relative()) filePath = outputDir / filePath;
+    filePath = filePath.lexically_normal();
+
+    std::error_code ec;
+    if (filePath.has_parent_path()) std::filesystem::create_directories(filePath.parent_path(), ec);
+    if (ec) throw std::runtime_error(fmt::format("Could not create directory '{}'", filePath.parent_path().string()));
+
+    return filePath;
+}
+
+// Tiled Plane is generated while it is saved, so there is no mesh for cache, optimization passes or strips
+static void runTiledPlane(const BatchItem& item, const std::filesystem::path& outputDir, const size_t index, const bool optimize, const unsigned int memoryBudget, BatchResult& result)
+{
+    constexpr unsigned int noLimit = 0x7FFFFFFFu;
+
+    if (toUpper(item.type) != "PLANE") throw std::runtime_error("Only Plane can be tiled");
+    if (!TiledPlane::isFormatSupported(item.format)) throw std::runtime_error("Tiled Plane can be saved only as BINARY or OBJ");
+    if (optimize) result.warnings.push_back("Optimization passes are skipped for tiled Plane");
+
+    const unsigned int rows = getUintParam(item.params, "rows", 2u, 2u, noLimit, result.warnings);
+    const unsigned int columns = getUintParam(item.params, "columns", 2u, 2u, noLimit, result.warnings);
+    const PlaneNormalDir dir = parsePlaneDirection(item.params.value("direction", std::string("UP")));
+
+    const TiledPlane tiled(item.shapeConfig, rows, columns, dir, item.range);
+    if (tiled.getSubMeshesCount(item.format) == 0ull) {
+        throw std::runtime_error(fmt::format("One row of {} columns doesn't fit 32-bit indices", columns));
+    }
+
+    const size_t peakBytes = tiled.getPeakBytes(item.format);
+    if (!ResourceEstimator::fitsBudget(peakBytes, memoryBudget)) {
+        throw std::runtime_error(fmt::format("Estimated memory {} is over budget of {} MB", ResourceEstimator::formatBytes(peakBytes), memoryBudget));
+    }
+
+    const std::filesystem::path filePath = getOutputPath(item, Plane::getClassName(), outputDir, index);
+    result.output = filePath.string();
+
+    auto start = std::chrono::high_resolution_clock::now();
+    AllocScope saveAlloc;
+    if (!tiled.save(result.output, item.format)) throw std::runtime_error(fmt::format("Could not write file '{}'", result.output));
+    result.saveAlloc = saveAlloc.stop();
+    auto end = std::chrono::high_resolution_clock::now();
+
+    const MeshCounts counts = tiled.getMeshCounts(item.format);
+    std::error_code ec;
+    result.saveTime = std::chrono::duration_cast<Milliseconds>(end - start);
+    result.verticesCount = counts.vertices;
+    result.indicesCount = counts.indices;
+    result.bytes = std::filesystem::file_size(filePath, ec);
+    result.success = true;
+}
+
+// Plane which can't be saved as one mesh is saved tile by tile (like with `tiled`) when its format allows it.
+// Returns why it is tiled, empty when it is saved as one mesh
+static std::string getTilingReason(const BatchItem& item, const bool optimize, const unsigned int memoryBudget)
+{
+    constexpr unsigned int noLimit = 0x7FFFFFFFu;
+
+    if (item.tiled || toUpper(item.type) != "PLANE" || !TiledPlane::isFormatSupported(item.format)) return "";
+
+    // Adjusted parameters are reported by runTiledPlane
+    std::vector<std::string> warnings;
+    const unsigned int rows = getUintParam(item.params, "rows", 2u, 2u, noLimit, warnings);
+    const unsigned int columns = getUintParam(item.params, "columns", 2u, 2u, noLimit, warnings);
+    const PlaneNormalDir dir = parsePlaneDirection(item.params.value("direction", std::string("UP")));
+
+    // Every sub-mesh of tiled binary file fits 32-bit indices, OBJ indices have no width
+    const MeshCounts counts = Plane::getMeshCounts(rows, columns, dir, item.range);
+    if (!counts.fitsIndexType()) return fmt::format("Plane has more than {} vertices or indices, saved tiled", MeshCounts::MAX_VERTICES);
+
+    // Optimization passes need the whole mesh, such entries fail over budget
+    if (optimize || ResourceEstimator::fitsBudget(ResourceEstimator::estimatePeak(counts, item.format, item.shapeConfig), memoryBudget)) return "";
+    return fmt::format("Plane is over memory budget of {} MB as one mesh, saved tiled", memoryBudget);
+}
+
+static BatchResult runBatchItem(const BatchItem& item, const std::filesystem::path& outputDir, const size_t index, const MeshOptimizeOptions& optimizeOptions, const bool primitiveRestart, const unsigned int memoryBudget)
+{
+    BatchResult result;
+
+    try {
+        const bool optimize = isAnyMeshOptimizationEnabled(optimizeOptions);
+        const std::string tilingReason = getTilingReason(item, optimize, memoryBudget);
+        if (item.tiled || !tilingReason.empty()) {
+            if (!tilingReason.empty()) result.warnings.push_back(tilingReason);
+            runTiledPlane(item, outputDir, index, optimize, memoryBudget, result);
+            return result;
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
+        AllocScope generateAlloc;
+        std::unique_ptr<Shape> shape = createShape(item, memoryBudget, result.warnings, result.cached);
+        result.generateAlloc = generateAlloc.stop();
+        auto end = std::chrono::high_resolution_clock::now();
+        result.generateTime = std::chrono::duration_cast<Milliseconds>(end - start);
+
+        if (optimize) {
+            start = std::chrono::high_resolution_clock::now();
+            AllocScope optimizeAlloc;
+            shape->optimize(optimizeOptions);
+            result.optimizeAlloc = optimizeAlloc.stop();
+            end = std::chrono::high_resolution_clock::now();
+            result.optimizeTime = std::chrono::duration_cast<Milliseconds>(end - start);
+        }
+
+        shape->setPrimitiveRestart(primitiveRestart);
+        result.verticesCount = shape->getVerticesCount();
+        result.indicesCount = shape->getIndicesCount();
+
+        const std::filesystem::path filePath = getOutputPath(item, shape->getObjectClassName(), outputDir, index);
+        result.output = filePath.string();
+
+        start = std::chrono::high_resolution_clock::now();
+        AllocScope saveAlloc;
+        if (!shape->save(result.output, item.format)) throw std::runtime_error(fmt::format("Could not write file '{}'", result.output));
+        result.saveAlloc = saveAlloc.stop();
+        end = std::chrono::high_resolution_clock::now();
+
+        std::error_code ec;
+        result.saveTime = std::chrono::duration_cast<Milliseconds>(end - start);
+        result.bytes = std::filesystem::file_size(filePath, ec);
+        result.success = true;
+    }
+    catch (const std::exception& e) {
+        result.error = e.what();
+    }
+
+    return result;
+}
+#pragma endregion
+
+#pragma region SUMMARY_FUNCTIONS
+static nlohmann::ordered_json allocToJson(const AllocStats& stats)
+{
+    nlohmann::ordered_json j;
+    j["count"] = stats.count;
+    j["bytes"] = stats.bytes;
+    j["peakBytes"] = stats.peakBytes;
+    return j;
+}
+
+static nlohmann::ordered_json resultToJson(const BatchItem* item, const BatchResult& result, const size_t index)
+{
+    nlohmann::ordered_json j;
+    j["index"] = index;
+    if (item) {
+        j["type"] = item->type;
+        if (!item->variant.empty()) j["variant"] = item->variant;
+        j["params"] = item->params;
+    }
+    j["status"] = result.success ? "ok" : "error";
+    if (!result.success) j["error"] = result.error;
+    if (!result.warnings.empty()) j["warnings"] = result.warnings;
+    if (item) j["format"] = formatNames[static_cast<size_t>(item->format)];
+    if (!result.output.empty()) j["output"] = result.output;
+    j["cached"] = result.cached;
+    j["generateMs"] = result.generateTime.count();
+    j["optimizeMs"] = result.optimizeTime.count();
+    j["saveMs"] = result.saveTime.count();
+    j["totalMs"] = (result.generateTime + result.optimizeTime + result.saveTime).count();
+    j["vertices"] = result.verticesCount;
+    j["indices"] = result.indicesCount;
+    j["bytes"] = result.bytes;
+    if (AllocScope::isEnabled()) {
+        j["allocations"] = {
+            { "generate", allocToJson(result.generateAlloc) },
+            { "optimize", allocToJson(result.optimizeAlloc) },
+            { "save", allocToJson(result.saveAlloc) }
+        };
+    }
+    return j;
+}
+
+static std::string csvField(const std::string& value)
+{
+    if (value.find_first_of(",\"\n") == std::string::npos) return value;
+
+    std::string escaped = value;
+    utils::replace_all(escaped, "\"", "\"\"");
+    return "\"" + escaped + "\"";
+}
+
+// Index file written row by row while the batch runs, CSV when path ends with .csv, JSON array otherwise
+class IndexWriter
+{
+public:
+    bool open(const std::filesystem::path& path)
+    {
+        std::error_code ec;
+        if (path.has_parent_path()) std::filesystem::create_directories(path.parent_path(), ec);
+
+        _file.open(path, std::ios::out | std::ios::trunc | std::ios::binary);
+        if (!_file.is_open()) return false;
+
+        _isCsv = toUpper(path.extension().string()) == ".CSV";
+        if (_isCsv) {
+            _file << "index,type,variant,params,format,status,output,cached,vertices,indices,bytes,generateMs,optimizeMs,exportMs,error\n";
+        }
+        else {
+            _file << "[";
+        }
+        return !_file.fail();
+    }
+
+    void write(const size_t index, const BatchItem* item, const BatchResult& result)
+    {
+        if (_isCsv) {
+            _file << fmt::format("{},{},{},{},{},{},{},{},{},{},{},{:.4f},{:.4f},{:.4f},{}\n", index,
+                item ? csvField(item->type) : "", item ? csvField(item->variant) : "", item ? csvField(item->params.dump()) : "",
+                item ? formatNames[static_cast<size_t>(item->format)] : "", result.success ? "ok" : "error", csvField(result.output), result.cached ? "true" : "false",
+                result.verticesCount, result.indicesCount, result.bytes,
+                result.generateTime.count(), result.optimizeTime.count(), result.saveTime.count(), csvField(result.error));
+        }
+        else {
+            // Separator goes before the row, count of rows isn't known until the batch ends
+            _file << (_rows == 0ull ? "\n    " : ",\n    ") << resultToJson(item, result, index).dump();
+        }
+        ++_rows;
+    }
+
+    bool close()
+    {
+        if (!_isCsv) _file << "\n]\n";
+        _file.close();
+        return !_file.fail();
+    }
+
+private:
+    std::ofstream _file;
+    bool _isCsv = false;
+    size_t _rows = 0ull;
+};
+
+// Results of finished jobs are passed to sink in job order. Job more than window ahead of the first unfinished one
+// waits before it starts, so at most window results are held while a slow job holds up the ones after it
+class OrderedResults
+{
+public:
+    using Sink = std::function<void(size_t, const BatchResult&)>;
+
+    OrderedResults(const size_t window, Sink sink) : _window(std::max<size_t>(window, 1ull)), _sink(std::move(sink)) {}
+
+    void waitForSlot(const size_t job)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _slotFree.wait(lock, [this, job]() { return job < _next + _window; });
+    }
+
+    // Sink is called under the lock, rows are never written by two threads at once
+    void add(const size_t job, BatchResult result)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _pending.emplace(job, std::move(result));
+
+        bool advanced = false;
+        for (auto it = _pending.begin(); it != _pending.end() && it->first == _next; it = _pending.erase(it)) {
+            _sink(_next, it->second);
+            ++_next;
+            advanced = true;
+        }
+        if (advanced) _slotFree.notify_all();
+    }
+
+private:
+    std::mutex _mutex;
+    std::condition_variable _slotFree;
+    std::map<size_t, BatchResult> _pending;
+    size_t _next = 0ull;
+    size_t _window = 1ull;
+    Sink _sink;
+};
+
+static int failBatch(const std::string& message)
+{
+    fmt::print(stderr, "[{}] Error: {}\n", fmt::styled("ERROR", fmt::fg(fmt::color::red)), message);
+    return EXIT_FAILURE;
+}
+#pragma endregion
+
+int cli::batchApp(const std::string& manifestPath, const std::string& summaryPath)
+{
+#pragma region LOAD_MANIFEST
+    std::string exeDirPath = utils::get_executable_path();
+    const utils::Config& config = utils::get_config(exeDirPath);
+
+    nlohmann::json manifest;
+    {
+        std::ifstream file(manifestPath);
+        if (!file.is_open()) return failBatch(fmt::format("Could not open manifest '{}'!", manifestPath));
+
+        manifest = nlohmann::json::parse(file, nullptr, false);
+        if (manifest.is_discarded()) return failBatch(fmt::format("Manifest '{}' is not valid JSON!", manifestPath));
+    }
+
+    // Manifest is either a list of shapes or an object with "shapes" and optional settings
+    const nlohmann::json shapes = manifest.is_array() ? manifest : manifest.value("shapes", nlohmann::json::array());
+    const nlohmann::json defaults = manifest.is_object() ? manifest.value("defaults", nlohmann::json::object()) : nlohmann::json::object();
+    if (!shapes.is_array()) return failBatch("Manifest 'shapes' has to be an array!");
+
+    // Relative outputDir is resolved against manifest location, default is saveDir from shapes.config
+    const std::filesystem::path manifestDir = std::filesystem::absolute(manifestPath).parent_path();
+    std::filesystem::path outputDir;
+    if (manifest.is_object() && manifest.contains("outputDir")) {
+        outputDir = manifest["outputDir"].get<std::string>();
+        if (outputDir.is_relative()) outputDir = manifestDir / outputDir;
+    }
+    else {
+        outputDir = config.saveDir;
+        if (outputDir.is_relative()) outputDir = std::filesystem::path(exeDirPath) / outputDir;
+    }
+
+    ShapeConfig baseConfig = {
+        config.genTangents,
+        config.calcBitangents,
+        config.tangentHandednessPositive
+    };
+
+    // Broken entries are reported in summary, the rest of the batch still runs
+    std::vector<BatchEntry> entries(shapes.size());
+    size_t jobsCount = 0ull;
+    for (size_t i = 0ull; i < shapes.size(); ++i) {
+        try {
+            entries[i] = parseBatchEntry(shapes[i], defaults, baseConfig);
+        }
+        catch (const std::exception& e) {
+            entries[i] = BatchEntry{};
+            entries[i].error = e.what();
+        }
+
+        entries[i].firstJob = jobsCount;
+        jobsCount += entries[i].variantsCount;
+    }
+
+    if (jobsCount > MAX_SWEEP_VARIANTS) return failBatch(fmt::format("Manifest expands to more than {} shapes!", MAX_SWEEP_VARIANTS));
+
+    // Entry that owns given job
+    auto findEntry = [&entries](const size_t job) -> size_t {
+        const auto it = std::upper_bound(entries.begin(), entries.end(), job, [](const size_t value, const BatchEntry& entry) { return value < entry.firstJob; });
+        return static_cast<size_t>(it - entries.begin()) - 1ull;
+    };
+
+    std::filesystem::path indexPath;
+    if (manifest.is_object() && manifest.contains("index")) {
+        indexPath = manifest["index"].get<std::string>();
+        if (indexPath.is_relative()) indexPath = outputDir / indexPath;
+    }
+#pragma endregion
+
+#pragma region RUN_BATCH
+    // Manifest can override pool size from shapes.config, pool is not created before this point
+    const unsigned int manifestThreads = manifest.is_object() ? manifest.value("threads", 0u) : 0u;
+    if (manifestThreads > 0u) ThreadPool::setDefaultThreadsCount(manifestThreads);
+
+    ThreadPool& pool = ThreadPool::get();
+    const size_t threadsCount = std::clamp<size_t>(pool.getThreadsCount(), 1ull, std::max<size_t>(jobsCount, 1ull));
+
+    const MeshOptimizeOptions optimizeOptions = getMeshOptimizeOptions(config);
+
+    auto itemAt = [&entries, &findEntry](const size_t job) -> std::optional<BatchItem> {
+        const BatchEntry& entry = entries[findEntry(job)];
+        if (!entry.item) return std::nullopt;
+        return makeVariant(entry, job - entry.firstJob);
+    };
+
+    // Rows go to the index file (or summary items) as soon as jobs before them are done, results aren't kept for the whole batch
+    IndexWriter index;
+    if (!indexPath.empty() && !index.open(indexPath)) return failBatch(fmt::format("Could not save index '{}'!", indexPath.string()));
+
+    nlohmann::ordered_json itemsJson = nlohmann::ordered_json::array();
+    size_t failedCount = 0ull;
+    size_t cachedCount = 0ull;
+    size_t totalBytes = 0ull;
+    OrderedResults ordered(BATCH_RESULTS_WINDOW_PER_THREAD * threadsCount, [&](const size_t job, const BatchResult& result) {
+        if (!result.success) ++failedCount;
+        if (result.cached) ++cachedCount;
+        totalBytes += result.bytes;
+
+        const std::optional<BatchItem> item = itemAt(job);
+        if (indexPath.empty()) itemsJson.push_back(resultToJson(item ? &*item : nullptr, result, job));
+        else index.write(job, item ? &*item : nullptr, result);
+    });
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    // Every batch thread takes next job until list runs out, so long shapes don't hold up short ones.
+    // Each of them keeps at most one shape in memory, it is freed as soon as its file is written.
+    // Batch loops run on own threads, not pool workers: a pool thread waiting inside a job could pick up another
+    // loop, which would wait for a window slot held by the job below it on the same stack. Parallel kernels of a job
+    // (tangents, formatting) still go to the pool, a thread outside of it only helps its own task group while waiting
+    std::atomic<size_t> nextJob = 0ull;
+    std::vector<std::exception_ptr> exceptions(threadsCount);
+    auto worker = [&](const size_t thread) {
+        try {
+            for (size_t i = nextJob++; i < jobsCount; i = nextJob++) {
+                ordered.waitForSlot(i);
+
+                const BatchEntry& entry = entries[findEntry(i)];
+                BatchResult result;
+                if (!entry.item) result.error = entry.error;
+                else result = runBatchItem(makeVariant(entry, i - entry.firstJob), outputDir, i, optimizeOptions, config.stripPrimitiveRestart, config.memoryBudget);
+
+                ordered.add(i, std::move(result));
+            }
+        }
+        catch (...) {
+            exceptions[thread] = std::current_exception();
+        }
+    };
+
+    {
+        std::vector<std::jthread> threads;
+        threads.reserve(threadsCount);
+        for (size_t t = 0ull; t < threadsCount; ++t) threads.emplace_back(worker, t);
+    }
+
+    for (const std::exception_ptr& exception : exceptions) {
+        if (exception) std::rethrow_exception(exception);
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    const Milliseconds elapsed = std::chrono::duration_cast<Milliseconds>(end - start);
+#pragma endregion
+
+#pragma region SUMMARY
+    nlohmann::ordered_json summary;
+    summary["version"] = SHAPES_GENERATOR_VERSION;
+    summary["manifest"] = std::filesystem::absolute(manifestPath).lexically_normal().string();
+    summary["threads"] = threadsCount;
+    summary["succeeded"] = jobsCount - failedCount;
+    summary["failed"] = failedCount;
+    summary["cached"] = cachedCount;
+    summary["bytes"] = totalBytes;
+    summary["totalMs"] = elapsed.count();
+
+    // With an index file the per item list lives only there, summary stays small for big sweeps
+    if (!indexPath.empty()) {
+        if (!index.close()) return failBatch(fmt::format("Could not save index '{}'!", indexPath.string()));
+        summary["index"] = indexPath.lexically_normal().string();
+    }
+    else {
+        summary["items"] = std::move(itemsJson);
+    }
+
+    const std::string summaryText = summary.dump(4);
+
+    if (summaryPath.empty()) {
+        fmt::print("{}\n", summaryText);
+    }
+    else {
+        std::ofstream file(summaryPath, std::ios::out | std::ios::trunc | std::ios::binary);
+        if (!file.is_open()) return failBatch(fmt::format("Could not save summary '{}'!", summaryPath));
+        file.write(summaryText.data(), summaryText.size());
+        file.close();
+
+        fmt::print("[{}] {} of {} shapes generated in {}ms on {} threads ({} from cache, {} KB)\n[{}] Summary: {}\n",
+            fmt::styled(failedCount == 0ull ? "OK" : "WARNING", fmt::fg(failedCount == 0ull ? fmt::color::green : fmt::color::yellow)),
+            jobsCount - failedCount, jobsCount, elapsed.count(), threadsCount, cachedCount, totalBytes / 1024ull,
+            fmt::styled("PATH", fmt::fg(fmt::color::white)), summaryPath);
+    }
+
+    return failedCount == 0ull ? EXIT_SUCCESS : EXIT_FAILURE;
+#pragma endregion
+}
\ No newline at end of file
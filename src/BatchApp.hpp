@@ -0,0 +1,12 @@
+#pragma once
+
+#pragma region STD_LIBS
+#include <string>
+#pragma endregion
+
+namespace cli
+{
+	// Generates every shape listed in the manifest on a thread pool, summary is written as JSON
+	// to summaryPath (or stdout when empty)
+	extern int batchApp(const std::string& manifestPath, const std::string& summaryPath);
+}
\ No newline at end of file
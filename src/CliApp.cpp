@@ -7,9 +7,9 @@
 #include <cstdlib>
 #include <ctype.h>
 #include <filesystem>
-#include <fstream>
 #include <iostream>
 #include <ratio>
+#include <stdexcept>
 #include <string>
 #include <vector>
 #pragma endregion
@@ -32,6 +32,7 @@
 #include <processenv.h>
 #include <conio.h>
 #else
+#include <poll.h>
 #include <termios.h>
 #include <unistd.h>
 #endif
@@ -47,10 +48,13 @@
 #include <Cone.hpp>
 #include <Cube.hpp>
 #include <Cylinder.hpp>
+#include <GenerationStats.hpp>
 #include <Hexagon.hpp>
 #include <IcoSphere.hpp>
 #include <Plane.hpp>
+#include <ProgressToken.hpp>
 #include <Pyramid.hpp>
+#include <ResourceEstimate.hpp>
 #include <Shape.hpp>
 #include <Sphere.hpp>
 #include <Tetrahedron.hpp>
@@ -60,6 +64,7 @@
 #pragma region MY_FILES
 #include "CliApp.hpp"
 #include "ConsoleTemplates.hpp"
+#include "OptimizeHelpers.hpp"
 #pragma endregion
 
 Shape* selectedShape = nullptr;
@@ -136,6 +141,31 @@ static char getChar() {
 #endif
 }
 
+// Waits up to timeoutMs for a key while a task runs, returns true when it was ESC
+static bool waitForCancelKey(int timeoutMs) {
+#if defined(_WIN32)
+    const auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (std::chrono::steady_clock::now() < end) {
+        if (_kbhit()) return _getch() == 27;
+        Sleep(10);
+    }
+    return false;
+#else
+    struct termios oldt, newt;
+    tcgetattr(STDIN_FILENO, &oldt);
+    newt = oldt;
+    newt.c_lflag &= ~(ICANON | ECHO);
+    tcsetattr(STDIN_FILENO, TCSANOW, &newt);
+
+    struct pollfd input = { STDIN_FILENO, POLLIN, 0 };
+    char ch = 0;
+    const bool wasRead = poll(&input, 1, timeoutMs) > 0 && read(STDIN_FILENO, &ch, 1) == 1;
+
+    tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
+    return wasRead && ch == 27;
+#endif
+}
+
 static bool checkForEsc(char ch)
 {
     if (ch == 27) {  // ASCII code for ESC key
@@ -146,6 +176,18 @@ static bool checkForEsc(char ch)
     return false;
 }
 
+// Digits over int range would make std::stoi throw
+static bool fitsInt(const std::string& input)
+{
+    try {
+        (void)std::stoi(input);
+        return true;
+    }
+    catch (const std::out_of_range&) {
+        return false;
+    }
+}
+
 static int getIntInput(const std::string& prompt)
 {
     std::string input = "";
@@ -172,6 +214,13 @@ static int getIntInput(const std::string& prompt)
                 fmt::print("\n[{}] Invalid input! Please enter a number.\n{}", fmt::styled("WARNING", fmt::fg(fmt::color::yellow)), prompt);
 #if !defined(_WIN32)
                 std::cout << std::flush;
+#endif
+                input.clear();
+            }
+            else if (!fitsInt(input)) {
+                fmt::print("\n[{}] Number is too large! Please enter a smaller one.\n{}", fmt::styled("WARNING", fmt::fg(fmt::color::yellow)), prompt);
+#if !defined(_WIN32)
+                std::cout << std::flush;
 #endif
                 input.clear();
             }
@@ -367,6 +416,43 @@ static Shading getShadingType(const std::string& shapeName, std::function<int(in
     return static_cast<Shading>(dir_choice - 1);
 }
 
+// Config values are the defaults, pass can be switched on or off for this shape
+static void getVertexCacheOptions(MeshOptimizeOptions& options)
+{
+    int choice;
+    do {
+        fmt::print("\n> Reorder indices for the post-transform vertex cache (config: {}):\n1) No\n2) Yes\n", options.optimizeVertexCache ? "yes" : "no");
+        choice = getIntInput(getInputPrompt(1, 2));
+        if (choice < 1 || choice > 2) {
+            printInvalidOption(1, 2);
+        }
+    } while (choice < 1 || choice > 2);
+
+    options.optimizeVertexCache = choice == 2;
+    if (!options.optimizeVertexCache) return;
+
+    // Optimizer clamps smaller caches, so the report would simulate a different one
+    const int minSize = static_cast<int>(MeshOptimizer::MIN_CACHE_SIZE);
+    const int maxSize = static_cast<int>(MeshOptimizer::MAX_CACHE_SIZE);
+    int cacheSize;
+    do {
+        cacheSize = getIntInput(fmt::format("   - Simulated cache size ({} - {}, config: {}): ", minSize, maxSize, options.vertexCacheSize));
+        if (cacheSize < minSize || cacheSize > maxSize) {
+            printInvalidOption(minSize, maxSize);
+        }
+    } while (cacheSize < minSize || cacheSize > maxSize);
+    options.vertexCacheSize = static_cast<unsigned int>(cacheSize);
+
+    do {
+        fmt::print("\n> Select the simulated cache type:\n1) FIFO\n2) LRU\n");
+        choice = getIntInput(getInputPrompt(1, 2));
+        if (choice < 1 || choice > 2) {
+            printInvalidOption(1, 2);
+        }
+    } while (choice < 1 || choice > 2);
+    options.vertexCacheType = choice == 2 ? VertexCacheType::LRU : VertexCacheType::FIFO;
+}
+
 static FormatType getFormatType()
 {
     static const std::vector<std::string> options {
@@ -382,7 +468,15 @@ static FormatType getFormatType()
 
         "Export — JSON — Vertices & Indices",
         "Export — JSON — Vertices only",
-        "Export — OBJ"
+        "Export — OBJ",
+        "Export — Binary",
+
+        "std::array — Vertices & Strip (struct)",
+        "C array    — Vertices & Strip (struct)",
+        "std::array — Vertices & Strip (float)",
+        "C array    — Vertices & Strip (float)",
+        "Export — JSON — Vertices & Strip",
+        "Export — Binary — Strip"
     };
 
     static const size_t optSize = options.size();
@@ -431,11 +525,15 @@ int cli::cliApp()
 #pragma region SHAPE_GENERATION
     range = getValuesRange();
     std::chrono::duration<double, std::milli> elapsed_seconds;
+    AllocScope::collectReport(true);
     ShapeConfig shapeConfig = {
         config.genTangents,
         config.calcBitangents,
         config.tangentHandednessPositive
     };
+    // Generation and saving run on the thread pool, ESC cancels them
+    ProgressToken progress;
+    shapeConfig.progress = &progress;
 
     switch (choice) {
         case 1: {
@@ -454,12 +552,12 @@ int cli::cliApp()
 
             PlaneNormalDir dir = getPlaneDirection();
 
-            elapsed_seconds = generateShape<Plane>(selectedShape, shapeConfig, rows, columns, dir, range);
+            elapsed_seconds = generateShape<Plane>(selectedShape, shapeConfig, config.memoryBudget, waitForCancelKey, rows, columns, dir, range);
             break;
         }
-        case 2: elapsed_seconds = generateShape<Cube>(selectedShape, shapeConfig, range); break;
-        case 3: elapsed_seconds = generateShape<Tetrahedron>(selectedShape, shapeConfig, range); break;
-        case 4: elapsed_seconds = generateShape<Pyramid>(selectedShape, shapeConfig, range); break;
+        case 2: elapsed_seconds = generateShape<Cube>(selectedShape, shapeConfig, config.memoryBudget, waitForCancelKey, range); break;
+        case 3: elapsed_seconds = generateShape<Tetrahedron>(selectedShape, shapeConfig, config.memoryBudget, waitForCancelKey, range); break;
+        case 4: elapsed_seconds = generateShape<Pyramid>(selectedShape, shapeConfig, config.memoryBudget, waitForCancelKey, range); break;
         case 5: {
             fmt::print("\n> Enter cylinder parameters:\n");
             int horizontalSegments = getIntInput("   - Number of horizontal segments (min: 1): ");
@@ -475,7 +573,7 @@ int cli::cliApp()
 
             Shading shade = getShadingType("cylinder", intChooseInput, printInvalidOption);
 
-            elapsed_seconds = generateShape<Cylinder>(selectedShape, shapeConfig, horizontalSegments, verticalSegments, range, shade);
+            elapsed_seconds = generateShape<Cylinder>(selectedShape, shapeConfig, config.memoryBudget, waitForCancelKey, horizontalSegments, verticalSegments, range, shade);
             break;
         }
         case 6: {
@@ -500,7 +598,7 @@ int cli::cliApp()
 
             Shading shade = getShadingType("cone", intChooseInput, printInvalidOption);
 
-            elapsed_seconds = generateShape<Cone>(selectedShape, shapeConfig, segments, height, radius, range, shade);
+            elapsed_seconds = generateShape<Cone>(selectedShape, shapeConfig, config.memoryBudget, waitForCancelKey, segments, height, radius, range, shade);
             break;
         }
         case 7: {
@@ -519,24 +617,25 @@ int cli::cliApp()
 
             Shading shade = getShadingType("sphere", intChooseInput, printInvalidOption);
 
-            elapsed_seconds = generateShape<Sphere>(selectedShape, shapeConfig, horizontal, vertical, range, shade);
+            elapsed_seconds = generateShape<Sphere>(selectedShape, shapeConfig, config.memoryBudget, waitForCancelKey, horizontal, vertical, range, shade);
             break;
         }
         case 8: {
             fmt::print("\n> Enter icoSphere parameters:\n");
-            int subs = getIntInput("   - Number of subdivisions (0 - 8): ");
+            constexpr int maxSubs = static_cast<int>(IcoSphere::MAX_SUBDIVISIONS);
+            int subs = getIntInput(fmt::format("   - Number of subdivisions (0 - {}): ", maxSubs));
             if (subs < 0) {
                 fmt::print("[{}] Adjusted to minimum of 0 subdivisions.\n", fmt::styled("INFO", fmt::fg(fmt::color::white)));
                 subs = 0;
             }
-            else if (subs > 8) {
-                fmt::print("[{}] Adjusted to maximum of 8 subdivisions.\n", fmt::styled("INFO", fmt::fg(fmt::color::white)));
-                subs = 8;
+            else if (subs > maxSubs) {
+                fmt::print("[{}] Adjusted to maximum of {} subdivisions.\n", fmt::styled("INFO", fmt::fg(fmt::color::white)), maxSubs);
+                subs = maxSubs;
             }
 
             Shading shade = getShadingType("icoSphere", intChooseInput, printInvalidOption);
 
-            elapsed_seconds = generateShape<IcoSphere>(selectedShape, shapeConfig, subs, range, shade);
+            elapsed_seconds = generateShape<IcoSphere>(selectedShape, shapeConfig, config.memoryBudget, waitForCancelKey, subs, range, shade);
             break;
         }
         case 9: {
@@ -567,7 +666,7 @@ int cli::cliApp()
 
             Shading shade = getShadingType("torus", intChooseInput, printInvalidOption);
 
-            elapsed_seconds = generateShape<Torus>(selectedShape, shapeConfig, segments, cs_segments, radius, cs_radius, range, shade);
+            elapsed_seconds = generateShape<Torus>(selectedShape, shapeConfig, config.memoryBudget, waitForCancelKey, segments, cs_segments, radius, cs_radius, range, shade);
             break;
         }
         case 10: {
@@ -578,7 +677,7 @@ int cli::cliApp()
                 horizontalSegments = 1;
             }
 
-            elapsed_seconds = generateShape<Hexagon>(selectedShape, shapeConfig, horizontalSegments, range);
+            elapsed_seconds = generateShape<Hexagon>(selectedShape, shapeConfig, config.memoryBudget, waitForCancelKey, horizontalSegments, range);
             break;
         }
     }
@@ -590,11 +689,53 @@ int cli::cliApp()
         return EXIT_FAILURE;
     }
 
+    if (selectedShape->isCancelled()) {
+        waitForEnter("\nPress Enter to exit...");
+        delete selectedShape;
+        return EXIT_SUCCESS;
+    }
+
     fmt::print("\n[{}] Shape successfully generated in {}ms!\n", fmt::styled("INFO", fmt::fg(fmt::color::white)), elapsed_seconds.count());
+    printGenerationStats(selectedShape->getGenerationStats());
+    printAllocReport();
+#pragma endregion
+
+#pragma region OPTIMIZE_SHAPE
+    MeshOptimizeOptions optimizeOptions = getMeshOptimizeOptions(config);
+    getVertexCacheOptions(optimizeOptions);
+    if (isAnyMeshOptimizationEnabled(optimizeOptions)) {
+        fmt::print("\n[{}] Start Optimizing {}...\n", fmt::styled("OK", fmt::fg(fmt::color::green)), selectedShape->getObjectClassName());
+        auto start = std::chrono::high_resolution_clock::now();
+
+        MeshOptimizeReport report = selectedShape->optimize(optimizeOptions);
+
+        auto end = std::chrono::high_resolution_clock::now();
+        elapsed_seconds = std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(end - start);
+
+        fmt::print("[{}] Shape optimized in {}ms!\n", fmt::styled("OK", fmt::fg(fmt::color::green)), elapsed_seconds.count());
+        for (const auto& [label, value] : getMeshOptimizeReportLines(report, optimizeOptions)) {
+            fmt::print("[{}] {}: {}\n", fmt::styled("INFO", fmt::fg(fmt::color::white)), label, value);
+        }
+        printAllocReport();
+    }
 #pragma endregion
 
 #pragma region SAVE_SHAPE
     FormatType format = getFormatType();
+    selectedShape->setPrimitiveRestart(config.stripPrimitiveRestart);
+
+    const ExportEstimate exportEstimate = ResourceEstimator::estimateExport({ selectedShape->getVerticesCount(), selectedShape->getIndicesCount() }, format, shapeConfig);
+    fmt::print("\n[{}] Expected file size ~{} (peak memory ~{})\n", fmt::styled("INFO", fmt::fg(fmt::color::white)),
+        ResourceEstimator::formatBytes(exportEstimate.fileBytes), ResourceEstimator::formatBytes(exportEstimate.peakBytes));
+    if (!ResourceEstimator::fitsBudget(exportEstimate.peakBytes, config.memoryBudget)) {
+        // Streamed format may fit when the chosen one needs the whole file in memory
+        const bool binaryFits = !Shape::isStreamable(format) && ResourceEstimator::fitsBudget(
+            ResourceEstimator::estimateExport({ selectedShape->getVerticesCount(), selectedShape->getIndicesCount() }, FormatType::BINARY, shapeConfig).peakBytes, config.memoryBudget);
+        fmt::print("[{}] Saving in this format needs more than memory budget of {} MB, choose {} or raise memoryBudget in shapes.config.\n",
+            fmt::styled("ERROR", fmt::fg(fmt::color::red)), config.memoryBudget, binaryFits ? "BINARY format (saved in chunks)" : "smaller format");
+        delete selectedShape;
+        return EXIT_FAILURE;
+    }
 
     if (!utils::check_directory(config.saveDir.c_str())) {
         if (utils::create_directory(config.saveDir.c_str())) {
@@ -613,13 +754,18 @@ int cli::cliApp()
     fmt::print("\n[{}] Start Saving {} to file...\n", fmt::styled("OK", fmt::fg(fmt::color::green)), selectedShape->getObjectClassName());
     auto start = std::chrono::high_resolution_clock::now();
 
-    std::ofstream file(filePath, std::ios::out | std::ios::trunc | std::ios::binary);
+    GenerationStats saveStats;
+    const bool saved = runCancellable(progress, waitForCancelKey, [&]() { return selectedShape->save(filePath, format, &saveStats, &progress); });
+    if (progress.isCancelled()) {
+        // Partly written file is removed by save
+        fmt::print("[{}] Saving cancelled, no file was written.\n", fmt::styled("CANCELLED", fmt::fg(fmt::color::yellow)));
 
-    if (file.is_open()) {
-        std::string text = selectedShape->toString(format);
-        file.write(text.data(), text.size());
-        file.close();
+        waitForEnter("\nPress Enter to exit...");
+        delete selectedShape;
+        return EXIT_SUCCESS;
+    }
 
+    if (saved) {
         auto end = std::chrono::high_resolution_clock::now();
 
         elapsed_seconds = std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(end - start);
@@ -631,6 +777,31 @@ int cli::cliApp()
             fmt::styled("SAVED", fmt::fg(fmt::color::green)),
             elapsed_seconds.count(),
             fmt::styled("PATH", fmt::fg(fmt::color::white)), filePath);
+        printGenerationStats(saveStats);
+        printAllocReport();
+
+        if (config.saveTrace) {
+            GenerationStats trace = selectedShape->getGenerationStats();
+            trace.append(saveStats);
+            const std::string tracePath = filePath + ".trace.json";
+            if (trace.saveChromeTrace(tracePath)) {
+                fmt::print("[{}] Trace path: {}\n", fmt::styled("PATH", fmt::fg(fmt::color::white)), tracePath);
+            }
+            else {
+                fmt::print("[{}] Error: Could not save the trace file!\n", fmt::styled("ERROR", fmt::fg(fmt::color::red)));
+            }
+        }
+
+        if (optimizeOptions.optimizeVertexFetch) {
+            VertexFetchStats fetchStats = selectedShape->getVertexFetchStats();
+            fmt::print("[{}] Vertex fetch: overfetch {:.3f}, {} bytes per vertex\n",
+                fmt::styled("INFO", fmt::fg(fmt::color::white)), fetchStats.overfetch, selectedShape->getVertexStride());
+        }
+
+        if (Shape::isStripFormat(format)) {
+            const auto [label, value] = getStripReportLine(selectedShape->getStripStats(), config.stripPrimitiveRestart);
+            fmt::print("[{}] {}: {}\n", fmt::styled("INFO", fmt::fg(fmt::color::white)), label, value);
+        }
 
         if (config.openDirOnSave)
         {
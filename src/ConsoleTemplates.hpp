@@ -2,7 +2,11 @@
 
 #pragma region STD_LIBS
 #include <chrono>
+#include <cstdio>
+#include <future>
 #include <ratio>
+#include <type_traits>
+#include <utility>
 #pragma endregion
 
 #pragma region FMT_LIB
@@ -11,22 +15,107 @@
 #pragma endregion
 
 #pragma region MY_FILES_CORE_LIB
+#include <AllocStats.hpp>
+#include <GenerationStats.hpp>
+#include <MeshCache.hpp>
+#include <Plane.hpp>
+#include <ProgressToken.hpp>
+#include <ResourceEstimate.hpp>
 #include <Shape.hpp>
+#include <ThreadPool.hpp>
 #pragma endregion
 
+// Prints phases measured since last call, nothing is measured unless built with SHAPES_GENERATOR_ALLOC_STATS
+static void printAllocReport() {
+    for (const auto& [phase, stats] : AllocScope::takeReport()) {
+        fmt::print("[{}] {}: {} allocations, {} KB allocated, {} KB peak\n", fmt::styled("MEMORY", fmt::fg(fmt::color::white)),
+            phase, stats.count, stats.bytes / 1024ull, stats.peakBytes / 1024ull);
+    }
+}
+
+// Prints summed duration of every phase, in order of first start
+static void printGenerationStats(const GenerationStats& stats) {
+    for (const auto& [phase, ms] : stats.getSummary()) {
+        fmt::print("[{}] {}: {:.3f}ms\n", fmt::styled("TIME", fmt::fg(fmt::color::white)), phase, ms);
+    }
+}
+
+// Runs task on the thread pool and prints progress of its phase until it finishes. waitForCancelKey(timeoutMs)
+// reads keyboard meanwhile, task is cancelled when it returns true
+template<class Task>
+static std::invoke_result_t<Task> runCancellable(ProgressToken& progress, bool (*waitForCancelKey)(int), Task task) {
+    progress.reset();
+    std::future<std::invoke_result_t<Task>> future = ThreadPool::get().submit(std::move(task));
+
+    bool printed = false;
+    while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        if (progress.isCancelled()) {
+            fmt::print("\r[{}] Cancelling...{:40}", fmt::styled("WAIT", fmt::fg(fmt::color::yellow)), "");
+        }
+        else {
+            fmt::print("\r[{}] {:<24} {:>3}%  (ESC to cancel)", fmt::styled("PROGRESS", fmt::fg(fmt::color::white)),
+                progress.getPhase(), static_cast<int>(progress.getProgress() * 100.f));
+        }
+        std::fflush(stdout);
+        printed = true;
+
+        if (progress.isCancelled()) future.wait_for(std::chrono::milliseconds(100));
+        else if (waitForCancelKey(100)) progress.cancel();
+    }
+
+    if (printed) fmt::print("\r{:70}\r", "");
+    return future.get();
+}
+
+// Prints counts and memory of shape before generating it, returns false when it doesn't fit unsigned int indices or budgetMB (0 is unlimited)
+template<class ShapeType, class... Args>
+static bool printResourceEstimate(const unsigned int budgetMB, const Args&... args) {
+    const MeshCounts counts = ShapeType::getMeshCounts(args...);
+    if (!counts.fitsIndexType()) {
+        fmt::print("\n[{}] {} would have more than {} vertices or indices, which 32-bit indices can't address. Lower its parameters.\n",
+            fmt::styled("ERROR", fmt::fg(fmt::color::red)), ShapeType::getClassName(), MeshCounts::MAX_VERTICES);
+        if constexpr (std::is_same_v<ShapeType, Plane>) {
+            fmt::print("[{}] Batch mode saves such Plane tiled, split into sub-meshes of 32-bit indices.\n", fmt::styled("INFO", fmt::fg(fmt::color::white)));
+        }
+        return false;
+    }
+
+    const ResourceEstimate estimate = ResourceEstimator::estimateGeneration(counts);
+
+    fmt::print("\n[{}] {} vertices, {} indices, {} in memory (peak ~{})\n", fmt::styled("INFO", fmt::fg(fmt::color::white)),
+        estimate.counts.vertices, estimate.counts.indices, ResourceEstimator::formatBytes(estimate.meshBytes), ResourceEstimator::formatBytes(estimate.peakBytes));
+
+    if (ResourceEstimator::fitsBudget(estimate.peakBytes, budgetMB)) return true;
+
+    fmt::print("[{}] {} needs more than memory budget of {} MB, lower its parameters or raise memoryBudget in shapes.config.\n",
+        fmt::styled("ERROR", fmt::fg(fmt::color::red)), ShapeType::getClassName(), budgetMB);
+    return false;
+}
+
+// config.progress has to be set, generation can be cancelled with it. out is nullptr when shape is over index type or budgetMB
 template<class ShapeType, class... Args>
-static std::chrono::duration<double, std::milli> generateShape(Shape*& out, const ShapeConfig& config, const Args&... args) {
-    
+static std::chrono::duration<double, std::milli> generateShape(Shape*& out, const ShapeConfig& config, const unsigned int budgetMB, bool (*waitForCancelKey)(int), const Args&... args) {
+
+    if (!printResourceEstimate<ShapeType>(budgetMB, args...)) {
+        out = nullptr;
+        return std::chrono::duration<double, std::milli>(0.0);
+    }
+
     fmt::print("\n[{}] Start Generating {}...\n", fmt::styled("OK", fmt::fg(fmt::color::green)), ShapeType::getClassName());
 
     auto start = std::chrono::high_resolution_clock::now();
 
     // Shape Creation
-    out = new ShapeType(config, args...);
+    auto [shape, fromCache] = runCancellable(*config.progress, waitForCancelKey, [&]() {
+        return MeshCache::get().getOrGenerate<ShapeType>(config, args...);
+    });
+    out = shape;
 
     auto end = std::chrono::high_resolution_clock::now();
 
-    fmt::print("[{}] {} Generated Successfully!\n", fmt::styled("OK", fmt::fg(fmt::color::green)), ShapeType::getClassName());
+    if (shape->isCancelled()) fmt::print("[{}] {} generation cancelled, its memory was freed.\n", fmt::styled("CANCELLED", fmt::fg(fmt::color::yellow)), ShapeType::getClassName());
+    else if (fromCache) fmt::print("[{}] {} Loaded From Cache!\n", fmt::styled("OK", fmt::fg(fmt::color::green)), ShapeType::getClassName());
+    else fmt::print("[{}] {} Generated Successfully!\n", fmt::styled("OK", fmt::fg(fmt::color::green)), ShapeType::getClassName());
 
     return std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(end - start);
 }
\ No newline at end of file
@@ -0,0 +1,107 @@
+#pragma once
+
+#pragma region STD_LIBS
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <utility>
+#include <vector>
+#pragma endregion
+
+#pragma region FMT_LIB
+#include <fmt/format.h>
+#pragma endregion
+
+#pragma region MY_FILES_CORE_LIB
+#include <GenerationStats.hpp>
+#include <MeshOptimizer.hpp>
+#include <Shape.hpp>
+#include <Stripifier.hpp>
+#pragma endregion
+
+#pragma region MY_FILES_UTILS_LIB
+#include <Config.hpp>
+#pragma endregion
+
+static MeshOptimizeOptions getMeshOptimizeOptions(const utils::Config& config)
+{
+    MeshOptimizeOptions options;
+    options.optimizeVertexCache = config.optimizeVertexCache;
+    // Same size as the pass optimizes for, so the report simulates that cache
+    options.vertexCacheSize = std::clamp(config.vertexCacheSize, MeshOptimizer::MIN_CACHE_SIZE, MeshOptimizer::MAX_CACHE_SIZE);
+    options.vertexCacheType = (config.vertexCacheType == "LRU" || config.vertexCacheType == "lru") ? VertexCacheType::LRU : VertexCacheType::FIFO;
+    options.optimizeVertexFetch = config.optimizeVertexFetch;
+    options.optimizeOverdraw = config.optimizeOverdraw;
+    options.overdrawThreshold = config.overdrawThreshold;
+    options.buildMeshlets = config.buildMeshlets;
+    options.meshletMaxVertices = config.meshletMaxVertices;
+    options.meshletMaxTriangles = config.meshletMaxTriangles;
+    options.generateLods = config.generateLods;
+    options.lodLevels = config.lodLevels;
+    options.lodReduction = config.lodReduction;
+    return options;
+}
+
+static bool isAnyMeshOptimizationEnabled(const MeshOptimizeOptions& options)
+{
+    return options.optimizeVertexCache || options.optimizeVertexFetch || options.optimizeOverdraw || options.buildMeshlets || options.generateLods;
+}
+
+static std::pair<std::string, std::string> getStripReportLine(const StripStats& stats, const bool usePrimitiveRestart)
+{
+    const float savings = stats.listIndexCount > 0ull ? 100.f * (1.f - stats.ratio) : 0.f;
+    return { "Strip", fmt::format("{} indices instead of {} ({:.1f}% {}), {} strips joined with {}",
+        stats.stripIndexCount, stats.listIndexCount, std::abs(savings), savings >= 0.f ? "fewer" : "more", stats.stripCount,
+        usePrimitiveRestart ? "restart index" : "degenerate triangles") };
+}
+
+// All phases in one line, in order of first start
+static std::pair<std::string, std::string> getPhasesReportLine(const std::string& label, const GenerationStats& stats)
+{
+    std::string value;
+    for (const auto& [phase, ms] : stats.getSummary()) {
+        if (!value.empty()) value += ", ";
+        value += fmt::format("{} {:.2f}ms", phase, ms);
+    }
+    return { label, value };
+}
+
+// Label - value pairs describing what optimization passes did
+static std::vector<std::pair<std::string, std::string>> getMeshOptimizeReportLines(const MeshOptimizeReport& report, const MeshOptimizeOptions& options)
+{
+    std::vector<std::pair<std::string, std::string>> lines;
+
+    if (report.vertexCacheOptimized) {
+        const std::string cacheName = fmt::format("{} {}", options.vertexCacheType == VertexCacheType::LRU ? "LRU" : "FIFO", options.vertexCacheSize);
+        lines.emplace_back("ACMR", fmt::format("{:.3f} -> {:.3f} ({})", report.vertexCacheBefore.acmr, report.vertexCacheAfter.acmr, cacheName));
+        lines.emplace_back("ATVR", fmt::format("{:.3f} -> {:.3f} ({})", report.vertexCacheBefore.atvr, report.vertexCacheAfter.atvr, cacheName));
+    }
+
+    if (report.overdrawOptimized) {
+        lines.emplace_back("Overdraw", fmt::format("{:.4f} -> {:.4f} (14 views)", report.overdrawBefore.overdraw, report.overdrawAfter.overdraw));
+    }
+
+    if (report.vertexFetchOptimized) {
+        lines.emplace_back("Overfetch", fmt::format("{:.3f} -> {:.3f} ({} KB read)", report.vertexFetchBefore.overfetch, report.vertexFetchAfter.overfetch, report.vertexFetchAfter.bytesFetched / 1024ull));
+    }
+
+    if (report.meshletsBuilt) {
+        lines.emplace_back("Meshlets", fmt::format("{} (avg {:.1f} vertices, {:.1f} triangles, {} cone cullable)",
+            report.meshlets.meshletCount, report.meshlets.avgVertices, report.meshlets.avgTriangles, report.meshlets.coneCullable));
+    }
+
+    if (report.lodsGenerated) {
+        // LOD 0 is the shape itself
+        for (size_t i = 1ull; i < report.lods.size(); ++i) {
+            const LodLevel& level = report.lods[i];
+            lines.emplace_back(fmt::format("LOD {}", i), fmt::format("{} triangles ({:.1f}%), error {:.5f} ({:.3f}% of size)",
+                level.indexCount / 3u, 100.f * (float)level.indexCount / (float)report.lods[0].indexCount, level.absoluteError, level.error * 100.f));
+        }
+
+        if (report.lods.size() < 2ull) {
+            lines.emplace_back("LOD", "Shape can't be simplified (flat shading or too few triangles)");
+        }
+    }
+
+    return lines;
+}
\ No newline at end of file
@@ -7,11 +7,29 @@
 #pragma endregion
 
 #pragma region MY_FILES
+#include "OptimizeHelpers.hpp"
 #include "TuiApp.hpp"
 #pragma endregion
 
 using namespace ftxui;
 
+// Floats are written in shortest exact form, so equal keys mean equal parameters
+template<class... Args>
+static std::string ShapeKey(const Args&... args)
+{
+    std::string key;
+    ((key += fmt::format("{}|", args)), ...);
+    return key;
+}
+
+static std::string OptimizeOptionsKey(const MeshOptimizeOptions& o)
+{
+    return fmt::format("{}|{}|{}|{}|{}|{}|{}|{}|{}|{}|{}|{}",
+        o.optimizeVertexCache, o.vertexCacheSize, static_cast<int>(o.vertexCacheType), o.optimizeVertexFetch,
+        o.optimizeOverdraw, o.overdrawThreshold, o.buildMeshlets, o.meshletMaxVertices, o.meshletMaxTriangles,
+        o.generateLods, o.lodLevels, o.lodReduction);
+}
+
 tui::App::App() : _screen(ScreenInteractive::Fullscreen())
 {
     _config = utils::get_config();
@@ -23,17 +41,9 @@ tui::App::App() : _screen(ScreenInteractive::Fullscreen())
 
 void tui::App::Run()
 {
-    Loop loop(&_screen, _root);
-    while (!loop.HasQuitted()) {
-        // Request a new frame to be drawn.
-        _screen.RequestAnimationFrame();
-
-        // Execute events, and draw the next frame.
-        loop.RunOnce();
-
-        // Sleep for a short duration to control the frame rate (60 FPS).
-        std::this_thread::sleep_for(std::chrono::milliseconds(1000 / 60));
-    }
+    // Frames are drawn after input and events posted by running tasks (TaskTicker),
+    // idle screen doesn't use the CPU
+    _screen.Loop(_root);
 }
 
 int tui::App::RegisterView(std::unique_ptr<View> view)
@@ -54,6 +64,7 @@ void tui::App::CreateViews()
                 _config.calcBitangents,
                 _config.tangentHandednessPositive
             };
+            _sConfig.progress = &_progress;
             // ShapeSelect = 0 and PlaneParams = 1 so +1 maps to params View
             _currentView = static_cast<int>(AppViewType::PlaneParams) + _selectedShapeIndex;
         },
@@ -66,7 +77,7 @@ void tui::App::CreateViews()
     RegisterView(std::make_unique<PlaneParametersView>(
         _intA, _intB, _rangeIndex, _planeDirIndex,
         [this]() {
-            GoToGenerate("Plane", [this]() -> GenerateView::GenerateResult {
+            GoToGenerate("Plane", ShapeKey(_intA, _intB, _planeDirIndex, _rangeIndex), [this]() -> GenerateView::GenerateResult {
                 return GenerateShape<Plane>(_sConfig, true, _intA, _intB, static_cast<PlaneNormalDir>(_planeDirIndex), static_cast<ValuesRange>(_rangeIndex));
             });
         },
@@ -76,7 +87,7 @@ void tui::App::CreateViews()
     RegisterView(std::make_unique<CubeParametersView>(
         _rangeIndex,
         [this]() {
-            GoToGenerate("Cube", [this]() -> GenerateView::GenerateResult {
+            GoToGenerate("Cube", ShapeKey(_rangeIndex), [this]() -> GenerateView::GenerateResult {
                 return GenerateShape<Cube>(_sConfig, true, static_cast<ValuesRange>(_rangeIndex));
             });
         },
@@ -86,7 +97,7 @@ void tui::App::CreateViews()
     RegisterView(std::make_unique<TetrahedronParametersView>(
         _rangeIndex,
         [this]() {
-            GoToGenerate("Tetrahedron", [this]() -> GenerateView::GenerateResult {
+            GoToGenerate("Tetrahedron", ShapeKey(_rangeIndex), [this]() -> GenerateView::GenerateResult {
                 return GenerateShape<Tetrahedron>(_sConfig, true, static_cast<ValuesRange>(_rangeIndex));
             });
         },
@@ -96,7 +107,7 @@ void tui::App::CreateViews()
     RegisterView(std::make_unique<PyramidParametersView>(
         _rangeIndex,
         [this]() {
-            GoToGenerate("Pyramid", [this]() -> GenerateView::GenerateResult {
+            GoToGenerate("Pyramid", ShapeKey(_rangeIndex), [this]() -> GenerateView::GenerateResult {
                 return GenerateShape<Pyramid>(_sConfig, true, static_cast<ValuesRange>(_rangeIndex));
             });
         },
@@ -106,7 +117,7 @@ void tui::App::CreateViews()
     RegisterView(std::make_unique<CylinderParametersView>(
         _intA, _intB, _rangeIndex, _shadingIndex,
         [this]() {
-            GoToGenerate("Cylinder", [this]() -> GenerateView::GenerateResult {
+            GoToGenerate("Cylinder", ShapeKey(_intA, _intB, _rangeIndex, _shadingIndex), [this]() -> GenerateView::GenerateResult {
                 return GenerateShape<Cylinder>(_sConfig, true, _intA, _intB, static_cast<ValuesRange>(_rangeIndex), static_cast<Shading>(_shadingIndex));
             });
         },
@@ -116,7 +127,7 @@ void tui::App::CreateViews()
     RegisterView(std::make_unique<ConeParametersView>(
         _intA, _floatA, _floatB, _rangeIndex, _shadingIndex,
         [this]() {
-            GoToGenerate("Cone", [this]() -> GenerateView::GenerateResult {
+            GoToGenerate("Cone", ShapeKey(_intA, _floatA, _floatB, _rangeIndex, _shadingIndex), [this]() -> GenerateView::GenerateResult {
                 return GenerateShape<Cone>(_sConfig, true, _intA, _floatA, _floatB, static_cast<ValuesRange>(_rangeIndex), static_cast<Shading>(_shadingIndex));
             });
         },
@@ -126,7 +137,7 @@ void tui::App::CreateViews()
     RegisterView(std::make_unique<SphereParametersView>(
         _intA, _intB, _rangeIndex, _shadingIndex,
         [this]() {
-            GoToGenerate("Sphere", [this]() -> GenerateView::GenerateResult {
+            GoToGenerate("Sphere", ShapeKey(_intA, _intB, _rangeIndex, _shadingIndex), [this]() -> GenerateView::GenerateResult {
                 return GenerateShape<Sphere>(_sConfig, true, _intA, _intB, static_cast<ValuesRange>(_rangeIndex), static_cast<Shading>(_shadingIndex));
             });
         },
@@ -136,7 +147,7 @@ void tui::App::CreateViews()
     RegisterView(std::make_unique<IcoSphereParametersView>(
         _intA, _rangeIndex, _shadingIndex,
         [this]() {
-            GoToGenerate("IcoSphere", [this]() -> GenerateView::GenerateResult {
+            GoToGenerate("IcoSphere", ShapeKey(_intA, _rangeIndex, _shadingIndex), [this]() -> GenerateView::GenerateResult {
                 return GenerateShape<IcoSphere>(_sConfig, (_intA < 7), _intA, static_cast<ValuesRange>(_rangeIndex), static_cast<Shading>(_shadingIndex));
             });
         },
@@ -146,7 +157,7 @@ void tui::App::CreateViews()
     RegisterView(std::make_unique<TorusParametersView>(
         _intA, _intB, _floatA, _floatB, _rangeIndex, _shadingIndex,
         [this]() {
-            GoToGenerate("Torus", [this]() -> GenerateView::GenerateResult {
+            GoToGenerate("Torus", ShapeKey(_intA, _intB, _floatA, _floatB, _rangeIndex, _shadingIndex), [this]() -> GenerateView::GenerateResult {
                 return GenerateShape<Torus>(_sConfig, true, _intA, _intB, _floatA, _floatB, static_cast<ValuesRange>(_rangeIndex), static_cast<Shading>(_shadingIndex));
             });
         },
@@ -156,7 +167,7 @@ void tui::App::CreateViews()
     RegisterView(std::make_unique<HexagonParametersView>(
         _intA, _rangeIndex,
         [this]() {
-            GoToGenerate("Hexagon", [this]() -> GenerateView::GenerateResult {
+            GoToGenerate("Hexagon", ShapeKey(_intA, _rangeIndex), [this]() -> GenerateView::GenerateResult {
                 return GenerateShape<Hexagon>(_sConfig, true, _intA, static_cast<ValuesRange>(_rangeIndex));
             });
         },
@@ -164,16 +175,25 @@ void tui::App::CreateViews()
     ));
 
     RegisterView(std::make_unique<GenerateView>(
-        _selectedShape, _elapsed,
-        [this]() { _shapeName = _selectedShape ? _selectedShape->getObjectClassName() : "Unknown"; _currentView = static_cast<int>(AppViewType::SaveFormat); }
+        _selectedShape, _elapsed, _progress,
+        [this](Event event) { _screen.PostEvent(event); },
+        [this]() { OnShapeGenerated(); }
     ));
 
     RegisterView(std::make_unique<SaveFormatView>(
-        _shapeName, _elapsed,
+        _shapeName, _elapsed, _shapeDetails, _config,
+        [this](int selectedFormat) -> ExportEstimate {
+            if (_selectedShape == nullptr) return {};
+            const MeshCounts counts = { _selectedShape->getVerticesCount(), _selectedShape->getIndicesCount() };
+            return ResourceEstimator::estimateExport(counts, static_cast<FormatType>(selectedFormat), _sConfig);
+        },
         [this](int selectedFormat) {
             _saveStatus = static_cast<int>(FileSaveStatus::SUCCESS);
             _saveFormat = static_cast<FormatType>(selectedFormat);
-            GoToSave(selectedFormat < 8 ? "Text" : (selectedFormat < 10 ? "JSON" : "OBJ"), [this]() -> SaveView::SaveResult {
+            _saveDetails.clear();
+            const std::string extension = Shape::getFormatFileExtension(_saveFormat);
+            const std::string fileType = extension == ".json" ? "JSON" : (extension == ".obj" ? "OBJ" : (extension == ".bin" ? "Binary" : "Text"));
+            GoToSave(fileType, [this]() -> SaveView::SaveResult {
                 SaveView::SaveDuration elapsed;
                 if (!utils::check_directory(_config.saveDir.c_str())) {
                     if (!utils::create_directory(_config.saveDir.c_str())) {
@@ -186,17 +206,30 @@ void tui::App::CreateViews()
                 std::string filePath = (isFullPath ? "" : _exeDir + DIRSEP) + _config.saveDir + DIRSEP + get_resolved_file_name(_config, _selectedShape->getObjectClassName()) + Shape::getFormatFileExtension(_saveFormat);
                 auto start = std::chrono::high_resolution_clock::now();
 
-                std::ofstream file(filePath, std::ios::out | std::ios::trunc | std::ios::binary);
-
-                if (file.is_open()) {
-                    std::string text = _selectedShape->toString(_saveFormat);
-                    file.write(text.data(), text.size());
-                    file.close();
+                _selectedShape->setPrimitiveRestart(_config.stripPrimitiveRestart);
+                GenerationStats saveStats;
+                const bool saved = _selectedShape->save(filePath, _saveFormat, &saveStats, &_progress);
+                // Partly written file is removed by save
+                if (_progress.isCancelled()) return { "", elapsed };
 
+                if (saved) {
                     auto end = std::chrono::high_resolution_clock::now();
 
                     elapsed = std::chrono::duration_cast<SaveView::SaveDuration>(end - start);
 
+                    if (Shape::isStripFormat(_saveFormat)) {
+                        _saveDetails.push_back(getStripReportLine(_selectedShape->getStripStats(), _config.stripPrimitiveRestart));
+                    }
+                    _saveDetails.push_back(getPhasesReportLine("Save phases", saveStats));
+
+                    if (_config.saveTrace) {
+                        GenerationStats trace = _selectedShape->getGenerationStats();
+                        trace.append(saveStats);
+                        if (!trace.saveChromeTrace(filePath + ".trace.json")) {
+                            _saveDetails.emplace_back("Trace", "could not save the trace file");
+                        }
+                    }
+
                     std::this_thread::sleep_for(std::chrono::milliseconds(30000 / 60));
 
                     std::string separator = std::string(1, DIRSEP);
@@ -215,8 +248,19 @@ void tui::App::CreateViews()
     ));
 
     RegisterView(std::make_unique<SaveView>(
-        _selectedShape, _elapsed, _saveLocation,
+        _selectedShape, _elapsed, _saveLocation, _progress,
+        [this](Event event) { _screen.PostEvent(event); },
         [this]() {
+            // Cancelled shape can be saved again
+            if (_saveLocation.empty() && _progress.isCancelled()) {
+                GoToSaveFormat();
+                return;
+            }
+
+            // Worker is done, details of previous save (strip line and phases) are replaced
+            _shapeDetails = _generateDetails;
+            _shapeDetails.insert(_shapeDetails.end(), _saveDetails.begin(), _saveDetails.end());
+
             if (_config.openDirOnSave)
             {
                 bool res = utils::open_in_file_explorer(_saveLocation.c_str());
@@ -232,8 +276,9 @@ void tui::App::CreateViews()
     ));
 
     RegisterView(std::make_unique<SaveResultView>(
-        _saveStatus, _exeDir, _saveLocation, _elapsed,
+        _saveStatus, _exeDir, _saveLocation, _elapsed, _shapeDetails,
         [this]() { GoToShapeSelect(); },
+        [this]() { GoToSaveFormat(); },
         [this]() { CloseApp(); }
     ));
 
@@ -241,40 +286,132 @@ void tui::App::CreateViews()
         _config, _exeDir,
         [this]() { GoToShapeSelect(); }
     ));
+
+    // Parameters views estimate memory of the shape and refuse generation over budget
+    for (int view = static_cast<int>(AppViewType::PlaneParams); view <= static_cast<int>(AppViewType::HexagonParams); ++view) {
+        dynamic_cast<ParametersView*>(_views[view].get())->SetResourceLimits(_sConfig, _config);
+    }
 }
 
 void tui::App::GoToShapeSelect()
 {
     DeleteShape();
-    if (!_saveLocation.empty()) std::string().swap(_saveLocation);
+    _saveLocation.clear();
     _currentView = static_cast<int>(AppViewType::ShapeSelect);
 }
 
-void tui::App::GoToGenerate(std::string shapeName, GenerateView::GenerateTask task)
+void tui::App::GoToGenerate(std::string shapeName, std::string key, GenerateView::GenerateTask task)
 {
+    _shapeDetails.clear();
+    _optimizeDetails.clear();
+    _saveDetails.clear();
+    MeshOptimizeOptions optimizeOptions = getMeshOptimizeOptions(_config);
+
+    const bool anyOptimization = isAnyMeshOptimizationEnabled(optimizeOptions);
+    _generateKey = ShapeKey(shapeName, key, _sConfig.genTangents, _sConfig.calcBitangents, _sConfig.tangentHandednessPositive) +
+        (anyOptimization ? OptimizeOptionsKey(optimizeOptions) : std::string());
+
+    // Same shape generated recently, no need to wait for generator again
+    auto start = std::chrono::high_resolution_clock::now();
+    if (std::optional<ShapeMemoryCache::Entry> entry = _shapeCache.find(_generateKey)) {
+        DeleteShape();
+        _selectedShapeOwner = entry->shape;
+        _selectedShape = _selectedShapeOwner.get();
+        _generateDetails = entry->details;
+        _generateDetails.emplace_back("Reused", "from memory (generated earlier in this session)");
+        _shapeDetails = _generateDetails;
+        _elapsed = std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(std::chrono::high_resolution_clock::now() - start);
+
+        _generateElapsed = _elapsed;
+        _shapeName = _selectedShape->getObjectClassName();
+        _currentView = static_cast<int>(AppViewType::SaveFormat);
+        return;
+    }
+
     _currentView = static_cast<int>(AppViewType::Generate);
     auto* gen = dynamic_cast<GenerateView*>(_views[_currentView].get());
-    gen->StartTask(shapeName, task);
+    _progress.reset();
+
+    if (!anyOptimization) {
+        gen->StartTask(shapeName, task);
+        return;
+    }
+
+    // Optimization passes run on the worker thread together with generation
+    gen->StartTask(shapeName, [this, task, optimizeOptions]() -> GenerateView::GenerateResult {
+        GenerateView::GenerateResult result = task();
+        if (result.first != nullptr && !result.first->isCancelled()) {
+            MeshOptimizeReport report = result.first->optimize(optimizeOptions);
+            _optimizeDetails = getMeshOptimizeReportLines(report, optimizeOptions);
+        }
+        return result;
+    });
+}
+
+void tui::App::OnShapeGenerated()
+{
+    // Cancelled shape is empty, parameters can be changed before generating again
+    if (_selectedShape != nullptr && _selectedShape->isCancelled()) {
+        DeleteShape();
+        _currentView = static_cast<int>(AppViewType::PlaneParams) + _selectedShapeIndex;
+        return;
+    }
+
+    // Worker is done, its details are read on UI thread only from here
+    _generateDetails = std::move(_optimizeDetails);
+    _optimizeDetails.clear();
+    if (_selectedShape != nullptr && _selectedShape != _selectedShapeOwner.get()) {
+        _generateDetails.insert(_generateDetails.begin(), getPhasesReportLine("Phases", _selectedShape->getGenerationStats()));
+        _selectedShapeOwner = std::shared_ptr<Shape>(_selectedShape);
+        // Save details are not cached, every save of a reused shape starts from these
+        _shapeCache.insert(_generateKey, _selectedShapeOwner, _generateDetails);
+    }
+
+    _shapeDetails = _generateDetails;
+    _generateElapsed = _elapsed;
+    _shapeName = _selectedShape ? _selectedShape->getObjectClassName() : "Unknown";
+    _currentView = static_cast<int>(AppViewType::SaveFormat);
+}
+
+void tui::App::GoToSaveFormat()
+{
+    if (_selectedShape == nullptr) {
+        GoToShapeSelect();
+        return;
+    }
+
+    // Details of previous save are dropped, the next one adds its own
+    _saveDetails.clear();
+    _shapeDetails = _generateDetails;
+    _elapsed = _generateElapsed;
+    _saveLocation.clear();
+    _currentView = static_cast<int>(AppViewType::SaveFormat);
 }
 
 void tui::App::GoToSave(std::string fileType, SaveView::SaveTask task)
 {
     _currentView = static_cast<int>(AppViewType::Save);
     auto* gen = dynamic_cast<SaveView*>(_views[_currentView].get());
+    _progress.reset();
     gen->StartTask(fileType, task);
 }
 
 void tui::App::DeleteShape()
 {
-    if (_selectedShape != nullptr)
+    // Shape stays in _shapeCache until it is evicted
+    if (_selectedShape != nullptr && _selectedShape != _selectedShapeOwner.get())
     {
         delete _selectedShape;
-        _selectedShape = nullptr;
     }
+
+    _selectedShape = nullptr;
+    _selectedShapeOwner.reset();
 }
 
 void tui::App::CloseApp()
 {
+    // Running task would keep the app open until it finishes
+    _progress.cancel();
     _screen.Exit();
     DeleteShape();
 }
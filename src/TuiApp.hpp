@@ -5,6 +5,7 @@
 #include <memory>
 #include <ratio>
 #include <string>
+#include <utility>
 #include <vector>
 #pragma endregion
 
@@ -14,7 +15,9 @@
 #pragma endregion
 
 #pragma region MY_FILES_CORE_LIB
+#include <ProgressToken.hpp>
 #include <Shape.hpp>
+#include <ShapeMemoryCache.hpp>
 #pragma endregion
 
 #pragma region MY_FILES_TUI_LIB
@@ -38,7 +41,11 @@ namespace tui
         void CreateViews();
 
         void GoToShapeSelect();
-        void GoToGenerate(std::string shapeName, GenerateView::GenerateTask task);
+        // key - shape parameters, config and optimization options are added here
+        void GoToGenerate(std::string shapeName, std::string key, GenerateView::GenerateTask task);
+        void OnShapeGenerated();
+        // Saves selected shape again in another format
+        void GoToSaveFormat();
         void GoToSave(std::string fileType, SaveView::SaveTask task);
 
         void DeleteShape();
@@ -102,11 +109,25 @@ namespace tui
         int _saveStatus = static_cast<int>(FileSaveStatus::SUCCESS);
 
         Shape* _selectedShape = nullptr;
+        // Keeps selected shape alive when it is evicted from _shapeCache
+        std::shared_ptr<Shape> _selectedShapeOwner;
+        ShapeMemoryCache _shapeCache;
+        std::string _generateKey;
+        // Generation details kept with the cached shape, never changed by saving
+        ShapeMemoryCache::Details _generateDetails;
+        // Filled by generate worker when optimization passes ran
+        ShapeMemoryCache::Details _optimizeDetails;
+        std::chrono::duration<double, std::milli> _generateElapsed;
         std::string _shapeName = "Unknown";
+        std::vector<std::pair<std::string, std::string>> _shapeDetails;
+        // Filled by save worker, shown after generation details once saving finished
+        ShapeMemoryCache::Details _saveDetails;
         std::string _saveLocation = "";
         std::string _exeDir;
         std::chrono::duration<double, std::milli> _elapsed;
         ShapeConfig _sConfig{};
+        // Progress of generate and save tasks, their views cancel it. Declared before views, which wait for tasks
+        ProgressToken _progress;
         utils::Config _config{};
         FormatType _saveFormat = FormatType::CPP_ARRAY_INDICES_STRUCT;
 
@@ -0,0 +1,198 @@
+#pragma region PCH
+#include "pch.hpp"
+#pragma endregion
+
+#pragma region STD_LIBS
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <utility>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "AllocStats.hpp"
+#pragma endregion
+
+static std::atomic<size_t> allocCount{ 0ull };
+static std::atomic<size_t> allocBytes{ 0ull };
+static std::atomic<size_t> liveBytes{ 0ull };
+static std::atomic<size_t> peakBytes{ 0ull };
+// Peaks of running scopes, bit of active slot is set in activeSlots
+static std::atomic<size_t> scopePeaks[AllocScope::MAX_PEAK_SCOPES];
+static std::atomic<uint64_t> activeSlots{ 0ull };
+static_assert(AllocScope::MAX_PEAK_SCOPES <= 64ull, "Active slots are bits of one uint64_t");
+// Report bookkeeping of this thread is not counted
+static thread_local bool suspended = false;
+static thread_local bool collecting = false;
+static thread_local AllocScope::Report threadReport;
+
+static void raisePeak(std::atomic<size_t>& peakValue, const size_t value)
+{
+    size_t peak = peakValue.load(std::memory_order_relaxed);
+    while (peak < value && !peakValue.compare_exchange_weak(peak, value, std::memory_order_relaxed)) {}
+}
+
+// Process peak and peak of every running scope
+static void raisePeaks(const size_t live)
+{
+    raisePeak(peakBytes, live);
+
+    for (uint64_t slots = activeSlots.load(std::memory_order_acquire); slots != 0ull; slots &= slots - 1ull) {
+        raisePeak(scopePeaks[std::countr_zero(slots)], live);
+    }
+}
+
+#if SHAPES_GENERATOR_ALLOC_STATS
+// Size of each allocation is stored in front of it, so unsized delete knows how much is freed
+static constexpr size_t PREFIX_SIZE = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+static void* countedAlloc(size_t size, const size_t alignment)
+{
+    if (size == 0ull) size = 1ull;
+    const size_t prefix = std::max(PREFIX_SIZE, alignment);
+
+#if defined(_MSC_VER)
+    std::byte* base = static_cast<std::byte*>(_aligned_malloc(prefix + size, prefix));
+#else
+    // aligned_alloc requires size to be a multiple of alignment
+    std::byte* base = static_cast<std::byte*>(alignment > PREFIX_SIZE
+        ? std::aligned_alloc(prefix, (prefix + size + prefix - 1ull) / prefix * prefix)
+        : std::malloc(prefix + size));
+#endif
+    if (base == nullptr) return nullptr;
+
+    *reinterpret_cast<size_t*>(base) = size;
+    if (!suspended) {
+        allocCount.fetch_add(1ull, std::memory_order_relaxed);
+        allocBytes.fetch_add(size, std::memory_order_relaxed);
+    }
+    raisePeaks(liveBytes.fetch_add(size, std::memory_order_relaxed) + size);
+    return base + prefix;
+}
+
+static void countedFree(void* ptr, const size_t alignment)
+{
+    if (ptr == nullptr) return;
+
+    std::byte* base = static_cast<std::byte*>(ptr) - std::max(PREFIX_SIZE, alignment);
+    liveBytes.fetch_sub(*reinterpret_cast<size_t*>(base), std::memory_order_relaxed);
+
+#if defined(_MSC_VER)
+    _aligned_free(base);
+#else
+    std::free(base);
+#endif
+}
+
+static void* countedNew(const size_t size, const size_t alignment)
+{
+    while (true) {
+        if (void* ptr = countedAlloc(size, alignment)) return ptr;
+
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) throw std::bad_alloc();
+        handler();
+    }
+}
+
+void* operator new(size_t size) { return countedNew(size, PREFIX_SIZE); }
+void* operator new[](size_t size) { return countedNew(size, PREFIX_SIZE); }
+void* operator new(size_t size, std::align_val_t al) { return countedNew(size, static_cast<size_t>(al)); }
+void* operator new[](size_t size, std::align_val_t al) { return countedNew(size, static_cast<size_t>(al)); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size, PREFIX_SIZE); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size, PREFIX_SIZE); }
+void* operator new(size_t size, std::align_val_t al, const std::nothrow_t&) noexcept { return countedAlloc(size, static_cast<size_t>(al)); }
+void* operator new[](size_t size, std::align_val_t al, const std::nothrow_t&) noexcept { return countedAlloc(size, static_cast<size_t>(al)); }
+
+void operator delete(void* ptr) noexcept { countedFree(ptr, PREFIX_SIZE); }
+void operator delete[](void* ptr) noexcept { countedFree(ptr, PREFIX_SIZE); }
+void operator delete(void* ptr, size_t) noexcept { countedFree(ptr, PREFIX_SIZE); }
+void operator delete[](void* ptr, size_t) noexcept { countedFree(ptr, PREFIX_SIZE); }
+void operator delete(void* ptr, std::align_val_t al) noexcept { countedFree(ptr, static_cast<size_t>(al)); }
+void operator delete[](void* ptr, std::align_val_t al) noexcept { countedFree(ptr, static_cast<size_t>(al)); }
+void operator delete(void* ptr, size_t, std::align_val_t al) noexcept { countedFree(ptr, static_cast<size_t>(al)); }
+void operator delete[](void* ptr, size_t, std::align_val_t al) noexcept { countedFree(ptr, static_cast<size_t>(al)); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { countedFree(ptr, PREFIX_SIZE); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { countedFree(ptr, PREFIX_SIZE); }
+void operator delete(void* ptr, std::align_val_t al, const std::nothrow_t&) noexcept { countedFree(ptr, static_cast<size_t>(al)); }
+void operator delete[](void* ptr, std::align_val_t al, const std::nothrow_t&) noexcept { countedFree(ptr, static_cast<size_t>(al)); }
+#endif
+
+AllocScope::AllocScope(const char* phase) : _phase(phase)
+{
+    if (!isEnabled()) return;
+
+    _start = getTotal();
+    _startLive = liveBytes.load(std::memory_order_relaxed);
+
+    // Claims a free slot, its peak starts from the current live bytes
+    uint64_t slots = activeSlots.load(std::memory_order_relaxed);
+    while (true) {
+        const size_t slot = static_cast<size_t>(std::countr_one(slots));
+        if (slot >= MAX_PEAK_SCOPES) break;
+
+        if (activeSlots.compare_exchange_weak(slots, slots | (1ull << slot), std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            scopePeaks[slot].store(_startLive, std::memory_order_relaxed);
+            _slot = slot;
+            break;
+        }
+    }
+}
+
+AllocScope::~AllocScope()
+{
+    stop();
+}
+
+AllocStats AllocScope::stop()
+{
+    if (!isEnabled() || _stopped) return _stats;
+    _stopped = true;
+
+    _stats.count = allocCount.load(std::memory_order_relaxed) - _start.count;
+    _stats.bytes = allocBytes.load(std::memory_order_relaxed) - _start.bytes;
+    if (_slot != NO_SLOT) {
+        const size_t peak = scopePeaks[_slot].load(std::memory_order_relaxed);
+        _stats.peakBytes = peak > _startLive ? peak - _startLive : 0ull;
+        activeSlots.fetch_and(~(1ull << _slot), std::memory_order_release);
+    }
+
+    if (_phase != nullptr && collecting) {
+        suspended = true;
+        threadReport.emplace_back(_phase, _stats);
+        suspended = false;
+    }
+    return _stats;
+}
+
+void AllocScope::collectReport(const bool enabled)
+{
+    collecting = enabled;
+}
+
+bool AllocScope::isCollectingReport()
+{
+    return isEnabled() && collecting;
+}
+
+AllocScope::Report AllocScope::takeReport()
+{
+    suspended = true;
+    Report report = std::exchange(threadReport, {});
+    suspended = false;
+    return report;
+}
+
+AllocStats AllocScope::getTotal()
+{
+    AllocStats stats;
+    stats.count = allocCount.load(std::memory_order_relaxed);
+    stats.bytes = allocBytes.load(std::memory_order_relaxed);
+    stats.peakBytes = peakBytes.load(std::memory_order_relaxed);
+    return stats;
+}
\ No newline at end of file
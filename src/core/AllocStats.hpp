@@ -0,0 +1,68 @@
+#pragma once
+
+#pragma region STD_LIBS
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+#pragma endregion
+
+// Heap allocations made through global operator new, counted only when built with
+// SHAPES_GENERATOR_ALLOC_STATS (CMake option of the same name replaces global operator new/delete)
+struct AllocStats
+{
+	size_t count = 0ull;
+	size_t bytes = 0ull;
+	// Highest amount of live bytes above the amount at the start of the measure
+	size_t peakBytes = 0ull;
+};
+
+// Measures allocations from construction until stop() (or destruction). Counters are process wide,
+// so work done by pool workers is included, as are allocations of phases running at the same time.
+// Every scope tracks its own peak, scopes running at the same time (nested, interleaved or on other threads)
+// don't reset each other's. At most MAX_PEAK_SCOPES scopes measure peak at once, scopes over it report 0 peak.
+// Named scopes are added to the phase report of the thread which created them, if it collects one
+class AllocScope
+{
+public:
+	using Report = std::vector<std::pair<std::string, AllocStats>>;
+
+	static constexpr size_t MAX_PEAK_SCOPES = 64ull;
+
+	// phase - name in the report, nullptr doesn't report
+	explicit AllocScope(const char* phase = nullptr);
+	~AllocScope();
+
+	AllocScope(const AllocScope&) = delete;
+	AllocScope& operator=(const AllocScope&) = delete;
+
+	AllocStats stop();
+
+	static constexpr bool isEnabled()
+	{
+#if SHAPES_GENERATOR_ALLOC_STATS
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	// Named scopes of this thread are reported only after this is enabled
+	static void collectReport(const bool enabled);
+	static bool isCollectingReport();
+	// Phases measured on this thread since the last call
+	static Report takeReport();
+	// Allocations since program start, peak is the highest amount of live bytes of the process
+	static AllocStats getTotal();
+
+private:
+	static constexpr size_t NO_SLOT = MAX_PEAK_SCOPES;
+
+	const char* _phase = nullptr;
+	bool _stopped = false;
+	AllocStats _start;
+	size_t _startLive = 0ull;
+	// Peak counter of this scope, raised by every allocation while the scope runs
+	size_t _slot = NO_SLOT;
+	AllocStats _stats;
+};
\ No newline at end of file
@@ -60,4 +60,17 @@ BIT_TEMPLATE
 static INLINE constexpr T mod_4(T x) noexcept {
 	STATIC_ASSERT_UNSIGNED(T);
 	return x & static_cast<T>(3);
-}
\ No newline at end of file
+}
+// Largest value of T instead of wrapping around
+BIT_TEMPLATE
+static INLINE constexpr T add_sat(T x, T y) noexcept {
+	STATIC_ASSERT_UNSIGNED(T);
+	return x > static_cast<T>(~static_cast<T>(0)) - y ? static_cast<T>(~static_cast<T>(0)) : x + y;
+}
+
+// Largest value of T instead of wrapping around
+BIT_TEMPLATE
+static INLINE constexpr T mul_sat(T x, T y) noexcept {
+	STATIC_ASSERT_UNSIGNED(T);
+	return y != static_cast<T>(0) && x > static_cast<T>(~static_cast<T>(0)) / y ? static_cast<T>(~static_cast<T>(0)) : x * y;
+}
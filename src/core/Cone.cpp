@@ -4,8 +4,9 @@
 
 #pragma region STD_LIBS
 #include <algorithm>
-#include <cstdint>
 #include <cmath>
+#include <cstdint>
+#include <memory_resource>
 #include <string>
 #include <utility>
 #include <vector>
@@ -18,6 +19,8 @@
 
 #pragma region MY_FILES
 #include "Cone.hpp"
+#include "GenerationArena.hpp"
+#include "GenerationStats.hpp"
 #include "Shape.hpp"
 #pragma endregion
 
@@ -28,7 +31,9 @@ void Cone::_generate(const unsigned int segments, const float height, const floa
 	const float h = height < EPSILON ? 1.f : height;
 	float r = radius < EPSILON ? 1.f : radius;
 
-	std::vector<unsigned int> trisNum;
+	// Temporaries of this generation
+	GenerationArena arena;
+	std::pmr::vector<unsigned int> trisNum(arena.resource());
 
 	const float angleXZDiff = 2.f * (float)M_PI / (float)segments;
 
@@ -39,7 +44,10 @@ void Cone::_generate(const unsigned int segments, const float height, const floa
 	r = sqrtf(rToH);
 
 	float angleXZ = 0.f;
+	PhaseTimer vertexTimer(&_generationStats, "vertex generation");
 	for (unsigned int j = 0u; j < segments; ++j) {
+		if (j % PROGRESS_STEP == 0u && _reportProgress("vertex generation", j, segments)) return;
+
 		const float z = cosf(angleXZ);
 		const float x = sinf(angleXZ);
 		_vertices.push_back({ glm::normalize(glm::vec3(x * r, y, z * r)) * mult, { .5f + x * .5f, .5f + z * .5f }, glm::vec3(0.f, -1.f, 0.f), glm::vec3(0.f), glm::vec3(0.f) });
@@ -48,10 +56,11 @@ void Cone::_generate(const unsigned int segments, const float height, const floa
 	}
 	_vertices.push_back({ glm::vec3(0.f, _vertices[_vertices.size() - 1ull].Position.y, 0.f) * mult, {.5f, .5f}, glm::vec3(0.f, -1.f, 0.f), glm::vec3(0.f), glm::vec3(0.f)});
 	if (_shapeConfig.genTangents) trisNum.push_back(segments);
+	vertexTimer.stop();
 
 	// INDICES
 	const size_t vertSize = _vertices.size();
-	glm::vec3 tangent;
+	PhaseTimer indexTimer(&_generationStats, "index generation");
 	for (size_t i = 0ull; i < vertSize - 1ull; ++i) {
 
 		const size_t right = i + 2ull == vertSize ? 0ull : i + 1ull;
@@ -59,18 +68,12 @@ void Cone::_generate(const unsigned int segments, const float height, const floa
 		_indices.push_back((unsigned int)right);
 		_indices.push_back((unsigned int)i);
 		_indices.push_back((unsigned int)vertSize - 1u);
-
-		if (_shapeConfig.genTangents) {
-			tangent = _calcTangent((unsigned int)right, (unsigned int)i, (unsigned int)vertSize - 1u);
-
-			_vertices[right].Tangent += tangent;
-			_vertices[i].Tangent += tangent;
-			_vertices[vertSize - 1ull].Tangent += tangent;
-		}
 	}
+	indexTimer.stop();
 
 	// CONE
 	// VERTICES AND TEX COORDS
+	PhaseTimer coneVertexTimer(&_generationStats, "vertex generation");
 	const size_t start = _vertices.size();
 	angleXZ = 0.f;
 	const glm::vec3 vr = glm::vec3(r, 0.f, 0.f);
@@ -81,6 +84,8 @@ void Cone::_generate(const unsigned int segments, const float height, const floa
 
 	const unsigned int count = segments + (useFlatShading ? 0u : 1u);
 	for (unsigned int j = 0u; j < count; ++j) {
+		if (j % PROGRESS_STEP == 0u && _reportProgress("vertex generation", j, count)) return;
+
 		if (useFlatShading) {
 			const float x_n = cos_cone * (sinf(angleXZ) + sinf(angleXZ + angleXZDiff)) * .5f;
 			const float z_n = cos_cone * (cosf(angleXZ) + cosf(angleXZ + angleXZDiff)) * .5f;
@@ -142,9 +147,12 @@ void Cone::_generate(const unsigned int segments, const float height, const floa
 		_vertices.push_back({ glm::normalize(glm::vec3(0.f, -y, 0.f)) * mult, { .5f, 0.f }, { 0.f, 1.f, 0.f }, glm::vec3(0.f), glm::vec3(0.f) });
 		if (_shapeConfig.genTangents) trisNum.push_back(segments);
 	}
+	coneVertexTimer.stop();
 
 	// INDICES
+	PhaseTimer coneIndexTimer(&_generationStats, "index generation");
 	for (unsigned int i = 0u; i < segments; ++i) {
+		if (i % PROGRESS_STEP == 0u && _reportProgress("index generation", i, segments)) return;
 
 		const size_t m = useFlatShading ? 3ull : 1ull;
 
@@ -155,31 +163,36 @@ void Cone::_generate(const unsigned int segments, const float height, const floa
 		_indices.push_back((unsigned int)left);
 		_indices.push_back((unsigned int)right);
 		_indices.push_back((unsigned int)top);
+	}
+	coneIndexTimer.stop();
 
-		if (_shapeConfig.genTangents) {
-			tangent = _calcTangent((unsigned int)left, (unsigned int)right, (unsigned int)top);
+	if (_shapeConfig.genTangents) {
+		_accumulateTangents(0ull, _indices.size());
+		if (_cancelled) return;
 
-			_vertices[left].Tangent += tangent;
-			_vertices[right].Tangent += tangent;
-			_vertices[top].Tangent += tangent;
-		}
+		_normalizeTangentsAndGenerateBitangents(trisNum, 0ull, _vertices.size());
 	}
 
-	if (_shapeConfig.genTangents) _normalizeTangentsAndGenerateBitangents(trisNum, 0ull, _vertices.size());
-
 	trisNum.clear();
 }
 
 Cone::Cone(const ShapeConfig& config, const unsigned int segments, const float height, const float radius, const ValuesRange range, const Shading shading)
+	: Shape(config)
 {
-	_shapeConfig = config;
 	_vertices.clear();
 	_indices.clear();
+	if (!_checkIndexType(getMeshCounts(segments, height, radius, range, shading))) return;
 	_generate(std::max(3u, segments), std::max(EPSILON, height), std::max(EPSILON, radius), range, shading == Shading::FLAT);
 }
 
 Cone::~Cone() {}
 
+MeshCounts Cone::getMeshCounts(const unsigned int segments, const float, const float, const ValuesRange, const Shading shading)
+{
+	const size_t s = std::max(3u, segments);
+	return { shading == Shading::FLAT ? 4ull * s + 1ull : 2ull * s + 3ull, 6ull * s };
+}
+
 std::string Cone::getClassName()
 {
 	return "Cone";
@@ -15,6 +15,8 @@ public:
 	Cone(const ShapeConfig& config, const unsigned int segments = 3u, const float height = 1.f, const float radius = 1.f, const ValuesRange range = ValuesRange::HALF_TO_HALF, const Shading shading = Shading::FLAT);
 	virtual ~Cone();
 
+	// Same parameters (and clamping) as constructor
+	static MeshCounts getMeshCounts(const unsigned int segments = 3u, const float height = 1.f, const float radius = 1.f, const ValuesRange range = ValuesRange::HALF_TO_HALF, const Shading shading = Shading::FLAT);
 	static std::string getClassName();
 	std::string getObjectClassName() const override;
 };
\ No newline at end of file
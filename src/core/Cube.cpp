@@ -3,6 +3,7 @@
 #pragma endregion
 
 #pragma region STD_LIBS
+#include <memory_resource>
 #include <string>
 #include <utility>
 #include <vector>
@@ -15,6 +16,8 @@
 #pragma region MY_FILES
 #include "BitMathOperators.hpp"
 #include "Cube.hpp"
+#include "GenerationArena.hpp"
+#include "GenerationStats.hpp"
 #include "Shape.hpp"
 #pragma endregion
 
@@ -94,8 +97,11 @@ void Cube::_generate(const ValuesRange range)
     20, 20 + 2, 20 + 1
     */
 
-    std::vector<unsigned int> trisNum;
+    // Temporaries of this generation
+    GenerationArena arena;
+    std::pmr::vector<unsigned int> trisNum(arena.resource());
 
+    PhaseTimer vertexTimer(&_generationStats, "vertex generation");
     for (unsigned int p = 0u; p < 3u; ++p) {
         for (unsigned int i = 0u; i < 8u; ++i) {
 
@@ -165,8 +171,9 @@ void Cube::_generate(const ValuesRange range)
             if (_shapeConfig.genTangents) trisNum.push_back(tris);
         }
     }
+    vertexTimer.stop();
 
-    glm::vec3 tangent;
+    PhaseTimer indexTimer(&_generationStats, "index generation");
     for (unsigned int p = 0u; p < 3u; ++p) {
         const unsigned int t1 = p + mul_8(p) + div_2(p);
         const unsigned int t2 = p + 2u + mul_8(p);
@@ -185,14 +192,6 @@ void Cube::_generate(const ValuesRange range)
                 _indices.push_back(s);
                 _indices.push_back(t);
 
-                if (_shapeConfig.genTangents) {
-                    tangent = _calcTangent(f, s, t);
-
-                    _vertices[f].Tangent += tangent;
-                    _vertices[s].Tangent += tangent;
-                    _vertices[t].Tangent += tangent;
-                }
-
                 // Second Triangle
                 s = v + 5u;
                 t = v + 1u;
@@ -200,14 +199,6 @@ void Cube::_generate(const ValuesRange range)
                 _indices.push_back(f);
                 _indices.push_back(s);
                 _indices.push_back(t);
-
-                if (_shapeConfig.genTangents) {
-                    tangent = _calcTangent(f, s, t);
-
-                    _vertices[f].Tangent += tangent;
-                    _vertices[s].Tangent += tangent;
-                    _vertices[t].Tangent += tangent;
-                }
             }
         }
         else if (p == 1u) {
@@ -221,14 +212,6 @@ void Cube::_generate(const ValuesRange range)
             _indices.push_back(s);
             _indices.push_back(t);
 
-            if (_shapeConfig.genTangents) {
-                tangent = _calcTangent(f, s, t);
-
-                _vertices[f].Tangent += tangent;
-                _vertices[s].Tangent += tangent;
-                _vertices[t].Tangent += tangent;
-            }
-
             // Second Triangle
             s = t1 + 5u;
             t = t1 + 1u;
@@ -237,14 +220,6 @@ void Cube::_generate(const ValuesRange range)
             _indices.push_back(s);
             _indices.push_back(t);
 
-            if (_shapeConfig.genTangents) {
-                tangent = _calcTangent(f, s, t);
-
-                _vertices[f].Tangent += tangent;
-                _vertices[s].Tangent += tangent;
-                _vertices[t].Tangent += tangent;
-            }
-
             // LEFT
             // First Triangle
             f = t2;
@@ -255,14 +230,6 @@ void Cube::_generate(const ValuesRange range)
             _indices.push_back(s);
             _indices.push_back(t);
 
-            if (_shapeConfig.genTangents) {
-                tangent = _calcTangent(f, s, t);
-
-                _vertices[f].Tangent += tangent;
-                _vertices[s].Tangent += tangent;
-                _vertices[t].Tangent += tangent;
-            }
-
             // Second Triangle
             s = t2 + 1u;
             t = t2 - 3u;
@@ -270,14 +237,6 @@ void Cube::_generate(const ValuesRange range)
             _indices.push_back(f);
             _indices.push_back(s);
             _indices.push_back(t);
-
-            if (_shapeConfig.genTangents) {
-                tangent = _calcTangent(f, s, t);
-
-                _vertices[f].Tangent += tangent;
-                _vertices[s].Tangent += tangent;
-                _vertices[t].Tangent += tangent;
-            }
         }
         else if (p == 2u) {
             // TOP
@@ -290,14 +249,6 @@ void Cube::_generate(const ValuesRange range)
             _indices.push_back(s);
             _indices.push_back(t);
 
-            if (_shapeConfig.genTangents) {
-                tangent = _calcTangent(f, s, t);
-
-                _vertices[f].Tangent += tangent;
-                _vertices[s].Tangent += tangent;
-                _vertices[t].Tangent += tangent;
-            }
-
             // Second Triangle
             s = t1 - 2u;
             t = t1 - 1u;
@@ -306,14 +257,6 @@ void Cube::_generate(const ValuesRange range)
             _indices.push_back(s);
             _indices.push_back(t);
 
-            if (_shapeConfig.genTangents) {
-                tangent = _calcTangent(f, s, t);
-
-                _vertices[f].Tangent += tangent;
-                _vertices[s].Tangent += tangent;
-                _vertices[t].Tangent += tangent;
-            }
-
             // BOTTOM
             // First Triangle
             f = t2;
@@ -324,14 +267,6 @@ void Cube::_generate(const ValuesRange range)
             _indices.push_back(s);
             _indices.push_back(t);
 
-            if (_shapeConfig.genTangents) {
-                tangent = _calcTangent(f, s, t);
-
-                _vertices[f].Tangent += tangent;
-                _vertices[s].Tangent += tangent;
-                _vertices[t].Tangent += tangent;
-            }
-
             // Second Triangle
             s = t2 + 2u;
             t = t2 + 1u;
@@ -339,25 +274,21 @@ void Cube::_generate(const ValuesRange range)
             _indices.push_back(f);
             _indices.push_back(s);
             _indices.push_back(t);
-
-            if (_shapeConfig.genTangents) {
-                tangent = _calcTangent(f, s, t);
-
-                _vertices[f].Tangent += tangent;
-                _vertices[s].Tangent += tangent;
-                _vertices[t].Tangent += tangent;
-            }
         }
     }
+    indexTimer.stop();
 
-    if (_shapeConfig.genTangents) _normalizeTangentsAndGenerateBitangents(trisNum, 0ull, _vertices.size());
+    if (_shapeConfig.genTangents) {
+        _accumulateTangents(0ull, _indices.size());
+        _normalizeTangentsAndGenerateBitangents(trisNum, 0ull, _vertices.size());
+    }
 
     trisNum.clear();
 }
 
 Cube::Cube(const ShapeConfig& config, const ValuesRange range)
+    : Shape(config)
 {
-    _shapeConfig = config;
     _vertices.clear();
     _indices.clear();
     _generate(range);
@@ -365,6 +296,11 @@ Cube::Cube(const ShapeConfig& config, const ValuesRange range)
 
 Cube::~Cube() {}
 
+MeshCounts Cube::getMeshCounts(const ValuesRange)
+{
+    return { 24ull, 36ull };
+}
+
 std::string Cube::getClassName()
 {
     return "Cube";
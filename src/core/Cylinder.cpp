@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
+#include <memory_resource>
 #include <utility>
 #include <vector>
 #pragma endregion
@@ -19,12 +20,16 @@
 #include "BitMathOperators.hpp"
 #include "Constants.hpp"
 #include "Cylinder.hpp"
+#include "GenerationArena.hpp"
+#include "GenerationStats.hpp"
 #include "Shape.hpp"
 #pragma endregion
 
-void Cylinder::_generateCircle(const unsigned int segments, const float y, const CylinderCullFace cullFace, const ValuesRange range)
+void Cylinder::_generateCircle(const unsigned int segments, const float y, const CylinderCullFace cullFace, const ValuesRange range, std::pmr::memory_resource* memory)
 {
-    std::vector<unsigned int> trisNum;
+    if (_cancelled) return;
+
+    std::pmr::vector<unsigned int> trisNum(memory);
 
     const float mult = range == ValuesRange::HALF_TO_HALF ? 0.5f : 1.0f;
     const float angleXZDiff = 2.f * (float)M_PI / (float)segments;
@@ -33,6 +38,7 @@ void Cylinder::_generateCircle(const unsigned int segments, const float y, const
     // VERTICES AND TEX COORDS
     const size_t start = _vertices.size();
     float angleXZ = 0.f;
+    PhaseTimer vertexTimer(&_generationStats, "vertex generation");
     for (unsigned int j = 0u; j < segments; ++j) {
         const float z = cosf(angleXZ);
         const float x = sinf(angleXZ);
@@ -42,33 +48,28 @@ void Cylinder::_generateCircle(const unsigned int segments, const float y, const
     }
     _vertices.push_back({ { 0.f, y, 0.f }, { .5f, .5f }, (cullFace == CylinderCullFace::FRONT ? glm::vec3(0.f, 1.f, 0.f) : glm::vec3(0.f, -1.f, 0.f)), glm::vec3(0.f), glm::vec3(0.f) });
     if (_shapeConfig.genTangents) trisNum.push_back(segments);
+    vertexTimer.stop();
 
     // INDICES
     const size_t vertSize = _vertices.size();
-    glm::vec3 tangent;
+    const size_t indexStart = _indices.size();
+    PhaseTimer indexTimer(&_generationStats, "index generation");
     for (size_t i = start; i < vertSize - 1ull; ++i) {
         const size_t right = i + 2ull == vertSize ? start : i + 1ull;
 
         _indices.push_back((unsigned int)(cullFace == CylinderCullFace::FRONT ? i : right));
         _indices.push_back((unsigned int)(cullFace == CylinderCullFace::FRONT ? right : i));
         _indices.push_back((unsigned int)vertSize - 1u);
+    }
+    indexTimer.stop();
 
-        if (_shapeConfig.genTangents) {
-            if (cullFace == CylinderCullFace::FRONT) {
-                tangent = _calcTangent((unsigned int)i, (unsigned int)right, (unsigned int)vertSize - 1u);
-            }
-            else {
-                tangent = _calcTangent((unsigned int)right, (unsigned int)i, (unsigned int)vertSize - 1u);
-            }
+    if (_shapeConfig.genTangents) {
+        _accumulateTangents(indexStart, _indices.size());
+        if (_cancelled) return;
 
-            _vertices[i].Tangent += tangent;
-            _vertices[right].Tangent += tangent;
-            _vertices[vertSize - 1ull].Tangent += tangent;
-        }
+        _normalizeTangentsAndGenerateBitangents(trisNum, start, _vertices.size());
     }
 
-    if (_shapeConfig.genTangents) _normalizeTangentsAndGenerateBitangents(trisNum, start, _vertices.size());
-
     trisNum.clear();
 }
 
@@ -77,9 +78,13 @@ void Cylinder::_generate(const unsigned int horizontalSegments, const unsigned i
     const float mult = range == ValuesRange::HALF_TO_HALF ? 0.5f : 1.0f;
     const float h = 2.f * mult;
 
-    _generateCircle(verticalSegments, h * 0.5f, CylinderCullFace::FRONT, range);
+    // Temporaries of this generation
+    GenerationArena arena;
 
-    std::vector<unsigned int> trisNum;
+    _generateCircle(verticalSegments, h * 0.5f, CylinderCullFace::FRONT, range, arena.resource());
+    if (_cancelled) return;
+
+    std::pmr::vector<unsigned int> trisNum(arena.resource());
 
     const float angleXZDiff = 2.f * (float)M_PI / (float)verticalSegments;
     const float hDiff = h / (float)horizontalSegments;
@@ -88,7 +93,10 @@ void Cylinder::_generate(const unsigned int horizontalSegments, const unsigned i
 
     // VERTICES UP AND DOWN
     const unsigned int horiSegms = (useFlatShading ? mul_2(horizontalSegments) : horizontalSegments + 1u);
+    PhaseTimer vertexTimer(&_generationStats, "vertex generation");
     for (unsigned int i = 0u; i < horiSegms; ++i) {
+        if (_reportProgress("vertex generation", i, horiSegms)) return;
+
         const float yDiff = hDiff * (float)(i - (useFlatShading ? div_2(i) : 0u));
         const float y = h * 0.5f - yDiff;
         float angleXZ = 0.f;
@@ -134,10 +142,14 @@ void Cylinder::_generate(const unsigned int horizontalSegments, const unsigned i
             angleXZ += angleXZDiff;
         }
     }
+    vertexTimer.stop();
 
     // INDICES
-    glm::vec3 tangent;
+    const size_t indexStart = _indices.size();
+    PhaseTimer indexTimer(&_generationStats, "index generation");
     for (unsigned int i = 0u; i < horizontalSegments; ++i) {
+        if (_reportProgress("index generation", i, horizontalSegments)) return;
+
         for (unsigned int j = 0u; j < verticalSegments; ++j) {
             const size_t f = (useFlatShading ? 1ull : 0ull);
             const size_t m = f + 1ull;
@@ -152,14 +164,6 @@ void Cylinder::_generate(const unsigned int horizontalSegments, const unsigned i
             _indices.push_back((unsigned int)dt);
             _indices.push_back((unsigned int)right);
 
-            if (_shapeConfig.genTangents) {
-                tangent = _calcTangent((unsigned int)left, (unsigned int)dt, (unsigned int)right);
-
-                _vertices[left].Tangent += tangent;
-                _vertices[dt].Tangent += tangent;
-                _vertices[right].Tangent += tangent;
-            }
-
             std::swap(dt, right);
             left = right;
             right += 1ull;
@@ -167,34 +171,47 @@ void Cylinder::_generate(const unsigned int horizontalSegments, const unsigned i
             _indices.push_back((unsigned int)dt);
             _indices.push_back((unsigned int)left);
             _indices.push_back((unsigned int)right);
-
-            if (_shapeConfig.genTangents) {
-                tangent = _calcTangent((unsigned int)dt, (unsigned int)left, (unsigned int)right);
-
-                _vertices[dt].Tangent += tangent;
-                _vertices[left].Tangent += tangent;
-                _vertices[right].Tangent += tangent;
-            }
         }
     }
+    indexTimer.stop();
 
-    if (_shapeConfig.genTangents) _normalizeTangentsAndGenerateBitangents(trisNum, start, _vertices.size());
+    if (_shapeConfig.genTangents) {
+        _accumulateTangents(indexStart, _indices.size());
+        if (_cancelled) return;
+
+        _normalizeTangentsAndGenerateBitangents(trisNum, start, _vertices.size());
+    }
 
     trisNum.clear();
 
-    _generateCircle(verticalSegments, -h * 0.5f, CylinderCullFace::BACK, range);
+    _generateCircle(verticalSegments, -h * 0.5f, CylinderCullFace::BACK, range, arena.resource());
 }
 
 Cylinder::Cylinder(const ShapeConfig& config, const unsigned int horizontalSegments, const unsigned int verticalSegments, const ValuesRange range, const Shading shading)
+    : Shape(config)
 {
-    _shapeConfig = config;
     _vertices.clear();
     _indices.clear();
+    if (!_checkIndexType(getMeshCounts(horizontalSegments, verticalSegments, range, shading))) return;
     _generate(std::max(1u, horizontalSegments), std::max(3u, verticalSegments), range, shading == Shading::FLAT);
 }
 
+Cylinder::Cylinder(const ShapeConfig& config, _NoGenerate) : Shape(config) {}
+
 Cylinder::~Cylinder() {}
 
+MeshCounts Cylinder::_getMeshCounts(const size_t horizontalSegments, const size_t verticalSegments, const bool useFlatShading)
+{
+    // Side (own vertices for every quad when flat) and two caps with center vertex
+    const size_t side = useFlatShading ? mul_sat<size_t>(4ull * horizontalSegments, verticalSegments) : mul_sat<size_t>(horizontalSegments + 1ull, verticalSegments + 1ull);
+    return { add_sat<size_t>(side, 2ull * (verticalSegments + 1ull)), mul_sat<size_t>(6ull * verticalSegments, horizontalSegments + 1ull) };
+}
+
+MeshCounts Cylinder::getMeshCounts(const unsigned int horizontalSegments, const unsigned int verticalSegments, const ValuesRange, const Shading shading)
+{
+    return _getMeshCounts(std::max(1u, horizontalSegments), std::max(3u, verticalSegments), shading == Shading::FLAT);
+}
+
 std::string Cylinder::getClassName()
 {
     return "Cylinder";
@@ -2,6 +2,7 @@
 
 #pragma region STD_LIBS
 #include <cstdint>
+#include <memory_resource>
 #include <string>
 #pragma endregion
 
@@ -16,16 +17,22 @@ private:
 		BACK = 1
 	};
 
-	void _generateCircle(const unsigned int segments, const float y, const CylinderCullFace cullFace, const ValuesRange range);
+	void _generateCircle(const unsigned int segments, const float y, const CylinderCullFace cullFace, const ValuesRange range, std::pmr::memory_resource* memory);
 
 protected:
 	void _generate(const unsigned int horizontalSegments, const unsigned int verticalSegments, const ValuesRange range, const bool useFlatShading);
+	static MeshCounts _getMeshCounts(const size_t horizontalSegments, const size_t verticalSegments, const bool useFlatShading);
+
+	// Only sets config, for derived shapes which call _generate themselves
+	struct _NoGenerate {};
+	Cylinder(const ShapeConfig& config, _NoGenerate);
 
 public:
-	Cylinder() = default;
 	Cylinder(const ShapeConfig& config, const unsigned int horizontalSegments = 1u, const unsigned int verticalSegments = 3u, const ValuesRange range = ValuesRange::HALF_TO_HALF, const Shading shading = Shading::FLAT);
 	virtual ~Cylinder();
 
+	// Same parameters (and clamping) as constructor
+	static MeshCounts getMeshCounts(const unsigned int horizontalSegments = 1u, const unsigned int verticalSegments = 3u, const ValuesRange range = ValuesRange::HALF_TO_HALF, const Shading shading = Shading::FLAT);
 	static std::string getClassName();
 	std::string getObjectClassName() const override;
 };
\ No newline at end of file
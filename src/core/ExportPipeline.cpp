@@ -0,0 +1,112 @@
+#pragma region PCH
+#include "pch.hpp"
+#pragma endregion
+
+#pragma region STD_LIBS
+#include <exception>
+#include <ostream>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <utility>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "ExportPipeline.hpp"
+#include "ProgressToken.hpp"
+#pragma endregion
+
+ExportPipeline::ExportPipeline(ProgressToken* progress, const size_t queueDepth)
+    : _progress(progress), _jobs(queueDepth), _chunks(queueDepth) {}
+
+size_t ExportPipeline::getChunksInFlight(const size_t queueDepth)
+{
+    return 2ull * SpscQueue<FormatJob>::roundCapacity(queueDepth) + 3ull;
+}
+
+bool ExportPipeline::emit(FormatJob job)
+{
+    if (_progress != nullptr && _progress->isCancelled()) return false;
+    return _jobs.push(std::move(job));
+}
+
+bool ExportPipeline::run(std::ostream& out, const Generator& generator, const char* phase, const size_t totalChunks)
+{
+    std::exception_ptr generatorException;
+    std::exception_ptr formatterException;
+    bool generated = false;
+
+    // Stages wait on queues for most of their time, so they get own threads instead of pool workers (the generator
+    // may wait for pool tasks too). Pool is still used by generation and formatting inside them. Threads are joined
+    // by their destructors when run exits early (writing threw), stop request closes queues, so no stage stays blocked
+    std::jthread generatorThread([this, &generator, &generatorException, &generated](std::stop_token stop) {
+        std::stop_callback closeQueues(stop, [this]() { _closeQueues(); });
+        try {
+            generated = generator(*this);
+        }
+        catch (...) {
+            generatorException = std::current_exception();
+        }
+
+        // Formatter finishes jobs emitted so far
+        _jobs.close();
+    });
+
+    std::jthread formatterThread([this, &formatterException](std::stop_token stop) {
+        std::stop_callback closeQueues(stop, [this]() { _closeQueues(); });
+        try {
+            FormatJob job;
+            while (_jobs.pop(job)) {
+                std::string bytes = job();
+                job = nullptr;
+                if (!_chunks.push(std::move(bytes))) break;
+            }
+        }
+        catch (...) {
+            formatterException = std::current_exception();
+        }
+
+        // Stops generator when formatter ended early
+        _closeQueues();
+    });
+
+    bool written = true;
+    std::string chunk;
+    while (_chunks.pop(chunk)) {
+        out.write(chunk.data(), chunk.size());
+        _writtenBytes += chunk.size();
+        ++_writtenChunks;
+        chunk = std::string();
+
+        if (!out || (_progress != nullptr && _progress->report(phase, _writtenChunks, totalChunks))) {
+            written = false;
+            break;
+        }
+    }
+
+    // Wakes stages still waiting on full queues
+    _closeQueues();
+    generatorThread.join();
+    formatterThread.join();
+
+    if (generatorException) std::rethrow_exception(generatorException);
+    if (formatterException) std::rethrow_exception(formatterException);
+
+    return written && generated && (_progress == nullptr || !_progress->isCancelled());
+}
+
+void ExportPipeline::_closeQueues()
+{
+    _chunks.close();
+    _jobs.close();
+}
+
+size_t ExportPipeline::getWrittenChunks() const
+{
+    return _writtenChunks;
+}
+
+size_t ExportPipeline::getWrittenBytes() const
+{
+    return _writtenBytes;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#pragma region STD_LIBS
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <string>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "ProgressToken.hpp"
+#include "SpscQueue.hpp"
+#pragma endregion
+
+// Saving in three overlapping stages joined by bounded SpscQueues: generator thread emits chunks of the mesh
+// (as jobs formatting them), formatter thread turns jobs into bytes and the calling thread writes them in order.
+// Memory in flight depends on queue depth and chunk size, not on mesh size. Generator stage generates chunks only
+// in TiledPlane, Shape::save emits slices of a generated mesh. Every pipeline runs once
+class ExportPipeline
+{
+public:
+	// Formats one emitted chunk on formatter thread, captures (or shares) data it needs
+	using FormatJob = std::function<std::string()>;
+	// Emits jobs in file order, returns false when it stopped early (emit returned false or generation failed)
+	using Generator = std::function<bool(ExportPipeline&)>;
+
+	static constexpr size_t DEFAULT_QUEUE_DEPTH = 4ull;
+
+	// progress - cancels saving and receives written chunks, nullptr can't be cancelled
+	explicit ExportPipeline(ProgressToken* progress = nullptr, const size_t queueDepth = DEFAULT_QUEUE_DEPTH);
+
+	ExportPipeline(const ExportPipeline&) = delete;
+	ExportPipeline& operator=(const ExportPipeline&) = delete;
+
+	// Most chunks held at once, both queues full and one chunk in every stage
+	static size_t getChunksInFlight(const size_t queueDepth = DEFAULT_QUEUE_DEPTH);
+
+	// Generator stage only, waits while formatter is behind. Returns false when pipeline stops (writing failed or saving was cancelled)
+	bool emit(FormatJob job);
+
+	// Runs generator and formatter on their own threads (std::jthread, joined on every exit) and writes chunks to out on calling thread, reporting them as done of totalChunks.
+	// Returns false when generator stopped early, writing failed or saving was cancelled. Exception of a stage is rethrown here
+	bool run(std::ostream& out, const Generator& generator, const char* phase, const size_t totalChunks);
+
+	size_t getWrittenChunks() const;
+	size_t getWrittenBytes() const;
+
+private:
+	// Either stage or writer, wakes all of them
+	void _closeQueues();
+
+	ProgressToken* _progress = nullptr;
+	SpscQueue<FormatJob> _jobs;
+	SpscQueue<std::string> _chunks;
+	size_t _writtenChunks = 0ull;
+	size_t _writtenBytes = 0ull;
+};
@@ -0,0 +1,139 @@
+#pragma region PCH
+#include "pch.hpp"
+#pragma endregion
+
+#pragma region STD_LIBS
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "GenerationArena.hpp"
+#pragma endregion
+
+struct ThreadBuffer
+{
+    std::unique_ptr<std::byte[]> data;
+    size_t size = 0ull;
+    bool inUse = false;
+    size_t lastOverflowCount = 0ull;
+    // Arenas in a row which used less than a quarter of the buffer
+    size_t underusedArenas = 0ull;
+};
+
+static thread_local ThreadBuffer threadBuffer;
+
+void* GenerationArena::_OverflowResource::do_allocate(size_t bytes, size_t alignment)
+{
+    ++count;
+    size += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+}
+
+void GenerationArena::_OverflowResource::do_deallocate(void* p, size_t bytes, size_t alignment)
+{
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+}
+
+bool GenerationArena::_OverflowResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
+
+void* GenerationArena::_UsageResource::do_allocate(size_t bytes, size_t alignment)
+{
+    size += bytes;
+    return upstream->allocate(bytes, alignment);
+}
+
+void GenerationArena::_UsageResource::do_deallocate(void* p, size_t bytes, size_t alignment)
+{
+    upstream->deallocate(p, bytes, alignment);
+}
+
+bool GenerationArena::_UsageResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
+
+GenerationArena::GenerationArena()
+{
+    if (threadBuffer.inUse) {
+        _monotonic.emplace(INITIAL_THREAD_BUFFER_SIZE, &_overflow);
+        _usage.upstream = &*_monotonic;
+        return;
+    }
+
+    if (threadBuffer.data == nullptr) {
+        threadBuffer.data = std::make_unique_for_overwrite<std::byte[]>(INITIAL_THREAD_BUFFER_SIZE);
+        threadBuffer.size = INITIAL_THREAD_BUFFER_SIZE;
+    }
+
+    threadBuffer.inUse = true;
+    _ownsThreadBuffer = true;
+    _monotonic.emplace(threadBuffer.data.get(), threadBuffer.size, &_overflow);
+    _usage.upstream = &*_monotonic;
+}
+
+GenerationArena::~GenerationArena()
+{
+    _monotonic.reset();
+    if (!_ownsThreadBuffer) return;
+
+    // Next arena on this thread fits in the buffer
+    if (_overflow.size > 0ull && threadBuffer.size < MAX_THREAD_BUFFER_SIZE) {
+        threadBuffer.size = std::min(MAX_THREAD_BUFFER_SIZE, threadBuffer.size + _overflow.size);
+        threadBuffer.data = std::make_unique_for_overwrite<std::byte[]>(threadBuffer.size);
+        threadBuffer.underusedArenas = 0ull;
+    }
+    // Big generation was a one-off, smaller ones don't need its buffer
+    else if (threadBuffer.size > INITIAL_THREAD_BUFFER_SIZE && _usage.size < threadBuffer.size / 4ull) {
+        if (++threadBuffer.underusedArenas >= TRIM_AFTER_ARENAS) {
+            threadBuffer.size = std::max<size_t>(INITIAL_THREAD_BUFFER_SIZE, threadBuffer.size / 2ull);
+            threadBuffer.data = std::make_unique_for_overwrite<std::byte[]>(threadBuffer.size);
+            threadBuffer.underusedArenas = 0ull;
+        }
+    }
+    else {
+        threadBuffer.underusedArenas = 0ull;
+    }
+
+    threadBuffer.lastOverflowCount = _overflow.count;
+    threadBuffer.inUse = false;
+}
+
+std::pmr::memory_resource* GenerationArena::resource()
+{
+    return &_usage;
+}
+
+size_t GenerationArena::getOverflowCount() const
+{
+    return _overflow.count;
+}
+
+size_t GenerationArena::getOverflowSize() const
+{
+    return _overflow.size;
+}
+
+size_t GenerationArena::getThreadBufferSize()
+{
+    return threadBuffer.size;
+}
+
+size_t GenerationArena::getLastOverflowCount()
+{
+    return threadBuffer.lastOverflowCount;
+}
+
+void GenerationArena::releaseThreadBuffer()
+{
+    if (threadBuffer.inUse) return;
+
+    threadBuffer.data.reset();
+    threadBuffer.size = 0ull;
+    threadBuffer.underusedArenas = 0ull;
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+#pragma once
+
+#pragma region STD_LIBS
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+#pragma endregion
+
+// Monotonic memory for temporaries of one generation or export, everything is freed at once when arena is destroyed.
+// Arena takes memory from a buffer owned by the current thread, which grows to the biggest use seen
+// (up to MAX_THREAD_BUFFER_SIZE), so following generations on the same thread don't allocate at all.
+// Buffer is halved after TRIM_AFTER_ARENAS arenas in a row used less than a quarter of it, so one big shape
+// doesn't keep memory on every pool thread for the rest of the process.
+// Arena created while another one is alive on the same thread (nested or interleaved pool task) gets its own memory
+class GenerationArena
+{
+public:
+	static constexpr size_t INITIAL_THREAD_BUFFER_SIZE = 64ull * 1024ull;
+	static constexpr size_t MAX_THREAD_BUFFER_SIZE = 16ull * 1024ull * 1024ull;
+	static constexpr size_t TRIM_AFTER_ARENAS = 8ull;
+
+	GenerationArena();
+	~GenerationArena();
+
+	GenerationArena(const GenerationArena&) = delete;
+	GenerationArena& operator=(const GenerationArena&) = delete;
+
+	std::pmr::memory_resource* resource();
+
+	// Allocations which didn't fit thread buffer
+	size_t getOverflowCount() const;
+	size_t getOverflowSize() const;
+
+	// Current thread buffer
+	static size_t getThreadBufferSize();
+	// Allocations which didn't fit thread buffer in last arena destroyed on this thread
+	static size_t getLastOverflowCount();
+	// Frees buffer of the current thread (must not be called while an arena is alive on it)
+	static void releaseThreadBuffer();
+
+private:
+	// Counts memory taken from outside of the thread buffer
+	class _OverflowResource : public std::pmr::memory_resource
+	{
+	public:
+		size_t count = 0ull;
+		size_t size = 0ull;
+
+	private:
+		void* do_allocate(size_t bytes, size_t alignment) override;
+		void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+	};
+
+	// Counts bytes requested from the arena, buffer is trimmed when they stay well below its size
+	class _UsageResource : public std::pmr::memory_resource
+	{
+	public:
+		std::pmr::memory_resource* upstream = nullptr;
+		size_t size = 0ull;
+
+	private:
+		void* do_allocate(size_t bytes, size_t alignment) override;
+		void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+	};
+
+	_OverflowResource _overflow;
+	std::optional<std::pmr::monotonic_buffer_resource> _monotonic;
+	_UsageResource _usage;
+	bool _ownsThreadBuffer = false;
+};
\ No newline at end of file
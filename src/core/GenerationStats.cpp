@@ -0,0 +1,140 @@
+#pragma region PCH
+#include "pch.hpp"
+#pragma endregion
+
+#pragma region STD_LIBS
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+#pragma endregion
+
+#pragma region JSON_LIB
+#include <nlohmann/json.hpp>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "GenerationStats.hpp"
+#pragma endregion
+
+using Milliseconds = std::chrono::duration<double, std::milli>;
+
+static std::chrono::steady_clock::time_point getEpoch()
+{
+    static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+    return epoch;
+}
+
+static size_t getThreadNumber()
+{
+    static std::atomic<size_t> threadsCount{ 0ull };
+    static thread_local const size_t number = threadsCount.fetch_add(1ull, std::memory_order_relaxed);
+    return number;
+}
+
+void GenerationStats::append(const GenerationStats& other)
+{
+    phases.insert(phases.end(), other.phases.begin(), other.phases.end());
+}
+
+void GenerationStats::clear()
+{
+    phases.clear();
+}
+
+bool GenerationStats::empty() const
+{
+    return phases.empty();
+}
+
+double GenerationStats::getPhaseMs(const std::string& name) const
+{
+    double sum = 0.0;
+    for (const PhaseTiming& phase : phases) {
+        if (phase.name == name) sum += phase.durationMs;
+    }
+    return sum;
+}
+
+std::vector<std::pair<std::string, double>> GenerationStats::getSummary() const
+{
+    std::vector<const PhaseTiming*> ordered;
+    ordered.reserve(phases.size());
+    for (const PhaseTiming& phase : phases) ordered.push_back(&phase);
+    std::stable_sort(ordered.begin(), ordered.end(), [](const PhaseTiming* a, const PhaseTiming* b) { return a->startMs < b->startMs; });
+
+    std::vector<std::pair<std::string, double>> summary;
+    for (const PhaseTiming* phase : ordered) {
+        auto it = std::find_if(summary.begin(), summary.end(), [&](const auto& entry) { return entry.first == phase->name; });
+        if (it == summary.end()) summary.emplace_back(phase->name, phase->durationMs);
+        else it->second += phase->durationMs;
+    }
+    return summary;
+}
+
+std::string GenerationStats::toChromeTrace() const
+{
+    nlohmann::ordered_json events = nlohmann::ordered_json::array();
+    for (const PhaseTiming& phase : phases) {
+        // Complete events, times in microseconds
+        events.push_back({
+            { "name", phase.name },
+            { "cat", "shapes" },
+            { "ph", "X" },
+            { "ts", phase.startMs * 1000.0 },
+            { "dur", phase.durationMs * 1000.0 },
+            { "pid", 0 },
+            { "tid", phase.thread }
+        });
+    }
+
+    nlohmann::ordered_json trace;
+    trace["traceEvents"] = std::move(events);
+    trace["displayTimeUnit"] = "ms";
+    return trace.dump(4);
+}
+
+bool GenerationStats::saveChromeTrace(const std::string& path) const
+{
+    std::ofstream file(path, std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!file.is_open()) return false;
+
+    const std::string text = toChromeTrace();
+    file.write(text.data(), text.size());
+    return file.good();
+}
+
+PhaseTimer::PhaseTimer(GenerationStats* stats, const char* name) : _stats(stats), _name(name)
+{
+    if (_stats == nullptr) return;
+
+    getEpoch();
+    _start = std::chrono::steady_clock::now();
+    if (AllocScope::isCollectingReport()) _alloc.emplace(name);
+}
+
+PhaseTimer::~PhaseTimer()
+{
+    stop();
+}
+
+void PhaseTimer::stop()
+{
+    if (_stats == nullptr) return;
+
+    const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    if (_alloc) _alloc->stop();
+    const std::chrono::steady_clock::time_point epoch = getEpoch();
+
+    PhaseTiming phase;
+    phase.name = _name;
+    phase.startMs = std::chrono::duration_cast<Milliseconds>(_start - epoch).count();
+    phase.durationMs = std::chrono::duration_cast<Milliseconds>(end - _start).count();
+    phase.thread = getThreadNumber();
+    _stats->phases.push_back(std::move(phase));
+    _stats = nullptr;
+}
\ No newline at end of file
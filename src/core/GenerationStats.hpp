@@ -0,0 +1,64 @@
+#pragma once
+
+#pragma region STD_LIBS
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "AllocStats.hpp"
+#pragma endregion
+
+// Wall time of one phase, start is measured from the first timer created in the process
+struct PhaseTiming
+{
+	std::string name;
+	double startMs = 0.0;
+	double durationMs = 0.0;
+	// Small number of the thread (in order of first use), not the system thread id
+	size_t thread = 0ull;
+};
+
+// Phases of generation and export recorded by PhaseTimer, in order of their end (nested phases come first)
+struct GenerationStats
+{
+	std::vector<PhaseTiming> phases;
+
+	void append(const GenerationStats& other);
+	void clear();
+	bool empty() const;
+
+	// Sum of durations of phases with given name
+	double getPhaseMs(const std::string& name) const;
+	// Name - summed duration pairs in order of first start
+	std::vector<std::pair<std::string, double>> getSummary() const;
+	// Chrome trace event format, opens in chrome://tracing or ui.perfetto.dev
+	std::string toChromeTrace() const;
+	// Writes toChromeTrace() to file, returns false when it can't be written
+	bool saveChromeTrace(const std::string& path) const;
+};
+
+// Records phase from construction until stop() (or destruction), does nothing when stats is nullptr.
+// When the thread collects allocation report, phase is also measured as a nested AllocScope of the same name.
+// Not thread safe, phases running in parallel need their own stats merged later with append()
+class PhaseTimer
+{
+public:
+	PhaseTimer(GenerationStats* stats, const char* name);
+	~PhaseTimer();
+
+	PhaseTimer(const PhaseTimer&) = delete;
+	PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+	void stop();
+
+private:
+	GenerationStats* _stats = nullptr;
+	const char* _name = nullptr;
+	std::chrono::steady_clock::time_point _start;
+	std::optional<AllocScope> _alloc;
+};
\ No newline at end of file
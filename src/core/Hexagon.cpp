@@ -12,15 +12,21 @@
 #pragma endregion
 
 Hexagon::Hexagon(const ShapeConfig& config, const unsigned int segments, const ValuesRange range)
+    : Cylinder(config, _NoGenerate())
 {
-    _shapeConfig = config;
     _vertices.clear();
     _indices.clear();
+    if (!_checkIndexType(getMeshCounts(segments, range))) return;
     _generate(segments, 6u, range, true);
 }
 
 Hexagon::~Hexagon() {}
 
+MeshCounts Hexagon::getMeshCounts(const unsigned int segments, const ValuesRange)
+{
+    return _getMeshCounts(segments, 6u, true);
+}
+
 std::string Hexagon::getClassName()
 {
     return "Hexagon";
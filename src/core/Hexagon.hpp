@@ -14,6 +14,8 @@ public:
 	Hexagon(const ShapeConfig& config, const unsigned int segments = 1u, const ValuesRange range = ValuesRange::HALF_TO_HALF);
 	virtual ~Hexagon();
 
+	// Same parameters (and clamping) as constructor
+	static MeshCounts getMeshCounts(const unsigned int segments = 1u, const ValuesRange range = ValuesRange::HALF_TO_HALF);
 	static std::string getClassName();
 	std::string getObjectClassName() const override;
 };
\ No newline at end of file
@@ -5,6 +5,7 @@
 #pragma region STD_LIBS
 #include <algorithm>
 #include <cstdint>
+#include <memory_resource>
 #include <string>
 #include <utility>
 #include <vector>
@@ -18,15 +19,17 @@
 #pragma region MY_FILES
 #include "BitMathOperators.hpp"
 #include "Constants.hpp"
+#include "GenerationArena.hpp"
+#include "GenerationStats.hpp"
 #include "IcoSphere.hpp"
 #include "Shape.hpp"
 #include "Vertex.hpp"
 #pragma endregion
 
-void IcoSphere::_generateIcoSahedron(const float mult, const bool useFlatShading, const bool hasSubdivisions)
+void IcoSphere::_generateIcoSahedron(const float mult, const bool useFlatShading, const bool hasSubdivisions, std::pmr::memory_resource* memory)
 {
-    std::vector<Vertex> tempVertices;
-    std::vector<unsigned int> tempIndices;
+    std::pmr::vector<Vertex> tempVertices(memory);
+    std::pmr::vector<unsigned int> tempIndices(memory);
 
     constexpr float t = .5f + (float)M_SQRT5 * .5f;
 
@@ -115,7 +118,7 @@ void IcoSphere::_generateIcoSahedron(const float mult, const bool useFlatShading
         }
 
         if (!hasSubdivisions && _shapeConfig.genTangents) {
-            std::vector<unsigned int> trisNum(_vertices.size(), 5);
+            std::pmr::vector<unsigned int> trisNum(_vertices.size(), 5, memory);
             _normalizeTangentsAndGenerateBitangents(trisNum, 0ull, _vertices.size());
         }
     }
@@ -155,12 +158,27 @@ void IcoSphere::_generateIcoSahedron(const float mult, const bool useFlatShading
 void IcoSphere::_generate(const unsigned int subdivisions, const ValuesRange range, const bool useFlatShading)
 {
     const float mult = (range == ValuesRange::HALF_TO_HALF) ? .5f : 1.f;
-    _generateIcoSahedron(mult, useFlatShading, subdivisions != 0u);
+    PhaseTimer vertexTimer(&_generationStats, "vertex generation");
+
+    // Temporaries of this generation, index buffer of every level reuses the same memory
+    GenerationArena arena;
+    _generateIcoSahedron(mult, useFlatShading, subdivisions != 0u, arena.resource());
+    std::pmr::vector<unsigned int> newIndices(arena.resource());
+
+    // Every level splits four times more triangles than the previous one
+    const size_t totalTriangles = 20ull * ((1ull << (2ull * subdivisions)) - 1ull) / 3ull;
+    size_t doneTriangles = 0ull;
 
     for (unsigned int i = 0u; i < subdivisions; ++i) {
-        std::vector<unsigned int> newIndices;
         const size_t indSize = _indices.size();
+        newIndices.clear();
+        newIndices.reserve(indSize * 4ull);
         for (size_t j = 0ull; j < indSize; j += 3ull) {
+            if (j % (3ull * PROGRESS_STEP) == 0ull && _reportProgress("vertex generation", doneTriangles + j / 3ull, totalTriangles)) {
+                _middlePointCache = {};
+                return;
+            }
+
             const unsigned int a = _indices[j];
             const unsigned int b = _indices[j + 1ull];
             const unsigned int c = _indices[j + 2ull];
@@ -185,30 +203,25 @@ void IcoSphere::_generate(const unsigned int subdivisions, const ValuesRange ran
             newIndices.push_back(ca);
         }
 
-        _indices.clear();
-        _indices.insert(_indices.end(), newIndices.begin(), newIndices.end());
+        _indices.assign(newIndices.begin(), newIndices.end());
+        doneTriangles += indSize / 3ull;
     }
+    vertexTimer.stop();
 
-    glm::vec3 tangent;
     const size_t indSize = _indices.size();
     if (!useFlatShading && _shapeConfig.genTangents) {
-        for (size_t i = 0ull; i < indSize; i += 3ull) {
-            const unsigned int ia = _indices[i];
-            const unsigned int ib = _indices[i + 1ull];
-            const unsigned int ic = _indices[i + 2ull];
+        _accumulateTangents(0ull, indSize);
+        if (_cancelled) return;
 
-            tangent = _calcTangent(ia, ib, ic);
-
-            _vertices[ia].Tangent += tangent;
-            _vertices[ib].Tangent += tangent;
-            _vertices[ic].Tangent += tangent;
-        }
-
-        std::vector<unsigned int> trisNum(_vertices.size(), 5);
+        std::pmr::vector<unsigned int> trisNum(_vertices.size(), 5, arena.resource());
         _normalizeTangentsAndGenerateBitangents(trisNum, 0ull, _vertices.size());
     }
     else {
+        PhaseTimer flatTimer(&_generationStats, "flat shading");
+        glm::vec3 tangent;
         for (size_t i = 0ull; i < indSize; i += 3ull) {
+            if (i % (3ull * PROGRESS_STEP) == 0ull && _reportProgress("flat shading", i, indSize)) return;
+
             const unsigned int ia = _indices[i];
             const unsigned int ib = _indices[i + 1ull];
             const unsigned int ic = _indices[i + 2ull];
@@ -267,16 +280,26 @@ void IcoSphere::_defineTangentBitangentFlatShading(const glm::vec3 tangent, cons
 }
 
 IcoSphere::IcoSphere(const ShapeConfig& config, const unsigned int subdivisions, const ValuesRange range, const Shading shading)
+    : Shape(config)
 {
-    _shapeConfig = config;
     _vertices.clear();
     _indices.clear();
     _middlePointCache.clear();
+    if (!_checkIndexType(getMeshCounts(subdivisions, range, shading))) return;
     _generate(subdivisions, range, shading == Shading::FLAT);
 }
 
 IcoSphere::~IcoSphere() {}
 
+MeshCounts IcoSphere::getMeshCounts(const unsigned int subdivisions, const ValuesRange, const Shading shading)
+{
+    // Every subdivision splits triangle into four, past 29 subdivisions faces don't fit size_t
+    if (subdivisions >= 30u) return { SIZE_MAX, SIZE_MAX };
+
+    const size_t faces = 20ull << (2ull * subdivisions);
+    return { shading == Shading::FLAT ? add_sat<size_t>(faces, 40ull) : faces / 2ull + 2ull, mul_sat<size_t>(faces, 3ull) };
+}
+
 std::string IcoSphere::getClassName()
 {
     return "IcoSphere";
@@ -2,6 +2,7 @@
 
 #pragma region STD_LIBS
 #include <cstdint>
+#include <memory_resource>
 #include <string>
 #include <unordered_map>
 #pragma endregion
@@ -16,7 +17,7 @@
 
 class IcoSphere : public Shape {
 private:
-    void _generateIcoSahedron(const float mult, const bool useFlatShading, const bool hasSubdivisions);
+    void _generateIcoSahedron(const float mult, const bool useFlatShading, const bool hasSubdivisions, std::pmr::memory_resource* memory);
     void _generate(const unsigned int subdivisions, const ValuesRange range, const bool useFlatShading);
 
     unsigned int _getMiddlePoint(const unsigned int p1, const unsigned int p2, const float mult);
@@ -32,6 +33,11 @@ public:
     IcoSphere(const ShapeConfig& config, const unsigned int subdivisions = 0u, const ValuesRange range = ValuesRange::HALF_TO_HALF, const Shading shading = Shading::FLAT);
     virtual ~IcoSphere();
 
+    // Largest subdivisions count whose indices still fit MeshCounts::MAX_INDICES (60 * 4^13 < 2^32)
+    static constexpr unsigned int MAX_SUBDIVISIONS = 13u;
+
+    // Same parameters (and clamping) as constructor
+    static MeshCounts getMeshCounts(const unsigned int subdivisions = 0u, const ValuesRange range = ValuesRange::HALF_TO_HALF, const Shading shading = Shading::FLAT);
     static std::string getClassName();
     std::string getObjectClassName() const override;
 };
\ No newline at end of file
@@ -0,0 +1,341 @@
+#pragma region PCH
+#include "pch.hpp"
+#pragma endregion
+
+#pragma region STD_LIBS
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+#pragma endregion
+
+#pragma region FMT_LIB
+#include <fmt/format.h>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "MeshCache.hpp"
+#include "Shape.hpp"
+#include "Vertex.hpp"
+#pragma endregion
+
+namespace fs = std::filesystem;
+
+// Position, tex coord and normal, tangent and bitangent are stored only when exported
+static constexpr size_t BASE_VERTEX_FLOATS = 8ull;
+static constexpr uint32_t FLAG_TANGENTS = 1u;
+static constexpr uint32_t FLAG_BITANGENTS = 2u;
+
+static uint32_t getStoredFlags(const ShapeConfig& config)
+{
+    uint32_t flags = 0u;
+    if (config.genTangents) flags |= FLAG_TANGENTS;
+    if (config.genTangents && config.calcBitangents) flags |= FLAG_BITANGENTS;
+    return flags;
+}
+
+static size_t getStoredVertexFloats(const uint32_t flags)
+{
+    return BASE_VERTEX_FLOATS + ((flags & FLAG_TANGENTS) ? 3ull : 0ull) + ((flags & FLAG_BITANGENTS) ? 3ull : 0ull);
+}
+
+// FNV-1a
+static uint64_t hashKey(const std::string& key)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (const char c : key) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+MeshCache::MeshCache(const std::string& directory, const uint64_t maxSize, const bool enabled)
+{
+    configure(directory, maxSize, enabled);
+}
+
+MeshCache& MeshCache::get()
+{
+    static MeshCache cache("", DEFAULT_MAX_SIZE, false);
+    return cache;
+}
+
+void MeshCache::configure(const std::string& directory, const uint64_t maxSize, const bool enabled)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _directory = fs::path(directory);
+    _maxSize = maxSize;
+    _enabled = enabled && !directory.empty() && maxSize > 0ull;
+    _sizeKnown = false;
+    _size = 0ull;
+}
+
+bool MeshCache::isEnabled() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _enabled;
+}
+
+std::string MeshCache::getDirectory() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _directory.string();
+}
+
+uint64_t MeshCache::getSize()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _updateSize();
+    return _size;
+}
+
+void MeshCache::clear()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    std::error_code ec;
+    for (const fs::directory_entry& entry : fs::directory_iterator(_directory, ec)) {
+        if (entry.path().extension() == FILE_EXTENSION) fs::remove(entry.path(), ec);
+    }
+
+    _sizeKnown = true;
+    _size = 0ull;
+}
+
+std::string MeshCache::_makeKey(const std::string& typeName, const ShapeConfig& config, const std::string& params)
+{
+    std::string key = fmt::format("{}|{}|{}|", SHAPES_GENERATOR_VERSION, FORMAT_VERSION, typeName);
+    key.push_back(config.genTangents ? '1' : '0');
+    key.push_back(config.calcBitangents ? '1' : '0');
+    key.push_back(config.tangentHandednessPositive ? '1' : '0');
+    key.push_back('|');
+    key += params;
+    return key;
+}
+
+fs::path MeshCache::_getEntryPath(const std::string& key) const
+{
+    return _directory / fmt::format("{:016x}{}", hashKey(key), FILE_EXTENSION);
+}
+
+// Vertices and indices of entry data, false when it was written for other key or settings or is damaged
+static bool parseEntry(const std::string& data, const std::string& key, const ShapeConfig& config, std::pmr::vector<Vertex>& vertices, std::pmr::vector<unsigned int>& indices)
+{
+    size_t offset = 0ull;
+    auto read = [&data, &offset](void* out, const size_t bytes) -> bool {
+        if (data.size() - offset < bytes) return false;
+        std::memcpy(out, data.data() + offset, bytes);
+        offset += bytes;
+        return true;
+    };
+
+    // Entry written by other version or another key with the same hash is treated as miss
+    char magic[4] = {};
+    uint32_t version = 0u, keySize = 0u, flags = 0u;
+    uint64_t vertexCount = 0ull, indexCount = 0ull;
+    if (!read(magic, 4ull) || std::memcmp(magic, "SGMC", 4ull) != 0) return false;
+    if (!read(&version, sizeof(version)) || version != MeshCache::FORMAT_VERSION) return false;
+    if (!read(&keySize, sizeof(keySize)) || keySize != key.size() || data.size() - offset < keySize) return false;
+    if (data.compare(offset, keySize, key) != 0) return false;
+    offset += keySize;
+    if (!read(&flags, sizeof(flags)) || flags != getStoredFlags(config)) return false;
+    if (!read(&vertexCount, sizeof(vertexCount)) || !read(&indexCount, sizeof(indexCount))) return false;
+
+    // Counts are checked against remaining bytes first, so the size sum can't overflow
+    const size_t vertexBytes = getStoredVertexFloats(flags) * sizeof(float);
+    if (vertexCount > (data.size() - offset) / vertexBytes) return false;
+    if (indexCount > (data.size() - offset) / sizeof(uint32_t)) return false;
+    if (data.size() - offset != vertexCount * vertexBytes + indexCount * sizeof(uint32_t)) return false;
+
+    vertices.assign(vertexCount, Vertex{});
+    float values[14] = {};
+    for (Vertex& v : vertices) {
+        read(values, vertexBytes);
+
+        v.Position = glm::vec3(values[0], values[1], values[2]);
+        v.TexCoord = glm::vec2(values[3], values[4]);
+        v.Normal = glm::vec3(values[5], values[6], values[7]);
+        if (flags & FLAG_TANGENTS) v.Tangent = glm::vec3(values[8], values[9], values[10]);
+        if (flags & FLAG_BITANGENTS) v.Bitangent = glm::vec3(values[11], values[12], values[13]);
+    }
+
+    indices.resize(indexCount);
+    static_assert(sizeof(unsigned int) == sizeof(uint32_t), "Indices are stored as uint32");
+    read(indices.data(), indices.size() * sizeof(uint32_t));
+
+    // Exporters and optimizer passes index vertices without checks
+    return std::all_of(indices.begin(), indices.end(), [vertexCount](const unsigned int index) { return index < vertexCount; });
+}
+
+bool MeshCache::_load(const std::string& key, const ShapeConfig& config, std::pmr::vector<Vertex>& vertices, std::pmr::vector<unsigned int>& indices)
+{
+    fs::path path;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        path = _getEntryPath(key);
+    }
+
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if (!file.is_open()) return false;
+
+    const std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+
+    std::error_code ec;
+    if (!parseEntry(data, key, config, vertices, indices)) {
+        vertices.clear();
+        indices.clear();
+
+        // Unusable entry is removed, the shape is generated and stored again
+        std::lock_guard<std::mutex> lock(_mutex);
+        _updateSize();
+        if (fs::remove(path, ec)) _size -= std::min<uint64_t>(_size, data.size());
+        return false;
+    }
+
+    // Modification time marks last use for eviction
+    fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+
+    return true;
+}
+
+void MeshCache::_store(const std::string& key, const Shape& shape)
+{
+    const uint32_t flags = getStoredFlags(shape._shapeConfig);
+    const size_t vertexFloats = getStoredVertexFloats(flags);
+
+    const uint32_t version = FORMAT_VERSION;
+    const uint32_t keySize = static_cast<uint32_t>(key.size());
+    const uint64_t vertexCount = shape._vertices.size();
+    const uint64_t indexCount = shape._indices.size();
+
+    const uint64_t bytes = 4ull + sizeof(version) + sizeof(keySize) + keySize + sizeof(flags) + sizeof(vertexCount) + sizeof(indexCount) +
+        vertexCount * vertexFloats * sizeof(float) + indexCount * sizeof(uint32_t);
+
+    fs::path path;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        // Entry bigger than whole cache would only evict everything else
+        if (bytes > _maxSize) return;
+        path = _getEntryPath(key);
+    }
+
+    std::string data;
+    data.reserve(bytes);
+    auto append = [&data](const void* value, const size_t size) {
+        data.append(reinterpret_cast<const char*>(value), size);
+    };
+
+    append("SGMC", 4ull);
+    append(&version, sizeof(version));
+    append(&keySize, sizeof(keySize));
+    append(key.data(), key.size());
+    append(&flags, sizeof(flags));
+    append(&vertexCount, sizeof(vertexCount));
+    append(&indexCount, sizeof(indexCount));
+
+    for (const Vertex& v : shape._vertices) {
+        const float values[14] = {
+            v.Position.x, v.Position.y, v.Position.z,
+            v.TexCoord.x, v.TexCoord.y,
+            v.Normal.x, v.Normal.y, v.Normal.z,
+            v.Tangent.x, v.Tangent.y, v.Tangent.z,
+            v.Bitangent.x, v.Bitangent.y, v.Bitangent.z
+        };
+        append(values, vertexFloats * sizeof(float));
+    }
+    append(shape._indices.data(), shape._indices.size() * sizeof(uint32_t));
+
+    // Written under unique name and renamed, so readers and other workers never see partial entry
+    static std::atomic<uint64_t> tempCounter = 0ull;
+    const fs::path tempPath = fs::path(path).concat(fmt::format(".{}.{}.tmp", std::hash<std::thread::id>{}(std::this_thread::get_id()), tempCounter++));
+
+    std::error_code ec;
+    fs::create_directories(path.parent_path(), ec);
+
+    std::ofstream file(tempPath, std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!file.is_open()) return;
+    file.write(data.data(), data.size());
+    file.close();
+
+    if (!file) {
+        fs::remove(tempPath, ec);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _updateSize();
+
+    const uint64_t replaced = fs::exists(path, ec) ? fs::file_size(path, ec) : 0ull;
+    fs::rename(tempPath, path, ec);
+    if (ec) {
+        fs::remove(tempPath, ec);
+        return;
+    }
+
+    _size = _size - std::min(_size, replaced) + data.size();
+    if (_size > _maxSize) _trim();
+}
+
+void MeshCache::_trim()
+{
+    struct Entry
+    {
+        fs::path path;
+        fs::file_time_type time;
+        uint64_t size;
+    };
+
+    std::vector<Entry> entries;
+    uint64_t total = 0ull;
+
+    std::error_code ec;
+    for (const fs::directory_entry& entry : fs::directory_iterator(_directory, ec)) {
+        if (entry.path().extension() != FILE_EXTENSION) continue;
+
+        std::error_code entryEc;
+        const uint64_t size = entry.file_size(entryEc);
+        const fs::file_time_type time = entry.last_write_time(entryEc);
+        if (entryEc) continue;
+
+        entries.push_back({ entry.path(), time, size });
+        total += size;
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.time < b.time; });
+
+    // Oldest first, newest entry stays even when it fills the cache alone
+    for (size_t i = 0ull; i + 1ull < entries.size() && total > _maxSize; ++i) {
+        if (fs::remove(entries[i].path, ec)) total -= entries[i].size;
+    }
+
+    _size = total;
+    _sizeKnown = true;
+}
+
+void MeshCache::_updateSize()
+{
+    if (_sizeKnown) return;
+
+    _size = 0ull;
+    std::error_code ec;
+    for (const fs::directory_entry& entry : fs::directory_iterator(_directory, ec)) {
+        if (entry.path().extension() != FILE_EXTENSION) continue;
+
+        std::error_code entryEc;
+        const uint64_t size = entry.file_size(entryEc);
+        if (!entryEc) _size += size;
+    }
+    _sizeKnown = true;
+}
\ No newline at end of file
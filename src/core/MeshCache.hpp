@@ -0,0 +1,128 @@
+#pragma once
+
+#pragma region STD_LIBS
+#include <cstdint>
+#include <filesystem>
+#include <memory_resource>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "AllocStats.hpp"
+#include "GenerationStats.hpp"
+#include "Shape.hpp"
+#include "Vertex.hpp"
+#pragma endregion
+
+// Shape restored from cache, exported exactly like ShapeType
+template<class ShapeType>
+class CachedShape : public Shape
+{
+public:
+	CachedShape(const ShapeConfig& config, std::pmr::vector<Vertex>&& vertices, std::pmr::vector<unsigned int>&& indices)
+		: Shape(config)
+	{
+		_vertices = std::move(vertices);
+		_indices = std::move(indices);
+	}
+
+	std::string getObjectClassName() const override
+	{
+		return ShapeType::getClassName();
+	}
+};
+
+// Content-addressed cache of generated meshes. Entry name is a hash of shape type, constructor parameters,
+// ShapeConfig and generator version, file holds the full key, so hash collisions are detected.
+// Only generated vertices and indices are stored, optimization passes run on the restored shape as usual.
+// Least recently used entries (by file modification time) are removed when the size limit is exceeded
+class MeshCache
+{
+public:
+	static constexpr uint32_t FORMAT_VERSION = 1u;
+	static constexpr uint64_t DEFAULT_MAX_SIZE = 256ull * 1024ull * 1024ull;
+	static constexpr const char* FILE_EXTENSION = ".sgmc";
+
+	explicit MeshCache(const std::string& directory = "", const uint64_t maxSize = DEFAULT_MAX_SIZE, const bool enabled = true);
+
+	MeshCache(const MeshCache&) = delete;
+	MeshCache& operator=(const MeshCache&) = delete;
+
+	// Cache used by interactive and batch generation, disabled until configured
+	static MeshCache& get();
+
+	void configure(const std::string& directory, const uint64_t maxSize, const bool enabled);
+	bool isEnabled() const;
+	std::string getDirectory() const;
+	// Bytes taken by cache entries
+	uint64_t getSize();
+	void clear();
+
+	// Returns shape and true when it was restored from cache
+	template<class ShapeType, class... Args>
+	std::pair<Shape*, bool> getOrGenerate(const ShapeConfig& config, const Args&... args)
+	{
+		AllocScope allocScope("generate");
+		if (!isEnabled()) return { new ShapeType(config, args...), false };
+
+		std::string params;
+		(_appendParam(params, args), ...);
+		const std::string key = _makeKey(ShapeType::getClassName(), config, params);
+
+		// Same memory as the shape, so vectors are moved into it without copying
+		std::pmr::vector<Vertex> vertices(config.getMemoryResource());
+		std::pmr::vector<unsigned int> indices(config.getMemoryResource());
+		GenerationStats lookupStats;
+		PhaseTimer loadTimer(&lookupStats, "cache load");
+		if (_load(key, config, vertices, indices)) {
+			loadTimer.stop();
+			Shape* shape = new CachedShape<ShapeType>(config, std::move(vertices), std::move(indices));
+			shape->_generationStats = std::move(lookupStats);
+			return { shape, true };
+		}
+		loadTimer.stop();
+
+		Shape* shape = new ShapeType(config, args...);
+		// Failed lookup goes before generation phases
+		lookupStats.append(shape->_generationStats);
+		shape->_generationStats = std::move(lookupStats);
+		// Cancelled shape and shape over index type are empty
+		if (shape->isCancelled() || shape->exceedsIndexType()) return { shape, false };
+
+		PhaseTimer storeTimer(&shape->_generationStats, "cache store");
+		_store(key, *shape);
+		storeTimer.stop();
+		return { shape, false };
+	}
+
+private:
+	template<class T>
+	static void _appendParam(std::string& params, const T& value)
+	{
+		static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>, "Cached shape parameters have to be numbers or enums");
+
+		params.push_back(static_cast<char>(sizeof(T)));
+		params.append(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	static std::string _makeKey(const std::string& typeName, const ShapeConfig& config, const std::string& params);
+	std::filesystem::path _getEntryPath(const std::string& key) const;
+
+	bool _load(const std::string& key, const ShapeConfig& config, std::pmr::vector<Vertex>& vertices, std::pmr::vector<unsigned int>& indices);
+	void _store(const std::string& key, const Shape& shape);
+	// Removes oldest entries until cache fits maxSize, _mutex has to be locked
+	void _trim();
+	// Scans directory on first use, _mutex has to be locked
+	void _updateSize();
+
+	mutable std::mutex _mutex;
+	std::filesystem::path _directory;
+	uint64_t _maxSize = DEFAULT_MAX_SIZE;
+	bool _enabled = false;
+	bool _sizeKnown = false;
+	uint64_t _size = 0ull;
+};
\ No newline at end of file
@@ -0,0 +1,537 @@
+#pragma region PCH
+#include "pch.hpp"
+#pragma endregion
+
+#pragma region STD_LIBS
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+#pragma endregion
+
+#pragma region GLM_LIB
+#include <glm/common.hpp>
+#include <glm/fwd.hpp>
+#include <glm/geometric.hpp>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "MeshOptimizer.hpp"
+#include "Vertex.hpp"
+#pragma endregion
+
+float MeshOptimizer::_vertexScore(const int cachePosition, const unsigned int liveTriangles, const unsigned int cacheSize)
+{
+    // https://tomforsyth1000.github.io/papers/fast_vert_cache_opt.html
+    constexpr float cacheDecayPower = 1.5f;
+    constexpr float lastTriScore = 0.75f;
+    constexpr float valenceBoostScale = 2.0f;
+    constexpr float valenceBoostPower = 0.5f;
+
+    if (liveTriangles == 0u) {
+        // No triangles left using this vertex
+        return -1.0f;
+    }
+
+    float score = 0.0f;
+    if (cachePosition >= 0) {
+        if (cachePosition < 3) {
+            // Vertex used in the last triangle, fixed score so that
+            // the algorithm doesn't prefer to use it again immediately
+            score = lastTriScore;
+        }
+        else {
+            const float scaler = 1.0f / (float)(cacheSize - 3u);
+            score = powf(1.0f - (float)(cachePosition - 3) * scaler, cacheDecayPower);
+        }
+    }
+
+    // Bonus for vertices with few triangles left so they are finished quickly
+    score += valenceBoostScale * powf((float)liveTriangles, -valenceBoostPower);
+
+    return score;
+}
+
+VertexCacheStats MeshOptimizer::analyzeVertexCache(std::span<const unsigned int> indices, const size_t vertexCount, const unsigned int cacheSize, const VertexCacheType type)
+{
+    VertexCacheStats stats;
+
+    const size_t indexCount = indices.size();
+    if (indexCount < 3ull || vertexCount == 0ull || cacheSize == 0u) return stats;
+
+    std::vector<uint8_t> referenced(vertexCount, 0u);
+    size_t uniqueVertices = 0ull;
+
+    if (type == VertexCacheType::FIFO) {
+        // Vertex is in cache if it was inserted less than cacheSize insertions ago
+        std::vector<size_t> timestamps(vertexCount, 0ull);
+        size_t timestamp = (size_t)cacheSize + 1ull;
+
+        for (size_t i = 0ull; i < indexCount; ++i) {
+            const unsigned int idx = indices[i];
+
+            if (timestamp - timestamps[idx] > (size_t)cacheSize) {
+                timestamps[idx] = timestamp++;
+                ++stats.misses;
+            }
+
+            if (!referenced[idx]) {
+                referenced[idx] = 1u;
+                ++uniqueVertices;
+            }
+        }
+    }
+    else {
+        // Most recently used entry at the front
+        std::vector<unsigned int> cache;
+        cache.reserve(cacheSize);
+
+        for (size_t i = 0ull; i < indexCount; ++i) {
+            const unsigned int idx = indices[i];
+
+            auto it = std::find(cache.begin(), cache.end(), idx);
+            if (it == cache.end()) {
+                ++stats.misses;
+
+                if (cache.size() < (size_t)cacheSize) cache.push_back(idx);
+                else cache.back() = idx;
+
+                it = cache.end() - 1;
+            }
+
+            std::rotate(cache.begin(), it, it + 1);
+
+            if (!referenced[idx]) {
+                referenced[idx] = 1u;
+                ++uniqueVertices;
+            }
+        }
+    }
+
+    stats.acmr = (float)stats.misses / (float)(indexCount / 3ull);
+    stats.atvr = uniqueVertices == 0ull ? 0.f : (float)stats.misses / (float)uniqueVertices;
+
+    return stats;
+}
+
+void MeshOptimizer::optimizeVertexCache(std::span<unsigned int> indices, const size_t vertexCount, const unsigned int cacheSize)
+{
+    const size_t indexCount = indices.size();
+    const size_t faceCount = indexCount / 3ull;
+
+    if (faceCount == 0ull || vertexCount == 0ull) return;
+
+    const unsigned int maxCache = std::clamp(cacheSize, MIN_CACHE_SIZE, MAX_CACHE_SIZE);
+    constexpr unsigned int invalidTriangle = ~0u;
+
+    // TRIANGLE ADJACENCY (vertex -> triangles)
+    std::vector<unsigned int> liveTriangles(vertexCount, 0u);
+    for (size_t i = 0ull; i < faceCount * 3ull; ++i) {
+        ++liveTriangles[indices[i]];
+    }
+
+    std::vector<size_t> adjacencyOffsets(vertexCount + 1ull, 0ull);
+    for (size_t v = 0ull; v < vertexCount; ++v) {
+        adjacencyOffsets[v + 1ull] = adjacencyOffsets[v] + liveTriangles[v];
+    }
+
+    std::vector<unsigned int> adjacency(faceCount * 3ull);
+    {
+        std::vector<size_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (size_t f = 0ull; f < faceCount; ++f) {
+            adjacency[fill[indices[f * 3ull]]++] = (unsigned int)f;
+            adjacency[fill[indices[f * 3ull + 1ull]]++] = (unsigned int)f;
+            adjacency[fill[indices[f * 3ull + 2ull]]++] = (unsigned int)f;
+        }
+    }
+
+    // INITIAL SCORES
+    std::vector<int> cachePositions(vertexCount, -1);
+    std::vector<float> vertexScores(vertexCount, 0.f);
+    for (size_t v = 0ull; v < vertexCount; ++v) {
+        vertexScores[v] = _vertexScore(-1, liveTriangles[v], maxCache);
+    }
+
+    std::vector<float> triangleScores(faceCount, 0.f);
+    unsigned int bestTriangle = invalidTriangle;
+    float bestScore = -1.f;
+    for (size_t f = 0ull; f < faceCount; ++f) {
+        triangleScores[f] = vertexScores[indices[f * 3ull]] + vertexScores[indices[f * 3ull + 1ull]] + vertexScores[indices[f * 3ull + 2ull]];
+        if (triangleScores[f] > bestScore) {
+            bestScore = triangleScores[f];
+            bestTriangle = (unsigned int)f;
+        }
+    }
+
+    std::vector<uint8_t> emitted(faceCount, 0u);
+    std::vector<unsigned int> result;
+    result.reserve(indexCount);
+
+    std::vector<unsigned int> cache;
+    std::vector<unsigned int> newCache;
+    cache.reserve(maxCache + 3u);
+    newCache.reserve(maxCache + 3u);
+
+    size_t inputCursor = 0ull;
+
+    while (bestTriangle != invalidTriangle) {
+        const unsigned int a = indices[bestTriangle * 3ull];
+        const unsigned int b = indices[bestTriangle * 3ull + 1ull];
+        const unsigned int c = indices[bestTriangle * 3ull + 2ull];
+
+        result.push_back(a);
+        result.push_back(b);
+        result.push_back(c);
+        emitted[bestTriangle] = 1u;
+
+        // Emitted triangle vertices go to the front of the cache
+        newCache.clear();
+        newCache.push_back(a);
+        newCache.push_back(b);
+        newCache.push_back(c);
+
+        for (const unsigned int v : cache) {
+            if (v != a && v != b && v != c) newCache.push_back(v);
+        }
+
+        // Remove emitted triangle from the adjacency of its vertices
+        for (const unsigned int v : { a, b, c }) {
+            const size_t begin = adjacencyOffsets[v];
+            const size_t end = begin + liveTriangles[v];
+
+            for (size_t k = begin; k < end; ++k) {
+                if (adjacency[k] == bestTriangle) {
+                    adjacency[k] = adjacency[end - 1ull];
+                    --liveTriangles[v];
+                    break;
+                }
+            }
+        }
+
+        // Update scores of every vertex that is in the cache or just left it
+        bestTriangle = invalidTriangle;
+        bestScore = -1.f;
+
+        const size_t newCacheSize = newCache.size();
+        for (size_t i = 0ull; i < newCacheSize; ++i) {
+            const unsigned int v = newCache[i];
+            const int position = i < (size_t)maxCache ? (int)i : -1;
+
+            cachePositions[v] = position;
+
+            const float score = _vertexScore(position, liveTriangles[v], maxCache);
+            const float delta = score - vertexScores[v];
+            vertexScores[v] = score;
+
+            const size_t begin = adjacencyOffsets[v];
+            const size_t end = begin + liveTriangles[v];
+            for (size_t k = begin; k < end; ++k) {
+                const unsigned int tri = adjacency[k];
+                triangleScores[tri] += delta;
+
+                if (triangleScores[tri] > bestScore) {
+                    bestScore = triangleScores[tri];
+                    bestTriangle = tri;
+                }
+            }
+        }
+
+        if (newCacheSize > (size_t)maxCache) newCache.resize(maxCache);
+        cache.swap(newCache);
+
+        // Nothing left around the cache, continue from the next unprocessed triangle
+        if (bestTriangle == invalidTriangle) {
+            while (inputCursor < faceCount && emitted[inputCursor]) ++inputCursor;
+            if (inputCursor < faceCount) bestTriangle = (unsigned int)inputCursor;
+        }
+    }
+
+    // Keep trailing indices that do not form a whole triangle
+    result.insert(result.end(), indices.begin() + faceCount * 3ull, indices.end());
+    std::copy(result.begin(), result.end(), indices.begin());
+}
+
+VertexFetchStats MeshOptimizer::analyzeVertexFetch(std::span<const unsigned int> indices, const size_t vertexCount, const size_t vertexSize)
+{
+    VertexFetchStats stats;
+
+    if (indices.empty() || vertexCount == 0ull || vertexSize == 0ull) return stats;
+
+    const size_t lineCount = (vertexCount * vertexSize + FETCH_CACHE_LINE_SIZE - 1ull) / FETCH_CACHE_LINE_SIZE;
+
+    // Same timestamp trick as in FIFO vertex cache simulation
+    std::vector<size_t> timestamps(lineCount, 0ull);
+    size_t timestamp = FETCH_CACHE_LINES + 1ull;
+
+    std::vector<uint8_t> referenced(vertexCount, 0u);
+    size_t uniqueVertices = 0ull;
+
+    for (const unsigned int idx : indices) {
+        // Repeated vertices are expected to hit post-transform cache,
+        // so only the first fetch of every vertex goes to memory
+        if (referenced[idx]) continue;
+
+        referenced[idx] = 1u;
+        ++uniqueVertices;
+
+        const size_t startLine = (idx * vertexSize) / FETCH_CACHE_LINE_SIZE;
+        const size_t endLine = (idx * vertexSize + vertexSize - 1ull) / FETCH_CACHE_LINE_SIZE;
+
+        for (size_t line = startLine; line <= endLine; ++line) {
+            if (timestamp - timestamps[line] > FETCH_CACHE_LINES) {
+                timestamps[line] = timestamp++;
+                stats.bytesFetched += FETCH_CACHE_LINE_SIZE;
+            }
+        }
+    }
+
+    stats.overfetch = (float)stats.bytesFetched / (float)(uniqueVertices * vertexSize);
+
+    return stats;
+}
+
+std::vector<unsigned int> MeshOptimizer::optimizeVertexFetch(std::span<unsigned int> indices, const size_t vertexCount)
+{
+    constexpr unsigned int invalidIndex = ~0u;
+
+    std::vector<unsigned int> remap(vertexCount, invalidIndex);
+    unsigned int next = 0u;
+
+    for (unsigned int& idx : indices) {
+        if (remap[idx] == invalidIndex) {
+            remap[idx] = next++;
+        }
+        idx = remap[idx];
+    }
+
+    for (unsigned int& newIdx : remap) {
+        if (newIdx == invalidIndex) newIdx = next++;
+    }
+
+    return remap;
+}
+
+OverdrawStats MeshOptimizer::analyzeOverdraw(std::span<const unsigned int> indices, std::span<const Vertex> vertices)
+{
+    OverdrawStats stats;
+
+    const size_t faceCount = indices.size() / 3ull;
+    if (faceCount == 0ull || vertices.empty()) return stats;
+
+    constexpr float diagonal = 0.57735027f;
+    const glm::vec3 viewDirections[] = {
+        {  1.f,  0.f,  0.f }, { -1.f,  0.f,  0.f },
+        {  0.f,  1.f,  0.f }, {  0.f, -1.f,  0.f },
+        {  0.f,  0.f,  1.f }, {  0.f,  0.f, -1.f },
+        {  diagonal,  diagonal,  diagonal }, { -diagonal,  diagonal,  diagonal },
+        {  diagonal, -diagonal,  diagonal }, { -diagonal, -diagonal,  diagonal },
+        {  diagonal,  diagonal, -diagonal }, { -diagonal,  diagonal, -diagonal },
+        {  diagonal, -diagonal, -diagonal }, { -diagonal, -diagonal, -diagonal }
+    };
+
+    const int rasterSize = (int)OVERDRAW_RASTER_SIZE;
+    std::vector<float> depthBuffer((size_t)rasterSize * (size_t)rasterSize);
+    std::vector<glm::vec3> projected(vertices.size());
+
+    for (const glm::vec3& dir : viewDirections) {
+        // Screen basis, camera looks along dir
+        const glm::vec3 up = std::fabs(dir.y) > 0.9f ? glm::vec3(1.f, 0.f, 0.f) : glm::vec3(0.f, 1.f, 0.f);
+        const glm::vec3 right = glm::normalize(glm::cross(dir, up));
+        const glm::vec3 screenUp = glm::cross(right, dir);
+
+        glm::vec2 minP = glm::vec2(FLT_MAX);
+        glm::vec2 maxP = glm::vec2(-FLT_MAX);
+        for (size_t i = 0ull; i < vertices.size(); ++i) {
+            const glm::vec3& p = vertices[i].Position;
+            const glm::vec2 screenPos = glm::vec2(glm::dot(p, right), glm::dot(p, screenUp));
+            projected[i] = glm::vec3(screenPos, glm::dot(p, dir));
+            minP = glm::min(minP, screenPos);
+            maxP = glm::max(maxP, screenPos);
+        }
+
+        const float extent = std::max(maxP.x - minP.x, maxP.y - minP.y);
+        const float scale = extent > 0.f ? (float)(rasterSize - 1) / extent : 0.f;
+        for (glm::vec3& p : projected) {
+            p.x = (p.x - minP.x) * scale;
+            p.y = (p.y - minP.y) * scale;
+        }
+
+        std::fill(depthBuffer.begin(), depthBuffer.end(), FLT_MAX);
+
+        for (size_t f = 0ull; f < faceCount; ++f) {
+            const unsigned int ia = indices[f * 3ull];
+            const unsigned int ib = indices[f * 3ull + 1ull];
+            const unsigned int ic = indices[f * 3ull + 2ull];
+
+            // Back-face culling (triangles are counter clockwise with outward normals)
+            const glm::vec3 faceNormal = glm::cross(vertices[ib].Position - vertices[ia].Position, vertices[ic].Position - vertices[ia].Position);
+            if (glm::dot(faceNormal, dir) >= 0.f) continue;
+
+            glm::vec3 v0 = projected[ia];
+            glm::vec3 v1 = projected[ib];
+            glm::vec3 v2 = projected[ic];
+
+            float area = (v1.x - v0.x) * (v2.y - v0.y) - (v2.x - v0.x) * (v1.y - v0.y);
+            if (std::fabs(area) < 1e-8f) continue;
+            if (area < 0.f) {
+                std::swap(v1, v2);
+                area = -area;
+            }
+
+            const int minX = std::max(0, (int)std::floor(std::min({ v0.x, v1.x, v2.x })));
+            const int maxX = std::min(rasterSize - 1, (int)std::ceil(std::max({ v0.x, v1.x, v2.x })));
+            const int minY = std::max(0, (int)std::floor(std::min({ v0.y, v1.y, v2.y })));
+            const int maxY = std::min(rasterSize - 1, (int)std::ceil(std::max({ v0.y, v1.y, v2.y })));
+
+            const float invArea = 1.f / area;
+
+            for (int y = minY; y <= maxY; ++y) {
+                const float py = (float)y + 0.5f;
+                for (int x = minX; x <= maxX; ++x) {
+                    const float px = (float)x + 0.5f;
+
+                    const float w0 = (v2.x - v1.x) * (py - v1.y) - (v2.y - v1.y) * (px - v1.x);
+                    const float w1 = (v0.x - v2.x) * (py - v2.y) - (v0.y - v2.y) * (px - v2.x);
+                    const float w2 = (v1.x - v0.x) * (py - v0.y) - (v1.y - v0.y) * (px - v0.x);
+                    if (w0 < 0.f || w1 < 0.f || w2 < 0.f) continue;
+
+                    const float depth = (w0 * v0.z + w1 * v1.z + w2 * v2.z) * invArea;
+                    float& stored = depthBuffer[(size_t)y * (size_t)rasterSize + (size_t)x];
+                    if (depth < stored) {
+                        if (stored == FLT_MAX) ++stats.pixelsCovered;
+                        stored = depth;
+                        ++stats.pixelsShaded;
+                    }
+                }
+            }
+        }
+    }
+
+    stats.overdraw = stats.pixelsCovered == 0ull ? 0.f : (float)stats.pixelsShaded / (float)stats.pixelsCovered;
+
+    return stats;
+}
+
+void MeshOptimizer::optimizeOverdraw(std::span<unsigned int> indices, std::span<const Vertex> vertices, const float threshold, const unsigned int cacheSize)
+{
+    const size_t faceCount = indices.size() / 3ull;
+    const size_t vertexCount = vertices.size();
+
+    if (faceCount == 0ull || vertexCount == 0ull) return;
+
+    const size_t cache = (size_t)std::max(cacheSize, 3u);
+
+    // FIFO cache simulation with timestamps, returns number of misses of triangle f
+    std::vector<size_t> timestamps(vertexCount, 0ull);
+    size_t timestamp = cache + 1ull;
+    auto triangleMisses = [&](const size_t f) -> unsigned int {
+        unsigned int misses = 0u;
+        for (size_t k = 0ull; k < 3ull; ++k) {
+            const unsigned int idx = indices[f * 3ull + k];
+            if (timestamp - timestamps[idx] > cache) {
+                timestamps[idx] = timestamp++;
+                ++misses;
+            }
+        }
+        return misses;
+    };
+    // Moving timestamp past cache size invalidates all entries
+    auto resetCache = [&]() { timestamp += cache + 1ull; };
+
+    // HARD BOUNDARIES (cache optimizer restarted, all three vertices missed)
+    std::vector<size_t> hardClusters;
+    for (size_t f = 0ull; f < faceCount; ++f) {
+        if (triangleMisses(f) == 3u || f == 0ull) hardClusters.push_back(f);
+    }
+    hardClusters.push_back(faceCount);
+
+    // SOFT BOUNDARIES (split while cluster ACMR stays under threshold)
+    std::vector<size_t> clusters;
+    for (size_t c = 0ull; c + 1ull < hardClusters.size(); ++c) {
+        const size_t start = hardClusters[c];
+        const size_t end = hardClusters[c + 1ull];
+
+        resetCache();
+        size_t hardMisses = 0ull;
+        for (size_t f = start; f < end; ++f) hardMisses += triangleMisses(f);
+
+        const float clusterThreshold = threshold * (float)hardMisses / (float)(end - start);
+
+        resetCache();
+        size_t clusterStart = start;
+        size_t clusterMisses = 0ull;
+        clusters.push_back(start);
+
+        for (size_t f = start; f < end; ++f) {
+            clusterMisses += triangleMisses(f);
+
+            if (f + 1ull < end && (float)clusterMisses / (float)(f - clusterStart + 1ull) <= clusterThreshold) {
+                clusters.push_back(f + 1ull);
+                clusterStart = f + 1ull;
+                clusterMisses = 0ull;
+                resetCache();
+            }
+        }
+    }
+    clusters.push_back(faceCount);
+
+    const size_t clusterCount = clusters.size() - 1ull;
+
+    // CLUSTER SORT KEYS (area weighted centroid and normal)
+    glm::vec3 meshCentroid = glm::vec3(0.f);
+    float meshArea = 0.f;
+
+    std::vector<glm::vec3> clusterCentroids(clusterCount, glm::vec3(0.f));
+    std::vector<glm::vec3> clusterNormals(clusterCount, glm::vec3(0.f));
+    std::vector<float> clusterAreas(clusterCount, 0.f);
+
+    for (size_t c = 0ull; c < clusterCount; ++c) {
+        for (size_t f = clusters[c]; f < clusters[c + 1ull]; ++f) {
+            const glm::vec3& a = vertices[indices[f * 3ull]].Position;
+            const glm::vec3& b = vertices[indices[f * 3ull + 1ull]].Position;
+            const glm::vec3& d = vertices[indices[f * 3ull + 2ull]].Position;
+
+            const glm::vec3 normal = glm::cross(b - a, d - a);
+            const float area = glm::length(normal);
+            const glm::vec3 centroid = (a + b + d) / 3.f;
+
+            clusterCentroids[c] += centroid * area;
+            clusterNormals[c] += normal;
+            clusterAreas[c] += area;
+
+            meshCentroid += centroid * area;
+            meshArea += area;
+        }
+    }
+
+    if (meshArea > 0.f) meshCentroid /= meshArea;
+
+    std::vector<float> sortKeys(clusterCount, 0.f);
+    for (size_t c = 0ull; c < clusterCount; ++c) {
+        const float normalLength = glm::length(clusterNormals[c]);
+        if (clusterAreas[c] <= 0.f || normalLength <= 0.f) continue;
+
+        const glm::vec3 centroid = clusterCentroids[c] / clusterAreas[c];
+        sortKeys[c] = glm::dot(centroid - meshCentroid, clusterNormals[c] / normalLength);
+    }
+
+    // Clusters facing outwards the most go first, they occlude the rest
+    std::vector<size_t> order(clusterCount);
+    for (size_t c = 0ull; c < clusterCount; ++c) order[c] = c;
+    std::stable_sort(order.begin(), order.end(), [&sortKeys](const size_t l, const size_t r) {
+        return sortKeys[l] > sortKeys[r];
+    });
+
+    std::vector<unsigned int> result;
+    result.reserve(indices.size());
+    for (const size_t c : order) {
+        result.insert(result.end(), indices.begin() + clusters[c] * 3ull, indices.begin() + clusters[c + 1ull] * 3ull);
+    }
+
+    // Keep trailing indices that do not form a whole triangle
+    result.insert(result.end(), indices.begin() + faceCount * 3ull, indices.end());
+    std::copy(result.begin(), result.end(), indices.begin());
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#pragma region STD_LIBS
+#include <cstdint>
+#include <span>
+#include <vector>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "Meshlets.hpp"
+#include "Simplifier.hpp"
+#include "Vertex.hpp"
+#pragma endregion
+
+enum class VertexCacheType : uint8_t {
+	FIFO = 0,
+	LRU	 = 1
+};
+
+struct VertexCacheStats
+{
+	// Average cache miss ratio (transformed vertices per triangle, 0.5 - 3.0)
+	float acmr = 0.f;
+	// Average transformed vertex ratio (transformed vertices per unique vertex, 1.0 is optimal)
+	float atvr = 0.f;
+	size_t misses = 0ull;
+};
+
+struct VertexFetchStats
+{
+	// Bytes read from memory through the simulated cache lines
+	size_t bytesFetched = 0ull;
+	// Fetched bytes per byte of referenced vertex data (1.0 is optimal)
+	float overfetch = 0.f;
+};
+
+struct OverdrawStats
+{
+	// Pixels covered by the mesh summed over all view directions
+	size_t pixelsCovered = 0ull;
+	// Pixels that passed depth test (were shaded) summed over all view directions
+	size_t pixelsShaded = 0ull;
+	// Shaded / covered (1.0 is optimal)
+	float overdraw = 0.f;
+};
+
+struct MeshOptimizeOptions
+{
+	bool optimizeVertexCache = false;
+	unsigned int vertexCacheSize = 32u;
+	VertexCacheType vertexCacheType = VertexCacheType::FIFO;
+	bool optimizeVertexFetch = false;
+	bool optimizeOverdraw = false;
+	// Allowed ACMR degradation of triangle clusters (1.05 = 5% worse vertex cache)
+	float overdrawThreshold = 1.05f;
+	bool buildMeshlets = false;
+	uint32_t meshletMaxVertices = MeshletBuilder::DEFAULT_MAX_VERTICES;
+	uint32_t meshletMaxTriangles = MeshletBuilder::DEFAULT_MAX_TRIANGLES;
+	bool generateLods = false;
+	unsigned int lodLevels = Simplifier::DEFAULT_LOD_LEVELS;
+	// Triangle ratio between consecutive LODs
+	float lodReduction = Simplifier::DEFAULT_LOD_REDUCTION;
+};
+
+struct MeshOptimizeReport
+{
+	bool vertexCacheOptimized = false;
+	VertexCacheStats vertexCacheBefore;
+	VertexCacheStats vertexCacheAfter;
+	bool vertexFetchOptimized = false;
+	VertexFetchStats vertexFetchBefore;
+	VertexFetchStats vertexFetchAfter;
+	bool overdrawOptimized = false;
+	OverdrawStats overdrawBefore;
+	OverdrawStats overdrawAfter;
+	bool meshletsBuilt = false;
+	MeshletStats meshlets;
+	bool lodsGenerated = false;
+	std::vector<LodLevel> lods;
+};
+
+class MeshOptimizer
+{
+private:
+	static float _vertexScore(const int cachePosition, const unsigned int liveTriangles, const unsigned int cacheSize);
+
+public:
+	static constexpr unsigned int DEFAULT_CACHE_SIZE = 32u;
+	static constexpr unsigned int MIN_CACHE_SIZE = 4u;
+	static constexpr unsigned int MAX_CACHE_SIZE = 64u;
+
+	static constexpr size_t FETCH_CACHE_LINE_SIZE = 64ull;
+	static constexpr size_t FETCH_CACHE_LINES = 256ull;
+
+	static constexpr float DEFAULT_OVERDRAW_THRESHOLD = 1.05f;
+	static constexpr unsigned int OVERDRAW_RASTER_SIZE = 256u;
+
+	// Simulates post-transform vertex cache of given size and type
+	static VertexCacheStats analyzeVertexCache(std::span<const unsigned int> indices, const size_t vertexCount, const unsigned int cacheSize = DEFAULT_CACHE_SIZE, const VertexCacheType type = VertexCacheType::FIFO);
+
+	// Reorders triangles for post-transform vertex cache reuse (Forsyth - Linear-Speed Vertex Cache Optimisation)
+	// Triangle winding is preserved
+	static void optimizeVertexCache(std::span<unsigned int> indices, const size_t vertexCount, const unsigned int cacheSize = DEFAULT_CACHE_SIZE);
+
+	// Simulates pre-transform vertex fetch through a FIFO cache of FETCH_CACHE_LINES lines
+	static VertexFetchStats analyzeVertexFetch(std::span<const unsigned int> indices, const size_t vertexCount, const size_t vertexSize);
+
+	// Renumbers vertices in order of first use in the index buffer and remaps indices
+	// Returns old -> new vertex index table, unreferenced vertices are moved to the end
+	static std::vector<unsigned int> optimizeVertexFetch(std::span<unsigned int> indices, const size_t vertexCount);
+
+	// Rasterizes the mesh in index order with back-face culling and depth test
+	// from 14 directions (axes and cube diagonals) into OVERDRAW_RASTER_SIZE square buffer
+	static OverdrawStats analyzeOverdraw(std::span<const unsigned int> indices, std::span<const Vertex> vertices);
+
+	// Splits cache optimized index order into triangle clusters and sorts them so that
+	// clusters facing away from the mesh center are drawn first (Sander et al. - Fast Triangle
+	// Reordering for Vertex Locality and Reduced Overdraw), expects vertex cache optimized input
+	static void optimizeOverdraw(std::span<unsigned int> indices, std::span<const Vertex> vertices, const float threshold = DEFAULT_OVERDRAW_THRESHOLD, const unsigned int cacheSize = DEFAULT_CACHE_SIZE);
+};
\ No newline at end of file
@@ -0,0 +1,236 @@
+#pragma region PCH
+#include "pch.hpp"
+#pragma endregion
+
+#pragma region STD_LIBS
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <vector>
+#pragma endregion
+
+#pragma region GLM_LIB
+#include <glm/fwd.hpp>
+#include <glm/geometric.hpp>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "Meshlets.hpp"
+#include "Vertex.hpp"
+#pragma endregion
+
+MeshletBounds MeshletBuilder::_computeBounds(const MeshletData& data, const Meshlet& meshlet, std::span<const Vertex> vertices)
+{
+    MeshletBounds bounds;
+
+    // BOUNDING SPHERE (Ritter)
+    auto position = [&](const uint32_t local) -> const glm::vec3& {
+        return vertices[data.vertices[meshlet.vertexOffset + local]].Position;
+    };
+
+    uint32_t minIdx[3] = { 0u, 0u, 0u };
+    uint32_t maxIdx[3] = { 0u, 0u, 0u };
+    for (uint32_t i = 1u; i < meshlet.vertexCount; ++i) {
+        const glm::vec3& p = position(i);
+        for (int axis = 0; axis < 3; ++axis) {
+            if (p[axis] < position(minIdx[axis])[axis]) minIdx[axis] = i;
+            if (p[axis] > position(maxIdx[axis])[axis]) maxIdx[axis] = i;
+        }
+    }
+
+    // Start with the most distant pair of axis extremes
+    int bestAxis = 0;
+    float bestDist = -1.f;
+    for (int axis = 0; axis < 3; ++axis) {
+        const glm::vec3 d = position(maxIdx[axis]) - position(minIdx[axis]);
+        const float dist = glm::dot(d, d);
+        if (dist > bestDist) {
+            bestDist = dist;
+            bestAxis = axis;
+        }
+    }
+
+    glm::vec3 center = (position(minIdx[bestAxis]) + position(maxIdx[bestAxis])) * 0.5f;
+    float radius = std::sqrt(bestDist) * 0.5f;
+
+    for (uint32_t i = 0u; i < meshlet.vertexCount; ++i) {
+        const glm::vec3& p = position(i);
+        const float dist = glm::length(p - center);
+        if (dist > radius) {
+            const float newRadius = (radius + dist) * 0.5f;
+            center += (p - center) * ((newRadius - radius) / dist);
+            radius = newRadius;
+        }
+    }
+
+    bounds.center = center;
+    bounds.radius = radius;
+
+    // NORMAL CONE
+    std::vector<glm::vec3> normals;
+    std::vector<glm::vec3> corners;
+    normals.reserve(meshlet.triangleCount);
+    corners.reserve(meshlet.triangleCount);
+
+    glm::vec3 axis = glm::vec3(0.f);
+    for (uint32_t t = 0u; t < meshlet.triangleCount; ++t) {
+        uint32_t a, b, c;
+        unpackTriangle(data.triangles[meshlet.triangleOffset + t], a, b, c);
+
+        const glm::vec3 normal = glm::cross(position(b) - position(a), position(c) - position(a));
+        const float area = glm::length(normal);
+
+        // Degenerate triangles do not affect the cone
+        if (area <= 0.f) continue;
+
+        normals.push_back(normal / area);
+        corners.push_back(position(a));
+        axis += normal / area;
+    }
+
+    bounds.coneApex = center;
+    bounds.coneAxis = glm::vec3(0.f, 0.f, 0.f);
+    bounds.coneCutoff = 1.f;
+
+    const float axisLength = glm::length(axis);
+    if (normals.empty() || axisLength <= 0.f) return bounds;
+
+    axis /= axisLength;
+    bounds.coneAxis = axis;
+
+    float minDot = 1.f;
+    for (const glm::vec3& n : normals) {
+        minDot = std::min(minDot, glm::dot(n, axis));
+    }
+
+    // Cone wider than ~84 degrees half angle is useless for culling
+    if (minDot <= 0.1f) return bounds;
+
+    // Apex is moved back along the axis so that every triangle plane is in front of it
+    float maxT = 0.f;
+    for (size_t i = 0ull; i < normals.size(); ++i) {
+        const float dc = glm::dot(center - corners[i], normals[i]);
+        const float dn = glm::dot(axis, normals[i]);
+        maxT = std::max(maxT, dc / dn);
+    }
+
+    bounds.coneApex = center - axis * maxT;
+    bounds.coneCutoff = std::sqrt(1.f - minDot * minDot);
+
+    return bounds;
+}
+
+uint32_t MeshletBuilder::packTriangle(const uint32_t a, const uint32_t b, const uint32_t c)
+{
+    return (a & 0xFFu) | ((b & 0xFFu) << 8u) | ((c & 0xFFu) << 16u);
+}
+
+void MeshletBuilder::unpackTriangle(const uint32_t packed, uint32_t& a, uint32_t& b, uint32_t& c)
+{
+    a = packed & 0xFFu;
+    b = (packed >> 8u) & 0xFFu;
+    c = (packed >> 16u) & 0xFFu;
+}
+
+MeshletData MeshletBuilder::build(std::span<const unsigned int> indices, std::span<const Vertex> vertices, const uint32_t maxVertices, const uint32_t maxTriangles)
+{
+    MeshletData data;
+    data.maxVertices = std::clamp(maxVertices, 3u, MAX_VERTICES);
+    data.maxTriangles = std::clamp(maxTriangles, 1u, MAX_TRIANGLES);
+
+    const size_t faceCount = indices.size() / 3ull;
+    if (faceCount == 0ull || vertices.empty()) return data;
+
+    // Worst case estimate, shrinked at the end
+    const size_t estimatedMeshlets = faceCount / (size_t)data.maxTriangles + 1ull;
+    data.meshlets.reserve(estimatedMeshlets * 2ull);
+    data.vertices.reserve(std::min(faceCount * 3ull, estimatedMeshlets * 2ull * (size_t)data.maxVertices));
+    data.triangles.reserve(faceCount);
+
+    // Local index of every global vertex in the current meshlet (MAX_VERTICES - 1 is still valid, so 16 bits)
+    constexpr uint16_t unusedLocal = 0xFFFFu;
+    std::vector<uint16_t> localIndices(vertices.size(), unusedLocal);
+
+    Meshlet current;
+
+    auto finishMeshlet = [&]() {
+        if (current.triangleCount == 0u) return;
+
+        data.meshlets.push_back(current);
+
+        for (uint32_t i = 0u; i < current.vertexCount; ++i) {
+            localIndices[data.vertices[current.vertexOffset + i]] = unusedLocal;
+        }
+
+        current.vertexOffset = (uint32_t)data.vertices.size();
+        current.triangleOffset = (uint32_t)data.triangles.size();
+        current.vertexCount = 0u;
+        current.triangleCount = 0u;
+    };
+
+    for (size_t f = 0ull; f < faceCount; ++f) {
+        const unsigned int tri[3] = { indices[f * 3ull], indices[f * 3ull + 1ull], indices[f * 3ull + 2ull] };
+
+        uint32_t newVertices = 0u;
+        for (int k = 0; k < 3; ++k) {
+            if (localIndices[tri[k]] == unusedLocal) {
+                // Repeated vertex inside one (degenerate) triangle counts once
+                if (k > 0 && tri[k] == tri[0]) continue;
+                if (k > 1 && tri[k] == tri[1]) continue;
+                ++newVertices;
+            }
+        }
+
+        if (current.vertexCount + newVertices > data.maxVertices || current.triangleCount + 1u > data.maxTriangles) {
+            finishMeshlet();
+        }
+
+        uint32_t local[3];
+        for (int k = 0; k < 3; ++k) {
+            uint16_t& localIdx = localIndices[tri[k]];
+            if (localIdx == unusedLocal) {
+                localIdx = (uint16_t)current.vertexCount++;
+                data.vertices.push_back(tri[k]);
+            }
+            local[k] = localIdx;
+        }
+
+        data.triangles.push_back(packTriangle(local[0], local[1], local[2]));
+        ++current.triangleCount;
+    }
+
+    finishMeshlet();
+
+    data.meshlets.shrink_to_fit();
+    data.bounds.resize(data.meshlets.size());
+    for (size_t m = 0ull; m < data.meshlets.size(); ++m) {
+        data.bounds[m] = _computeBounds(data, data.meshlets[m], vertices);
+    }
+
+    return data;
+}
+
+MeshletStats MeshletBuilder::analyze(const MeshletData& data)
+{
+    MeshletStats stats;
+    stats.meshletCount = data.meshlets.size();
+
+    if (stats.meshletCount == 0ull) return stats;
+
+    size_t vertexCount = 0ull;
+    size_t triangleCount = 0ull;
+    for (const Meshlet& m : data.meshlets) {
+        vertexCount += m.vertexCount;
+        triangleCount += m.triangleCount;
+    }
+
+    for (const MeshletBounds& b : data.bounds) {
+        if (b.coneCutoff < 1.f) ++stats.coneCullable;
+    }
+
+    stats.avgVertices = (float)vertexCount / (float)stats.meshletCount;
+    stats.avgTriangles = (float)triangleCount / (float)stats.meshletCount;
+
+    return stats;
+}
\ No newline at end of file
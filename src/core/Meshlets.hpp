@@ -0,0 +1,84 @@
+#pragma once
+
+#pragma region STD_LIBS
+#include <cstdint>
+#include <span>
+#include <vector>
+#pragma endregion
+
+#pragma region GLM_LIB
+#include <glm/fwd.hpp>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "Vertex.hpp"
+#pragma endregion
+
+struct Meshlet
+{
+	// Offsets into MeshletData::vertices and MeshletData::triangles
+	uint32_t vertexOffset = 0u;
+	uint32_t triangleOffset = 0u;
+	uint32_t vertexCount = 0u;
+	uint32_t triangleCount = 0u;
+};
+
+struct MeshletBounds
+{
+	// Bounding sphere
+	glm::vec3 center;
+	float radius = 0.f;
+
+	// Normal cone, meshlet is back-facing if dot(normalize(coneApex - cameraPosition), coneAxis) >= coneCutoff
+	// coneCutoff == 1 means that cone culling can't be used
+	glm::vec3 coneApex;
+	glm::vec3 coneAxis;
+	float coneCutoff = 1.f;
+};
+
+struct MeshletData
+{
+	std::vector<Meshlet> meshlets;
+	std::vector<MeshletBounds> bounds;
+	// Local -> global vertex index for every meshlet
+	std::vector<uint32_t> vertices;
+	// Micro-index triangles packed as i0 | i1 << 8 | i2 << 16 (indices into meshlet local vertices)
+	std::vector<uint32_t> triangles;
+
+	uint32_t maxVertices = 0u;
+	uint32_t maxTriangles = 0u;
+
+	bool empty() const { return meshlets.empty(); }
+};
+
+struct MeshletStats
+{
+	size_t meshletCount = 0ull;
+	// Average fill of meshlets
+	float avgVertices = 0.f;
+	float avgTriangles = 0.f;
+	// Meshlets with usable normal cone
+	size_t coneCullable = 0ull;
+};
+
+class MeshletBuilder
+{
+private:
+	static MeshletBounds _computeBounds(const MeshletData& data, const Meshlet& meshlet, std::span<const Vertex> vertices);
+
+public:
+	static constexpr uint32_t DEFAULT_MAX_VERTICES = 64u;
+	static constexpr uint32_t DEFAULT_MAX_TRIANGLES = 124u;
+	// Local indices are stored in 8 bits
+	static constexpr uint32_t MAX_VERTICES = 256u;
+	static constexpr uint32_t MAX_TRIANGLES = 512u;
+
+	static uint32_t packTriangle(const uint32_t a, const uint32_t b, const uint32_t c);
+	static void unpackTriangle(const uint32_t packed, uint32_t& a, uint32_t& b, uint32_t& c);
+
+	// Greedily fills meshlets with triangles in index order, so index buffer should be vertex cache optimized first
+	// Linear in triangle count, limits are clamped to 3 - MAX_VERTICES and 1 - MAX_TRIANGLES
+	static MeshletData build(std::span<const unsigned int> indices, std::span<const Vertex> vertices, const uint32_t maxVertices = DEFAULT_MAX_VERTICES, const uint32_t maxTriangles = DEFAULT_MAX_TRIANGLES);
+
+	static MeshletStats analyze(const MeshletData& data);
+};
\ No newline at end of file
@@ -4,10 +4,11 @@
 
 #pragma region STD_LIBS
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <functional>
 #include <string>
 #include <utility>
-#include <vector>
 #pragma endregion
 
 #pragma region GLM_LIB
@@ -15,11 +16,53 @@
 #pragma endregion
 
 #pragma region MY_FILES
+#include "BitMathOperators.hpp"
+#include "GenerationStats.hpp"
 #include "Plane.hpp"
+#include "ProgressToken.hpp"
 #include "Shape.hpp"
+#include "ThreadPool.hpp"
+#include "Vertex.hpp"
 #pragma endregion
 
 void Plane::_generate(const unsigned int rows, const unsigned int columns, const PlaneNormalDir dir, const ValuesRange range)
+{
+    _generateRows(rows, columns, 0u, rows, dir, range);
+}
+
+// Triangles around vertex of rows x columns grid, quads above it give it 1 + 2 of them and quads below 2 + 1
+static unsigned int getTrianglesCount(const unsigned int row, const unsigned int col, const unsigned int rows, const unsigned int columns)
+{
+    const unsigned int left = col > 0u ? 1u : 0u;
+    const unsigned int right = col + 1u < columns ? 1u : 0u;
+    const unsigned int above = row > 0u ? left + 2u * right : 0u;
+    const unsigned int below = row + 1u < rows ? 2u * left + right : 0u;
+    return above + below;
+}
+
+bool Plane::_forEachRow(const char* phase, const unsigned int rowBegin, const unsigned int rowEnd, const unsigned int columns, const std::function<void(unsigned int)>& body)
+{
+    const size_t total = rowEnd - rowBegin;
+    if (_reportProgress(phase, 0ull, total)) return true;
+
+    // Every row is independent, bands started after cancel are skipped
+    std::atomic<size_t> done = 0ull;
+    ProgressToken* progress = _shapeConfig.progress;
+    const size_t grainRows = std::max<size_t>(1ull, ThreadPool::DEFAULT_GRAIN_SIZE / columns);
+    ThreadPool::get().parallelFor(rowBegin, rowEnd, grainRows, [&body, &done, progress, phase, total](size_t bandBegin, size_t bandEnd) {
+        if (progress != nullptr && progress->isCancelled()) return;
+
+        for (size_t row = bandBegin; row < bandEnd; ++row) {
+            body((unsigned int)row);
+        }
+        if (progress != nullptr) progress->report(phase, done += bandEnd - bandBegin, total);
+    });
+
+    // Vertices are freed on this thread, after all bands are finished
+    return _reportProgress(phase, total, total);
+}
+
+void Plane::_generateRows(const unsigned int rows, const unsigned int columns, const unsigned int rowBegin, const unsigned int rowEnd, const PlaneNormalDir dir, const ValuesRange range)
 {
     const float space = range == ValuesRange::HALF_TO_HALF ? 1.f : 2.f;
     const float minRange = -space * .5f;
@@ -28,104 +71,123 @@ void Plane::_generate(const unsigned int rows, const unsigned int columns, const
     const float diffX = space / (float)(columns - 1u);
     const float diffZ = space / (float)(rows - 1u);
 
-    std::vector<unsigned int> trisNum;
+    const bool isFront = dir == PlaneNormalDir::FRONT;
+    const glm::vec3 normal = isFront ? glm::vec3(0.f, 0.f, -1.f) : glm::vec3(0.f, 1.f, 0.f);
+
+    // Buffers are sized up front, so bands of rows write their own ranges
+    const unsigned int quadRowEnd = rowEnd > rowBegin ? rowEnd - 1u : rowBegin;
+    if (_reportProgress("vertex generation", 0ull, rowEnd - rowBegin)) return;
+    _vertices.resize((size_t)(rowEnd - rowBegin) * columns);
+    _indices.resize(6ull * (size_t)(quadRowEnd - rowBegin) * (columns - 1u));
 
-    for (unsigned int row = 0u; row < rows; ++row) {
+    PhaseTimer vertexTimer(&_generationStats, "vertex generation");
+    const bool vertexCancelled = _forEachRow("vertex generation", rowBegin, rowEnd, columns, [&](const unsigned int row) {
         const float z = minRange + (float)row * diffZ;
+        const float texY = _map(z, minRange, maxRange, 0.f, 1.f);
 
+        Vertex* out = _vertices.data() + (size_t)(row - rowBegin) * columns;
         for (unsigned int col = 0u; col < columns; ++col) {
             const float x = minRange + (float)col * diffX;
+            out[col] = { isFront ? glm::vec3(x, z, 0.f) : glm::vec3(x, 0.f, z), { _map(x, minRange, maxRange, 0.f, 1.f), texY }, normal, glm::vec3(0.f), glm::vec3(0.f) };
+        }
+    });
+    vertexTimer.stop();
+    if (vertexCancelled) return;
+
+    PhaseTimer indexTimer(&_generationStats, "index generation");
+    const bool indexCancelled = _forEachRow("index generation", rowBegin, quadRowEnd, columns, [&](const unsigned int row) {
+        const unsigned int rowStart = (row - rowBegin) * columns;
+
+        unsigned int* out = _indices.data() + 6ull * (size_t)(row - rowBegin) * (columns - 1u);
+        for (unsigned int col = 0u; col + 1u < columns; ++col) {
+            const unsigned int i = rowStart + col;
+            const unsigned int first = i + columns;
+
+            // First Triangle
+            out[0] = first;
+            out[1] = i + 1u;
+            out[2] = i;
+
+            // Second Triangle
+            out[3] = first;
+            out[4] = first + 1u;
+            out[5] = i + 1u;
+            out += 6;
+        }
+    });
+    indexTimer.stop();
+    if (indexCancelled || !_shapeConfig.genTangents) return;
 
-            switch (dir) {
-                case PlaneNormalDir::UP : {
-                    _vertices.push_back({ { x, 0.f, z }, { _map(x, minRange, maxRange, 0.f, 1.f), _map(z, minRange, maxRange, 0.f, 1.f) }, { 0.f, 1.f, 0.f }, glm::vec3(0.f), glm::vec3(0.f) });
-                    break;
-                }
-                case PlaneNormalDir::FRONT : {
-                    _vertices.push_back({ { x, z, 0.f }, { _map(x, minRange, maxRange, 0.f, 1.f), _map(z, minRange, maxRange, 0.f, 1.f) }, { 0.f, 0.f, -1.f }, glm::vec3(0.f), glm::vec3(0.f) });
-                    break;
-                }
-                default : {
-                    _vertices.push_back({ { x, 0.f, z }, { _map(x, minRange, maxRange, 0.f, 1.f), _map(z, minRange, maxRange, 0.f, 1.f) }, { 0.f, 1.f, 0.f }, glm::vec3(0.f), glm::vec3(0.f) });
-                    break;
-                }
-            }
+    // Every vertex sums tangents of its own triangles in the order of _indices, so sums are the same as of _accumulateTangents
+    PhaseTimer accumulationTimer(&_generationStats, "tangent accumulation");
+    const bool accumulationCancelled = _forEachRow("tangent accumulation", rowBegin, rowEnd, columns, [&](const unsigned int row) {
+        const unsigned int rowStart = (row - rowBegin) * columns;
+        const bool hasAbove = row > rowBegin;
+        const bool hasBelow = row + 1u < rowEnd;
 
-            if (_shapeConfig.genTangents) {
-                if (row * columns + col == 0u || row * columns + col == rows * columns - 1u) {
-                    trisNum.push_back(1u);
-                }
-                else if ((row == 0u && col + 1u == columns) || (row + 1u == rows && col == 0u)) {
-                    trisNum.push_back(2u);
-                }
-                else if (row == 0u || row + 1u == rows || col == 0u || col + 1u == columns) {
-                    trisNum.push_back(3u);
+        for (unsigned int col = 0u; col < columns; ++col) {
+            const unsigned int v = rowStart + col;
+            const bool hasLeft = col > 0u;
+            const bool hasRight = col + 1u < columns;
+
+            glm::vec3 tangent(0.f);
+            if (hasAbove) {
+                const unsigned int up = v - columns;
+                if (hasLeft) tangent += _calcTangent(v - 1u, v, up);
+                if (hasRight) {
+                    tangent += _calcTangent(v, up + 1u, up);
+                    tangent += _calcTangent(v, v + 1u, up + 1u);
                 }
-                else {
-                    trisNum.push_back(6u);
+            }
+            if (hasBelow) {
+                const unsigned int down = v + columns;
+                if (hasLeft) {
+                    tangent += _calcTangent(down - 1u, v, v - 1u);
+                    tangent += _calcTangent(down - 1u, down, v);
                 }
+                if (hasRight) tangent += _calcTangent(down, v + 1u, v);
             }
+            _vertices[v].Tangent = tangent;
         }
-    }
-
-    const size_t vertSize = _vertices.size();
-    glm::vec3 tangent;
-    for (size_t i = 0ull; i < vertSize; ++i) {
+    });
+    accumulationTimer.stop();
+    if (accumulationCancelled) return;
 
-        const size_t first = i + (size_t)columns;
-        size_t second = i + 1ull;
-
-        if (second % (size_t)columns == 0ull) continue;
-
-        if (first >= vertSize) break;
-
-        // First Triangle
-        size_t third = i;
-
-        _indices.push_back((unsigned int)first);
-        _indices.push_back((unsigned int)second);
-        _indices.push_back((unsigned int)third);
-
-        if (_shapeConfig.genTangents) {
-            tangent = _calcTangent((unsigned int)first, (unsigned int)second, (unsigned int)third);
-
-            _vertices[first].Tangent += tangent;
-            _vertices[second].Tangent += tangent;
-            _vertices[third].Tangent += tangent;
-        }
-
-        // Second Triangle
-        third = second;
-        second = first + 1ull;
-
-        _indices.push_back((unsigned int)first);
-        _indices.push_back((unsigned int)second);
-        _indices.push_back((unsigned int)third);
-
-        if (_shapeConfig.genTangents) {
-            tangent = _calcTangent((unsigned int)first, (unsigned int)second, (unsigned int)third);
-
-            _vertices[first].Tangent += tangent;
-            _vertices[second].Tangent += tangent;
-            _vertices[third].Tangent += tangent;
+    PhaseTimer normalisationTimer(&_generationStats, "tangent normalisation");
+    _forEachRow("tangent normalisation", rowBegin, rowEnd, columns, [&](const unsigned int row) {
+        const unsigned int rowStart = (row - rowBegin) * columns;
+        for (unsigned int col = 0u; col < columns; ++col) {
+            _normalizeTangentAndGenerateBitangent(rowStart + col, getTrianglesCount(row, col, rows, columns));
         }
-    }
-
-    if (_shapeConfig.genTangents) _normalizeTangentsAndGenerateBitangents(trisNum, 0ull, vertSize);
-
-    trisNum.clear();
+    });
 }
 
 Plane::Plane(const ShapeConfig& config, const unsigned int rows, const unsigned int columns, const PlaneNormalDir dir, const ValuesRange range)
+    : Shape(config)
 {
-    _shapeConfig = config;
     _vertices.clear();
     _indices.clear();
+    if (!_checkIndexType(getMeshCounts(rows, columns, dir, range))) return;
     _generate(std::max(2u, rows), std::max(2u, columns), dir, range);
 }
 
+Plane::Plane(const ShapeConfig& config, const unsigned int rows, const unsigned int columns, const unsigned int rowBegin, const unsigned int rowEnd, const PlaneNormalDir dir, const ValuesRange range)
+    : Shape(config)
+{
+    _vertices.clear();
+    _indices.clear();
+    _generateRows(rows, columns, rowBegin, rowEnd, dir, range);
+}
+
 Plane::~Plane() {}
 
+MeshCounts Plane::getMeshCounts(const unsigned int rows, const unsigned int columns, const PlaneNormalDir, const ValuesRange)
+{
+    const size_t r = std::max(2u, rows);
+    const size_t c = std::max(2u, columns);
+    return { r * c, mul_sat<size_t>(6ull * (r - 1ull), c - 1ull) };
+}
+
 std::string Plane::getClassName()
 {
     return "Plane";
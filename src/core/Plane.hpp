@@ -2,6 +2,7 @@
 
 #pragma region STD_LIBS
 #include <cstdint>
+#include <functional>
 #include <string>
 #pragma endregion
 
@@ -17,11 +18,23 @@ enum class PlaneNormalDir : uint8_t {
 class Plane : public Shape {
 private:
 	void _generate(const unsigned int rows, const unsigned int columns, const PlaneNormalDir dir, const ValuesRange range);
+	// Rows [rowBegin, rowEnd) of rows x columns grid with the same vertices as the whole grid has there.
+	// Tangents of first and last row are complete only when rows around them are generated too, indices are local to rowBegin
+	void _generateRows(const unsigned int rows, const unsigned int columns, const unsigned int rowBegin, const unsigned int rowEnd, const PlaneNormalDir dir, const ValuesRange range);
+	// Runs body for every row of [rowBegin, rowEnd) in parallel bands, returns true when generation was cancelled
+	bool _forEachRow(const char* phase, const unsigned int rowBegin, const unsigned int rowEnd, const unsigned int columns, const std::function<void(unsigned int)>& body);
+
+	// Part of the grid for tiled generation, rows and columns have to be clamped already
+	Plane(const ShapeConfig& config, const unsigned int rows, const unsigned int columns, const unsigned int rowBegin, const unsigned int rowEnd, const PlaneNormalDir dir, const ValuesRange range);
+
+	friend class TiledPlane;
 
 public:
 	Plane(const ShapeConfig& config, const unsigned int rows = 2u, const unsigned int columns = 2u, const PlaneNormalDir dir = PlaneNormalDir::UP, const ValuesRange range = ValuesRange::HALF_TO_HALF);
 	virtual ~Plane();
 
+	// Same parameters (and clamping) as constructor
+	static MeshCounts getMeshCounts(const unsigned int rows = 2u, const unsigned int columns = 2u, const PlaneNormalDir dir = PlaneNormalDir::UP, const ValuesRange range = ValuesRange::HALF_TO_HALF);
 	static std::string getClassName();
 	std::string getObjectClassName() const override;
 };
\ No newline at end of file
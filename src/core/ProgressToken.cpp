@@ -0,0 +1,47 @@
+#pragma region PCH
+#include "pch.hpp"
+#pragma endregion
+
+#pragma region STD_LIBS
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "ProgressToken.hpp"
+#pragma endregion
+
+void ProgressToken::cancel()
+{
+    _cancelled.store(true, std::memory_order_relaxed);
+}
+
+bool ProgressToken::isCancelled() const
+{
+    return _cancelled.load(std::memory_order_relaxed);
+}
+
+void ProgressToken::reset()
+{
+    _cancelled.store(false, std::memory_order_relaxed);
+    _phase.store("", std::memory_order_relaxed);
+    _progress.store(0.f, std::memory_order_relaxed);
+}
+
+bool ProgressToken::report(const char* phase, const size_t done, const size_t total)
+{
+    _phase.store(phase, std::memory_order_relaxed);
+    _progress.store(total > 0ull ? std::min(1.f, (float)done / (float)total) : 1.f, std::memory_order_relaxed);
+    return isCancelled();
+}
+
+const char* ProgressToken::getPhase() const
+{
+    return _phase.load(std::memory_order_relaxed);
+}
+
+float ProgressToken::getProgress() const
+{
+    return _progress.load(std::memory_order_relaxed);
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+
+#pragma region STD_LIBS
+#include <atomic>
+#include <cstddef>
+#pragma endregion
+
+// Progress of one generation or export shared with the thread showing it. Task reports done steps of its
+// current phase and stops at the next report after cancel() (shapes free their vertices and indices)
+class ProgressToken
+{
+public:
+	ProgressToken() = default;
+
+	ProgressToken(const ProgressToken&) = delete;
+	ProgressToken& operator=(const ProgressToken&) = delete;
+
+	void cancel();
+	bool isCancelled() const;
+	// Clears cancel request and progress before the next task
+	void reset();
+
+	// phase - string literal shown with progress. Returns true when task should stop
+	bool report(const char* phase, const size_t done, const size_t total);
+	const char* getPhase() const;
+	// Done fraction of current phase, 0 - 1
+	float getProgress() const;
+
+private:
+	std::atomic<bool> _cancelled = false;
+	std::atomic<const char*> _phase = "";
+	std::atomic<float> _progress = 0.f;
+};
\ No newline at end of file
@@ -5,6 +5,7 @@
 #pragma region STD_LIBS
 #include <cmath>
 #include <cstdint>
+#include <memory_resource>
 #include <string>
 #include <utility>
 #include <vector>
@@ -18,6 +19,8 @@
 #pragma region MY_FILES
 #include "BitMathOperators.hpp"
 #include "Constants.hpp"
+#include "GenerationArena.hpp"
+#include "GenerationStats.hpp"
 #include "Pyramid.hpp"
 #include "Shape.hpp"
 #pragma endregion
@@ -29,9 +32,12 @@ void Pyramid::_generate(const ValuesRange range)
 	const float sqrt_2 = (float)M_SQRT2 * mult;
 	const float h = sqrt_2 * 0.5f;
 
-	std::vector<unsigned int> trisNum;
+	// Temporaries of this generation
+	GenerationArena arena;
+	std::pmr::vector<unsigned int> trisNum(arena.resource());
 
 	// SQUARE BOTTOM
+	PhaseTimer vertexTimer(&_generationStats, "vertex generation");
 	for (unsigned int i = 0u; i < 4u; ++i) {
 		float x = (-.5f + (float)(mod_2(i))) * mult;
 		float z = (.5f - (float)(div_2(i))) * mult;
@@ -46,8 +52,9 @@ void Pyramid::_generate(const ValuesRange range)
 			}
 		}
 	}
+	vertexTimer.stop();
 
-	glm::vec3 tangent;
+	PhaseTimer indexTimer(&_generationStats, "index generation");
 	for (unsigned int i = 0u; i < 2u; ++i) {
 		const unsigned int f = i;
 		const unsigned int s = 2u;
@@ -56,17 +63,11 @@ void Pyramid::_generate(const ValuesRange range)
 		_indices.push_back(f);
 		_indices.push_back(s);
 		_indices.push_back(t);
-
-		if (_shapeConfig.genTangents) {
-			tangent = _calcTangent(f, s, t);
-
-			_vertices[(size_t)f].Tangent += tangent;
-			_vertices[(size_t)s].Tangent += tangent;
-			_vertices[(size_t)t].Tangent += tangent;
-		}
 	}
+	indexTimer.stop();
 
 	// TOP TRIANGLES
+	PhaseTimer topVertexTimer(&_generationStats, "vertex generation");
 	const size_t start = _vertices.size();
 	const float cos_cone = sqrt_2 / sqrtf(sqrt_2 * sqrt_2 + h * h);
 	const float sin_cone = h / sqrtf(sqrt_2 * sqrt_2 + h * h);
@@ -99,7 +100,9 @@ void Pyramid::_generate(const ValuesRange range)
 		x += cos_angle;
 		z += sin_angle_pi;
 	}
+	topVertexTimer.stop();
 
+	PhaseTimer topIndexTimer(&_generationStats, "index generation");
 	for (size_t i = 0ull; i < 4ull; ++i) {
 		const size_t left = start + i * 3ull;
 		const size_t right = start + i * 3ull + 1ull;
@@ -108,24 +111,20 @@ void Pyramid::_generate(const ValuesRange range)
 		_indices.push_back((unsigned int)left);
 		_indices.push_back((unsigned int)right);
 		_indices.push_back((unsigned int)top);
-
-		if (_shapeConfig.genTangents) {
-			tangent = _calcTangent((unsigned int)left, (unsigned int)right, (unsigned int)top);
-
-			_vertices[left].Tangent += tangent;
-			_vertices[right].Tangent += tangent;
-			_vertices[top].Tangent += tangent;
-		}
 	}
+	topIndexTimer.stop();
 
-	if (_shapeConfig.genTangents) _normalizeTangentsAndGenerateBitangents(trisNum, 0ull, _vertices.size());
+	if (_shapeConfig.genTangents) {
+		_accumulateTangents(0ull, _indices.size());
+		_normalizeTangentsAndGenerateBitangents(trisNum, 0ull, _vertices.size());
+	}
 
 	trisNum.clear();
 }
 
 Pyramid::Pyramid(const ShapeConfig& config, const ValuesRange range)
+	: Shape(config)
 {
-	_shapeConfig = config;
 	_vertices.clear();
 	_indices.clear();
 	_generate(range);
@@ -133,6 +132,11 @@ Pyramid::Pyramid(const ShapeConfig& config, const ValuesRange range)
 
 Pyramid::~Pyramid() {}
 
+MeshCounts Pyramid::getMeshCounts(const ValuesRange)
+{
+	return { 16ull, 18ull };
+}
+
 std::string Pyramid::getClassName()
 {
 	return "Pyramid";
@@ -0,0 +1,186 @@
+#pragma region PCH
+#include "pch.hpp"
+#pragma endregion
+
+#pragma region STD_LIBS
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <string>
+#pragma endregion
+
+#pragma region FMT_LIB
+#include <fmt/format.h>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "ExportPipeline.hpp"
+#include "ResourceEstimate.hpp"
+#include "Shape.hpp"
+#include "Vertex.hpp"
+#pragma endregion
+
+// Generated header, struct definitions and array declarations of text formats
+static constexpr size_t TEXT_HEADER_BYTES = 1024ull;
+// "-0.123456f, " - six decimals with redundant zeros removed, so most values are shorter
+static constexpr size_t TEXT_FLOAT_BYTES = 12ull;
+// Tabs, braces and new line around one vertex
+static constexpr size_t TEXT_VERTEX_BYTES = 24ull;
+// nlohmann prints floats stored as double with full precision, one per line with indentation
+static constexpr size_t JSON_FLOAT_BYTES = 28ull;
+// Attribute keys, brackets and indentation of one vertex object
+static constexpr size_t JSON_VERTEX_BYTES = 160ull;
+// json value of every float and std::map nodes of every vertex object
+static constexpr size_t JSON_DOM_FLOAT_BYTES = 16ull;
+static constexpr size_t JSON_DOM_VERTEX_BYTES = 640ull;
+// "v", "vn" and "vt" lines of one vertex before deduplication
+static constexpr size_t OBJ_VERTEX_BYTES = 96ull;
+// Dedup maps of position, normal and texture coordinate and index remap of one vertex
+static constexpr size_t OBJ_DEDUP_VERTEX_BYTES = 256ull;
+// Adjacency of stripifier per index
+static constexpr size_t STRIP_BUILD_INDEX_BYTES = 16ull;
+// "SGMB" header and one chunk header
+static constexpr size_t BINARY_HEADER_BYTES = 16ull;
+static constexpr size_t BINARY_CHUNK_BYTES = 16ull;
+// Temporary copy of vertices (flat shading), triangles per vertex, subdivided indices and middle point cache
+static constexpr size_t GENERATION_VERTEX_BYTES = sizeof(Vertex) + sizeof(unsigned int) + 64ull;
+
+static size_t countDigits(size_t value)
+{
+    size_t digits = 1ull;
+    while (value >= 10ull) {
+        value /= 10ull;
+        ++digits;
+    }
+    return digits;
+}
+
+ResourceEstimate ResourceEstimator::estimateGeneration(const MeshCounts& counts)
+{
+    ResourceEstimate estimate;
+    estimate.counts = counts;
+    estimate.meshBytes = counts.vertices * sizeof(Vertex) + counts.indices * sizeof(unsigned int);
+    estimate.peakBytes = estimate.meshBytes + counts.vertices * GENERATION_VERTEX_BYTES + counts.indices * sizeof(unsigned int);
+    return estimate;
+}
+
+ExportEstimate ResourceEstimator::estimateExport(const MeshCounts& counts, FormatType format, const ShapeConfig& config)
+{
+    const size_t stride = Shape::getVertexStride(config);
+    const size_t floats = stride / sizeof(float);
+    const size_t meshBytes = counts.vertices * sizeof(Vertex) + counts.indices * sizeof(unsigned int);
+
+    // Strips are not known before stripifying, worst case is every triangle in its own strip followed by restart index
+    const size_t stripIndices = counts.indices + counts.indices / 3ull;
+    const size_t indexDigits = Shape::isStripFormat(format) ? countDigits(Stripifier::RESTART_INDEX) : countDigits(counts.vertices);
+
+    const size_t textVertex = floats * TEXT_FLOAT_BYTES + TEXT_VERTEX_BYTES;
+    const size_t jsonVertex = floats * JSON_FLOAT_BYTES + JSON_VERTEX_BYTES;
+    const size_t jsonDomVertex = floats * JSON_DOM_FLOAT_BYTES + JSON_DOM_VERTEX_BYTES;
+
+    ExportEstimate estimate;
+    // Temporaries besides the text, which is built in pieces and joined (so it is held twice)
+    size_t temporaries = 0ull;
+    // File bytes of one vertex and one index of streamable formats, their chunks hold SAVE_CHUNK_VERTICES and SAVE_CHUNK_INDICES of them
+    size_t vertexBytes = 0ull;
+    size_t indexBytes = 0ull;
+
+    switch (format) {
+        case FormatType::CPP_ARRAY_INDICES_STRUCT:
+        case FormatType::C_ARRAY_INDICES_STRUCT:
+        case FormatType::CPP_ARRAY_INDICES_FLOAT:
+        case FormatType::C_ARRAY_INDICES_FLOAT: {
+            vertexBytes = textVertex;
+            indexBytes = indexDigits + 3ull;
+            estimate.fileBytes = TEXT_HEADER_BYTES + counts.vertices * vertexBytes + counts.indices * indexBytes;
+            break;
+        }
+        case FormatType::CPP_ARRAY_VERTICES_STRUCT:
+        case FormatType::C_ARRAY_VERTICES_STRUCT:
+        case FormatType::CPP_ARRAY_VERTICES_FLOAT:
+        case FormatType::C_ARRAY_VERTICES_FLOAT: {
+            vertexBytes = textVertex;
+            estimate.fileBytes = TEXT_HEADER_BYTES + counts.indices * vertexBytes;
+            break;
+        }
+        case FormatType::CPP_ARRAY_STRIP_STRUCT:
+        case FormatType::C_ARRAY_STRIP_STRUCT:
+        case FormatType::CPP_ARRAY_STRIP_FLOAT:
+        case FormatType::C_ARRAY_STRIP_FLOAT: {
+            vertexBytes = textVertex;
+            indexBytes = indexDigits + 2ull;
+            estimate.fileBytes = TEXT_HEADER_BYTES + counts.vertices * vertexBytes + stripIndices * indexBytes;
+            temporaries = stripIndices * sizeof(unsigned int) + counts.indices * STRIP_BUILD_INDEX_BYTES;
+            break;
+        }
+        case FormatType::JSON_INDICES: {
+            estimate.fileBytes = counts.vertices * jsonVertex + counts.indices * (indexDigits + 6ull);
+            temporaries = counts.vertices * jsonDomVertex + counts.indices * JSON_DOM_FLOAT_BYTES;
+            break;
+        }
+        case FormatType::JSON_VERTICES: {
+            estimate.fileBytes = counts.indices * jsonVertex;
+            temporaries = counts.indices * (sizeof(Vertex) + jsonDomVertex);
+            break;
+        }
+        case FormatType::JSON_STRIP: {
+            estimate.fileBytes = counts.vertices * jsonVertex + stripIndices * (indexDigits + 6ull);
+            temporaries = counts.vertices * jsonDomVertex + stripIndices * (sizeof(unsigned int) + JSON_DOM_FLOAT_BYTES) + counts.indices * STRIP_BUILD_INDEX_BYTES;
+            break;
+        }
+        case FormatType::OBJ: {
+            // Every face corner is "v/vt/vn"
+            estimate.fileBytes = TEXT_HEADER_BYTES + counts.vertices * OBJ_VERTEX_BYTES + counts.indices * (3ull * indexDigits + 3ull);
+            temporaries = counts.vertices * OBJ_DEDUP_VERTEX_BYTES + counts.indices * 3ull * sizeof(unsigned int);
+            break;
+        }
+        case FormatType::BINARY: {
+            vertexBytes = stride;
+            indexBytes = sizeof(unsigned int);
+            estimate.fileBytes = BINARY_HEADER_BYTES + 2ull * BINARY_CHUNK_BYTES + counts.vertices * vertexBytes + counts.indices * indexBytes;
+            break;
+        }
+        case FormatType::BINARY_STRIP: {
+            vertexBytes = stride;
+            indexBytes = sizeof(unsigned int);
+            estimate.fileBytes = BINARY_HEADER_BYTES + 2ull * BINARY_CHUNK_BYTES + counts.vertices * vertexBytes + stripIndices * indexBytes;
+            temporaries = stripIndices * sizeof(unsigned int) + counts.indices * STRIP_BUILD_INDEX_BYTES;
+            break;
+        }
+    }
+
+    // Shape::save formats streamable formats chunk by chunk, only chunks in flight are held besides the mesh (and strip)
+    if (Shape::isStreamable(format)) {
+        const size_t chunkBytes = std::max(Shape::SAVE_CHUNK_VERTICES * vertexBytes, Shape::SAVE_CHUNK_INDICES * indexBytes);
+        estimate.peakBytes = meshBytes + std::min(ExportPipeline::getChunksInFlight() * chunkBytes, estimate.fileBytes) + temporaries;
+        return estimate;
+    }
+
+    estimate.peakBytes = meshBytes + 2ull * estimate.fileBytes + temporaries;
+    return estimate;
+}
+
+size_t ResourceEstimator::estimatePeak(const MeshCounts& counts, FormatType format, const ShapeConfig& config)
+{
+    return std::max(estimateGeneration(counts).peakBytes, estimateExport(counts, format, config).peakBytes);
+}
+
+bool ResourceEstimator::fitsBudget(const size_t bytes, const unsigned int budgetMB)
+{
+    return budgetMB == 0u || bytes <= (size_t)budgetMB * BYTES_IN_MB;
+}
+
+std::string ResourceEstimator::formatBytes(const size_t bytes)
+{
+    static const char* units[] = { "B", "KB", "MB", "GB", "TB" };
+
+    double value = (double)bytes;
+    size_t unit = 0ull;
+    while (value >= 1024.0 && unit + 1ull < std::size(units)) {
+        value /= 1024.0;
+        ++unit;
+    }
+
+    if (unit == 0ull) return fmt::format("{} {}", bytes, units[unit]);
+    return fmt::format("{:.1f} {}", value, units[unit]);
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#pragma region STD_LIBS
+#include <cstddef>
+#include <string>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "Shape.hpp"
+#pragma endregion
+
+// Memory of one generation, known before generating from ShapeType::getMeshCounts
+struct ResourceEstimate
+{
+	MeshCounts counts;
+	// Vertices and indices kept by the shape
+	size_t meshBytes = 0ull;
+	// Upper bound of memory used while generating (mesh and generator temporaries)
+	size_t peakBytes = 0ull;
+};
+
+// Output of one export, optimisation passes (meshlets, LODs) are not included
+struct ExportEstimate
+{
+	// Exact for binary formats, text formats assume average number length
+	size_t fileBytes = 0ull;
+	// Mesh, output text and exporter temporaries of Shape::save, streamable formats hold only chunks in flight instead of the text
+	size_t peakBytes = 0ull;
+};
+
+class ResourceEstimator
+{
+public:
+	static constexpr size_t BYTES_IN_MB = 1024ull * 1024ull;
+
+	static ResourceEstimate estimateGeneration(const MeshCounts& counts);
+	static ExportEstimate estimateExport(const MeshCounts& counts, FormatType format, const ShapeConfig& config);
+	// Larger of generation and export peaks
+	static size_t estimatePeak(const MeshCounts& counts, FormatType format, const ShapeConfig& config);
+
+	// budgetMB - 0 is unlimited
+	static bool fitsBudget(const size_t bytes, const unsigned int budgetMB);
+	// Bytes with the largest unit below 1024 ("12.3 MB")
+	static std::string formatBytes(const size_t bytes);
+};
@@ -3,12 +3,20 @@
 #pragma endregion
 
 #pragma region STD_LIBS
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <cmath>
+#include <filesystem>
+#include <fstream>
 #include <iomanip>
+#include <memory_resource>
 #include <ios>
+#include <ostream>
+#include <span>
 #include <sstream>
 #include <string>
+#include <system_error>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -29,11 +37,47 @@
 #pragma endregion
 
 #pragma region MY_FILES
+#include "AllocStats.hpp"
 #include "Constants.hpp"
+#include "ExportPipeline.hpp"
+#include "GenerationArena.hpp"
+#include "GenerationStats.hpp"
+#include "MeshOptimizer.hpp"
+#include "Meshlets.hpp"
+#include "ProgressToken.hpp"
+#include "Simplifier.hpp"
 #include "Shape.hpp"
+#include "Stripifier.hpp"
+#include "ThreadPool.hpp"
 #include "Vertex.hpp"
 #pragma endregion
 
+// Export progress is optional, nullptr is never cancelled
+static bool reportExport(ProgressToken* progress, const char* phase, const size_t done, const size_t total)
+{
+    return progress != nullptr && progress->report(phase, done, total);
+}
+
+bool Shape::_reportProgress(const char* phase, const size_t done, const size_t total)
+{
+    if (_shapeConfig.progress == nullptr || !_shapeConfig.progress->report(phase, done, total)) return false;
+
+    if (!_cancelled) {
+        _cancelled = true;
+        _vertices.clear();
+        _vertices.shrink_to_fit();
+        _indices.clear();
+        _indices.shrink_to_fit();
+    }
+    return true;
+}
+
+bool Shape::_checkIndexType(const MeshCounts& counts)
+{
+    _exceedsIndexType = !counts.fitsIndexType();
+    return !_exceedsIndexType;
+}
+
 float Shape::_map(const float input, const float currStart, const float currEnd, const float expectedStart, const float expectedEnd) const
 {
     return expectedStart + ((expectedEnd - expectedStart) / (currEnd - currStart)) * (input - currStart);
@@ -41,9 +85,10 @@ float Shape::_map(const float input, const float currStart, const float currEnd,
 
 glm::vec3 Shape::_calcTangent(const unsigned int t1, const unsigned int t2, const unsigned int t3) const
 {
-    const Vertex v0 = _vertices[t1];
-    const Vertex v1 = _vertices[t2];
-    const Vertex v2 = _vertices[t3];
+    // References, tangents of these vertices may be written by other threads meanwhile
+    const Vertex& v0 = _vertices[t1];
+    const Vertex& v1 = _vertices[t2];
+    const Vertex& v2 = _vertices[t3];
 
     const glm::vec3 pos0 = v0.Position;
     const glm::vec3 pos1 = v1.Position;
@@ -93,6 +138,27 @@ glm::vec3 Shape::_calcTangent(const unsigned int t1, const unsigned int t2, cons
     return tangent;
 }
 
+void Shape::_accumulateTangents(const size_t indexStart, const size_t indexEnd)
+{
+    PhaseTimer timer(&_generationStats, "tangent accumulation");
+
+    for (size_t chunk = indexStart; chunk < indexEnd; chunk += 3ull * PROGRESS_STEP) {
+        if (_reportProgress("tangent accumulation", chunk - indexStart, indexEnd - indexStart)) return;
+
+        const size_t chunkEnd = std::min<size_t>(indexEnd, chunk + 3ull * PROGRESS_STEP);
+        for (size_t i = chunk; i + 2ull < chunkEnd; i += 3ull) {
+            const unsigned int first = _indices[i];
+            const unsigned int second = _indices[i + 1ull];
+            const unsigned int third = _indices[i + 2ull];
+            const glm::vec3 tangent = _calcTangent(first, second, third);
+
+            _vertices[first].Tangent += tangent;
+            _vertices[second].Tangent += tangent;
+            _vertices[third].Tangent += tangent;
+        }
+    }
+}
+
 void Shape::_normalizeTangentAndGenerateBitangent(const unsigned int vertIdx, const unsigned int trisNum)
 {
     if (vertIdx < 0 || vertIdx >= _vertices.size())
@@ -117,11 +183,25 @@ void Shape::_normalizeTangentAndGenerateBitangent(const unsigned int vertIdx, co
     }
 }
 
-void Shape::_normalizeTangentsAndGenerateBitangents(const std::vector<unsigned int>& trisNum, const size_t start, const size_t end)
+void Shape::_normalizeTangentsAndGenerateBitangents(std::span<const unsigned int> trisNum, const size_t start, const size_t end)
 {
-    for (size_t i = start; i < end; ++i) {
-        _normalizeTangentAndGenerateBitangent(i, trisNum[i - start]);
-    }
+    PhaseTimer timer(&_generationStats, "tangent normalisation");
+    if (_reportProgress("tangent normalisation", 0ull, end - start)) return;
+
+    // Every vertex is independent, chunks started after cancel are skipped
+    std::atomic<size_t> done = 0ull;
+    ProgressToken* progress = _shapeConfig.progress;
+    ThreadPool::get().parallelFor(start, end, ThreadPool::DEFAULT_GRAIN_SIZE, [this, &trisNum, &done, progress, start, end](size_t chunkBegin, size_t chunkEnd) {
+        if (progress != nullptr && progress->isCancelled()) return;
+
+        for (size_t i = chunkBegin; i < chunkEnd; ++i) {
+            _normalizeTangentAndGenerateBitangent(i, trisNum[i - start]);
+        }
+        if (progress != nullptr) progress->report("tangent normalisation", done += chunkEnd - chunkBegin, end - start);
+    });
+
+    // Vertices are freed on this thread, after all chunks are finished
+    _reportProgress("tangent normalisation", end - start, end - start);
 }
 
 std::string Shape::_getGeneratedHeader(const std::string commentSign) const
@@ -253,7 +333,7 @@ std::string Shape::_formatVertex(const Vertex& v, bool useFloat) const
     return fmt::vformat(fmt::string_view(formatStr), store);
 }
 
-std::string Shape::_formatVertices(bool onlyVertices, bool useArray, bool useFloat) const
+std::string Shape::_getVerticesHeader(bool onlyVertices, bool useArray, bool useFloat) const
 {
     std::string result;
     std::string typeStr = useFloat ? "float" : "Vertex";
@@ -270,29 +350,58 @@ std::string Shape::_formatVertices(bool onlyVertices, bool useArray, bool useFlo
     if (useFloat) result += "\t//POSITION\t\t\t\t\t//TEX COORD\t//NORMAL" + tangentBlock + "\n";
     else result += "\t//POSITION\t\t\t\t\t\t//TEX COORD\t\t//NORMAL" + tangentBlock + "\n";
 
-    size_t count = onlyVertices ? _indices.size() : _vertices.size();
-    for (size_t i = 0; i < count; ++i) {
-        const Vertex& v = onlyVertices ? _vertices[_indices[i]] : _vertices[i];
-        result += _formatVertex(v, useFloat);
-        if (i + 1ull < count) result += ",";
-        result += "\n";
-    }
-
-    result += "};";
     return result;
 }
 
-std::string Shape::_formatIndices(bool useArray) const
+std::string Shape::_formatVertexRows(bool onlyVertices, bool useFloat, const size_t begin, const size_t end, ProgressToken* progress) const
 {
+    const size_t count = onlyVertices ? _indices.size() : _vertices.size();
+
+    // Chunks are formatted in parallel and joined in order, so output doesn't depend on threads count
+    const size_t chunkSize = ThreadPool::DEFAULT_GRAIN_SIZE / 4ull;
+    std::vector<std::string> chunks((end - begin + chunkSize - 1ull) / chunkSize);
+    std::atomic<size_t> done = 0ull;
+    ThreadPool::get().parallelFor(0ull, chunks.size(), 1ull, [&](size_t chunkBegin, size_t chunkEnd) {
+        for (size_t c = chunkBegin; c < chunkEnd; ++c) {
+            if (reportExport(progress, "vertex formatting", done++, chunks.size())) return;
+
+            std::string& chunk = chunks[c];
+            for (size_t i = begin + c * chunkSize; i < std::min<size_t>(end, begin + (c + 1ull) * chunkSize); ++i) {
+                const Vertex& v = onlyVertices ? _vertices[_indices[i]] : _vertices[i];
+                chunk += _formatVertex(v, useFloat);
+                if (i + 1ull < count) chunk += ",";
+                chunk += "\n";
+            }
+        }
+    });
+
+    size_t length = 0ull;
+    for (const std::string& chunk : chunks) length += chunk.size();
+
     std::string result;
-    std::string countStr = std::to_string(_indices.size());
-    std::string header = useArray
+    result.reserve(length);
+    for (const std::string& chunk : chunks) result += chunk;
+    return result;
+}
+
+std::string Shape::_formatVertices(bool onlyVertices, bool useArray, bool useFloat, ProgressToken* progress) const
+{
+    return _getVerticesHeader(onlyVertices, useArray, useFloat) +
+           _formatVertexRows(onlyVertices, useFloat, 0ull, onlyVertices ? _indices.size() : _vertices.size(), progress) + "};";
+}
+
+std::string Shape::_getIndicesHeader(const size_t count, bool useArray) const
+{
+    std::string countStr = std::to_string(count);
+    return useArray
         ? "unsigned int indices[" + countStr + "] = {\n"
         : "std::array<unsigned int, " + countStr + "> indices = {\n";
+}
 
-    result += header;
-
-    for (size_t i = 0; i < _indices.size(); i += 3) {
+std::string Shape::_formatIndexRows(const size_t begin, const size_t end) const
+{
+    std::string result;
+    for (size_t i = begin; i < end; i += 3) {
         result += fmt::vformat(
             fmt::string_view("\t{0}, {1}, {2}"),
             fmt::make_format_args(_indices[i], _indices[i + 1], _indices[i + 2])
@@ -300,25 +409,83 @@ std::string Shape::_formatIndices(bool useArray) const
         if (i + 3 < _indices.size()) result += ",";
         result += "\n";
     }
+    return result;
+}
+
+std::string Shape::_formatIndices(bool useArray, ProgressToken* progress) const
+{
+    std::string result = _getIndicesHeader(_indices.size(), useArray);
+
+    for (size_t i = 0; i < _indices.size(); i += 3ull * PROGRESS_STEP) {
+        if (reportExport(progress, "index formatting", i, _indices.size())) return result;
+        result += _formatIndexRows(i, std::min<size_t>(_indices.size(), i + 3ull * PROGRESS_STEP));
+    }
 
     result += "};";
     return result;
 }
 
-std::string Shape::_toJSON(bool onlyVertices) const
+std::string Shape::_getStripIndicesHeader(const size_t count, bool useArray) const
+{
+    std::string result = _usePrimitiveRestart
+        ? "// Triangle strip, strips are separated with restart index 0xFFFFFFFF\n"
+        : "// Triangle strip, strips are joined with degenerate triangles\n";
+
+    return result + _getIndicesHeader(count, useArray);
+}
+
+std::string Shape::_formatStripRows(const std::vector<unsigned int>& strip, const size_t begin, const size_t end) const
+{
+    std::string result;
+    for (size_t i = begin; i < end; ++i) {
+        if (i % 16ull == 0ull) result += "\t";
+        result += strip[i] == Stripifier::RESTART_INDEX ? "0xFFFFFFFF" : std::to_string(strip[i]);
+        if (i + 1ull < strip.size()) result += (i % 16ull == 15ull) ? ",\n" : ", ";
+    }
+    return result;
+}
+
+std::string Shape::_formatStripIndices(const std::vector<unsigned int>& strip, bool useArray, ProgressToken* progress) const
+{
+    std::string result = _getStripIndicesHeader(strip.size(), useArray);
+
+    for (size_t i = 0; i < strip.size(); i += PROGRESS_STEP) {
+        if (reportExport(progress, "index formatting", i, strip.size())) return result;
+        result += _formatStripRows(strip, i, std::min(strip.size(), i + PROGRESS_STEP));
+    }
+
+    result += "\n};";
+    return result;
+}
+
+std::string Shape::_toJSON(bool onlyVertices, bool useStrip, ProgressToken* progress) const
 {
+    // Vertices are converted by nlohmann in one go, so only start and end are reported
+    if (reportExport(progress, "formatting", 0ull, 1ull)) return "";
+
     nlohmann::json j;
 
     j["type"] = getObjectClassName();
-    j["format"] = onlyVertices ? "unindexed" : "indexed";
+    j["format"] = onlyVertices ? "unindexed" : (useStrip ? "strip" : "indexed");
     j["positiveHandedness"] = _shapeConfig.tangentHandednessPositive;
     j["hasBitangents"] = _shapeConfig.calcBitangents;
     j["vertexCount"] = onlyVertices ? _indices.size() : _vertices.size();
     j["indexCount"] = onlyVertices ? 0 : _indices.size();
 
-    if (onlyVertices)
+    if (useStrip)
+    {
+        const std::vector<unsigned int> strip = getStripIndices();
+
+        j["indexCount"] = strip.size();
+        j["primitiveRestart"] = _usePrimitiveRestart;
+        if (_usePrimitiveRestart) j["restartIndex"] = Stripifier::RESTART_INDEX;
+        j["vertices"] = nlohmann::vertex_vector_to_json(_vertices, _shapeConfig.genTangents, _shapeConfig.calcBitangents, _shapeConfig.tangentHandednessPositive);
+        j["indices"] = strip;
+    }
+    else if (onlyVertices)
     {
-        std::vector<Vertex> expanded;
+        GenerationArena arena;
+        std::pmr::vector<Vertex> expanded(arena.resource());
         expanded.reserve(_indices.size());
 
         for (unsigned int idx : _indices) {
@@ -332,28 +499,66 @@ std::string Shape::_toJSON(bool onlyVertices) const
     {
         j["vertices"] = nlohmann::vertex_vector_to_json(_vertices, _shapeConfig.genTangents, _shapeConfig.calcBitangents, _shapeConfig.tangentHandednessPositive);
         j["indices"] = _indices;
+
+        if (!_lods.empty()) {
+            nlohmann::json lods = nlohmann::json::array();
+            for (const LodLevel& level : _lods.levels) {
+                lods.push_back({
+                    { "indexOffset",   level.indexOffset },
+                    { "indexCount",    level.indexCount },
+                    { "targetRatio",   level.targetRatio },
+                    { "error",         level.error },
+                    { "absoluteError", level.absoluteError }
+                });
+            }
+
+            j["lods"] = lods;
+            j["lodIndices"] = _lods.indices;
+        }
     }
 
+    if (reportExport(progress, "formatting", 1ull, 1ull)) return "";
     return j.dump(2);
 }
 
-std::string Shape::_toOBJ() const
+std::string Shape::_toOBJ(GenerationStats* stats, ProgressToken* progress) const
 {
-    std::unordered_map<glm::vec3, unsigned int, Vec3Hash, Vec3Equal> vertexMap;
-    std::unordered_map<glm::vec2, unsigned int, Vec2Hash, Vec2Equal> texCoordMap;
-    std::unordered_map<glm::vec3, unsigned int, Vec3Hash, Vec3Equal> normalMap;
+    // Temporaries of this export
+    GenerationArena arena;
+    std::pmr::memory_resource* memory = arena.resource();
+
+    std::pmr::unordered_map<glm::vec3, unsigned int, Vec3Hash, Vec3Equal> vertexMap(memory);
+    std::pmr::unordered_map<glm::vec2, unsigned int, Vec2Hash, Vec2Equal> texCoordMap(memory);
+    std::pmr::unordered_map<glm::vec3, unsigned int, Vec3Hash, Vec3Equal> normalMap(memory);
+
+    std::pmr::vector<glm::vec3> v(memory);
+    std::pmr::vector<glm::vec2> vt(memory);
+    std::pmr::vector<glm::vec3> vn(memory);
+    std::pmr::vector<std::tuple<unsigned int, unsigned int, unsigned int>> vertIndices(memory);
 
-    std::vector<glm::vec3> v;
-    std::vector<glm::vec2> vt;
-    std::vector<glm::vec3> vn;
-    std::vector<std::tuple<unsigned int, unsigned int, unsigned int>> vertIndices;
+    // LODs share vertices, so every shape vertex is mapped once
+    std::pmr::vector<std::tuple<unsigned int, unsigned int, unsigned int>> vertexToObj(_vertices.size(), memory);
+    std::pmr::vector<uint8_t> mapped(_vertices.size(), 0u, memory);
+
+    vertexMap.reserve(_vertices.size());
+    texCoordMap.reserve(_vertices.size());
+    normalMap.reserve(_vertices.size());
 
     v.reserve(_vertices.size());
     vt.reserve(_vertices.size());
     vn.reserve(_vertices.size());
     vertIndices.reserve(_indices.size());
 
-    for (unsigned int i : _indices) {
+    PhaseTimer dedupTimer(stats, "dedup");
+    for (size_t index = 0ull; index < _indices.size(); ++index) {
+        if (index % PROGRESS_STEP == 0ull && reportExport(progress, "dedup", index, _indices.size())) return "";
+
+        const unsigned int i = _indices[index];
+        if (mapped[i]) {
+            vertIndices.push_back(vertexToObj[i]);
+            continue;
+        }
+
         Vertex vert = _vertices[i];
         std::tuple<unsigned int, unsigned int, unsigned int> ind = {};
 
@@ -369,8 +574,11 @@ std::string Shape::_toOBJ() const
         if (insertedN) vn.push_back(vert.Normal);
         std::get<2>(ind) = itN->second;
 
+        vertexToObj[i] = ind;
+        mapped[i] = 1u;
         vertIndices.push_back(ind);
     }
+    dedupTimer.stop();
 
     std::string text = _getGeneratedHeader("#") + "o " + getObjectClassName() + "\n";
     for (const glm::vec3& pos : v) {
@@ -408,6 +616,8 @@ std::string Shape::_toOBJ() const
     text += "s 0\n";
 
     for (size_t i = 0; i < vertIndices.size(); i += 3ull) {
+        if (i % (3ull * PROGRESS_STEP) == 0ull && reportExport(progress, "formatting", i, vertIndices.size())) return "";
+
         text += fmt::vformat(fmt::string_view("f {}/{}/{} {}/{}/{} {}/{}/{}\n"),
             fmt::make_format_args
             (
@@ -418,76 +628,752 @@ std::string Shape::_toOBJ() const
         );
     }
 
+    // LOD 0 is the object above, every other level is a separate object using the same vertices
+    for (size_t level = 1ull; level < _lods.levels.size(); ++level) {
+        const LodLevel& lod = _lods.levels[level];
+        text += fmt::vformat(fmt::string_view("o {}_LOD{}\ns 0\n"), fmt::make_format_args(unmove(getObjectClassName()), level));
+
+        for (size_t i = lod.indexOffset; i < (size_t)lod.indexOffset + lod.indexCount; i += 3ull) {
+            const auto& a = vertexToObj[_lods.indices[i]];
+            const auto& b = vertexToObj[_lods.indices[i + 1ull]];
+            const auto& c = vertexToObj[_lods.indices[i + 2ull]];
+
+            text += fmt::vformat(fmt::string_view("f {}/{}/{} {}/{}/{} {}/{}/{}\n"),
+                fmt::make_format_args
+                (
+                    std::get<0>(a), std::get<1>(a), std::get<2>(a),
+                    std::get<0>(b), std::get<1>(b), std::get<2>(b),
+                    std::get<0>(c), std::get<1>(c), std::get<2>(c)
+                )
+            );
+        }
+    }
+
     return text;
 }
 
+std::string Shape::_getMeshletStructDefinition(bool isC99) const
+{
+    const std::string meshletFields = "\tunsigned int VertexOffset;\n\tunsigned int TriangleOffset;\n\tunsigned int VertexCount;\n\tunsigned int TriangleCount;\n";
+    const std::string boundsFields = "\tvec3 Center;\n\tfloat Radius;\n\tvec3 ConeApex;\n\tvec3 ConeAxis;\n\tfloat ConeCutoff;\n";
+
+    if (isC99) {
+        return "typedef struct {\n" + meshletFields + "} Meshlet;\n\n"
+               "typedef struct {\n" + boundsFields + "} MeshletBounds;\n\n";
+    }
+    else {
+        return "struct Meshlet\n{\n" + meshletFields + "};\n\n"
+               "struct MeshletBounds\n{\n" + boundsFields + "};\n\n";
+    }
+}
+
+std::string Shape::_formatMeshlets(bool useArray, bool useFloat) const
+{
+    auto header = [useArray](const std::string& typeStr, const std::string& name, size_t count) -> std::string {
+        const std::string countStr = std::to_string(count);
+        return useArray
+            ? typeStr + " " + name + "[" + countStr + "] = {\n"
+            : "std::array<" + typeStr + ", " + countStr + "> " + name + " = {\n";
+    };
+
+    const std::vector<Meshlet>& meshlets = _meshlets.meshlets;
+    const std::vector<MeshletBounds>& bounds = _meshlets.bounds;
+
+    std::string result = fmt::vformat(fmt::string_view("// Meshlets (max {} vertices, {} triangles)\n"),
+        fmt::make_format_args(_meshlets.maxVertices, _meshlets.maxTriangles));
+
+    // DESCRIPTORS
+    if (useFloat) {
+        result += header("unsigned int", "meshlets", meshlets.size() * 4ull);
+        result += "\t//VERTEX OFFSET, TRIANGLE OFFSET, VERTEX COUNT, TRIANGLE COUNT\n";
+    }
+    else {
+        result += header("Meshlet", "meshlets", meshlets.size());
+    }
+
+    for (size_t i = 0; i < meshlets.size(); ++i) {
+        const Meshlet& m = meshlets[i];
+        result += fmt::vformat(fmt::string_view(useFloat ? "\t{}, {}, {}, {}" : "\t{{ {}, {}, {}, {} }}"),
+            fmt::make_format_args(m.vertexOffset, m.triangleOffset, m.vertexCount, m.triangleCount));
+        if (i + 1ull < meshlets.size()) result += ",";
+        result += "\n";
+    }
+    result += "};\n\n";
+
+    // LOCAL VERTICES
+    result += header("unsigned int", "meshletVertices", _meshlets.vertices.size());
+    for (size_t i = 0; i < _meshlets.vertices.size(); ++i) {
+        if (i % 16ull == 0ull) result += "\t";
+        result += std::to_string(_meshlets.vertices[i]);
+        if (i + 1ull < _meshlets.vertices.size()) result += (i % 16ull == 15ull) ? ",\n" : ", ";
+    }
+    result += "\n};\n\n";
+
+    // MICRO-INDEX TRIANGLES
+    result += "// Packed local indices: i0 | i1 << 8 | i2 << 16\n";
+    result += header("unsigned int", "meshletTriangles", _meshlets.triangles.size());
+    for (size_t i = 0; i < _meshlets.triangles.size(); ++i) {
+        if (i % 8ull == 0ull) result += "\t";
+        const uint32_t packed = _meshlets.triangles[i];
+        result += fmt::vformat(fmt::string_view("0x{:06X}"), fmt::make_format_args(packed));
+        if (i + 1ull < _meshlets.triangles.size()) result += (i % 8ull == 7ull) ? ",\n" : ", ";
+    }
+    result += "\n};\n\n";
+
+    // BOUNDS
+    if (useFloat) {
+        result += header("float", "meshletBounds", bounds.size() * 11ull);
+        result += "\t//CENTER\t\t\t\t\t//RADIUS\t//CONE APEX\t\t\t\t//CONE AXIS\t\t\t\t//CONE CUTOFF\n";
+    }
+    else {
+        result += header("MeshletBounds", "meshletBounds", bounds.size());
+    }
+
+    for (size_t i = 0; i < bounds.size(); ++i) {
+        const MeshletBounds& b = bounds[i];
+        fmt::dynamic_format_arg_store<fmt::format_context> store;
+        for (const float value : { b.center.x, b.center.y, b.center.z, b.radius,
+                                   b.coneApex.x, b.coneApex.y, b.coneApex.z,
+                                   b.coneAxis.x, b.coneAxis.y, b.coneAxis.z, b.coneCutoff }) {
+            store.push_back(_formatFloat(value));
+        }
+
+        result += fmt::vformat(fmt::string_view(useFloat
+            ? "\t{}f, {}f, {}f,\t{}f,\t{}f, {}f, {}f,\t{}f, {}f, {}f,\t{}f"
+            : "\t{{ {{ {}f, {}f, {}f }}, {}f, {{ {}f, {}f, {}f }}, {{ {}f, {}f, {}f }}, {}f }}"), store);
+        if (i + 1ull < bounds.size()) result += ",";
+        result += "\n";
+    }
+    result += "};";
+
+    return result;
+}
+
+std::string Shape::_getLodStructDefinition(bool isC99) const
+{
+    const std::string lodFields = "\tunsigned int IndexOffset;\n\tunsigned int IndexCount;\n\tfloat Error;\n";
+
+    if (isC99) {
+        return "typedef struct {\n" + lodFields + "} Lod;\n\n";
+    }
+    else {
+        return "struct Lod\n{\n" + lodFields + "};\n\n";
+    }
+}
+
+std::string Shape::_formatLods(bool useArray, bool useFloat) const
+{
+    auto header = [useArray](const std::string& typeStr, const std::string& name, size_t count) -> std::string {
+        const std::string countStr = std::to_string(count);
+        return useArray
+            ? typeStr + " " + name + "[" + countStr + "] = {\n"
+            : "std::array<" + typeStr + ", " + countStr + "> " + name + " = {\n";
+    };
+
+    const std::vector<LodLevel>& levels = _lods.levels;
+
+    std::string result = "// LODs (ranges in lodIndices, error relative to shape extent)\n";
+
+    // RANGES
+    if (useFloat) {
+        result += header("unsigned int", "lods", levels.size() * 2ull);
+        result += "\t//INDEX OFFSET, INDEX COUNT\n";
+    }
+    else {
+        result += header("Lod", "lods", levels.size());
+    }
+
+    for (size_t i = 0; i < levels.size(); ++i) {
+        const LodLevel& l = levels[i];
+        if (useFloat) {
+            result += fmt::vformat(fmt::string_view("\t{}, {}"), fmt::make_format_args(l.indexOffset, l.indexCount));
+        }
+        else {
+            result += fmt::vformat(fmt::string_view("\t{{ {}, {}, {}f }}"), fmt::make_format_args(l.indexOffset, l.indexCount, unmove(_formatFloat(l.error))));
+        }
+        if (i + 1ull < levels.size()) result += ",";
+        result += "\n";
+    }
+    result += "};\n\n";
+
+    if (useFloat) {
+        result += header("float", "lodErrors", levels.size());
+        for (size_t i = 0; i < levels.size(); ++i) {
+            result += "\t" + _formatFloat(levels[i].error) + "f";
+            if (i + 1ull < levels.size()) result += ",";
+            result += "\n";
+        }
+        result += "};\n\n";
+    }
+
+    // INDICES
+    result += header("unsigned int", "lodIndices", _lods.indices.size());
+    for (size_t i = 0; i < _lods.indices.size(); i += 3) {
+        result += fmt::vformat(
+            fmt::string_view("\t{0}, {1}, {2}"),
+            fmt::make_format_args(_lods.indices[i], _lods.indices[i + 1], _lods.indices[i + 2])
+        );
+        if (i + 3 < _lods.indices.size()) result += ",";
+        result += "\n";
+    }
+    result += "};";
+
+    return result;
+}
+
+size_t Shape::_writeVertexFloats(const Vertex& v, float* out) const
+{
+    size_t count = 0ull;
+    out[count++] = v.Position.x; out[count++] = v.Position.y; out[count++] = v.Position.z;
+    out[count++] = v.TexCoord.x; out[count++] = v.TexCoord.y;
+    out[count++] = v.Normal.x;   out[count++] = v.Normal.y;   out[count++] = v.Normal.z;
+
+    if (_shapeConfig.genTangents) {
+        out[count++] = v.Tangent.x; out[count++] = v.Tangent.y; out[count++] = v.Tangent.z;
+
+        if (_shapeConfig.calcBitangents) {
+            out[count++] = v.Bitangent.x; out[count++] = v.Bitangent.y; out[count++] = v.Bitangent.z;
+        }
+        else {
+            out[count++] = _shapeConfig.tangentHandednessPositive ? 1.0f : -1.0f;
+        }
+    }
+
+    return count;
+}
+
+static void appendBinary(std::string& result, const void* data, const size_t bytes)
+{
+    result.append(reinterpret_cast<const char*>(data), bytes);
+}
+
+static void appendBinaryChunkHeader(std::string& result, const char* id, const uint32_t count, const uint64_t bytes)
+{
+    appendBinary(result, id, 4ull);
+    appendBinary(result, &count, sizeof(count));
+    appendBinary(result, &bytes, sizeof(bytes));
+}
+
+std::string Shape::_getBinaryHeader(bool useStrip) const
+{
+    // Layout is described in README (Binary format), all values are little-endian
+    constexpr uint32_t version = 1u;
+
+    const uint32_t flags = (_shapeConfig.genTangents ? 1u : 0u) | (_shapeConfig.calcBitangents ? 2u : 0u) | (_shapeConfig.tangentHandednessPositive ? 4u : 0u) |
+        (useStrip ? 8u : 0u) | (useStrip && _usePrimitiveRestart ? 16u : 0u);
+    const uint32_t chunkCount = 2u + (!_meshlets.empty() ? 4u : 0u) + (!_lods.empty() ? 2u : 0u);
+
+    std::string result;
+    appendBinary(result, "SGMB", 4ull);
+    appendBinary(result, &version, sizeof(version));
+    appendBinary(result, &flags, sizeof(flags));
+    appendBinary(result, &chunkCount, sizeof(chunkCount));
+    appendBinaryChunkHeader(result, "VERT", (uint32_t)_vertices.size(), (uint64_t)(_vertices.size() * getVertexStride()));
+    return result;
+}
+
+void Shape::_appendBinaryVertices(std::string& result, const size_t begin, const size_t end) const
+{
+    float floats[14];
+    for (size_t i = begin; i < end; ++i) {
+        const size_t count = _writeVertexFloats(_vertices[i], floats);
+        appendBinary(result, floats, count * sizeof(float));
+    }
+}
+
+std::string Shape::_getBinaryExtras() const
+{
+    std::string result;
+
+    if (!_lods.empty()) {
+        // LODS
+        appendBinaryChunkHeader(result, "LODS", (uint32_t)_lods.levels.size(), (uint64_t)(_lods.levels.size() * 16ull));
+        for (const LodLevel& level : _lods.levels) {
+            appendBinary(result, &level.indexOffset, sizeof(uint32_t));
+            appendBinary(result, &level.indexCount, sizeof(uint32_t));
+            appendBinary(result, &level.error, sizeof(float));
+            appendBinary(result, &level.absoluteError, sizeof(float));
+        }
+
+        appendBinaryChunkHeader(result, "LODI", (uint32_t)_lods.indices.size(), (uint64_t)(_lods.indices.size() * sizeof(unsigned int)));
+        appendBinary(result, _lods.indices.data(), _lods.indices.size() * sizeof(unsigned int));
+    }
+
+    if (_meshlets.empty()) return result;
+
+    // MESHLETS
+    appendBinaryChunkHeader(result, "MSHL", (uint32_t)_meshlets.meshlets.size(), (uint64_t)(_meshlets.meshlets.size() * sizeof(Meshlet)));
+    appendBinary(result, _meshlets.meshlets.data(), _meshlets.meshlets.size() * sizeof(Meshlet));
+
+    appendBinaryChunkHeader(result, "MSHB", (uint32_t)_meshlets.bounds.size(), (uint64_t)(_meshlets.bounds.size() * 11ull * sizeof(float)));
+    for (const MeshletBounds& b : _meshlets.bounds) {
+        const float values[11] = {
+            b.center.x, b.center.y, b.center.z, b.radius,
+            b.coneApex.x, b.coneApex.y, b.coneApex.z,
+            b.coneAxis.x, b.coneAxis.y, b.coneAxis.z, b.coneCutoff
+        };
+        appendBinary(result, values, sizeof(values));
+    }
+
+    appendBinaryChunkHeader(result, "MSHV", (uint32_t)_meshlets.vertices.size(), (uint64_t)(_meshlets.vertices.size() * sizeof(uint32_t)));
+    appendBinary(result, _meshlets.vertices.data(), _meshlets.vertices.size() * sizeof(uint32_t));
+
+    appendBinaryChunkHeader(result, "MSHT", (uint32_t)_meshlets.triangles.size(), (uint64_t)(_meshlets.triangles.size() * sizeof(uint32_t)));
+    appendBinary(result, _meshlets.triangles.data(), _meshlets.triangles.size() * sizeof(uint32_t));
+
+    return result;
+}
+
+std::string Shape::_toBinary(bool useStrip, ProgressToken* progress) const
+{
+    const std::vector<unsigned int> strip = useStrip ? getStripIndices() : std::vector<unsigned int>();
+    const std::span<const unsigned int> indices = useStrip ? std::span<const unsigned int>(strip) : std::span<const unsigned int>(_indices);
+
+    const size_t stride = getVertexStride();
+    const bool hasMeshlets = !_meshlets.empty();
+    const bool hasLods = !_lods.empty();
+
+    std::string result;
+    result.reserve(16ull + 16ull * 8ull + _vertices.size() * stride + indices.size() * sizeof(unsigned int) +
+        (hasMeshlets ? _meshlets.meshlets.size() * (sizeof(Meshlet) + 11ull * sizeof(float)) + (_meshlets.vertices.size() + _meshlets.triangles.size()) * sizeof(uint32_t) : 0ull) +
+        (hasLods ? _lods.levels.size() * 16ull + _lods.indices.size() * sizeof(unsigned int) : 0ull));
+
+    // HEADER and VERTICES
+    result += _getBinaryHeader(useStrip);
+    for (size_t i = 0ull; i < _vertices.size(); i += PROGRESS_STEP) {
+        if (reportExport(progress, "vertex formatting", i, _vertices.size())) return "";
+        _appendBinaryVertices(result, i, std::min(_vertices.size(), i + PROGRESS_STEP));
+    }
+
+    // INDICES (triangle list or strip)
+    appendBinaryChunkHeader(result, useStrip ? "STRP" : "INDX", (uint32_t)indices.size(), (uint64_t)(indices.size() * sizeof(unsigned int)));
+    appendBinary(result, indices.data(), indices.size() * sizeof(unsigned int));
+
+    // LODS and MESHLETS
+    result += _getBinaryExtras();
+    return result;
+}
+
+bool Shape::_saveBinaryPipelined(std::ostream& out, bool useStrip, ProgressToken* progress) const
+{
+    // Strips are built over all triangles before the first chunk
+    const std::vector<unsigned int> strip = useStrip ? getStripIndices() : std::vector<unsigned int>();
+    const std::span<const unsigned int> indices = useStrip ? std::span<const unsigned int>(strip) : std::span<const unsigned int>(_indices);
+
+    const size_t vertexChunks = (_vertices.size() + SAVE_CHUNK_VERTICES - 1ull) / SAVE_CHUNK_VERTICES;
+    const size_t indexChunks = (indices.size() + SAVE_CHUNK_INDICES - 1ull) / SAVE_CHUNK_INDICES;
+    const bool hasExtras = !_meshlets.empty() || !_lods.empty();
+
+    // Shape is generated already, so generator stage only cuts it into chunks
+    ExportPipeline pipeline(progress);
+    return pipeline.run(out, [this, useStrip, indices, hasExtras](ExportPipeline& stages) -> bool {
+        if (!stages.emit([this, useStrip]() { return _getBinaryHeader(useStrip); })) return false;
+
+        for (size_t begin = 0ull; begin < _vertices.size(); begin += SAVE_CHUNK_VERTICES) {
+            const size_t end = std::min(_vertices.size(), begin + SAVE_CHUNK_VERTICES);
+            const bool emitted = stages.emit([this, begin, end]() {
+                std::string bytes;
+                bytes.reserve((end - begin) * getVertexStride());
+                _appendBinaryVertices(bytes, begin, end);
+                return bytes;
+            });
+            if (!emitted) return false;
+        }
+
+        const bool emittedHeader = stages.emit([useStrip, count = indices.size()]() {
+            std::string bytes;
+            appendBinaryChunkHeader(bytes, useStrip ? "STRP" : "INDX", (uint32_t)count, (uint64_t)(count * sizeof(unsigned int)));
+            return bytes;
+        });
+        if (!emittedHeader) return false;
+
+        for (size_t begin = 0ull; begin < indices.size(); begin += SAVE_CHUNK_INDICES) {
+            const std::span<const unsigned int> chunk = indices.subspan(begin, std::min(indices.size() - begin, SAVE_CHUNK_INDICES));
+            const bool emitted = stages.emit([chunk]() {
+                return std::string(reinterpret_cast<const char*>(chunk.data()), chunk.size_bytes());
+            });
+            if (!emitted) return false;
+        }
+
+        return !hasExtras || stages.emit([this]() { return _getBinaryExtras(); });
+    }, "pipelined saving", 2ull + vertexChunks + indexChunks + (hasExtras ? 1ull : 0ull));
+}
+
+// C/C++ array formats differ in array type (C99 array or std::array), element type (Vertex struct or floats) and indices (list, strip or none)
+static bool isCArrayFormat(const FormatType type)
+{
+    return type == FormatType::C_ARRAY_INDICES_STRUCT || type == FormatType::C_ARRAY_VERTICES_STRUCT || type == FormatType::C_ARRAY_INDICES_FLOAT ||
+        type == FormatType::C_ARRAY_VERTICES_FLOAT || type == FormatType::C_ARRAY_STRIP_STRUCT || type == FormatType::C_ARRAY_STRIP_FLOAT;
+}
+
+static bool isFloatArrayFormat(const FormatType type)
+{
+    return (type >= FormatType::CPP_ARRAY_INDICES_FLOAT && type <= FormatType::C_ARRAY_VERTICES_FLOAT) ||
+        type == FormatType::CPP_ARRAY_STRIP_FLOAT || type == FormatType::C_ARRAY_STRIP_FLOAT;
+}
+
+static bool isVerticesArrayFormat(const FormatType type)
+{
+    return type == FormatType::CPP_ARRAY_VERTICES_STRUCT || type == FormatType::C_ARRAY_VERTICES_STRUCT ||
+        type == FormatType::CPP_ARRAY_VERTICES_FLOAT || type == FormatType::C_ARRAY_VERTICES_FLOAT;
+}
+
+static bool isArrayFormat(const FormatType type)
+{
+    return type <= FormatType::C_ARRAY_VERTICES_FLOAT || (type >= FormatType::CPP_ARRAY_STRIP_STRUCT && type <= FormatType::C_ARRAY_STRIP_FLOAT);
+}
+
+// Meshlets and LODs follow indices of triangle list arrays
+static bool hasArrayExtras(const FormatType type)
+{
+    return !isVerticesArrayFormat(type) && !Shape::isStripFormat(type);
+}
+
+std::string Shape::_getArrayPreamble(FormatType type) const
+{
+    const bool isC99 = isCArrayFormat(type);
+    const bool withExtras = hasArrayExtras(type);
+
+    std::string result = _getGeneratedHeader("//") + (isC99 ? "" : "#include <array>\n\n");
+    if (isFloatArrayFormat(type)) return result;
+
+    result += _getStructDefinition(isC99);
+    if (withExtras && !_meshlets.empty()) result += _getMeshletStructDefinition(isC99);
+    if (withExtras && !_lods.empty()) result += _getLodStructDefinition(isC99);
+    return result;
+}
+
+std::string Shape::_getArrayExtras(bool useArray, bool useFloat) const
+{
+    return (!_meshlets.empty() ? "\n\n" + _formatMeshlets(useArray, useFloat) : "") +
+           (!_lods.empty() ? "\n\n" + _formatLods(useArray, useFloat) : "");
+}
+
+std::string Shape::_toArray(FormatType type, ProgressToken* progress) const
+{
+    const bool useArray = isCArrayFormat(type);
+    const bool useFloat = isFloatArrayFormat(type);
+
+    if (isVerticesArrayFormat(type)) return _getArrayPreamble(type) + _formatVertices(true, useArray, useFloat, progress);
+
+    std::string result = _getArrayPreamble(type) + _formatVertices(false, useArray, useFloat, progress) + "\n\n";
+    if (isStripFormat(type)) return result + _formatStripIndices(getStripIndices(), useArray, progress);
+
+    return result + _formatIndices(useArray, progress) + _getArrayExtras(useArray, useFloat);
+}
+
+bool Shape::_saveArrayPipelined(std::ostream& out, FormatType type, ProgressToken* progress) const
+{
+    const bool useArray = isCArrayFormat(type);
+    const bool useFloat = isFloatArrayFormat(type);
+    const bool onlyVertices = isVerticesArrayFormat(type);
+    const bool useStrip = isStripFormat(type);
+
+    // Strips are built over all triangles before the first chunk, counts of every array are known up front
+    const std::vector<unsigned int> strip = useStrip ? getStripIndices() : std::vector<unsigned int>();
+    const size_t vertexCount = onlyVertices ? _indices.size() : _vertices.size();
+    const size_t indexCount = onlyVertices ? 0ull : (useStrip ? strip.size() : _indices.size());
+
+    const size_t vertexChunks = (vertexCount + SAVE_CHUNK_VERTICES - 1ull) / SAVE_CHUNK_VERTICES;
+    const size_t indexChunks = (indexCount + SAVE_CHUNK_INDICES - 1ull) / SAVE_CHUNK_INDICES;
+
+    // Pieces of toString (see _toArray): vertices, indices and closing part with meshlets and LODs
+    ExportPipeline pipeline(progress);
+    return pipeline.run(out, [&](ExportPipeline& stages) -> bool {
+        if (!stages.emit([this, type, onlyVertices, useArray, useFloat]() { return _getArrayPreamble(type) + _getVerticesHeader(onlyVertices, useArray, useFloat); })) return false;
+
+        for (size_t begin = 0ull; begin < vertexCount; begin += SAVE_CHUNK_VERTICES) {
+            const size_t end = std::min(vertexCount, begin + SAVE_CHUNK_VERTICES);
+            // Chunk rows are formatted in parallel on the pool, formatter stage waits for them
+            if (!stages.emit([this, onlyVertices, useFloat, begin, end]() { return _formatVertexRows(onlyVertices, useFloat, begin, end, nullptr); })) return false;
+        }
+
+        if (onlyVertices) return stages.emit([]() { return std::string("};"); });
+
+        const bool emittedHeader = stages.emit([this, useStrip, useArray, indexCount]() {
+            return "};\n\n" + (useStrip ? _getStripIndicesHeader(indexCount, useArray) : _getIndicesHeader(indexCount, useArray));
+        });
+        if (!emittedHeader) return false;
+
+        for (size_t begin = 0ull; begin < indexCount; begin += SAVE_CHUNK_INDICES) {
+            const size_t end = std::min(indexCount, begin + SAVE_CHUNK_INDICES);
+            const bool emitted = stages.emit([this, &strip, useStrip, begin, end]() {
+                return useStrip ? _formatStripRows(strip, begin, end) : _formatIndexRows(begin, end);
+            });
+            if (!emitted) return false;
+        }
+
+        return stages.emit([this, useStrip, useArray, useFloat]() {
+            return useStrip ? std::string("\n};") : "};" + _getArrayExtras(useArray, useFloat);
+        });
+    }, "pipelined saving", 1ull + vertexChunks + (onlyVertices ? 1ull : 2ull + indexChunks));
+}
+
+Shape::Shape(const ShapeConfig& config)
+    : _shapeConfig(config), _vertices(config.getMemoryResource()), _indices(config.getMemoryResource()) {}
+
 Shape::~Shape()
 {
     _vertices.clear();
     _indices.clear();
 }
 
-std::string Shape::toString(FormatType type) const
+std::string Shape::_format(FormatType type, GenerationStats* stats, ProgressToken* progress) const
 {
     switch (type) {
-        case FormatType::CPP_ARRAY_INDICES_STRUCT : {
-            return _getGeneratedHeader("//") +
-                   "#include <array>\n\n" +
-                   _getStructDefinition(false) +
-                   _formatVertices(false, false, false) + "\n\n" +
-                   _formatIndices(false);
-        }
-        case FormatType::C_ARRAY_INDICES_STRUCT : {
-            return _getGeneratedHeader("//") +
-                   _getStructDefinition(true) +
-                   _formatVertices(false, true, false) + "\n\n" +
-                   _formatIndices(true);
-        }
-        case FormatType::CPP_ARRAY_VERTICES_STRUCT: {
-            return _getGeneratedHeader("//") +
-                   "#include <array>\n\n" +
-                   _getStructDefinition(false)  +
-                   _formatVertices(true, false, false);
-        }
-        case FormatType::C_ARRAY_VERTICES_STRUCT: {
-            return _getGeneratedHeader("//") +
-                   _getStructDefinition(true) +
-                   _formatVertices(true, true, false);
-        }
-        case FormatType::CPP_ARRAY_INDICES_FLOAT: {
-            return _getGeneratedHeader("//") +
-                   "#include <array>\n\n" +
-                   _formatVertices(false, false, true) + "\n\n" +
-                   _formatIndices(false);
-        }
-        case FormatType::C_ARRAY_INDICES_FLOAT: {
-            return _getGeneratedHeader("//") +
-                   _formatVertices(false, true, true) + "\n\n" +
-                   _formatIndices(true);
-        }
-        case FormatType::CPP_ARRAY_VERTICES_FLOAT: {
-            return _getGeneratedHeader("//") +
-                   "#include <array>\n\n" +
-                   _formatVertices(true, false, true);
-        }
-        case FormatType::C_ARRAY_VERTICES_FLOAT: {
-            return _getGeneratedHeader("//") +
-                   _formatVertices(true, true, true);
+        case FormatType::CPP_ARRAY_INDICES_STRUCT:
+        case FormatType::C_ARRAY_INDICES_STRUCT:
+        case FormatType::CPP_ARRAY_VERTICES_STRUCT:
+        case FormatType::C_ARRAY_VERTICES_STRUCT:
+        case FormatType::CPP_ARRAY_INDICES_FLOAT:
+        case FormatType::C_ARRAY_INDICES_FLOAT:
+        case FormatType::CPP_ARRAY_VERTICES_FLOAT:
+        case FormatType::C_ARRAY_VERTICES_FLOAT:
+        case FormatType::CPP_ARRAY_STRIP_STRUCT:
+        case FormatType::C_ARRAY_STRIP_STRUCT:
+        case FormatType::CPP_ARRAY_STRIP_FLOAT:
+        case FormatType::C_ARRAY_STRIP_FLOAT: {
+            return _toArray(type, progress);
         }
         case FormatType::JSON_INDICES: {
-            return _toJSON(false);
+            return _toJSON(false, false, progress);
         }
         case FormatType::JSON_VERTICES: {
-            return _toJSON(true);
+            return _toJSON(true, false, progress);
         }
         case FormatType::OBJ: {
-            return _toOBJ();
+            return _toOBJ(stats, progress);
+        }
+        case FormatType::BINARY: {
+            return _toBinary(false, progress);
+        }
+        case FormatType::JSON_STRIP: {
+            return _toJSON(false, true, progress);
+        }
+        case FormatType::BINARY_STRIP: {
+            return _toBinary(true, progress);
         }
     }
 
     return "";
 }
 
+std::string Shape::toString(FormatType type, GenerationStats* stats, ProgressToken* progress) const
+{
+    AllocScope allocScope("export");
+    PhaseTimer timer(stats, "formatting");
+
+    std::string text = _format(type, stats, progress);
+    if (progress != nullptr && progress->isCancelled()) return "";
+    return text;
+}
+
+bool Shape::isStreamable(const FormatType type)
+{
+    return type != FormatType::OBJ && type != FormatType::JSON_INDICES && type != FormatType::JSON_VERTICES && type != FormatType::JSON_STRIP;
+}
+
+bool Shape::isStripFormat(const FormatType type)
+{
+    return type >= FormatType::CPP_ARRAY_STRIP_STRUCT && type <= FormatType::BINARY_STRIP;
+}
+
+bool Shape::save(const std::string& path, FormatType type, GenerationStats* stats, ProgressToken* progress) const
+{
+    std::ofstream file(path, std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!file.is_open()) return false;
+
+    bool saved = true;
+    if (isStreamable(type)) {
+        AllocScope allocScope("export");
+        PhaseTimer timer(stats, "pipelined saving");
+        saved = isArrayFormat(type) ? _saveArrayPipelined(file, type, progress) : _saveBinaryPipelined(file, type == FormatType::BINARY_STRIP, progress);
+    }
+    else {
+        // OBJ and JSON are built whole (deduplicated attributes, JSON document), they are formatted like toString and written at once
+        const std::string text = toString(type, stats, progress);
+        saved = progress == nullptr || !progress->isCancelled();
+
+        PhaseTimer writeTimer(stats, "file write");
+        if (saved) file.write(text.data(), text.size());
+    }
+
+    file.close();
+    if (!saved || !file) {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+        return false;
+    }
+    return true;
+}
+
+MeshOptimizeReport Shape::optimize(const MeshOptimizeOptions& options)
+{
+    MeshOptimizeReport report;
+
+    // Fetch and overdraw are compared against generation order, so they are measured before any pass
+    if (options.optimizeVertexFetch) {
+        report.vertexFetchBefore = getVertexFetchStats();
+    }
+
+    if (options.optimizeOverdraw) {
+        report.overdrawBefore = getOverdrawStats();
+    }
+
+    // Overdraw clusters and meshlets are built from cache optimized order
+    if (options.optimizeVertexCache || options.optimizeOverdraw || options.buildMeshlets) {
+        report.vertexCacheBefore = getVertexCacheStats(options.vertexCacheSize, options.vertexCacheType);
+        optimizeVertexCache(options.vertexCacheSize);
+
+        if (options.optimizeOverdraw) {
+            optimizeOverdraw(options.overdrawThreshold, options.vertexCacheSize);
+            report.overdrawAfter = getOverdrawStats();
+            report.overdrawOptimized = true;
+        }
+
+        report.vertexCacheAfter = getVertexCacheStats(options.vertexCacheSize, options.vertexCacheType);
+        report.vertexCacheOptimized = true;
+    }
+
+    // Has to run after triangle reordering, it follows final index order
+    if (options.optimizeVertexFetch) {
+        optimizeVertexFetch();
+        report.vertexFetchAfter = getVertexFetchStats();
+        report.vertexFetchOptimized = true;
+    }
+
+    // LODs reference final vertices, LOD 0 is the final index order
+    if (options.generateLods) {
+        generateLods(options.lodLevels, options.lodReduction, options.vertexCacheSize);
+        report.lods = _lods.levels;
+        report.lodsGenerated = true;
+    }
+
+    // Built last, so that meshlets reference final vertices and follow final index order
+    if (options.buildMeshlets) {
+        buildMeshlets(options.meshletMaxVertices, options.meshletMaxTriangles);
+        report.meshlets = MeshletBuilder::analyze(_meshlets);
+        report.meshletsBuilt = true;
+    }
+
+    return report;
+}
+
+void Shape::optimizeVertexCache(const unsigned int cacheSize)
+{
+    AllocScope allocScope("optimize vertex cache");
+    clearMeshlets();
+    clearLods();
+    MeshOptimizer::optimizeVertexCache(_indices, _vertices.size(), cacheSize);
+}
+
+VertexCacheStats Shape::getVertexCacheStats(const unsigned int cacheSize, const VertexCacheType type) const
+{
+    return MeshOptimizer::analyzeVertexCache(_indices, _vertices.size(), cacheSize, type);
+}
+
+void Shape::optimizeVertexFetch()
+{
+    AllocScope allocScope("optimize vertex fetch");
+    clearMeshlets();
+    clearLods();
+    std::vector<unsigned int> remap = MeshOptimizer::optimizeVertexFetch(_indices, _vertices.size());
+
+    std::pmr::vector<Vertex> vertices(_vertices.size(), _vertices.get_allocator());
+    for (size_t i = 0ull; i < _vertices.size(); ++i) {
+        vertices[remap[i]] = _vertices[i];
+    }
+    _vertices.swap(vertices);
+}
+
+VertexFetchStats Shape::getVertexFetchStats() const
+{
+    return MeshOptimizer::analyzeVertexFetch(_indices, _vertices.size(), getVertexStride());
+}
+
+void Shape::optimizeOverdraw(const float threshold, const unsigned int cacheSize)
+{
+    AllocScope allocScope("optimize overdraw");
+    clearMeshlets();
+    clearLods();
+    MeshOptimizer::optimizeOverdraw(_indices, _vertices, threshold, cacheSize);
+}
+
+OverdrawStats Shape::getOverdrawStats() const
+{
+    return MeshOptimizer::analyzeOverdraw(_indices, _vertices);
+}
+
+void Shape::buildMeshlets(const uint32_t maxVertices, const uint32_t maxTriangles)
+{
+    AllocScope allocScope("build meshlets");
+    _meshlets = MeshletBuilder::build(_indices, _vertices, maxVertices, maxTriangles);
+}
+
+void Shape::clearMeshlets()
+{
+    _meshlets = MeshletData();
+}
+
+const MeshletData& Shape::getMeshlets() const
+{
+    return _meshlets;
+}
+
+void Shape::generateLods(const unsigned int levels, const float reduction, const unsigned int cacheSize)
+{
+    AllocScope allocScope("generate lods");
+    _lods = Simplifier::buildLodChain(_indices, _vertices, levels, reduction, cacheSize);
+}
+
+void Shape::clearLods()
+{
+    _lods = LodChain();
+}
+
+const LodChain& Shape::getLods() const
+{
+    return _lods;
+}
+
+void Shape::setPrimitiveRestart(const bool enabled)
+{
+    _usePrimitiveRestart = enabled;
+}
+
+bool Shape::isPrimitiveRestartEnabled() const
+{
+    return _usePrimitiveRestart;
+}
+
+std::vector<unsigned int> Shape::getStripIndices(StripStats* stats) const
+{
+    return Stripifier::stripify(_indices, _vertices.size(), _usePrimitiveRestart, stats);
+}
+
+StripStats Shape::getStripStats() const
+{
+    StripStats stats;
+    getStripIndices(&stats);
+    return stats;
+}
+
+size_t Shape::getVertexStride() const
+{
+    return getVertexStride(_shapeConfig);
+}
+
+size_t Shape::getVertexStride(const ShapeConfig& config)
+{
+    // Position + TexCoord + Normal
+    size_t floats = 8ull;
+    if (config.genTangents) {
+        // Tangent + Bitangent or Tangent with handedness in w
+        floats += config.calcBitangents ? 6ull : 4ull;
+    }
+    return floats * sizeof(float);
+}
+
 std::string Shape::getClassName()
 {
     return "Shape";
@@ -503,9 +1389,15 @@ std::string Shape::getFormatFileExtension(const FormatType& format)
         }
         case FormatType::JSON_INDICES:
         case FormatType::JSON_VERTICES:
+        case FormatType::JSON_STRIP:
         {
             return ".json";
         }
+        case FormatType::BINARY:
+        case FormatType::BINARY_STRIP:
+        {
+            return ".bin";
+        }
         default:
         {
             return ".txt";
@@ -526,4 +1418,55 @@ size_t Shape::getVerticesCount() const
 size_t Shape::getIndicesCount() const
 {
     return _indices.size();
+}
+
+const std::pmr::vector<Vertex>& Shape::getVertices() const
+{
+    return _vertices;
+}
+
+const std::pmr::vector<unsigned int>& Shape::getIndices() const
+{
+    return _indices;
+}
+
+MeshData Shape::release()
+{
+    MeshData data{ std::move(_vertices), std::move(_indices) };
+
+    // Moved from vectors are only guaranteed to be valid
+    _vertices.clear();
+    _indices.clear();
+    clearMeshlets();
+    clearLods();
+
+    return data;
+}
+
+const GenerationStats& Shape::getGenerationStats() const
+{
+    return _generationStats;
+}
+
+bool Shape::isCancelled() const
+{
+    return _cancelled;
+}
+
+bool Shape::exceedsIndexType() const
+{
+    return _exceedsIndexType;
+}
+
+size_t Shape::getMemorySize() const
+{
+    return sizeof(*this) +
+        _vertices.capacity() * sizeof(Vertex) +
+        _indices.capacity() * sizeof(unsigned int) +
+        _meshlets.meshlets.capacity() * sizeof(Meshlet) +
+        _meshlets.bounds.capacity() * sizeof(MeshletBounds) +
+        _meshlets.vertices.capacity() * sizeof(uint32_t) +
+        _meshlets.triangles.capacity() * sizeof(uint32_t) +
+        _lods.indices.capacity() * sizeof(unsigned int) +
+        _lods.levels.capacity() * sizeof(LodLevel);
 }
\ No newline at end of file
@@ -1,7 +1,11 @@
 #pragma once
 
 #pragma region STD_LIBS
+#include <algorithm>
 #include <cstdint>
+#include <memory_resource>
+#include <ostream>
+#include <span>
 #include <string>
 #include <utility>
 #include <vector>
@@ -12,6 +16,12 @@
 #pragma endregion
 
 #pragma region MY_FILES
+#include "GenerationStats.hpp"
+#include "MeshOptimizer.hpp"
+#include "Meshlets.hpp"
+#include "ProgressToken.hpp"
+#include "Simplifier.hpp"
+#include "Stripifier.hpp"
 #include "Vertex.hpp"
 #pragma endregion
 
@@ -31,7 +41,16 @@ enum class FormatType : uint8_t {
 	// Dedicated Files
 	JSON_INDICES			  = 8,
 	JSON_VERTICES		      = 9,
-	OBJ					      = 10
+	OBJ					      = 10,
+	BINARY					  = 11,
+
+	// Triangle strips
+	CPP_ARRAY_STRIP_STRUCT    = 12,
+	C_ARRAY_STRIP_STRUCT      = 13,
+	CPP_ARRAY_STRIP_FLOAT     = 14,
+	C_ARRAY_STRIP_FLOAT       = 15,
+	JSON_STRIP				  = 16,
+	BINARY_STRIP			  = 17
 };
 
 enum class ValuesRange : uint8_t {
@@ -55,40 +74,181 @@ struct ShapeConfig
 	bool genTangents = true;
 	bool calcBitangents = true;
 	bool tangentHandednessPositive = true;
+	// Memory of shape vertices and indices, nullptr uses default resource (new/delete)
+	std::pmr::memory_resource* memoryResource = nullptr;
+	// Receives generation progress and cancels it, nullptr can't be cancelled
+	ProgressToken* progress = nullptr;
+
+	std::pmr::memory_resource* getMemoryResource() const { return memoryResource != nullptr ? memoryResource : std::pmr::get_default_resource(); }
+};
+
+// Number of vertices and indices of generated shape, known before generation
+struct MeshCounts
+{
+	// Indices are unsigned int, the largest one is reserved for primitive restart (Stripifier::RESTART_INDEX)
+	static constexpr size_t MAX_VERTICES = 0xFFFFFFFFull;
+	// Binary format stores counts as uint32
+	static constexpr size_t MAX_INDICES = 0xFFFFFFFFull;
+
+	// Saturated (SIZE_MAX) when the count doesn't fit size_t
+	size_t vertices = 0ull;
+	size_t indices = 0ull;
+
+	// Every vertex can be addressed with unsigned int index, larger meshes are not generated (TiledPlane splits larger grids into sub-meshes)
+	bool fitsIndexType() const { return vertices <= MAX_VERTICES && indices <= MAX_INDICES; }
+};
+
+// Vertices and indices taken out of a shape
+struct MeshData
+{
+	std::pmr::vector<Vertex> vertices;
+	std::pmr::vector<unsigned int> indices;
 };
 
 class Shape
 {
 protected:
+	// Steps (vertices, indices or triangles) between progress reports of loops without rows
+	static constexpr size_t PROGRESS_STEP = 16384ull;
+
 	ShapeConfig _shapeConfig;
-	std::vector<Vertex> _vertices;
-	std::vector<unsigned int> _indices;
+	std::pmr::vector<Vertex> _vertices;
+	std::pmr::vector<unsigned int> _indices;
+	// Built on demand, cleared by passes that change vertices or indices
+	MeshletData _meshlets;
+	LodChain _lods;
+	// Strip exports join strips with Stripifier::RESTART_INDEX or with degenerate triangles
+	bool _usePrimitiveRestart = true;
+	// Phases of generation (cache load for shapes restored from MeshCache)
+	GenerationStats _generationStats;
+	// Generation stopped by ShapeConfig::progress, vertices and indices are freed
+	bool _cancelled = false;
+	// Generation refused because mesh doesn't fit unsigned int indices (see MeshCounts::fitsIndexType)
+	bool _exceedsIndexType = false;
 
 	float _map(const float input, const float currStart, const float currEnd, const float expectedStart, const float expectedEnd) const;
 
+	// Reports done of total steps of phase, frees vertices and indices and returns true when generation was cancelled
+	bool _reportProgress(const char* phase, const size_t done, const size_t total);
+	// Called by generators before allocating, returns false (and marks shape) when counts don't fit unsigned int indices
+	bool _checkIndexType(const MeshCounts& counts);
+
 	glm::vec3 _calcTangent(const unsigned int t1, const unsigned int t2, const unsigned int t3) const;
+	// Adds tangent of every triangle of _indices[indexStart, indexEnd) to its vertices
+	void _accumulateTangents(const size_t indexStart, const size_t indexEnd);
 	void _normalizeTangentAndGenerateBitangent(const unsigned int vertIdx, const unsigned int trisNum = 1);
 	// start - inclusive, end - exclusive
-	void _normalizeTangentsAndGenerateBitangents(const std::vector<unsigned int>& trisNum, const size_t start, const size_t end);
+	void _normalizeTangentsAndGenerateBitangents(std::span<const unsigned int> trisNum, const size_t start, const size_t end);
 
 	std::string _getGeneratedHeader(const std::string commentSign) const;
 	std::string _getStructDefinition(bool isC99) const;
 	std::string _formatFloat(float value, bool delRedundantZeros=true) const;
 	std::string _formatVertex(const Vertex& v, bool useFloat) const;
-	std::string _formatVertices(bool onlyVertices, bool useArray, bool useFloat) const;
-	std::string _formatIndices(bool useArray) const;
-	std::string _toJSON(bool onlyVertices) const;
-	std::string _toOBJ() const;
+	// Arrays are split into header, rows [begin, end) and closing brace, so save() can write them in chunks.
+	// Vertex rows of onlyVertices are vertices of indices, index rows begin at triangle boundary
+	std::string _getVerticesHeader(bool onlyVertices, bool useArray, bool useFloat) const;
+	std::string _formatVertexRows(bool onlyVertices, bool useFloat, const size_t begin, const size_t end, ProgressToken* progress) const;
+	std::string _formatVertices(bool onlyVertices, bool useArray, bool useFloat, ProgressToken* progress) const;
+	std::string _getIndicesHeader(const size_t count, bool useArray) const;
+	std::string _formatIndexRows(const size_t begin, const size_t end) const;
+	std::string _formatIndices(bool useArray, ProgressToken* progress) const;
+	std::string _getStripIndicesHeader(const size_t count, bool useArray) const;
+	std::string _formatStripRows(const std::vector<unsigned int>& strip, const size_t begin, const size_t end) const;
+	std::string _formatStripIndices(const std::vector<unsigned int>& strip, bool useArray, ProgressToken* progress) const;
+	std::string _toJSON(bool onlyVertices, bool useStrip, ProgressToken* progress) const;
+	std::string _toOBJ(GenerationStats* stats, ProgressToken* progress) const;
+	std::string _getMeshletStructDefinition(bool isC99) const;
+	std::string _formatMeshlets(bool useArray, bool useFloat) const;
+	std::string _getLodStructDefinition(bool isC99) const;
+	std::string _formatLods(bool useArray, bool useFloat) const;
+	// Parts of C/C++ array formats: generated header with includes and struct definitions, meshlets and LODs after indices
+	std::string _getArrayPreamble(FormatType type) const;
+	std::string _getArrayExtras(bool useArray, bool useFloat) const;
+	std::string _toArray(FormatType type, ProgressToken* progress) const;
+	// Writes vertex in exported layout (see getVertexStride), returns number of floats
+	size_t _writeVertexFloats(const Vertex& v, float* out) const;
+	// Parts of binary format: file header with VERT chunk header, vertices [begin, end), LODS and meshlet chunks
+	std::string _getBinaryHeader(bool useStrip) const;
+	void _appendBinaryVertices(std::string& result, const size_t begin, const size_t end) const;
+	std::string _getBinaryExtras() const;
+	std::string _toBinary(bool useStrip, ProgressToken* progress) const;
+	// Binary and C/C++ array formats written by ExportPipeline in chunks of SAVE_CHUNK_VERTICES vertices and SAVE_CHUNK_INDICES indices,
+	// generator stage only slices the generated mesh (strip is built first). False when writing failed or was cancelled
+	bool _saveBinaryPipelined(std::ostream& out, bool useStrip, ProgressToken* progress) const;
+	bool _saveArrayPipelined(std::ostream& out, FormatType type, ProgressToken* progress) const;
+	// Text of toString, partial when progress gets cancelled
+	std::string _format(FormatType type, GenerationStats* stats, ProgressToken* progress) const;
+
+	// Stores generated vertices and indices
+	friend class MeshCache;
 
 public:
+	// Vertices and indices of one chunk written by save() of streamable formats, index chunks hold whole triangles
+	static constexpr size_t SAVE_CHUNK_VERTICES = 65536ull;
+	static constexpr size_t SAVE_CHUNK_INDICES = 12ull * SAVE_CHUNK_VERTICES;
+
 	Shape() = default;
+	// Vertices and indices use config.memoryResource
+	explicit Shape(const ShapeConfig& config);
 	virtual ~Shape();
 
-	std::string toString(FormatType type = FormatType::CPP_ARRAY_INDICES_STRUCT) const;
+	// stats - receives formatting phases, nullptr doesn't measure them.
+	// progress - receives formatting progress, returns empty string when it gets cancelled
+	std::string toString(FormatType type = FormatType::CPP_ARRAY_INDICES_STRUCT, GenerationStats* stats = nullptr, ProgressToken* progress = nullptr) const;
+	// Writes toString(type) to file. Streamable formats are formatted in chunks while earlier chunks are written (see ExportPipeline),
+	// output in flight doesn't grow with mesh. Mesh is already generated, so only formatting overlaps writing (TiledPlane generates
+	// while it writes). Returns false when file can't be written or progress got cancelled (file is removed)
+	bool save(const std::string& path, FormatType type = FormatType::CPP_ARRAY_INDICES_STRUCT, GenerationStats* stats = nullptr, ProgressToken* progress = nullptr) const;
+	// Formats save() writes chunk by chunk: binary and C/C++ arrays, strips after they are built over all triangles.
+	// OBJ (deduplicated attributes) and JSON (built as one document) are formatted whole before their first byte
+	static bool isStreamable(const FormatType type);
+	// Formats written as triangle strips (built by Stripifier) instead of a triangle list
+	static bool isStripFormat(const FormatType type);
+
+	// Runs enabled post-generation passes over vertices and indices
+	MeshOptimizeReport optimize(const MeshOptimizeOptions& options);
+	void optimizeVertexCache(const unsigned int cacheSize = MeshOptimizer::DEFAULT_CACHE_SIZE);
+	VertexCacheStats getVertexCacheStats(const unsigned int cacheSize = MeshOptimizer::DEFAULT_CACHE_SIZE, const VertexCacheType type = VertexCacheType::FIFO) const;
+	void optimizeVertexFetch();
+	VertexFetchStats getVertexFetchStats() const;
+	void optimizeOverdraw(const float threshold = MeshOptimizer::DEFAULT_OVERDRAW_THRESHOLD, const unsigned int cacheSize = MeshOptimizer::DEFAULT_CACHE_SIZE);
+	OverdrawStats getOverdrawStats() const;
+
+	// Meshlets are exported with indexed C/C++ array formats and binary format
+	void buildMeshlets(const uint32_t maxVertices = MeshletBuilder::DEFAULT_MAX_VERTICES, const uint32_t maxTriangles = MeshletBuilder::DEFAULT_MAX_TRIANGLES);
+	void clearMeshlets();
+	const MeshletData& getMeshlets() const;
+
+	// LODs share shape vertices and are exported with indexed formats (C/C++ arrays, JSON, OBJ and binary)
+	void generateLods(const unsigned int levels = Simplifier::DEFAULT_LOD_LEVELS, const float reduction = Simplifier::DEFAULT_LOD_REDUCTION, const unsigned int cacheSize = MeshOptimizer::DEFAULT_CACHE_SIZE);
+	void clearLods();
+	const LodChain& getLods() const;
+
+	void setPrimitiveRestart(const bool enabled);
+	bool isPrimitiveRestartEnabled() const;
+	std::vector<unsigned int> getStripIndices(StripStats* stats = nullptr) const;
+	StripStats getStripStats() const;
+	// Size in bytes of one exported vertex (depends on tangents and bitangents settings)
+	size_t getVertexStride() const;
+	static size_t getVertexStride(const ShapeConfig& config);
 
 	static std::string getClassName();
 	static std::string getFormatFileExtension(const FormatType& format);
 	virtual std::string getObjectClassName() const;
 	size_t getVerticesCount() const;
 	size_t getIndicesCount() const;
+	const std::pmr::vector<Vertex>& getVertices() const;
+	const std::pmr::vector<unsigned int>& getIndices() const;
+	// Moves vertices and indices out without copying, shape is left empty (meshlets and LODs are cleared).
+	// Zero-copy way to take the mesh, for caller owned memory set ShapeConfig::memoryResource
+	// (e.g. std::pmr::monotonic_buffer_resource over caller buffer) and release the shape
+	MeshData release();
+	// Bytes allocated for vertices, indices, meshlets and LODs
+	size_t getMemorySize() const;
+	// Timings of generation phases, empty for shapes made without generating
+	const GenerationStats& getGenerationStats() const;
+	// Generation was cancelled with ShapeConfig::progress, shape is empty
+	bool isCancelled() const;
+	// Parameters give more vertices or indices than unsigned int can index, shape is empty
+	bool exceedsIndexType() const;
 };
\ No newline at end of file
@@ -0,0 +1,85 @@
+#pragma region PCH
+#include "pch.hpp"
+#pragma endregion
+
+#pragma region STD_LIBS
+#include <list>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "Shape.hpp"
+#include "ShapeMemoryCache.hpp"
+#pragma endregion
+
+ShapeMemoryCache::ShapeMemoryCache(const size_t maxSize) : _maxSize(maxSize) {}
+
+std::optional<ShapeMemoryCache::Entry> ShapeMemoryCache::find(const std::string& key)
+{
+    auto it = _lookup.find(key);
+    if (it == _lookup.end()) return std::nullopt;
+
+    _nodes.splice(_nodes.begin(), _nodes, it->second);
+    return it->second->entry;
+}
+
+void ShapeMemoryCache::insert(const std::string& key, std::shared_ptr<Shape> shape, Details details)
+{
+    if (shape == nullptr) return;
+
+    erase(key);
+
+    const size_t size = shape->getMemorySize();
+    if (size > _maxSize) return;
+
+    _nodes.push_front({ key, { std::move(shape), std::move(details) }, size });
+    _lookup[key] = _nodes.begin();
+    _size += size;
+
+    _trim();
+}
+
+void ShapeMemoryCache::erase(const std::string& key)
+{
+    auto it = _lookup.find(key);
+    if (it == _lookup.end()) return;
+
+    _size -= it->second->size;
+    _nodes.erase(it->second);
+    _lookup.erase(it);
+}
+
+void ShapeMemoryCache::clear()
+{
+    _nodes.clear();
+    _lookup.clear();
+    _size = 0ull;
+}
+
+size_t ShapeMemoryCache::getSize() const
+{
+    return _size;
+}
+
+size_t ShapeMemoryCache::getCount() const
+{
+    return _nodes.size();
+}
+
+size_t ShapeMemoryCache::getMaxSize() const
+{
+    return _maxSize;
+}
+
+void ShapeMemoryCache::_trim()
+{
+    while (_size > _maxSize && !_nodes.empty()) {
+        const Node& oldest = _nodes.back();
+        _size -= oldest.size;
+        _lookup.erase(oldest.key);
+        _nodes.pop_back();
+    }
+}
\ No newline at end of file
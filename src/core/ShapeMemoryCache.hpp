@@ -0,0 +1,61 @@
+#pragma once
+
+#pragma region STD_LIBS
+#include <list>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "Shape.hpp"
+#pragma endregion
+
+// Least recently used shapes kept in memory, bounded by Shape::getMemorySize of all entries.
+// Shapes are shared, evicted shape stays alive as long as someone still holds it
+class ShapeMemoryCache
+{
+public:
+	// Label - value pairs shown with the shape (optimization report and similar)
+	using Details = std::vector<std::pair<std::string, std::string>>;
+
+	struct Entry
+	{
+		std::shared_ptr<Shape> shape;
+		Details details;
+	};
+
+	static constexpr size_t DEFAULT_MAX_SIZE = 512ull * 1024ull * 1024ull;
+
+	explicit ShapeMemoryCache(const size_t maxSize = DEFAULT_MAX_SIZE);
+
+	// Found entry becomes the most recently used one
+	std::optional<Entry> find(const std::string& key);
+	// Shape bigger than the whole cache is not kept
+	void insert(const std::string& key, std::shared_ptr<Shape> shape, Details details = {});
+	void erase(const std::string& key);
+	void clear();
+
+	size_t getSize() const;
+	size_t getCount() const;
+	size_t getMaxSize() const;
+
+private:
+	struct Node
+	{
+		std::string key;
+		Entry entry;
+		size_t size = 0ull;
+	};
+
+	void _trim();
+
+	// Most recently used first
+	std::list<Node> _nodes;
+	std::unordered_map<std::string, std::list<Node>::iterator> _lookup;
+	size_t _maxSize = DEFAULT_MAX_SIZE;
+	size_t _size = 0ull;
+};
\ No newline at end of file
@@ -0,0 +1,516 @@
+#pragma region PCH
+#include "pch.hpp"
+#pragma endregion
+
+#pragma region STD_LIBS
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <unordered_map>
+#include <vector>
+#pragma endregion
+
+#pragma region GLM_LIB
+#include <glm/fwd.hpp>
+#include <glm/geometric.hpp>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "MeshOptimizer.hpp"
+#include "Simplifier.hpp"
+#include "Vertex.hpp"
+#pragma endregion
+
+namespace {
+    enum VertexKind : uint8_t {
+        MANIFOLD = 0,   // Single attribute set, all edges shared by two triangles
+        BORDER   = 1,   // Single attribute set on an open mesh border
+        SEAM     = 2,   // Two attribute sets split along one edge loop
+        LOCKED   = 3    // Anything else (corners, poles, flat shading), never moved
+    };
+
+    // Collapse from kind (row) to kind (column)
+    constexpr bool canCollapse[4][4] = {
+        { true,  true,  true,  true },
+        { false, true,  false, true },
+        { false, false, true,  true },
+        { false, false, false, false }
+    };
+
+    // Edge between kinds is present in both directions, so it is processed once
+    constexpr bool hasOpposite[4][4] = {
+        { true,  true,  true,  true },
+        { true,  false, true,  false },
+        { true,  true,  true,  true },
+        { true,  false, true,  false }
+    };
+
+    // Border and seam edges are preserved by adding planes perpendicular to the triangle
+    constexpr float edgeWeight = 10.f;
+
+    constexpr unsigned int invalidIndex = ~0u;
+
+    struct Quadric
+    {
+        float a00 = 0.f, a11 = 0.f, a22 = 0.f;
+        float a10 = 0.f, a20 = 0.f, a21 = 0.f;
+        float b0 = 0.f, b1 = 0.f, b2 = 0.f;
+        float c = 0.f;
+        float w = 0.f;
+
+        void add(const Quadric& q)
+        {
+            a00 += q.a00; a11 += q.a11; a22 += q.a22;
+            a10 += q.a10; a20 += q.a20; a21 += q.a21;
+            b0 += q.b0; b1 += q.b1; b2 += q.b2;
+            c += q.c;
+            w += q.w;
+        }
+
+        // Squared distance to planes, weighted average
+        float error(const glm::vec3& v) const
+        {
+            float rx = b0, ry = b1, rz = b2;
+            rx += a10 * v.y; ry += a21 * v.z; rz += a20 * v.x;
+            rx *= 2.f; ry *= 2.f; rz *= 2.f;
+            rx += a00 * v.x; ry += a11 * v.y; rz += a22 * v.z;
+
+            const float r = c + rx * v.x + ry * v.y + rz * v.z;
+            return w > 0.f ? std::fabs(r) / w : 0.f;
+        }
+
+        static Quadric fromPlane(const glm::vec3& n, const float d, const float weight)
+        {
+            Quadric q;
+            q.a00 = n.x * n.x * weight; q.a11 = n.y * n.y * weight; q.a22 = n.z * n.z * weight;
+            q.a10 = n.y * n.x * weight; q.a20 = n.z * n.x * weight; q.a21 = n.z * n.y * weight;
+            q.b0 = n.x * d * weight; q.b1 = n.y * d * weight; q.b2 = n.z * d * weight;
+            q.c = d * d * weight;
+            q.w = weight;
+            return q;
+        }
+    };
+
+    struct Collapse
+    {
+        unsigned int v0;
+        unsigned int v1;
+        bool bidirectional;
+        float error;
+    };
+
+    // Per position list of triangle corners (other two vertices, in winding order)
+    struct Adjacency
+    {
+        std::vector<unsigned int> offsets;
+        std::vector<std::pair<unsigned int, unsigned int>> corners;
+
+        void build(const std::vector<unsigned int>& indices, const size_t indexCount, const std::vector<unsigned int>& remap)
+        {
+            offsets.assign(remap.size() + 1ull, 0u);
+            for (size_t i = 0ull; i < indexCount; ++i) ++offsets[remap[indices[i]] + 1ull];
+            for (size_t i = 1ull; i < offsets.size(); ++i) offsets[i] += offsets[i - 1ull];
+
+            corners.resize(indexCount);
+            std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+            for (size_t i = 0ull; i < indexCount; i += 3ull) {
+                const unsigned int a = indices[i], b = indices[i + 1ull], c = indices[i + 2ull];
+                corners[fill[remap[a]]++] = { b, c };
+                corners[fill[remap[b]]++] = { c, a };
+                corners[fill[remap[c]]++] = { a, b };
+            }
+        }
+    };
+
+    bool hasTriangleFlips(const Adjacency& adjacency, const std::vector<glm::vec3>& positions, const std::vector<unsigned int>& remap, const std::vector<unsigned int>& collapseRemap, const unsigned int i0, const unsigned int i1)
+    {
+        const glm::vec3& v0 = positions[i0];
+        const glm::vec3& v1 = positions[i1];
+        const unsigned int r1 = remap[i1];
+
+        for (unsigned int i = adjacency.offsets[remap[i0]]; i < adjacency.offsets[remap[i0] + 1u]; ++i) {
+            const unsigned int a = collapseRemap[adjacency.corners[i].first];
+            const unsigned int b = collapseRemap[adjacency.corners[i].second];
+
+            // Triangles containing the collapsed edge disappear
+            if (remap[a] == r1 || remap[b] == r1) continue;
+
+            const glm::vec3 ab = positions[b] - positions[a];
+            const glm::vec3 before = glm::cross(ab, v0 - positions[a]);
+            const glm::vec3 after = glm::cross(ab, v1 - positions[a]);
+            if (glm::dot(before, after) <= 0.f) return true;
+        }
+
+        return false;
+    }
+
+    void remapEdgeLoops(std::vector<unsigned int>& loop, const std::vector<unsigned int>& collapseRemap)
+    {
+        for (size_t i = 0ull; i < loop.size(); ++i) {
+            if (loop[i] == invalidIndex) continue;
+
+            const unsigned int l = loop[i];
+            const unsigned int r = collapseRemap[l];
+
+            // Loop edge was collapsed into this vertex, follow it
+            if (r == (unsigned int)i) loop[i] = loop[l] != invalidIndex ? collapseRemap[loop[l]] : invalidIndex;
+            else loop[i] = r;
+        }
+    }
+}
+
+float Simplifier::_getExtent(std::span<const Vertex> vertices)
+{
+    if (vertices.empty()) return 0.f;
+
+    glm::vec3 minPos = vertices[0].Position;
+    glm::vec3 maxPos = vertices[0].Position;
+    for (const Vertex& v : vertices) {
+        minPos = glm::vec3(std::min(minPos.x, v.Position.x), std::min(minPos.y, v.Position.y), std::min(minPos.z, v.Position.z));
+        maxPos = glm::vec3(std::max(maxPos.x, v.Position.x), std::max(maxPos.y, v.Position.y), std::max(maxPos.z, v.Position.z));
+    }
+
+    const glm::vec3 size = maxPos - minPos;
+    return std::max(size.x, std::max(size.y, size.z));
+}
+
+std::vector<unsigned int> Simplifier::simplify(std::span<const unsigned int> indices, std::span<const Vertex> vertices, const size_t targetIndexCount, const float targetError, float* resultError)
+{
+    std::vector<unsigned int> result(indices.begin(), indices.end());
+    if (resultError) *resultError = 0.f;
+
+    const size_t vertexCount = vertices.size();
+    if (result.size() <= targetIndexCount || vertexCount == 0ull) return result;
+
+    // POSITIONS (normalized to unit cube, so errors are relative to extent)
+    const float extent = _getExtent(vertices);
+    const float scale = extent > 0.f ? 1.f / extent : 0.f;
+
+    std::vector<glm::vec3> positions(vertexCount);
+    for (size_t i = 0ull; i < vertexCount; ++i) {
+        positions[i] = vertices[i].Position * scale;
+    }
+
+    // POSITION REMAP AND WEDGES
+    // remap - first vertex with the same position, wedge - circular list of vertices with the same position
+    std::vector<unsigned int> remap(vertexCount);
+    std::vector<unsigned int> wedge(vertexCount);
+    {
+        std::unordered_map<glm::vec3, unsigned int, Vec3Hash, Vec3Equal> firstVertex;
+        firstVertex.reserve(vertexCount);
+
+        for (unsigned int i = 0u; i < (unsigned int)vertexCount; ++i) {
+            auto [it, inserted] = firstVertex.try_emplace(vertices[i].Position, i);
+            remap[i] = it->second;
+            wedge[i] = i;
+
+            if (!inserted) {
+                const unsigned int first = it->second;
+                wedge[i] = wedge[first];
+                wedge[first] = i;
+            }
+        }
+    }
+
+    // OPEN EDGES (in index space, so attribute seams are open too)
+    std::vector<unsigned int> loop(vertexCount, invalidIndex);
+    std::vector<unsigned int> loopback(vertexCount, invalidIndex);
+    {
+        std::vector<unsigned int> offsets(vertexCount + 1ull, 0u);
+        for (unsigned int idx : result) ++offsets[idx + 1ull];
+        for (size_t i = 1ull; i < offsets.size(); ++i) offsets[i] += offsets[i - 1ull];
+
+        std::vector<unsigned int> next(result.size());
+        std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0ull; i < result.size(); i += 3ull) {
+            for (size_t e = 0ull; e < 3ull; ++e) {
+                next[fill[result[i + e]]++] = result[i + (e + 1ull) % 3ull];
+            }
+        }
+
+        auto hasEdge = [&](const unsigned int a, const unsigned int b) -> bool {
+            for (unsigned int i = offsets[a]; i < offsets[a + 1ull]; ++i) {
+                if (next[i] == b) return true;
+            }
+            return false;
+        };
+
+        // Vertex itself marks more than one open edge
+        for (unsigned int v = 0u; v < (unsigned int)vertexCount; ++v) {
+            for (unsigned int i = offsets[v]; i < offsets[v + 1ull]; ++i) {
+                const unsigned int target = next[i];
+
+                if (target == v) {
+                    loop[v] = v;
+                    loopback[v] = v;
+                }
+                else if (!hasEdge(target, v)) {
+                    loopback[target] = loopback[target] == invalidIndex ? v : target;
+                    loop[v] = loop[v] == invalidIndex ? target : v;
+                }
+            }
+        }
+    }
+
+    // VERTEX KINDS
+    std::vector<uint8_t> kinds(vertexCount, LOCKED);
+    for (unsigned int i = 0u; i < (unsigned int)vertexCount; ++i) {
+        if (remap[i] != i) continue;
+
+        if (wedge[i] == i) {
+            const unsigned int openIn = loopback[i], openOut = loop[i];
+
+            if (openIn == invalidIndex && openOut == invalidIndex) kinds[i] = MANIFOLD;
+            else if (openIn != invalidIndex && openOut != invalidIndex && openIn != i && openOut != i) kinds[i] = BORDER;
+        }
+        else if (wedge[wedge[i]] == i) {
+            const unsigned int w = wedge[i];
+            const unsigned int inV = loopback[i], outV = loop[i], inW = loopback[w], outW = loop[w];
+
+            // Seam has to continue on the other side in opposite direction
+            if (inV != invalidIndex && inV != i && outV != invalidIndex && outV != i &&
+                inW != invalidIndex && inW != w && outW != invalidIndex && outW != w &&
+                remap[inV] == remap[outW] && remap[outV] == remap[inW] && remap[inV] != remap[outV]) {
+                kinds[i] = SEAM;
+            }
+        }
+    }
+
+    for (unsigned int i = 0u; i < (unsigned int)vertexCount; ++i) {
+        kinds[i] = kinds[remap[i]];
+        if (loop[i] == i) loop[i] = invalidIndex;
+        if (loopback[i] == i) loopback[i] = invalidIndex;
+    }
+
+    // QUADRICS (per position)
+    std::vector<Quadric> quadrics(vertexCount);
+    for (size_t i = 0ull; i < result.size(); i += 3ull) {
+        const unsigned int i0 = result[i], i1 = result[i + 1ull], i2 = result[i + 2ull];
+        const glm::vec3& p0 = positions[i0];
+
+        glm::vec3 normal = glm::cross(positions[i1] - p0, positions[i2] - p0);
+        const float area = glm::length(normal);
+        if (area > 0.f) normal /= area;
+
+        const Quadric q = Quadric::fromPlane(normal, -glm::dot(normal, p0), area);
+        quadrics[remap[i0]].add(q);
+        quadrics[remap[i1]].add(q);
+        quadrics[remap[i2]].add(q);
+
+        const unsigned int tri[3] = { i0, i1, i2 };
+        for (int e = 0; e < 3; ++e) {
+            const unsigned int a = tri[e], b = tri[(e + 1) % 3], c = tri[(e + 2) % 3];
+            const uint8_t ka = kinds[a], kb = kinds[b];
+
+            if (ka != BORDER && ka != SEAM && kb != BORDER && kb != SEAM) continue;
+            if ((ka == BORDER || ka == SEAM) && loop[a] != b) continue;
+            if ((kb == BORDER || kb == SEAM) && loopback[b] != a) continue;
+            if (hasOpposite[ka][kb] && remap[b] > remap[a]) continue;
+
+            // Plane through the edge, perpendicular to the triangle
+            glm::vec3 edge = positions[b] - positions[a];
+            const float length = glm::length(edge);
+            if (length <= 0.f) continue;
+            edge /= length;
+
+            const glm::vec3 toC = positions[c] - positions[a];
+            glm::vec3 edgeNormal = toC - edge * glm::dot(toC, edge);
+            const float normalLength = glm::length(edgeNormal);
+            if (normalLength <= 0.f) continue;
+            edgeNormal /= normalLength;
+
+            const Quadric eq = Quadric::fromPlane(edgeNormal, -glm::dot(edgeNormal, positions[a]), length * length * edgeWeight);
+            quadrics[remap[a]].add(eq);
+            quadrics[remap[b]].add(eq);
+        }
+    }
+
+    // EDGE COLLAPSE PASSES
+    Adjacency adjacency;
+    std::vector<Collapse> collapses;
+    std::vector<unsigned int> order;
+    std::vector<unsigned int> collapseRemap(vertexCount);
+    std::vector<uint8_t> collapseLocked(vertexCount);
+
+    const float errorLimit = targetError * targetError;
+    float maxError = 0.f;
+    size_t resultCount = result.size();
+
+    while (resultCount > targetIndexCount) {
+        adjacency.build(result, resultCount, remap);
+
+        // PICK
+        collapses.clear();
+        for (size_t i = 0ull; i < resultCount; i += 3ull) {
+            for (size_t e = 0ull; e < 3ull; ++e) {
+                const unsigned int i0 = result[i + e];
+                const unsigned int i1 = result[i + (e + 1ull) % 3ull];
+                const uint8_t k0 = kinds[i0], k1 = kinds[i1];
+
+                if (remap[i0] == remap[i1]) continue;
+                if (!canCollapse[k0][k1] && !canCollapse[k1][k0]) continue;
+                if (hasOpposite[k0][k1] && remap[i1] > remap[i0]) continue;
+
+                // Border and seam vertices move only along their own edge loop
+                if ((k0 == BORDER || k0 == SEAM) && k1 != MANIFOLD && loop[i0] != i1) continue;
+                if ((k1 == BORDER || k1 == SEAM) && k0 != MANIFOLD && loopback[i1] != i0) continue;
+
+                if (canCollapse[k0][k1] && canCollapse[k1][k0]) {
+                    collapses.push_back({ i0, i1, true, 0.f });
+                }
+                else {
+                    const bool forward = canCollapse[k0][k1];
+                    collapses.push_back({ forward ? i0 : i1, forward ? i1 : i0, false, 0.f });
+                }
+            }
+        }
+
+        if (collapses.empty()) break;
+
+        // RANK (pick direction with smaller error)
+        for (Collapse& c : collapses) {
+            const float forwardError = quadrics[remap[c.v0]].error(positions[c.v1]);
+            const float backwardError = c.bidirectional ? quadrics[remap[c.v1]].error(positions[c.v0]) : FLT_MAX;
+
+            if (backwardError < forwardError) std::swap(c.v0, c.v1);
+            c.error = std::min(forwardError, backwardError);
+        }
+
+        order.resize(collapses.size());
+        std::iota(order.begin(), order.end(), 0u);
+        std::sort(order.begin(), order.end(), [&collapses](const unsigned int a, const unsigned int b) {
+            return collapses[a].error < collapses[b].error;
+        });
+
+        // PERFORM
+        std::iota(collapseRemap.begin(), collapseRemap.end(), 0u);
+        std::fill(collapseLocked.begin(), collapseLocked.end(), 0u);
+
+        const size_t triangleCollapseGoal = (resultCount - targetIndexCount) / 3ull;
+        size_t edgeCollapseGoal = triangleCollapseGoal / 2ull;
+        size_t triangleCollapses = 0ull;
+        size_t edgeCollapses = 0ull;
+
+        for (size_t i = 0ull; i < order.size(); ++i) {
+            const Collapse& c = collapses[order[i]];
+
+            if (c.error > errorLimit) break;
+            if (triangleCollapses >= triangleCollapseGoal) break;
+
+            // Many collapses get locked by neighbours, so the pass accepts errors a bit above
+            // the error of the last collapse needed to reach the goal to stay roughly uniform
+            const float errorGoal = edgeCollapseGoal < collapses.size() ? 1.5f * collapses[order[edgeCollapseGoal]].error : FLT_MAX;
+            if (c.error > errorGoal && triangleCollapses > triangleCollapseGoal / 6ull) break;
+
+            const unsigned int i0 = c.v0, i1 = c.v1;
+            const unsigned int r0 = remap[i0], r1 = remap[i1];
+
+            // Vertices are moved at most once per pass and nothing is moved onto a moved vertex
+            if (collapseLocked[r0] || collapseLocked[r1]) continue;
+
+            if (hasTriangleFlips(adjacency, positions, remap, collapseRemap, i0, i1)) {
+                ++edgeCollapseGoal;
+                continue;
+            }
+
+            if (kinds[i0] == SEAM) {
+                // Other side of the seam moves to the matching wedge of the target
+                const unsigned int s0 = wedge[i0];
+                const unsigned int s1 = loop[i0] == i1 ? loopback[s0] : loop[s0];
+
+                if (s1 == invalidIndex || remap[s1] != r1) continue;
+
+                collapseRemap[i0] = i1;
+                collapseRemap[s0] = s1;
+            }
+            else {
+                unsigned int v = i0;
+                do {
+                    collapseRemap[v] = i1;
+                    v = wedge[v];
+                } while (v != i0);
+            }
+
+            collapseLocked[r0] = 1u;
+            collapseLocked[r1] = 1u;
+
+            quadrics[r1].add(quadrics[r0]);
+
+            // Border edge removes one triangle, other edges two
+            triangleCollapses += kinds[i0] == BORDER ? 1ull : 2ull;
+            ++edgeCollapses;
+            maxError = std::max(maxError, c.error);
+        }
+
+        if (edgeCollapses == 0ull) break;
+
+        remapEdgeLoops(loop, collapseRemap);
+        remapEdgeLoops(loopback, collapseRemap);
+
+        // Remove triangles that became degenerate
+        size_t writeCount = 0ull;
+        for (size_t i = 0ull; i < resultCount; i += 3ull) {
+            const unsigned int v0 = collapseRemap[result[i]];
+            const unsigned int v1 = collapseRemap[result[i + 1ull]];
+            const unsigned int v2 = collapseRemap[result[i + 2ull]];
+
+            if (remap[v0] == remap[v1] || remap[v0] == remap[v2] || remap[v1] == remap[v2]) continue;
+
+            result[writeCount++] = v0;
+            result[writeCount++] = v1;
+            result[writeCount++] = v2;
+        }
+        resultCount = writeCount;
+    }
+
+    result.resize(resultCount);
+    result.shrink_to_fit();
+
+    if (resultError) *resultError = std::sqrt(maxError);
+
+    return result;
+}
+
+LodChain Simplifier::buildLodChain(std::span<const unsigned int> indices, std::span<const Vertex> vertices, const unsigned int levels, const float reduction, const unsigned int cacheSize)
+{
+    LodChain chain;
+    if (indices.empty()) return chain;
+
+    const float extent = _getExtent(vertices);
+    const size_t triangleCount = indices.size() / 3ull;
+
+    chain.indices.assign(indices.begin(), indices.end());
+    chain.levels.push_back({ 0u, (uint32_t)indices.size(), 1.f, 0.f, 0.f });
+
+    const unsigned int levelCount = std::min(levels, MAX_LOD_LEVELS);
+    float ratio = 1.f;
+
+    for (unsigned int level = 1u; level < levelCount + 1u; ++level) {
+        ratio *= std::clamp(reduction, 0.f, 1.f);
+        const size_t targetIndexCount = (size_t)((float)triangleCount * ratio) * 3ull;
+
+        // Every level is simplified from LOD 0, so reported error is measured against the full mesh
+        float error = 0.f;
+        std::vector<unsigned int> lod = simplify(indices, vertices, targetIndexCount, 1.f, &error);
+
+        // Nothing left to collapse (locked vertices), further levels would be the same
+        if (lod.empty() || lod.size() >= chain.levels.back().indexCount) break;
+
+        MeshOptimizer::optimizeVertexCache(lod, vertices.size(), cacheSize);
+
+        LodLevel lodLevel;
+        lodLevel.indexOffset = (uint32_t)chain.indices.size();
+        lodLevel.indexCount = (uint32_t)lod.size();
+        lodLevel.targetRatio = ratio;
+        lodLevel.error = error;
+        lodLevel.absoluteError = error * extent;
+
+        chain.indices.insert(chain.indices.end(), lod.begin(), lod.end());
+        chain.levels.push_back(lodLevel);
+    }
+
+    return chain;
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+#pragma once
+
+#pragma region STD_LIBS
+#include <cstdint>
+#include <span>
+#include <vector>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "Vertex.hpp"
+#pragma endregion
+
+struct LodLevel
+{
+	// Range in LodChain::indices
+	uint32_t indexOffset = 0u;
+	uint32_t indexCount = 0u;
+	// Requested triangle count relative to LOD 0
+	float targetRatio = 1.f;
+	// Geometric error relative to mesh extent (largest bounding box side) and in shape units
+	float error = 0.f;
+	float absoluteError = 0.f;
+};
+
+struct LodChain
+{
+	// All levels share shape vertices, LOD 0 is a copy of shape indices
+	std::vector<unsigned int> indices;
+	std::vector<LodLevel> levels;
+
+	bool empty() const { return levels.empty(); }
+};
+
+class Simplifier
+{
+private:
+	static float _getExtent(std::span<const Vertex> vertices);
+
+public:
+	static constexpr unsigned int DEFAULT_LOD_LEVELS = 3u;
+	static constexpr unsigned int MAX_LOD_LEVELS = 8u;
+	static constexpr float DEFAULT_LOD_REDUCTION = 0.5f;
+
+	// Quadric error metric edge collapse (Garland, Heckbert - Surface Simplification Using Quadric Error Metrics)
+	// Vertices are never moved or created, so the result indexes the same vertex buffer.
+	// Vertices sharing a position but not attributes (UV seams, hard edges) are collapsed only along the seam
+	// together with their pair, mesh borders only along the border and vertices with more than two attribute sets are kept.
+	// Returns indices with at most targetIndexCount indices (if error allows), error is relative to mesh extent
+	static std::vector<unsigned int> simplify(std::span<const unsigned int> indices, std::span<const Vertex> vertices, const size_t targetIndexCount, const float targetError = 1.f, float* resultError = nullptr);
+
+	// LOD n targets reduction^n of LOD 0 triangles, levels that can't be simplified further are not added
+	static LodChain buildLodChain(std::span<const unsigned int> indices, std::span<const Vertex> vertices, const unsigned int levels = DEFAULT_LOD_LEVELS, const float reduction = DEFAULT_LOD_REDUCTION, const unsigned int cacheSize = 32u);
+};
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
+#include <memory_resource>
 #include <string>
 #include <utility>
 #include <vector>
@@ -17,7 +18,10 @@
 #pragma endregion
 
 #pragma region MY_FILES
+#include "BitMathOperators.hpp"
 #include "Constants.hpp"
+#include "GenerationArena.hpp"
+#include "GenerationStats.hpp"
 #include "Shape.hpp"
 #include "Sphere.hpp"
 #include "Vertex.hpp"
@@ -38,9 +42,12 @@ void Sphere::_generate(const unsigned int h, const unsigned int v, const ValuesR
 	const float texHDiff = 1.f / (float)h;
 	const float texVDiff = 1.f / (float)v;
 
-	std::vector<unsigned int> trisNum;
+	// Temporaries of this generation
+	GenerationArena arena;
+	std::pmr::vector<unsigned int> trisNum(arena.resource());
 
 	// VERTICIES AND NUMBER OF TRIANGLES
+	PhaseTimer vertexTimer(&_generationStats, "vertex generation");
 	// TOP VERTEX
 	_vertices.push_back({ { 0.f, 1.f * mult, 0.f }, { .5f, 0.f }, { 0.f, 1.f, 0.f }, glm::vec3(0.f), glm::vec3(0.f) });
 	if (_shapeConfig.genTangents) trisNum.push_back(v);
@@ -48,6 +55,8 @@ void Sphere::_generate(const unsigned int h, const unsigned int v, const ValuesR
 	// TOP HALF AND BOTTOM HALF
 	float angleY = angleYDiff;
 	for (unsigned int i = 0u; i < h - 1u; ++i) {
+		if (_reportProgress("vertex generation", i, h - 1u)) return;
+
 		const float r = sinf(angleY) * mult;
 		const float y = cosf(angleY) * mult;
 
@@ -94,12 +103,13 @@ void Sphere::_generate(const unsigned int h, const unsigned int v, const ValuesR
 	// BOTTOM VERTEX
 	_vertices.push_back({ { 0.f, -1.f * mult, 0.f }, { .5f, 1.f }, { 0.f, -1.f, 0.f }, glm::vec3(0.f), glm::vec3(0.f) });
 	if (_shapeConfig.genTangents) trisNum.push_back(v);
+	vertexTimer.stop();
 
 	// INDICIES, TANGENTS AND BITANGENTS
-	glm::vec3 tangent;
-
 	if (useFlatShading) {
-		std::vector<Vertex> tempVertices(_vertices);
+		PhaseTimer flatTimer(&_generationStats, "flat shading");
+		glm::vec3 tangent;
+		std::pmr::vector<Vertex> tempVertices(_vertices, arena.resource());
 		_vertices.clear();
 
 		// TOP CIRCLE + BOTTOM CIRCLE
@@ -157,6 +167,8 @@ void Sphere::_generate(const unsigned int h, const unsigned int v, const ValuesR
 
 		// CENTER CIRCLES
 		for (unsigned int c = 0u; c < h - 2u; ++c) {
+			if (_reportProgress("flat shading", c, h - 2u)) return;
+
 			const unsigned int startV = c * (v + 1u) + 1u;
 			for (unsigned int i = 0u; i < v; ++i) {
 				const unsigned int topLeft = i + startV;
@@ -208,6 +220,7 @@ void Sphere::_generate(const unsigned int h, const unsigned int v, const ValuesR
 		}
 	}
 	else {
+		PhaseTimer indexTimer(&_generationStats, "index generation");
 		// TOP CIRCLE + BOTTOM CIRCLE
 		const size_t verticesNum = _vertices.size();
 		for (unsigned int i = 0u; i < v; ++i) {
@@ -220,14 +233,6 @@ void Sphere::_generate(const unsigned int h, const unsigned int v, const ValuesR
 			_indices.push_back(topVertex);
 			_indices.push_back(leftVertex);
 
-			if (_shapeConfig.genTangents) {
-				tangent = _calcTangent(rightVertex, topVertex, leftVertex);
-
-				_vertices[rightVertex].Tangent += tangent;
-				_vertices[topVertex].Tangent += tangent;
-				_vertices[leftVertex].Tangent += tangent;
-			}
-
 			// BOTTOM CIRCLE
 			rightVertex = (unsigned int)verticesNum - 2u - v - 1u + (i + 1u) + 1u;
 			leftVertex = (unsigned int)verticesNum - 2u - v - 1u + i + 1u;
@@ -236,18 +241,12 @@ void Sphere::_generate(const unsigned int h, const unsigned int v, const ValuesR
 			_indices.push_back(rightVertex);
 			_indices.push_back(leftVertex);
 			_indices.push_back(topVertex);
-
-			if (_shapeConfig.genTangents) {
-				tangent = _calcTangent(rightVertex, leftVertex, topVertex);
-
-				_vertices[rightVertex].Tangent += tangent;
-				_vertices[leftVertex].Tangent += tangent;
-				_vertices[topVertex].Tangent += tangent;
-			}
 		}
 
 		// CENTER CIRCLES
 		for (unsigned int c = 0u; c < h - 2u; ++c) {
+			if (_reportProgress("index generation", c, h - 2u)) return;
+
 			const unsigned int startV = c * (v + 1u) + 1u;
 			for (unsigned int i = 0u; i < v; ++i) {
 				const unsigned int topLeft = i + startV;
@@ -264,41 +263,42 @@ void Sphere::_generate(const unsigned int h, const unsigned int v, const ValuesR
 				_indices.push_back(bottomRight);
 				_indices.push_back(topRight);
 				_indices.push_back(bottomLeft);
+			}
+		}
 
-				if (_shapeConfig.genTangents) {
-					// first triangle
-					tangent = _calcTangent(topRight, topLeft, bottomLeft);
-
-					_vertices[topRight].Tangent += tangent;
-					_vertices[topLeft].Tangent += tangent;
-					_vertices[bottomLeft].Tangent += tangent;
+		indexTimer.stop();
 
-					// second triangle
-					tangent = _calcTangent(bottomRight, topRight, bottomLeft);
+		if (_shapeConfig.genTangents) {
+			_accumulateTangents(0ull, _indices.size());
+			if (_cancelled) return;
 
-					_vertices[bottomRight].Tangent += tangent;
-					_vertices[topRight].Tangent += tangent;
-					_vertices[bottomLeft].Tangent += tangent;
-				}
-			}
+			_normalizeTangentsAndGenerateBitangents(trisNum, 0ull, verticesNum);
 		}
-
-		if (_shapeConfig.genTangents) _normalizeTangentsAndGenerateBitangents(trisNum, 0ull, verticesNum);
 	}
 
 	trisNum.clear();
 }
 
 Sphere::Sphere(const ShapeConfig& config, const unsigned int h, const unsigned int v, const ValuesRange range, const Shading shading)
+	: Shape(config)
 {
-	_shapeConfig = config;
 	_vertices.clear();
 	_indices.clear();
+	if (!_checkIndexType(getMeshCounts(h, v, range, shading))) return;
 	_generate(std::max(2u, h), std::max(3u, v), range, shading == Shading::FLAT);
 }
 
 Sphere::~Sphere() {}
 
+MeshCounts Sphere::getMeshCounts(const unsigned int h, const unsigned int v, const ValuesRange, const Shading shading)
+{
+	const size_t rings = std::max(2u, h);
+	const size_t segments = std::max(3u, v);
+	const size_t indices = mul_sat<size_t>(6ull * segments, rings - 1ull);
+	// Flat shading doesn't share vertices, smooth one adds seam vertex to every ring
+	return { shading == Shading::FLAT ? indices : 2ull + (rings - 1ull) * (segments + 1ull), indices };
+}
+
 std::string Sphere::getClassName()
 {
 	return "Sphere";
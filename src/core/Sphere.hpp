@@ -21,6 +21,8 @@ public:
 	Sphere(const ShapeConfig& config, const unsigned int h = 2u, const unsigned int v = 3u, const ValuesRange range = ValuesRange::HALF_TO_HALF, const Shading shading = Shading::SMOOTH);
 	virtual ~Sphere();
 
+	// Same parameters (and clamping) as constructor
+	static MeshCounts getMeshCounts(const unsigned int h = 2u, const unsigned int v = 3u, const ValuesRange range = ValuesRange::HALF_TO_HALF, const Shading shading = Shading::SMOOTH);
 	static std::string getClassName();
 	std::string getObjectClassName() const override;
 };
\ No newline at end of file
@@ -0,0 +1,118 @@
+#pragma once
+
+#pragma region STD_LIBS
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#pragma endregion
+
+// Bounded lock-free ring buffer of one producer and one consumer thread. tryPush and tryPop never block,
+// push and pop sleep on the other side's index (std::atomic::wait) while queue is full or empty.
+// close() ends the stream, consumer still gets items pushed before it
+template<class T>
+class SpscQueue
+{
+public:
+	// Capacity is rounded up to a power of two
+	explicit SpscQueue(const size_t capacity)
+		: _capacity(roundCapacity(capacity)), _slots(std::make_unique<T[]>(_capacity)) {}
+
+	// Power of two not less than capacity (at least 1)
+	static size_t roundCapacity(const size_t capacity)
+	{
+		size_t rounded = 1ull;
+		while (rounded < capacity) rounded <<= 1;
+		return rounded;
+	}
+
+	SpscQueue(const SpscQueue&) = delete;
+	SpscQueue& operator=(const SpscQueue&) = delete;
+
+	// Producer only, false when queue is full or closed (item isn't moved then)
+	bool tryPush(T& item)
+	{
+		const size_t tail = _tail.load(std::memory_order_relaxed);
+		const size_t head = _head.load(std::memory_order_acquire);
+		if (((head | tail) & CLOSED) != 0ull || _index(tail) - _index(head) >= _capacity) return false;
+
+		_slots[_index(tail) & (_capacity - 1ull)] = std::move(item);
+		// Read-modify-write keeps closed flag set by consumer
+		_tail.fetch_add(1ull, std::memory_order_release);
+		_tail.notify_one();
+		return true;
+	}
+
+	// Producer only, waits for free slot, false when queue was closed
+	bool push(T item)
+	{
+		while (true) {
+			if (tryPush(item)) return true;
+
+			const size_t head = _head.load(std::memory_order_acquire);
+			if (((head | _tail.load(std::memory_order_relaxed)) & CLOSED) != 0ull) return false;
+			if (_index(_tail.load(std::memory_order_relaxed)) - _index(head) >= _capacity) _head.wait(head, std::memory_order_acquire);
+		}
+	}
+
+	// Consumer only, false when queue is empty
+	bool tryPop(T& item)
+	{
+		const size_t head = _head.load(std::memory_order_relaxed);
+		const size_t tail = _tail.load(std::memory_order_acquire);
+		if (_index(head) == _index(tail)) return false;
+
+		// Moved out slot is reset, so it doesn't hold memory until it is reused
+		T& slot = _slots[_index(head) & (_capacity - 1ull)];
+		item = std::move(slot);
+		slot = T();
+		_head.fetch_add(1ull, std::memory_order_release);
+		_head.notify_one();
+		return true;
+	}
+
+	// Consumer only, waits for item, false when queue is closed and empty
+	bool pop(T& item)
+	{
+		while (true) {
+			if (tryPop(item)) return true;
+
+			const size_t tail = _tail.load(std::memory_order_acquire);
+			if (_index(tail) != _index(_head.load(std::memory_order_relaxed))) continue;
+			if ((tail & CLOSED) != 0ull) return false;
+			_tail.wait(tail, std::memory_order_acquire);
+		}
+	}
+
+	// Either side, wakes the other one. Producer closes after last item, consumer when it stops early
+	void close()
+	{
+		_head.fetch_or(CLOSED, std::memory_order_release);
+		_tail.fetch_or(CLOSED, std::memory_order_release);
+		_head.notify_all();
+		_tail.notify_all();
+	}
+
+	bool isClosed() const
+	{
+		return (_tail.load(std::memory_order_acquire) & CLOSED) != 0ull;
+	}
+
+	size_t getCapacity() const
+	{
+		return _capacity;
+	}
+
+private:
+	// Highest bit of both indices, set on close so waiting side sees changed value
+	static constexpr size_t CLOSED = ~(~size_t(0) >> 1);
+	// Indices are on separate cache lines, producer and consumer don't invalidate each other's
+	static constexpr size_t CACHE_LINE_BYTES = 64ull;
+
+	static size_t _index(const size_t value) { return value & ~CLOSED; }
+
+	alignas(CACHE_LINE_BYTES) std::atomic<size_t> _head = 0ull;
+	alignas(CACHE_LINE_BYTES) std::atomic<size_t> _tail = 0ull;
+	alignas(CACHE_LINE_BYTES) size_t _capacity = 1ull;
+	std::unique_ptr<T[]> _slots;
+};
@@ -0,0 +1,188 @@
+#pragma region PCH
+#include "pch.hpp"
+#pragma endregion
+
+#pragma region STD_LIBS
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "Stripifier.hpp"
+#pragma endregion
+
+std::vector<unsigned int> Stripifier::stripify(std::span<const unsigned int> indices, const size_t vertexCount, const bool usePrimitiveRestart, StripStats* stats)
+{
+    constexpr size_t invalidTriangle = ~0ull;
+
+    std::vector<unsigned int> strip;
+
+    // Degenerate triangles are not drawn anyway
+    std::vector<unsigned int> triangles;
+    triangles.reserve(indices.size());
+    for (size_t i = 0ull; i + 2ull < indices.size(); i += 3ull) {
+        const unsigned int a = indices[i], b = indices[i + 1ull], c = indices[i + 2ull];
+        if (a == b || a == c || b == c) continue;
+
+        triangles.push_back(a);
+        triangles.push_back(b);
+        triangles.push_back(c);
+    }
+
+    const size_t triangleCount = triangles.size() / 3ull;
+
+    // VERTEX -> TRIANGLES
+    std::vector<unsigned int> offsets(vertexCount + 1ull, 0u);
+    for (unsigned int idx : triangles) ++offsets[idx + 1ull];
+    for (size_t i = 1ull; i < offsets.size(); ++i) offsets[i] += offsets[i - 1ull];
+
+    std::vector<unsigned int> vertexTriangles(triangles.size());
+    {
+        std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0ull; i < triangles.size(); ++i) {
+            vertexTriangles[fill[triangles[i]]++] = (unsigned int)(i / 3ull);
+        }
+    }
+
+    std::vector<uint8_t> used(triangleCount, 0u);
+
+    // Unused triangle with directed edge a -> b
+    auto findTriangle = [&](const unsigned int a, const unsigned int b) -> size_t {
+        for (unsigned int k = offsets[a]; k < offsets[a + 1u]; ++k) {
+            const unsigned int t = vertexTriangles[k];
+            if (used[t]) continue;
+
+            const unsigned int* v = &triangles[t * 3ull];
+            if ((v[0] == a && v[1] == b) || (v[1] == a && v[2] == b) || (v[2] == a && v[0] == b)) return t;
+        }
+        return invalidTriangle;
+    };
+
+    auto thirdVertex = [&](const size_t t, const unsigned int a, const unsigned int b) -> unsigned int {
+        const unsigned int* v = &triangles[t * 3ull];
+        for (int k = 0; k < 3; ++k) {
+            if (v[k] != a && v[k] != b) return v[k];
+        }
+        return v[0];
+    };
+
+    auto countNeighbours = [&](const size_t t) -> int {
+        const unsigned int* v = &triangles[t * 3ull];
+        int count = 0;
+        for (int k = 0; k < 3; ++k) {
+            if (findTriangle(v[(k + 1) % 3], v[k]) != invalidTriangle) ++count;
+        }
+        return count;
+    };
+
+    strip.reserve(triangleCount + triangleCount / 4ull + 3ull);
+
+    size_t cursor = 0ull;
+    size_t stripCount = 0ull;
+
+    while (true) {
+        while (cursor < triangleCount && used[cursor]) ++cursor;
+        if (cursor == triangleCount) break;
+
+        // START TRIANGLE
+        // Triangle with fewest free neighbours near the current position, so strips don't leave isolated triangles behind
+        size_t start = cursor;
+        int startNeighbours = 4;
+        for (size_t t = cursor, seen = 0ull, scanned = 0ull; t < triangleCount && seen < START_WINDOW && scanned < START_WINDOW * 4ull; ++t, ++scanned) {
+            if (used[t]) continue;
+            ++seen;
+
+            const int neighbours = countNeighbours(t);
+            if (neighbours < startNeighbours) {
+                startNeighbours = neighbours;
+                start = t;
+            }
+        }
+
+        used[start] = 1u;
+
+        // Rotate so that the strip can continue over the last edge
+        const unsigned int* v = &triangles[start * 3ull];
+        int rotation = 0;
+        for (int r = 0; r < 3; ++r) {
+            if (findTriangle(v[(r + 2) % 3], v[(r + 1) % 3]) != invalidTriangle) {
+                rotation = r;
+                break;
+            }
+        }
+
+        const unsigned int a = v[rotation], b = v[(rotation + 1) % 3], c = v[(rotation + 2) % 3];
+
+        // JOIN
+        if (!strip.empty()) {
+            if (usePrimitiveRestart) {
+                strip.push_back(RESTART_INDEX);
+            }
+            else {
+                // Degenerate triangles, new strip has to start at even position to keep winding
+                const unsigned int last = strip.back();
+                strip.push_back(last);
+                strip.push_back(a);
+                if (strip.size() & 1ull) strip.push_back(a);
+            }
+        }
+
+        const size_t stripStart = strip.size();
+        strip.push_back(a);
+        strip.push_back(b);
+        strip.push_back(c);
+        ++stripCount;
+
+        // GROW
+        while (true) {
+            const size_t n = strip.size();
+            const unsigned int x = strip[n - 2ull], y = strip[n - 1ull];
+
+            // Odd triangles are (y, x, next)
+            const size_t t = ((n - 2ull - stripStart) & 1ull) == 0ull ? findTriangle(x, y) : findTriangle(y, x);
+            if (t == invalidTriangle) break;
+
+            used[t] = 1u;
+            strip.push_back(thirdVertex(t, x, y));
+        }
+    }
+
+    if (stats) {
+        stats->listIndexCount = indices.size();
+        stats->stripIndexCount = strip.size();
+        stats->stripCount = stripCount;
+        stats->ratio = indices.empty() ? 0.f : (float)strip.size() / (float)indices.size();
+    }
+
+    return strip;
+}
+
+std::vector<unsigned int> Stripifier::unstripify(const std::vector<unsigned int>& strip, const bool usePrimitiveRestart)
+{
+    std::vector<unsigned int> indices;
+    indices.reserve(strip.size() * 3ull);
+
+    size_t start = 0ull;
+    for (size_t i = 0ull; i < strip.size(); ++i) {
+        if (usePrimitiveRestart && strip[i] == RESTART_INDEX) {
+            start = i + 1ull;
+            continue;
+        }
+
+        if (i < start + 2ull) continue;
+
+        unsigned int a = strip[i - 2ull], b = strip[i - 1ull];
+        const unsigned int c = strip[i];
+        if ((i - 2ull - start) & 1ull) std::swap(a, b);
+
+        if (a == b || a == c || b == c) continue;
+
+        indices.push_back(a);
+        indices.push_back(b);
+        indices.push_back(c);
+    }
+
+    return indices;
+}
\ No newline at end of file
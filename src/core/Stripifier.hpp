@@ -0,0 +1,33 @@
+#pragma once
+
+#pragma region STD_LIBS
+#include <cstdint>
+#include <span>
+#include <vector>
+#pragma endregion
+
+struct StripStats
+{
+	size_t listIndexCount = 0ull;
+	size_t stripIndexCount = 0ull;
+	size_t stripCount = 0ull;
+	// Strip indices per triangle list index (lower is better)
+	float ratio = 0.f;
+};
+
+class Stripifier
+{
+public:
+	static constexpr unsigned int RESTART_INDEX = 0xFFFFFFFFu;
+	// Triangles considered when starting a new strip
+	static constexpr size_t START_WINDOW = 16ull;
+
+	// Converts triangle list into triangle strips (triangle i is (i, i + 1, i + 2) for even i
+	// and (i + 1, i, i + 2) for odd i, so winding is preserved). Strips are joined with RESTART_INDEX
+	// or, when primitive restart is not used, with degenerate triangles.
+	// Triangles are taken in index order, so vertex cache optimized input gives cache friendly strips
+	static std::vector<unsigned int> stripify(std::span<const unsigned int> indices, const size_t vertexCount, const bool usePrimitiveRestart = true, StripStats* stats = nullptr);
+
+	// Converts strip back into triangle list, degenerate triangles are skipped
+	static std::vector<unsigned int> unstripify(const std::vector<unsigned int>& strip, const bool usePrimitiveRestart = true);
+};
\ No newline at end of file
@@ -5,6 +5,7 @@
 #pragma region STD_LIBS
 #include <cmath>
 #include <cstdint>
+#include <memory_resource>
 #include <string>
 #include <utility>
 #include <vector>
@@ -17,6 +18,8 @@
 
 #pragma region MY_FILES
 #include "Constants.hpp"
+#include "GenerationArena.hpp"
+#include "GenerationStats.hpp"
 #include "Shape.hpp"
 #include "Tetrahedron.hpp"
 #pragma endregion
@@ -29,8 +32,9 @@ void Tetrahedron::_generate(const ValuesRange range)
 	const float h = 2.f / 3.f;
 	const float r = (float)M_SQRT3 / 3.f;
 
-	std::vector<unsigned int> trisNum;
-	glm::vec3 tangent;
+	// Temporaries of this generation
+	GenerationArena arena;
+	std::pmr::vector<unsigned int> trisNum(arena.resource());
 
 	const float angleXZDiff = 2.f * (float)M_PI / (float)segments;
 
@@ -38,6 +42,7 @@ void Tetrahedron::_generate(const ValuesRange range)
 	// VERTICES AND TEX COORDS
 	const float y = -h * 0.5f;
 	float angleXZ = 0.f;
+	PhaseTimer vertexTimer(&_generationStats, "vertex generation");
 	for (unsigned int j = 0u; j < segments; ++j) {
 		const float z = cosf(angleXZ);
 		const float x = sinf(angleXZ);
@@ -45,18 +50,13 @@ void Tetrahedron::_generate(const ValuesRange range)
 		if (_shapeConfig.genTangents) trisNum.push_back(1u);
 		angleXZ += angleXZDiff;
 	}
+	vertexTimer.stop();
 
+	PhaseTimer indexTimer(&_generationStats, "index generation");
 	_indices.push_back(0u);
 	_indices.push_back(2u);
 	_indices.push_back(1u);
-
-	if (_shapeConfig.genTangents) {
-		tangent = _calcTangent(0u, 2u, 1u);
-
-		_vertices[0ull].Tangent += tangent;
-		_vertices[2ull].Tangent += tangent;
-		_vertices[1ull].Tangent += tangent;
-	}
+	indexTimer.stop();
 
 	// CONE
 	// VERTICES AND TEX COORDS
@@ -64,6 +64,7 @@ void Tetrahedron::_generate(const ValuesRange range)
 	angleXZ = 0.f;
 	const float cos_cone = r / sqrtf(r * r + h * h);
 	const float sin_cone = h / sqrtf(r * r + h * h);
+	PhaseTimer coneVertexTimer(&_generationStats, "vertex generation");
 	for (unsigned int j = 0u; j < segments; ++j) {
 		const float x_n = cos_cone * (sinf(angleXZ) + sinf(angleXZ + angleXZDiff)) * .5f;
 		const float z_n = cos_cone * (cosf(angleXZ) + cosf(angleXZ + angleXZDiff)) * .5f;
@@ -86,8 +87,10 @@ void Tetrahedron::_generate(const ValuesRange range)
 
 		angleXZ += angleXZDiff;
 	}
+	coneVertexTimer.stop();
 
 	// INDICES
+	PhaseTimer coneIndexTimer(&_generationStats, "index generation");
 	for (unsigned int i = 0u; i < segments; ++i) {
 		const size_t left = start + (size_t)i * 3ull;
 		const size_t right = start + (size_t)i * 3ull + 1ull;
@@ -96,24 +99,20 @@ void Tetrahedron::_generate(const ValuesRange range)
 		_indices.push_back((unsigned int)left);
 		_indices.push_back((unsigned int)right);
 		_indices.push_back((unsigned int)top);
-
-		if (_shapeConfig.genTangents) {
-			tangent = _calcTangent((unsigned int)left, (unsigned int)right, (unsigned int)top);
-
-			_vertices[left].Tangent += tangent;
-			_vertices[right].Tangent += tangent;
-			_vertices[top].Tangent += tangent;
-		}
 	}
+	coneIndexTimer.stop();
 
-	if (_shapeConfig.genTangents) _normalizeTangentsAndGenerateBitangents(trisNum, 0ull, _vertices.size());
+	if (_shapeConfig.genTangents) {
+		_accumulateTangents(0ull, _indices.size());
+		_normalizeTangentsAndGenerateBitangents(trisNum, 0ull, _vertices.size());
+	}
 
 	trisNum.clear();
 }
 
 Tetrahedron::Tetrahedron(const ShapeConfig& config, const ValuesRange range)
+	: Shape(config)
 {
-	_shapeConfig = config;
 	_vertices.clear();
 	_indices.clear();
 	_generate(range);
@@ -121,6 +120,11 @@ Tetrahedron::Tetrahedron(const ShapeConfig& config, const ValuesRange range)
 
 Tetrahedron::~Tetrahedron() {}
 
+MeshCounts Tetrahedron::getMeshCounts(const ValuesRange)
+{
+	return { 12ull, 12ull };
+}
+
 std::string Tetrahedron::getClassName()
 {
 	return "Tetrahedron";
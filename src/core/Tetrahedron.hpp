@@ -16,6 +16,8 @@ public:
 	Tetrahedron(const ShapeConfig& config, const ValuesRange range = ValuesRange::HALF_TO_HALF);
 	virtual ~Tetrahedron();
 
+	// Same parameters (and clamping) as constructor
+	static MeshCounts getMeshCounts(const ValuesRange range = ValuesRange::HALF_TO_HALF);
 	static std::string getClassName();
 	std::string getObjectClassName() const override;
 };
\ No newline at end of file
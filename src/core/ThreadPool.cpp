@@ -0,0 +1,265 @@
+#pragma region PCH
+#include "pch.hpp"
+#pragma endregion
+
+#pragma region STD_LIBS
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "ThreadPool.hpp"
+#pragma endregion
+
+// Pool and queue of the worker running on this thread
+static thread_local ThreadPool* currentPool = nullptr;
+static thread_local size_t currentWorker = 0ull;
+
+static std::atomic<size_t> defaultThreadsCount = 0ull;
+
+ThreadPool::ThreadPool(const size_t threadsCount)
+{
+    const size_t count = threadsCount == 0ull ? getHardwareThreadsCount() : threadsCount;
+
+    _queues.reserve(count);
+    for (size_t i = 0ull; i < count; ++i) _queues.push_back(std::make_unique<TaskQueue>());
+
+    _threads.reserve(count);
+    for (size_t i = 0ull; i < count; ++i) _threads.emplace_back(&ThreadPool::_workerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _stop = true;
+    }
+    _sleepCondition.notify_all();
+
+    for (std::thread& thread : _threads) thread.join();
+}
+
+ThreadPool& ThreadPool::get()
+{
+    static ThreadPool pool(defaultThreadsCount.load());
+    return pool;
+}
+
+void ThreadPool::setDefaultThreadsCount(const size_t threadsCount)
+{
+    defaultThreadsCount = threadsCount;
+}
+
+size_t ThreadPool::getHardwareThreadsCount()
+{
+    return std::max<size_t>(1ull, std::thread::hardware_concurrency());
+}
+
+size_t ThreadPool::getThreadsCount() const
+{
+    return _threads.size();
+}
+
+void ThreadPool::parallelFor(const size_t begin, const size_t end, const size_t grainSize, const std::function<void(size_t, size_t)>& body)
+{
+    if (begin >= end) return;
+
+    const size_t count = end - begin;
+    const size_t grain = std::max<size_t>(1ull, grainSize);
+
+    // A few chunks per thread evens out uneven chunk costs
+    const size_t chunks = std::min<size_t>((count + grain - 1ull) / grain, _threads.size() * 4ull);
+    if (chunks <= 1ull) {
+        body(begin, end);
+        return;
+    }
+
+    const size_t chunkSize = (count + chunks - 1ull) / chunks;
+
+    TaskGroup group(*this);
+    for (size_t chunkBegin = begin + chunkSize; chunkBegin < end; chunkBegin += chunkSize) {
+        const size_t chunkEnd = std::min(end, chunkBegin + chunkSize);
+        group.run([&body, chunkBegin, chunkEnd]() { body(chunkBegin, chunkEnd); });
+    }
+
+    // First chunk is done by the calling thread
+    body(begin, std::min(end, begin + chunkSize));
+    group.wait();
+}
+
+bool ThreadPool::tryRunPendingTask()
+{
+    Task task;
+    if (!_pop(task)) return false;
+
+    task();
+    return true;
+}
+
+void ThreadPool::_push(Task task)
+{
+    TaskQueue& queue = currentPool == this ? *_queues[currentWorker] : _sharedQueue;
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+
+    // Taking the lock keeps worker from missing the notification between its check and sleep
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        ++_queuedCount;
+    }
+    _sleepCondition.notify_one();
+}
+
+bool ThreadPool::_pop(Task& task)
+{
+    auto take = [this, &task](TaskQueue& queue, const bool newest) -> bool {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) return false;
+
+        if (newest) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        }
+        else {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+
+        --_queuedCount;
+        return true;
+    };
+
+    const bool isWorker = currentPool == this;
+
+    // Own queue newest first (its data is still in cache), then shared queue, then steal oldest
+    if (isWorker && take(*_queues[currentWorker], true)) return true;
+    if (take(_sharedQueue, false)) return true;
+
+    const size_t first = isWorker ? currentWorker + 1ull : 0ull;
+    for (size_t i = 0ull; i < _queues.size(); ++i) {
+        const size_t victim = (first + i) % _queues.size();
+        if (isWorker && victim == currentWorker) continue;
+        if (take(*_queues[victim], false)) return true;
+    }
+
+    return false;
+}
+
+void ThreadPool::_workerLoop(const size_t index)
+{
+    currentPool = this;
+    currentWorker = index;
+
+    while (true) {
+        Task task;
+        if (_pop(task)) {
+            task();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        if (_stop && _queuedCount == 0ull) break;
+        _sleepCondition.wait(lock, [this]() { return _stop || _queuedCount > 0ull; });
+        if (_stop && _queuedCount == 0ull) break;
+    }
+
+    currentPool = nullptr;
+}
+
+TaskGroup::TaskGroup(ThreadPool& pool) : _pool(pool) {}
+
+TaskGroup::~TaskGroup()
+{
+    try {
+        wait();
+    }
+    catch (...) {}
+}
+
+void TaskGroup::run(ThreadPool::Task task)
+{
+    std::shared_ptr<GroupTask> groupTask = std::make_shared<GroupTask>();
+    groupTask->task = std::move(task);
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        ++_pending;
+        _tasks.push_back(groupTask);
+    }
+
+    // Group isn't touched when the task was already run by waiting thread, it may be destroyed by now
+    _pool._push([this, groupTask]() {
+        if (!groupTask->taken.exchange(true)) _runTask(*groupTask);
+    });
+}
+
+void TaskGroup::_runTask(GroupTask& groupTask)
+{
+    std::exception_ptr exception;
+    try {
+        groupTask.task();
+    }
+    catch (...) {
+        exception = std::current_exception();
+    }
+    groupTask.task = nullptr;
+
+    // Group can be destroyed as soon as the lock is released
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (exception && !_exception) _exception = exception;
+    if (--_pending == 0ull) _condition.notify_all();
+}
+
+std::shared_ptr<TaskGroup::GroupTask> TaskGroup::_takeOwnTask()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    while (!_tasks.empty()) {
+        // Newest first, like worker's own queue
+        std::shared_ptr<GroupTask> groupTask = std::move(_tasks.back());
+        _tasks.pop_back();
+        if (!groupTask->taken.exchange(true)) return groupTask;
+    }
+    return nullptr;
+}
+
+void TaskGroup::wait()
+{
+    // Unrelated task could run for long (or wait on something) and hold up a thread that only waits for this group
+    const bool isWorker = currentPool == &_pool;
+
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_pending == 0ull) break;
+        }
+
+        if (isWorker) {
+            if (_pool.tryRunPendingTask()) continue;
+        }
+        else if (std::shared_ptr<GroupTask> groupTask = _takeOwnTask()) {
+            _runTask(*groupTask);
+            continue;
+        }
+
+        // Remaining tasks are running on other threads, check again shortly in case new tasks show up
+        std::unique_lock<std::mutex> lock(_mutex);
+        _condition.wait_for(lock, std::chrono::milliseconds(1), [this]() { return _pending == 0ull; });
+    }
+
+    std::exception_ptr exception;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _tasks.clear();
+        std::swap(exception, _exception);
+    }
+    if (exception) std::rethrow_exception(exception);
+}
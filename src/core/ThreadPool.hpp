@@ -0,0 +1,121 @@
+#pragma once
+
+#pragma region STD_LIBS
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#pragma endregion
+
+// Work-stealing pool, every worker has its own queue. Tasks submitted from a worker go to its queue
+// (taken newest first), tasks from other threads go to a shared queue. Idle workers steal oldest tasks
+// from other queues. Worker waiting through TaskGroup runs queued tasks meanwhile, so nested fork/join
+// doesn't block workers and never needs more threads than the pool has. Other threads help only with tasks of their group
+class ThreadPool
+{
+public:
+	using Task = std::function<void()>;
+
+	// Chunks smaller than this are not worth a task
+	static constexpr size_t DEFAULT_GRAIN_SIZE = 4096ull;
+
+	// 0 uses hardware concurrency
+	explicit ThreadPool(const size_t threadsCount = 0ull);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	// Pool shared by generation, export and batch jobs, created on first use
+	static ThreadPool& get();
+	// Size of the shared pool (0 uses hardware concurrency), has effect only before first get()
+	static void setDefaultThreadsCount(const size_t threadsCount);
+	static size_t getHardwareThreadsCount();
+
+	size_t getThreadsCount() const;
+
+	// Don't wait for the future from inside a pool task, use TaskGroup there
+	template<class F>
+	std::future<std::invoke_result_t<std::decay_t<F>>> submit(F&& func)
+	{
+		using Result = std::invoke_result_t<std::decay_t<F>>;
+
+		std::shared_ptr<std::packaged_task<Result()>> task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(func));
+		std::future<Result> future = task->get_future();
+		_push([task]() { (*task)(); });
+		return future;
+	}
+
+	// Calls body(chunkBegin, chunkEnd) for chunks of [begin, end) in parallel and waits for all of them.
+	// Small ranges run on the calling thread
+	void parallelFor(const size_t begin, const size_t end, const size_t grainSize, const std::function<void(size_t, size_t)>& body);
+
+	// Runs one queued task on the calling thread, returns false when there was nothing to run
+	bool tryRunPendingTask();
+
+private:
+	struct TaskQueue
+	{
+		std::mutex mutex;
+		std::deque<Task> tasks;
+	};
+
+	void _push(Task task);
+	bool _pop(Task& task);
+	void _workerLoop(const size_t index);
+
+	std::vector<std::unique_ptr<TaskQueue>> _queues;
+	TaskQueue _sharedQueue;
+	std::vector<std::thread> _threads;
+
+	std::mutex _sleepMutex;
+	std::condition_variable _sleepCondition;
+	std::atomic<size_t> _queuedCount = 0ull;
+	std::atomic<bool> _stop = false;
+
+	friend class TaskGroup;
+};
+
+// Fork/join scope, destructor waits for all tasks
+class TaskGroup
+{
+public:
+	explicit TaskGroup(ThreadPool& pool = ThreadPool::get());
+	~TaskGroup();
+
+	TaskGroup(const TaskGroup&) = delete;
+	TaskGroup& operator=(const TaskGroup&) = delete;
+
+	void run(ThreadPool::Task task);
+	// Runs queued tasks while waiting (only tasks of this group outside of pool workers), first exception thrown by a task is rethrown here
+	void wait();
+
+private:
+	// Task is run by whoever takes it first, pool worker or thread waiting for the group
+	struct GroupTask
+	{
+		std::atomic<bool> taken = false;
+		ThreadPool::Task task;
+	};
+
+	void _runTask(GroupTask& groupTask);
+	// Group task not taken yet, nullptr when every one was taken
+	std::shared_ptr<GroupTask> _takeOwnTask();
+
+	ThreadPool& _pool;
+	size_t _pending = 0ull;
+	// Tasks of this group, waiting thread outside of the pool runs them instead of unrelated ones
+	std::vector<std::shared_ptr<GroupTask>> _tasks;
+	std::exception_ptr _exception;
+	std::mutex _mutex;
+	std::condition_variable _condition;
+};
\ No newline at end of file
@@ -0,0 +1,386 @@
+#pragma region PCH
+#include "pch.hpp"
+#pragma endregion
+
+#pragma region STD_LIBS
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+#pragma endregion
+
+#pragma region FMT_LIB
+#include <fmt/format.h>
+#pragma endregion
+
+#pragma region GLM_LIB
+#include <glm/fwd.hpp>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "BitMathOperators.hpp"
+#include "ExportPipeline.hpp"
+#include "Plane.hpp"
+#include "ProgressToken.hpp"
+#include "Shape.hpp"
+#include "ThreadPool.hpp"
+#include "TiledPlane.hpp"
+#include "Vertex.hpp"
+#pragma endregion
+
+// "v x y z" and "vt u v" lines of one vertex
+static constexpr size_t OBJ_VERTEX_BYTES = 64ull;
+// Two "f a/a/1 b/b/1 c/c/1" lines of one quad
+static constexpr size_t OBJ_QUAD_BYTES = 144ull;
+// Plane of one tile keeps its indices and triangle counts besides vertices
+static constexpr size_t TILE_VERTEX_BYTES = sizeof(Vertex) + 7ull * sizeof(unsigned int);
+
+// Lines of OBJ text formatted by one task
+static constexpr size_t OBJ_BAND_LINES = ThreadPool::DEFAULT_GRAIN_SIZE;
+
+// Text of items [begin, end) formatted in parallel bands and joined in order
+static std::string formatInBands(const size_t begin, const size_t end, const size_t itemBytes, const std::function<void(size_t, std::string&)>& formatItem)
+{
+    const size_t bands = (end - begin + OBJ_BAND_LINES - 1ull) / OBJ_BAND_LINES;
+    std::vector<std::string> texts(bands);
+
+    ThreadPool::get().parallelFor(0ull, bands, 1ull, [&texts, &formatItem, begin, end, itemBytes](size_t bandBegin, size_t bandEnd) {
+        for (size_t band = bandBegin; band < bandEnd; ++band) {
+            const size_t first = begin + band * OBJ_BAND_LINES;
+            const size_t last = std::min(end, first + OBJ_BAND_LINES);
+
+            texts[band].reserve((last - first) * itemBytes);
+            for (size_t i = first; i < last; ++i) formatItem(i, texts[band]);
+        }
+    });
+
+    size_t bytes = 0ull;
+    for (const std::string& text : texts) bytes += text.size();
+
+    std::string result;
+    result.reserve(bytes);
+    for (const std::string& text : texts) result += text;
+    return result;
+}
+
+TiledPlane::TiledPlane(const ShapeConfig& config, const unsigned int rows, const unsigned int columns, const PlaneNormalDir dir, const ValuesRange range, const size_t tileVertices)
+    : _config(config), _rows(std::max(2u, rows)), _columns(std::max(2u, columns)), _dir(dir), _range(range)
+{
+    _config.memoryResource = nullptr;
+    _tileRows = (unsigned int)std::clamp<size_t>(tileVertices / _columns, 1ull, _rows);
+
+    // Sub-mesh is limited by its vertices and by indices of its quads
+    const size_t byVertices = MeshCounts::MAX_VERTICES / _columns;
+    const size_t byIndices = MeshCounts::MAX_INDICES / (6ull * ((size_t)_columns - 1ull)) + 1ull;
+    _subMeshRows = (unsigned int)std::min<size_t>({ (size_t)_rows, byVertices, byIndices });
+}
+
+bool TiledPlane::isFormatSupported(const FormatType format)
+{
+    return format == FormatType::BINARY || format == FormatType::OBJ;
+}
+
+std::vector<std::pair<unsigned int, unsigned int>> TiledPlane::_getSubMeshes(const FormatType format) const
+{
+    // OBJ indices are text, so they have no limit
+    if (format != FormatType::BINARY) return { { 0u, _rows } };
+
+    std::vector<std::pair<unsigned int, unsigned int>> subMeshes;
+    if (_subMeshRows < 2u) return subMeshes;
+
+    unsigned int begin = 0u;
+    while (true) {
+        const unsigned int end = (unsigned int)std::min<size_t>(_rows, (size_t)begin + _subMeshRows);
+        subMeshes.emplace_back(begin, end);
+        if (end == _rows) break;
+
+        // Last row is shared with the next sub-mesh
+        begin = end - 1u;
+    }
+    return subMeshes;
+}
+
+std::vector<TiledPlane::Tile> TiledPlane::_getTiles(const unsigned int meshRowBegin, const unsigned int meshRowEnd) const
+{
+    std::vector<Tile> tiles;
+    tiles.reserve(((size_t)meshRowEnd - meshRowBegin + _tileRows - 1ull) / _tileRows);
+
+    for (size_t row = meshRowBegin; row < meshRowEnd; row += _tileRows) {
+        Tile tile;
+        tile.rowBegin = (unsigned int)row;
+        tile.rowEnd = (unsigned int)std::min<size_t>(meshRowEnd, row + _tileRows);
+        tile.meshRowBegin = meshRowBegin;
+        tile.quadRowEnd = std::min(tile.rowEnd, meshRowEnd - 1u);
+        tiles.push_back(tile);
+    }
+    return tiles;
+}
+
+std::shared_ptr<const Plane> TiledPlane::_generateTile(const Tile& tile, const FormatType format) const
+{
+    ShapeConfig config = _config;
+    config.progress = nullptr;
+    // OBJ doesn't export tangents
+    if (format == FormatType::OBJ) config.genTangents = false;
+
+    // Tangents of a row are accumulated from quads on both sides of it
+    const unsigned int planeBegin = config.genTangents && tile.rowBegin > 0u ? tile.rowBegin - 1u : tile.rowBegin;
+    const unsigned int planeEnd = config.genTangents ? std::min(_rows, tile.rowEnd + 1u) : tile.rowEnd;
+    return std::shared_ptr<const Plane>(new Plane(config, _rows, _columns, planeBegin, planeEnd, _dir, _range));
+}
+
+std::string TiledPlane::_formatVertices(const Plane& plane, const Tile& tile, const FormatType format) const
+{
+    // Plane of the tile starts a row earlier when it has the row above for tangents
+    const size_t first = plane._shapeConfig.genTangents && tile.rowBegin > 0u ? (size_t)_columns : 0ull;
+    const size_t last = first + (size_t)(tile.rowEnd - tile.rowBegin) * _columns;
+
+    std::string result;
+    if (format == FormatType::BINARY) {
+        result.resize((last - first) * plane.getVertexStride());
+
+        char* out = result.data();
+        float floats[14];
+        for (size_t i = first; i < last; ++i) {
+            const size_t bytes = plane._writeVertexFloats(plane._vertices[i], floats) * sizeof(float);
+            std::memcpy(out, floats, bytes);
+            out += bytes;
+        }
+        return result;
+    }
+
+    // Position and texture coordinate lists get the same number for every vertex
+    result = formatInBands(first, last, OBJ_VERTEX_BYTES / 2ull, [&plane](size_t i, std::string& text) {
+        const glm::vec3& pos = plane._vertices[i].Position;
+        text += fmt::format("v {} {} {}\n", plane._formatFloat(pos.x, false), plane._formatFloat(pos.y, false), plane._formatFloat(pos.z, false));
+    });
+    result += formatInBands(first, last, OBJ_VERTEX_BYTES / 2ull, [&plane](size_t i, std::string& text) {
+        const glm::vec2& tex = plane._vertices[i].TexCoord;
+        text += fmt::format("vt {} {}\n", plane._formatFloat(tex.x, false), plane._formatFloat(tex.y, false));
+    });
+    return result;
+}
+
+std::string TiledPlane::_formatIndices(const Tile& tile, const FormatType format) const
+{
+    const size_t quads = (size_t)(tile.quadRowEnd - tile.rowBegin) * (_columns - 1u);
+
+    std::string result;
+    if (format == FormatType::BINARY) {
+        result.resize(quads * 6ull * sizeof(unsigned int));
+
+        char* out = result.data();
+        for (unsigned int row = tile.rowBegin; row < tile.quadRowEnd; ++row) {
+            const unsigned int rowStart = (row - tile.meshRowBegin) * _columns;
+            for (unsigned int col = 0u; col + 1u < _columns; ++col) {
+                // Same triangles as Plane::_generateRows, sub-mesh fits unsigned int
+                const unsigned int i = rowStart + col;
+                const unsigned int quad[6] = { i + _columns, i + 1u, i, i + _columns, i + _columns + 1u, i + 1u };
+                std::memcpy(out, quad, sizeof(quad));
+                out += sizeof(quad);
+            }
+        }
+        return result;
+    }
+
+    // OBJ numbers from 1 and has only one normal
+    const size_t columns = _columns;
+    const size_t firstVertex = (size_t)tile.rowBegin * columns + 1ull;
+    return formatInBands(0ull, quads, OBJ_QUAD_BYTES, [columns, firstVertex](size_t quad, std::string& text) {
+        const size_t i = firstVertex + quad / (columns - 1ull) * columns + quad % (columns - 1ull);
+        text += fmt::format("f {0}/{0}/1 {1}/{1}/1 {2}/{2}/1\nf {0}/{0}/1 {3}/{3}/1 {1}/{1}/1\n", i + columns, i + 1ull, i, i + columns + 1ull);
+    });
+}
+
+bool TiledPlane::_emitTiles(ExportPipeline& pipeline, const std::vector<Tile>& tiles, const bool vertices, const FormatType format) const
+{
+    if (!vertices) {
+        for (const Tile& tile : tiles) {
+            if (!pipeline.emit([this, tile, format]() { return _formatIndices(tile, format); })) return false;
+        }
+        return true;
+    }
+
+    // Next GENERATE_WINDOW tiles are generated in parallel on the pool while formatter works on earlier ones,
+    // they are emitted in order. Generator stage has its own thread, so it can wait for the futures
+    ThreadPool& pool = ThreadPool::get();
+    std::deque<std::future<std::shared_ptr<const Plane>>> window;
+    size_t next = 0ull;
+    bool emitted = true;
+
+    try {
+        for (size_t i = 0ull; i < tiles.size() && emitted; ++i) {
+            for (; next < tiles.size() && next < i + GENERATE_WINDOW; ++next) {
+                window.push_back(pool.submit([this, tile = tiles[next], format]() { return _generateTile(tile, format); }));
+            }
+
+            std::future<std::shared_ptr<const Plane>> front = std::move(window.front());
+            window.pop_front();
+            const std::shared_ptr<const Plane> plane = front.get();
+            emitted = pipeline.emit([this, plane, tile = tiles[i], format]() { return _formatVertices(*plane, tile, format); });
+        }
+    }
+    catch (...) {
+        // Tiles still generating use this object
+        for (std::future<std::shared_ptr<const Plane>>& future : window) future.wait();
+        throw;
+    }
+
+    for (std::future<std::shared_ptr<const Plane>>& future : window) future.wait();
+    return emitted;
+}
+
+bool TiledPlane::save(const std::string& path, const FormatType format) const
+{
+    const std::vector<std::pair<unsigned int, unsigned int>> subMeshes = _getSubMeshes(format);
+    if (!isFormatSupported(format) || subMeshes.empty()) return false;
+
+    std::ofstream file(path, std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!file.is_open()) return false;
+
+    auto append = [](std::string& text, const void* data, const size_t bytes) {
+        text.append(reinterpret_cast<const char*>(data), bytes);
+    };
+
+    auto emitText = [](ExportPipeline& pipeline, std::string text) {
+        return pipeline.emit([text = std::move(text)]() { return text; });
+    };
+
+    // Vertices and indices are separate passes over tiles, headers are chunks of their own
+    ExportPipeline pipeline(_config.progress);
+    bool written = true;
+
+    if (format == FormatType::BINARY) {
+        written = pipeline.run(file, [this, &subMeshes, &append, &emitText, format](ExportPipeline& stages) -> bool {
+            // Same header as Shape::toString(FormatType::BINARY), every sub-mesh is a VERT and INDX chunk pair
+            constexpr uint32_t version = 1u;
+            const uint32_t flags = (_config.genTangents ? 1u : 0u) | (_config.calcBitangents ? 2u : 0u) | (_config.tangentHandednessPositive ? 4u : 0u);
+            const uint32_t chunkCount = 2u * (uint32_t)subMeshes.size();
+
+            std::string header;
+            append(header, "SGMB", 4ull);
+            append(header, &version, sizeof(version));
+            append(header, &flags, sizeof(flags));
+            append(header, &chunkCount, sizeof(chunkCount));
+            if (!emitText(stages, std::move(header))) return false;
+
+            auto chunkHeader = [&append](const char* id, const uint32_t count, const uint64_t bytes) {
+                std::string text;
+                append(text, id, 4ull);
+                append(text, &count, sizeof(count));
+                append(text, &bytes, sizeof(bytes));
+                return text;
+            };
+
+            const size_t stride = Shape::getVertexStride(_config);
+            for (const auto& [begin, end] : subMeshes) {
+                const std::vector<Tile> tiles = _getTiles(begin, end);
+                const size_t verticesCount = (size_t)(end - begin) * _columns;
+                const size_t indicesCount = 6ull * (size_t)(end - begin - 1u) * (size_t)(_columns - 1u);
+
+                if (!emitText(stages, chunkHeader("VERT", (uint32_t)verticesCount, (uint64_t)(verticesCount * stride)))) return false;
+                if (!_emitTiles(stages, tiles, true, format)) return false;
+
+                if (!emitText(stages, chunkHeader("INDX", (uint32_t)indicesCount, (uint64_t)(indicesCount * sizeof(unsigned int))))) return false;
+                if (!_emitTiles(stages, tiles, false, format)) return false;
+            }
+            return true;
+        }, "tile saving", _getChunksCount(format));
+    }
+    else {
+        written = pipeline.run(file, [this, &emitText, format](ExportPipeline& stages) -> bool {
+            ShapeConfig config = _config;
+            config.genTangents = false;
+            config.progress = nullptr;
+            // Empty part of the grid, only for header and object name
+            const Plane header(config, _rows, _columns, 0u, 0u, _dir, _range);
+
+            // Every vertex has the normal of Plane::_generateRows
+            const float normalY = _dir == PlaneNormalDir::FRONT ? 0.f : 1.f;
+            const float normalZ = _dir == PlaneNormalDir::FRONT ? -1.f : 0.f;
+
+            std::string text = header._getGeneratedHeader("#") + "o " + header.getObjectClassName() + "\n" +
+                fmt::format("vn {} {} {}\n", header._formatFloat(0.f, false), header._formatFloat(normalY, false), header._formatFloat(normalZ, false));
+            if (!emitText(stages, std::move(text))) return false;
+
+            const std::vector<Tile> tiles = _getTiles(0u, _rows);
+            return _emitTiles(stages, tiles, true, format) && emitText(stages, "s 0\n") && _emitTiles(stages, tiles, false, format);
+        }, "tile saving", _getChunksCount(format));
+    }
+
+    file.close();
+    if (!written || !file) {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+        return false;
+    }
+    return true;
+}
+
+size_t TiledPlane::_getChunksCount(const FormatType format) const
+{
+    // File header, then headers of VERT and INDX chunks of every sub-mesh (OBJ has "s 0" between vertices and faces instead)
+    const size_t headers = format == FormatType::BINARY ? 1ull + 2ull * getSubMeshesCount(format) : 2ull;
+    return headers + 2ull * getTilesCount(format);
+}
+
+unsigned int TiledPlane::getRows() const
+{
+    return _rows;
+}
+
+unsigned int TiledPlane::getColumns() const
+{
+    return _columns;
+}
+
+unsigned int TiledPlane::getTileRows() const
+{
+    return _tileRows;
+}
+
+size_t TiledPlane::getTilesCount(const FormatType format) const
+{
+    size_t count = 0ull;
+    for (const auto& [begin, end] : _getSubMeshes(format)) {
+        count += ((size_t)end - begin + _tileRows - 1ull) / _tileRows;
+    }
+    return count;
+}
+
+size_t TiledPlane::getSubMeshesCount(const FormatType format) const
+{
+    return _getSubMeshes(format).size();
+}
+
+MeshCounts TiledPlane::getMeshCounts(const FormatType format) const
+{
+    MeshCounts counts;
+    for (const auto& [begin, end] : _getSubMeshes(format)) {
+        counts.vertices = add_sat<size_t>(counts.vertices, (size_t)(end - begin) * _columns);
+        counts.indices = add_sat<size_t>(counts.indices, mul_sat<size_t>(6ull * (size_t)(end - begin - 1u), (size_t)_columns - 1ull));
+    }
+    return counts;
+}
+
+size_t TiledPlane::getPeakBytes(const FormatType format) const
+{
+    const size_t tileVertices = (size_t)_tileRows * _columns;
+    // Plane of a tile has a row above and below it for tangents
+    const size_t planeBytes = ((size_t)_tileRows + 2ull) * _columns * TILE_VERTEX_BYTES;
+    const size_t verticesBytes = tileVertices * (format == FormatType::OBJ ? OBJ_VERTEX_BYTES : Shape::getVertexStride(_config));
+    const size_t indicesBytes = tileVertices * (format == FormatType::OBJ ? OBJ_QUAD_BYTES : 6ull * sizeof(unsigned int));
+
+    // Tiles generated ahead are held besides the ones in pipeline queues
+    return ExportPipeline::getChunksInFlight() * std::max(planeBytes + verticesBytes, indicesBytes) + GENERATE_WINDOW * planeBytes;
+}
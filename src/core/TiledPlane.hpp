@@ -0,0 +1,86 @@
+#pragma once
+
+#pragma region STD_LIBS
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "ExportPipeline.hpp"
+#include "Plane.hpp"
+#include "Shape.hpp"
+#pragma endregion
+
+// Plane saved straight to file tile by tile (bands of rows) through ExportPipeline, so generating (a few tiles in parallel),
+// formatting and writing of consecutive tiles overlap and memory depends on tile size and queue depth, not on grid size. Vertices are the same as
+// Plane with the same parameters has, rows shared by neighbouring tiles are generated by both (with the rows around them,
+// so tangents match) and written once
+class TiledPlane
+{
+public:
+	// Tile rows are chosen so one tile has about this many vertices
+	static constexpr size_t DEFAULT_TILE_VERTICES = 65536ull;
+	// Tiles generated ahead in parallel on the thread pool, they are emitted to the pipeline in order
+	static constexpr size_t GENERATE_WINDOW = 4ull;
+
+	// config.progress receives saving progress and cancels it, config.memoryResource isn't used (tiles are generated on the thread pool).
+	// Rows and columns are clamped like in Plane
+	TiledPlane(const ShapeConfig& config, const unsigned int rows = 2u, const unsigned int columns = 2u, const PlaneNormalDir dir = PlaneNormalDir::UP,
+		const ValuesRange range = ValuesRange::HALF_TO_HALF, const size_t tileVertices = DEFAULT_TILE_VERTICES);
+
+	// Binary and OBJ, other formats need the whole mesh (strips, JSON document, array sizes in header)
+	static bool isFormatSupported(const FormatType format);
+
+	// Returns false when format isn't supported, file can't be written or saving was cancelled (partial file is removed)
+	bool save(const std::string& path, const FormatType format) const;
+
+	unsigned int getRows() const;
+	unsigned int getColumns() const;
+	unsigned int getTileRows() const;
+	// Tiles of one pass over the grid, vertices and indices are written in separate passes
+	size_t getTilesCount(const FormatType format) const;
+	// Binary files have one VERT and INDX chunk pair per sub-mesh, so every sub-mesh fits 32-bit indices.
+	// Neighbouring sub-meshes share a row, OBJ is always one mesh
+	size_t getSubMeshesCount(const FormatType format) const;
+	// Vertices and indices written to file (shared rows of sub-meshes are counted twice)
+	MeshCounts getMeshCounts(const FormatType format) const;
+	// Upper bound of memory used by tiles in flight while saving (ExportPipeline::getChunksInFlight of them and GENERATE_WINDOW generated ahead)
+	size_t getPeakBytes(const FormatType format) const;
+
+private:
+	struct Tile
+	{
+		// Vertex rows written by tile
+		unsigned int rowBegin = 0u;
+		unsigned int rowEnd = 0u;
+		// First row of sub-mesh, indices are relative to it
+		unsigned int meshRowBegin = 0u;
+		// Quads between row and row + 1 are written for rows [rowBegin, quadRowEnd)
+		unsigned int quadRowEnd = 0u;
+	};
+
+	// Vertex rows [begin, end) of every sub-mesh
+	std::vector<std::pair<unsigned int, unsigned int>> _getSubMeshes(const FormatType format) const;
+	std::vector<Tile> _getTiles(const unsigned int meshRowBegin, const unsigned int meshRowEnd) const;
+
+	// Part of the grid with vertices of the tile (and rows around it when tangents are generated)
+	std::shared_ptr<const Plane> _generateTile(const Tile& tile, const FormatType format) const;
+	std::string _formatVertices(const Plane& plane, const Tile& tile, const FormatType format) const;
+	std::string _formatIndices(const Tile& tile, const FormatType format) const;
+	// Generator stage, emits vertices or indices of every tile (vertex tiles are generated GENERATE_WINDOW ahead). False when pipeline stopped
+	bool _emitTiles(ExportPipeline& pipeline, const std::vector<Tile>& tiles, const bool vertices, const FormatType format) const;
+	// Chunks written by save, headers included
+	size_t _getChunksCount(const FormatType format) const;
+
+	ShapeConfig _config;
+	unsigned int _rows = 2u;
+	unsigned int _columns = 2u;
+	PlaneNormalDir _dir = PlaneNormalDir::UP;
+	ValuesRange _range = ValuesRange::HALF_TO_HALF;
+	unsigned int _tileRows = 1u;
+	// Most rows of binary sub-mesh, less than 2 when even one row of quads doesn't fit 32-bit indices
+	unsigned int _subMeshRows = 2u;
+};
@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
+#include <memory_resource>
 #include <string>
 #include <utility>
 #include <vector>
@@ -17,7 +18,10 @@
 #pragma endregion
 
 #pragma region MY_FILES
+#include "BitMathOperators.hpp"
 #include "Constants.hpp"
+#include "GenerationArena.hpp"
+#include "GenerationStats.hpp"
 #include "Shape.hpp"
 #include "Torus.hpp"
 #include "Vertex.hpp"
@@ -31,6 +35,9 @@ glm::vec3 Torus::_getAverageNormal(const glm::vec3 n1, const glm::vec3 n2, const
 
 void Torus::_generate(const unsigned int segments, const unsigned int cs_segments, const float radius, const float cs_radius, const ValuesRange range, const bool useFlatShading)
 {
+    // Temporaries of this generation
+    GenerationArena arena;
+
     // Helpful 
     // https://gamedev.stackexchange.com/questions/16845/how-do-i-generate-a-torus-mesh
 
@@ -40,8 +47,11 @@ void Torus::_generate(const unsigned int segments, const unsigned int cs_segment
     const float cs_angleincs = 2.f * (float)M_PI / (float)cs_segments;
     const float maxradius = radius + cs_radius;
 
+    PhaseTimer vertexTimer(&_generationStats, "vertex generation");
     /* iterate cs_sides: inner ring */
     for (unsigned int j = 0u; j < cs_segments + 1u; ++j) {
+        if (_reportProgress("vertex generation", j, cs_segments + 1u)) return;
+
         const float radJ = (float)j * cs_angleincs;
         const float currentradius = radius + (cs_radius * cosf(radJ));
         const float yval = cs_radius * sinf(radJ);
@@ -62,21 +72,27 @@ void Torus::_generate(const unsigned int segments, const unsigned int cs_segment
             _vertices.push_back({ n * mult, { u, v }, glm::normalize(glm::vec3(pos.x - xc, pos.y, pos.z - zc)), glm::vec3(0.f), glm::vec3(0.f) });
         }
     }
+    vertexTimer.stop();
 
     if (useFlatShading) {
+        PhaseTimer flatTimer(&_generationStats, "flat shading");
         /* inner ring */
         glm::vec3 tangent;
-        std::vector<Vertex> tempVertices(_vertices);
+        std::pmr::vector<Vertex> tempVertices(_vertices, arena.resource());
         _vertices.clear();
         for (unsigned int i = 0u; i < cs_segments; ++i) {
-            const unsigned int nextrow = segments + 1u;
+            if (_reportProgress("flat shading", i, cs_segments)) return;
+
+            // Vertex ids in size_t, constructor checked that they fit unsigned int
+            const size_t nextrow = (size_t)segments + 1ull;
+            const size_t rowStart = (size_t)i * nextrow;
 
             /* outer ring */
             for (unsigned int j = 0u; j < segments; ++j) {
-                const unsigned int first = i * nextrow + j;
-                const unsigned int second = i * nextrow + j + 1u;
-                const unsigned int third = i * nextrow + j + nextrow;
-                const unsigned int fourth = i * nextrow + j + nextrow + 1u;
+                const size_t first = rowStart + j;
+                const size_t second = rowStart + j + 1ull;
+                const size_t third = rowStart + j + nextrow;
+                const size_t fourth = rowStart + j + nextrow + 1ull;
 
                 const size_t start = _vertices.size();
                 unsigned int f = (unsigned int)start;
@@ -125,48 +141,40 @@ void Torus::_generate(const unsigned int segments, const unsigned int cs_segment
         }
     }
     else {
+        PhaseTimer indexTimer(&_generationStats, "index generation");
         /* inner ring */
-        glm::vec3 tangent;
         for (unsigned int i = 0u; i < cs_segments; ++i) {
-            const unsigned int nextrow = segments + 1u;
+            if (_reportProgress("index generation", i, cs_segments)) return;
+
+            // Vertex ids in size_t, constructor checked that they fit unsigned int
+            const size_t nextrow = (size_t)segments + 1ull;
+            const size_t rowStart = (size_t)i * nextrow;
 
             /* outer ring */
             for (unsigned int j = 0u; j < segments; ++j) {
-                const unsigned int first = i * nextrow + j;
-                const unsigned int second = i * nextrow + j + 1u;
-                const unsigned int third = i * nextrow + j + nextrow;
-                const unsigned int fourth = i * nextrow + j + nextrow + 1u;
+                const size_t first = rowStart + j;
+                const size_t second = rowStart + j + 1ull;
+                const size_t third = rowStart + j + nextrow;
+                const size_t fourth = rowStart + j + nextrow + 1ull;
 
                 // first triangle
-                _indices.push_back(third);
-                _indices.push_back(second);
-                _indices.push_back(first);
+                _indices.push_back((unsigned int)third);
+                _indices.push_back((unsigned int)second);
+                _indices.push_back((unsigned int)first);
 
                 // second triangle
-                _indices.push_back(second);
-                _indices.push_back(third);
-                _indices.push_back(fourth);
-
-                if (_shapeConfig.genTangents) {
-                    // first triangle
-                    tangent = _calcTangent(third, second, first);
-
-                    _vertices[third].Tangent += tangent;
-                    _vertices[second].Tangent += tangent;
-                    _vertices[first].Tangent += tangent;
-
-                    // second triangle
-                    tangent = _calcTangent(second, third, fourth);
-
-                    _vertices[second].Tangent += tangent;
-                    _vertices[third].Tangent += tangent;
-                    _vertices[fourth].Tangent += tangent;
-                }
+                _indices.push_back((unsigned int)second);
+                _indices.push_back((unsigned int)third);
+                _indices.push_back((unsigned int)fourth);
             }
         }
+        indexTimer.stop();
 
         if (_shapeConfig.genTangents) {
-            std::vector<unsigned int> trisNum(_vertices.size(), 0u);
+            _accumulateTangents(0ull, _indices.size());
+            if (_cancelled) return;
+
+            std::pmr::vector<unsigned int> trisNum(_vertices.size(), 0u, arena.resource());
 
             const size_t indexCount = _indices.size();
             for (size_t i = 0ull; i < indexCount; ++i) {
@@ -180,15 +188,24 @@ void Torus::_generate(const unsigned int segments, const unsigned int cs_segment
 }
 
 Torus::Torus(const ShapeConfig& config, const unsigned int segments, const unsigned int cs_segments, const float radius, const float cs_radius, const ValuesRange range, const Shading shading)
+	: Shape(config)
 {
-    _shapeConfig = config;
 	_vertices.clear();
 	_indices.clear();
+    if (!_checkIndexType(getMeshCounts(segments, cs_segments, radius, cs_radius, range, shading))) return;
     _generate(std::max(3u, segments), std::max(3u, cs_segments), std::max(EPSILON, radius), std::max(EPSILON, cs_radius), range, shading == Shading::FLAT);
 }
 
 Torus::~Torus() {}
 
+MeshCounts Torus::getMeshCounts(const unsigned int segments, const unsigned int cs_segments, const float, const float, const ValuesRange, const Shading shading)
+{
+    const size_t s = std::max(3u, segments);
+    const size_t cs = std::max(3u, cs_segments);
+    const size_t indices = mul_sat<size_t>(6ull * s, cs);
+    return { shading == Shading::FLAT ? indices : mul_sat<size_t>(s + 1ull, cs + 1ull), indices };
+}
+
 std::string Torus::getClassName()
 {
 	return "Torus";
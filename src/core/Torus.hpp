@@ -25,6 +25,8 @@ public:
 	Torus(const ShapeConfig& config, const unsigned int segments = 3u, const unsigned int cs_segments = 3u, const float radius = 1.f, const float cs_radius = 0.5f, const ValuesRange range = ValuesRange::HALF_TO_HALF, const Shading shading = Shading::SMOOTH);
 	virtual ~Torus();
 
+	// Same parameters (and clamping) as constructor
+	static MeshCounts getMeshCounts(const unsigned int segments = 3u, const unsigned int cs_segments = 3u, const float radius = 1.f, const float cs_radius = 0.5f, const ValuesRange range = ValuesRange::HALF_TO_HALF, const Shading shading = Shading::SMOOTH);
 	static std::string getClassName();
 	std::string getObjectClassName() const override;
 };
\ No newline at end of file
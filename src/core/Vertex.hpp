@@ -4,6 +4,7 @@
 #include <cmath>
 #include <cstdint>
 #include <functional>
+#include <span>
 #include <type_traits>
 #pragma endregion
 
@@ -128,7 +129,7 @@ namespace nlohmann
         return j;
     }
 
-    inline json vertex_vector_to_json(const std::vector<Vertex>& vertices, bool genTangents, bool calcBitangents, bool positiveHandedness)
+    inline json vertex_vector_to_json(std::span<const Vertex> vertices, bool genTangents, bool calcBitangents, bool positiveHandedness)
     {
         json j = json::array();
 
@@ -14,8 +14,14 @@
 #include "pch.hpp"
 #pragma endregion
 
+#pragma region MY_FILES_CORE_LIB
+#include <MeshCache.hpp>
+#include <ThreadPool.hpp>
+#pragma endregion
+
 #pragma region MY_FILES
 #include "TuiApp.hpp"
+#include "BatchApp.hpp"
 #include "CliApp.hpp"
 #pragma endregion
 
@@ -28,16 +34,42 @@ int main(int argc, char** argv) {
 #endif
 
     std::string exe_dir_path = utils::get_executable_path();
-    utils::Config& _ = utils::get_config(exe_dir_path);
+    utils::Config& config = utils::get_config(exe_dir_path);
+    ThreadPool::setDefaultThreadsCount(config.threadPoolSize);
+
+    // --no-cache can be given with any mode
+    std::vector<std::string> args;
+    bool noCache = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == std::string("--no-cache")) noCache = true;
+        else args.push_back(argv[i]);
+    }
+
+    bool isCacheDirFullPath = std::filesystem::path(config.meshCacheDir).is_absolute();
+    std::string cacheDir = (isCacheDirFullPath ? "" : exe_dir_path + DIRSEP) + config.meshCacheDir;
+    MeshCache::get().configure(cacheDir, static_cast<uint64_t>(config.meshCacheSize) * 1024ull * 1024ull, config.meshCache && !noCache);
     
-    bool isCli = argc > 1 && (std::string(argv[1]) == std::string("-c") || std::string(argv[1]) == std::string("--cli"));
+    bool isCli = !args.empty() && (args[0] == std::string("-c") || args[0] == std::string("--cli"));
+    bool isBatch = !args.empty() && (args[0] == std::string("-b") || args[0] == std::string("--batch"));
 
-    if (argc > 1 && !isCli)
+    if (!args.empty() && !isCli && !isBatch)
     {
-        fmt::print("\n[{}] Error: Unknown argument '{}'!\n", fmt::styled("ERROR", fmt::fg(fmt::color::red)), std::string(argv[1]));
+        fmt::print("\n[{}] Error: Unknown argument '{}'!\n", fmt::styled("ERROR", fmt::fg(fmt::color::red)), args[0]);
         return EXIT_FAILURE;
     }
 
+    if (isBatch)
+    {
+        // --batch <manifest.json> [--summary <summary.json>]
+        if (args.size() != 2 && !(args.size() == 4 && (args[2] == std::string("-s") || args[2] == std::string("--summary"))))
+        {
+            fmt::print(stderr, "\n[{}] Error: Usage: {} --batch <manifest.json> [--summary <summary.json>] [--no-cache]\n", fmt::styled("ERROR", fmt::fg(fmt::color::red)), std::string(argv[0]));
+            return EXIT_FAILURE;
+        }
+
+        return cli::batchApp(args[1], args.size() == 4 ? args[3] : "");
+    }
+
     if (isCli)
     {
         return cli::cliApp();
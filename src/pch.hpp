@@ -52,9 +52,11 @@
 #include <IcoSphere.hpp>
 #include <Plane.hpp>
 #include <Pyramid.hpp>
+#include <ResourceEstimate.hpp>
 #include <Shape.hpp>
 #include <Sphere.hpp>
 #include <Tetrahedron.hpp>
+#include <TiledPlane.hpp>
 #include <Torus.hpp>
 
 // TUI_LIB
@@ -3,11 +3,16 @@
 #pragma endregion
 
 #pragma region STD_LIBS
+#include <algorithm>
 #include <functional>
 #include <string>
 #include <type_traits>
 #pragma endregion
 
+#pragma region FMT_LIB
+#include <fmt/format.h>
+#pragma endregion
+
 #pragma region FTXUI_LIB
 #include <ftxui/component/component.hpp>
 #include <ftxui/component/event.hpp>
@@ -17,6 +22,7 @@
 
 #pragma region MY_FILES_UTILS_LIB
 #include <Config.hpp>
+#include <StringHelpers.hpp>
 #pragma endregion
 
 #pragma region MY_FILES
@@ -38,8 +44,46 @@ tui::EditConfigView::EditConfigView(utils::Config& config, const std::string exe
     _calcBitangentsCheckbox = Checkbox("Calculate Bitangents", &_currentConfig.calcBitangents);
     _handednessCheckbox = Checkbox("Positive Handedness (w = 1.0)", &_currentConfig.tangentHandednessPositive);
     _openDirCheckbox = Checkbox("Open folder after save", &_currentConfig.openDirOnSave);
+    _saveTraceCheckbox = Checkbox("Save phase timings (.trace.json)", &_currentConfig.saveTrace);
+
+    _vertexCacheSizeStr = std::to_string(_currentConfig.vertexCacheSize);
+    auto typeIt = std::find(_vertexCacheTypes.begin(), _vertexCacheTypes.end(), _currentConfig.vertexCacheType);
+    _vertexCacheTypeIndex = typeIt != _vertexCacheTypes.end() ? static_cast<int>(typeIt - _vertexCacheTypes.begin()) : 0;
+
+    _optimizeVertexCacheCheckbox = Checkbox("Optimize vertex cache", &_currentConfig.optimizeVertexCache);
+    _vertexCacheSizeInput = Input(&_vertexCacheSizeStr, "32");
+    _vertexCacheTypeToggle = Toggle(&_vertexCacheTypes, &_vertexCacheTypeIndex);
+    _optimizeVertexFetchCheckbox = Checkbox("Optimize vertex fetch (reorder vertices)", &_currentConfig.optimizeVertexFetch);
+
+    _overdrawThresholdStr = fmt::format("{}", _currentConfig.overdrawThreshold);
+    _optimizeOverdrawCheckbox = Checkbox("Optimize overdraw", &_currentConfig.optimizeOverdraw);
+    _overdrawThresholdInput = Input(&_overdrawThresholdStr, "1.05");
+
+    _meshletMaxVerticesStr = std::to_string(_currentConfig.meshletMaxVertices);
+    _meshletMaxTrianglesStr = std::to_string(_currentConfig.meshletMaxTriangles);
+    _buildMeshletsCheckbox = Checkbox("Build meshlets", &_currentConfig.buildMeshlets);
+    _meshletMaxVerticesInput = Input(&_meshletMaxVerticesStr, "64");
+    _meshletMaxTrianglesInput = Input(&_meshletMaxTrianglesStr, "124");
+
+    _lodLevelsStr = std::to_string(_currentConfig.lodLevels);
+    _lodReductionStr = fmt::format("{}", _currentConfig.lodReduction);
+    _generateLodsCheckbox = Checkbox("Generate LODs", &_currentConfig.generateLods);
+    _lodLevelsInput = Input(&_lodLevelsStr, "3");
+    _lodReductionInput = Input(&_lodReductionStr, "0.5");
+
+    _threadPoolSizeStr = std::to_string(_currentConfig.threadPoolSize);
+    _threadPoolSizeInput = Input(&_threadPoolSizeStr, "0");
+
+    _meshCacheSizeStr = std::to_string(_currentConfig.meshCacheSize);
+    _meshCacheCheckbox = Checkbox("Reuse generated meshes (mesh cache)", &_currentConfig.meshCache);
+    _meshCacheDirInput = Input(&_currentConfig.meshCacheDir, "path/to/cache");
+    _meshCacheSizeInput = Input(&_meshCacheSizeStr, "256");
+
+    _memoryBudgetStr = std::to_string(_currentConfig.memoryBudget);
+    _memoryBudgetInput = Input(&_memoryBudgetStr, "4096");
 
     _saveButton = Button(" SAVE SETTINGS ", [this] {
+        UpdateCurrentConfig();
         if (CheckIfChanged())
         {
             utils::update_config(_config, _currentConfig, _exeDirPath);
@@ -58,10 +102,29 @@ tui::EditConfigView::EditConfigView(utils::Config& config, const std::string exe
         _calcBitangentsCheckbox,
         _handednessCheckbox,
         _openDirCheckbox,
+        _saveTraceCheckbox,
+        _optimizeVertexCacheCheckbox,
+        _vertexCacheSizeInput,
+        _vertexCacheTypeToggle,
+        _optimizeVertexFetchCheckbox,
+        _optimizeOverdrawCheckbox,
+        _overdrawThresholdInput,
+        _buildMeshletsCheckbox,
+        _meshletMaxVerticesInput,
+        _meshletMaxTrianglesInput,
+        _generateLodsCheckbox,
+        _lodLevelsInput,
+        _lodReductionInput,
+        _threadPoolSizeInput,
+        _meshCacheCheckbox,
+        _meshCacheDirInput,
+        _meshCacheSizeInput,
+        _memoryBudgetInput,
         _saveButton
     });
 
     _renderer = Renderer(_container, [this] {
+        UpdateCurrentConfig();
         bool isChanged = CheckIfChanged();
 
         Element saveStatus = vbox({
@@ -90,6 +153,27 @@ tui::EditConfigView::EditConfigView(utils::Config& config, const std::string exe
             _calcBitangentsCheckbox->Render(),
             _handednessCheckbox->Render(),
             _openDirCheckbox->Render(),
+            _saveTraceCheckbox->Render(),
+            separator(),
+            _optimizeVertexCacheCheckbox->Render(),
+            hbox(text(" Cache Size:     ") | size(WIDTH, EQUAL, 20), _vertexCacheSizeInput->Render()) | size(WIDTH, GREATER_THAN, 40),
+            hbox(text(" Cache Type:     ") | size(WIDTH, EQUAL, 20), _vertexCacheTypeToggle->Render()),
+            _optimizeVertexFetchCheckbox->Render(),
+            _optimizeOverdrawCheckbox->Render(),
+            hbox(text(" ACMR Threshold: ") | size(WIDTH, EQUAL, 20), _overdrawThresholdInput->Render()) | size(WIDTH, GREATER_THAN, 40),
+            _buildMeshletsCheckbox->Render(),
+            hbox(text(" Max Vertices:   ") | size(WIDTH, EQUAL, 20), _meshletMaxVerticesInput->Render()) | size(WIDTH, GREATER_THAN, 40),
+            hbox(text(" Max Triangles:  ") | size(WIDTH, EQUAL, 20), _meshletMaxTrianglesInput->Render()) | size(WIDTH, GREATER_THAN, 40),
+            _generateLodsCheckbox->Render(),
+            hbox(text(" LOD Levels:     ") | size(WIDTH, EQUAL, 20), _lodLevelsInput->Render()) | size(WIDTH, GREATER_THAN, 40),
+            hbox(text(" LOD Reduction:  ") | size(WIDTH, EQUAL, 20), _lodReductionInput->Render()) | size(WIDTH, GREATER_THAN, 40),
+            separator(),
+            hbox(text(" Threads (0=all):") | size(WIDTH, EQUAL, 20), _threadPoolSizeInput->Render()) | size(WIDTH, GREATER_THAN, 40),
+            _meshCacheCheckbox->Render(),
+            hbox(text(" Cache Directory:") | size(WIDTH, EQUAL, 20), _meshCacheDirInput->Render()) | size(WIDTH, GREATER_THAN, 40),
+            hbox(text(" Cache Limit MB: ") | size(WIDTH, EQUAL, 20), _meshCacheSizeInput->Render()) | size(WIDTH, GREATER_THAN, 40),
+            hbox(text(" Memory Budget MB:") | size(WIDTH, EQUAL, 20), _memoryBudgetInput->Render()) | size(WIDTH, GREATER_THAN, 40),
+            text(" Thread count and cache are applied on next start") | color(Color::GrayDark),
             separator(),
             saveStatus
         };
@@ -105,7 +189,7 @@ tui::EditConfigView::EditConfigView(utils::Config& config, const std::string exe
                     text("    ")
                 }),
                 separator(),
-                vbox(std::move(content)) | frame | size(HEIGHT, LESS_THAN, 15)
+                vbox(std::move(content)) | frame | size(HEIGHT, LESS_THAN, 28)
             }) | borderRounded | center | size(WIDTH, GREATER_THAN, 70),
             filler(),
             ControlsInfo({
@@ -138,5 +222,49 @@ bool tui::EditConfigView::CheckIfChanged()
            _currentConfig.genTangents               != _config.genTangents    ||
            _currentConfig.openDirOnSave             != _config.openDirOnSave  ||
            _currentConfig.calcBitangents            != _config.calcBitangents ||
-           _currentConfig.tangentHandednessPositive != _config.tangentHandednessPositive;
+           _currentConfig.tangentHandednessPositive != _config.tangentHandednessPositive ||
+           _currentConfig.optimizeVertexCache       != _config.optimizeVertexCache       ||
+           _currentConfig.vertexCacheSize           != _config.vertexCacheSize           ||
+           _currentConfig.vertexCacheType           != _config.vertexCacheType           ||
+           _currentConfig.optimizeVertexFetch       != _config.optimizeVertexFetch       ||
+           _currentConfig.optimizeOverdraw          != _config.optimizeOverdraw          ||
+           _currentConfig.overdrawThreshold         != _config.overdrawThreshold         ||
+           _currentConfig.buildMeshlets             != _config.buildMeshlets             ||
+           _currentConfig.meshletMaxVertices        != _config.meshletMaxVertices        ||
+           _currentConfig.meshletMaxTriangles       != _config.meshletMaxTriangles       ||
+           _currentConfig.generateLods              != _config.generateLods              ||
+           _currentConfig.lodLevels                 != _config.lodLevels                 ||
+           _currentConfig.lodReduction              != _config.lodReduction              ||
+           _currentConfig.threadPoolSize            != _config.threadPoolSize            ||
+           _currentConfig.meshCache                 != _config.meshCache                 ||
+           _currentConfig.meshCacheDir              != _config.meshCacheDir              ||
+           _currentConfig.meshCacheSize             != _config.meshCacheSize             ||
+           _currentConfig.saveTrace                 != _config.saveTrace                 ||
+           _currentConfig.memoryBudget              != _config.memoryBudget;
+}
+
+void tui::EditConfigView::UpdateCurrentConfig()
+{
+    // Invalid size input keeps the last valid value
+    unsigned int cacheSize = utils::parse_uint(_vertexCacheSizeStr, _currentConfig.vertexCacheSize);
+    if (cacheSize > 0u) _currentConfig.vertexCacheSize = cacheSize;
+    _currentConfig.vertexCacheType = _vertexCacheTypes[_vertexCacheTypeIndex];
+
+    // Threshold below 1.0 would not allow any cluster split
+    float threshold = utils::parse_float(_overdrawThresholdStr, _currentConfig.overdrawThreshold);
+    if (threshold >= 1.f) _currentConfig.overdrawThreshold = threshold;
+
+    // Meshlet limits are clamped by the builder, only zero is rejected here
+    unsigned int maxVertices = utils::parse_uint(_meshletMaxVerticesStr, _currentConfig.meshletMaxVertices);
+    if (maxVertices > 0u) _currentConfig.meshletMaxVertices = maxVertices;
+    unsigned int maxTriangles = utils::parse_uint(_meshletMaxTrianglesStr, _currentConfig.meshletMaxTriangles);
+    if (maxTriangles > 0u) _currentConfig.meshletMaxTriangles = maxTriangles;
+
+    _currentConfig.lodLevels = utils::parse_uint(_lodLevelsStr, _currentConfig.lodLevels);
+    float reduction = utils::parse_float(_lodReductionStr, _currentConfig.lodReduction);
+    if (reduction > 0.f && reduction < 1.f) _currentConfig.lodReduction = reduction;
+
+    _currentConfig.threadPoolSize = utils::parse_uint(_threadPoolSizeStr, _currentConfig.threadPoolSize);
+    _currentConfig.meshCacheSize = utils::parse_uint(_meshCacheSizeStr, _currentConfig.meshCacheSize);
+    _currentConfig.memoryBudget = utils::parse_uint(_memoryBudgetStr, _currentConfig.memoryBudget);
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #pragma region STD_LIBS
 #include <functional>
 #include <string>
+#include <vector>
 #pragma endregion
 
 #pragma region FTXUI_LIB
@@ -29,6 +30,7 @@ namespace tui {
 
     private:
         bool CheckIfChanged();
+        void UpdateCurrentConfig();
 
         utils::Config& _config;
         utils::Config _currentConfig;
@@ -43,12 +45,42 @@ namespace tui {
         ftxui::Component _calcBitangentsCheckbox;
         ftxui::Component _handednessCheckbox;
         ftxui::Component _openDirCheckbox;
+        ftxui::Component _saveTraceCheckbox;
+        ftxui::Component _optimizeVertexCacheCheckbox;
+        ftxui::Component _vertexCacheSizeInput;
+        ftxui::Component _vertexCacheTypeToggle;
+        ftxui::Component _optimizeVertexFetchCheckbox;
+        ftxui::Component _optimizeOverdrawCheckbox;
+        ftxui::Component _overdrawThresholdInput;
+        ftxui::Component _buildMeshletsCheckbox;
+        ftxui::Component _meshletMaxVerticesInput;
+        ftxui::Component _meshletMaxTrianglesInput;
+        ftxui::Component _generateLodsCheckbox;
+        ftxui::Component _lodLevelsInput;
+        ftxui::Component _lodReductionInput;
+        ftxui::Component _threadPoolSizeInput;
+        ftxui::Component _meshCacheCheckbox;
+        ftxui::Component _meshCacheDirInput;
+        ftxui::Component _meshCacheSizeInput;
+        ftxui::Component _memoryBudgetInput;
         ftxui::Component _saveButton;
         ftxui::Component _backButton;
 
         ftxui::Component _container;
         ftxui::Component _renderer;
 
+        std::string _vertexCacheSizeStr;
+        std::string _overdrawThresholdStr;
+        std::string _meshletMaxVerticesStr;
+        std::string _meshletMaxTrianglesStr;
+        std::string _lodLevelsStr;
+        std::string _lodReductionStr;
+        std::string _threadPoolSizeStr;
+        std::string _meshCacheSizeStr;
+        std::string _memoryBudgetStr;
+        int _vertexCacheTypeIndex = 0;
+        const std::vector<std::string> _vertexCacheTypes = { "FIFO", "LRU" };
+
         bool _showSavedMessage = false;
         int _messageTimer = 0;
     };
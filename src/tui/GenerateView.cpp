@@ -18,28 +18,31 @@
 #include <ftxui/component/event.hpp>
 #pragma endregion
 
+#pragma region MY_FILES_CORE_LIB
+#include <ThreadPool.hpp>
+#pragma endregion
+
 #pragma region MY_FILES
 #include "GenerateView.hpp"
+#include "ViewHelpers.hpp"
 #pragma endregion
 
 using namespace ftxui;
 
-tui::GenerateView::GenerateView(Shape*& outShape, GenerateDuration& outTime, std::function<void()> onFinish)
-    : _outShape(outShape), _outTime(outTime), _onFinish(std::move(onFinish))
+tui::GenerateView::GenerateView(Shape*& outShape, GenerateDuration& outTime, ProgressToken& progress, PostEvent post, std::function<void()> onFinish)
+    : _outShape(outShape), _outTime(outTime), _progress(progress), _post(std::move(post)), _onFinish(std::move(onFinish))
 {
-    _renderer = Renderer([this] {
-        if (_future.valid() && _future.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
-            auto [shape, time] = _future.get();
-            _outShape = shape;
-            _outTime = time;
-            _onFinish();
-        }
+    _cancelButton = TaskCancelButton(_progress);
 
+    _renderer = Renderer(_cancelButton, [this] {
         return vbox({
             filler(),
             vbox({
                 text("Generating " + _shapeStr + "\n\n") | center | bold,
-                spinner(18, (_frameIndex++) / 3) | center
+                TaskSpinner(_startTime) | center,
+                TaskProgress(_progress) | center,
+                text(""),
+                _cancelButton->Render() | center
             }) | center,
             filler()
         }) | borderRounded;
@@ -59,13 +62,30 @@ Component tui::GenerateView::GetComponent()
     return _renderer;
 }
 
+tui::GenerateView::~GenerateView()
+{
+    if (_future.valid()) _future.wait();
+}
+
 bool tui::GenerateView::OnEvent(Event event)
 {
+    if (event == Event::Escape) _progress.cancel();
+
+    // Result is taken once, on UI thread
+    if (event == TaskFinishedEvent() && _future.valid()) {
+        auto [shape, time] = _future.get();
+        _future = {};
+        _outShape = shape;
+        _outTime = time;
+        _onFinish();
+    }
     return true;
 }
 
 void tui::GenerateView::StartWorker() {
-    _future = std::async(std::launch::async, [this]() {
+    _startTime = std::chrono::steady_clock::now();
+    _future = ThreadPool::get().submit([this]() {
         return _task();
-    });
+    }).share();
+    _ticker = TaskTicker(_future, _post);
 }
\ No newline at end of file
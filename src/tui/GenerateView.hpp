@@ -7,6 +7,7 @@
 #include <future>
 #include <ratio>
 #include <string>
+#include <thread>
 #include <utility>
 #pragma endregion
 
@@ -19,6 +20,7 @@
 #include "View.hpp"
 #pragma endregion
 
+class ProgressToken;
 class Shape;
 
 namespace tui {
@@ -28,7 +30,10 @@ namespace tui {
         using GenerateResult = std::pair<Shape*, GenerateDuration>;
         using GenerateTask = std::function<GenerateResult()>;
 
-        GenerateView(Shape*& outShape, GenerateDuration& outTime, std::function<void()> onFinish);
+        // progress - given to the task by owner, Cancel button and ESC cancel it. post - posts events to the screen from ticker thread
+        GenerateView(Shape*& outShape, GenerateDuration& outTime, ProgressToken& progress, PostEvent post, std::function<void()> onFinish);
+        // Pool task uses this view, so it has to finish first
+        ~GenerateView() override;
 
         void StartTask(std::string shapeName, GenerateTask task);
 
@@ -45,11 +50,17 @@ namespace tui {
 
         Shape*& _outShape;
         GenerateDuration& _outTime;
-        std::future<GenerateResult> _future;
+        std::shared_future<GenerateResult> _future;
+        // Redraws the view while task runs and posts TaskFinishedEvent
+        std::jthread _ticker;
+        PostEvent _post;
 
         std::string _shapeStr = "shape";
 
-        size_t _frameIndex = 0;
+        ProgressToken& _progress;
+
+        std::chrono::steady_clock::time_point _startTime;
+        ftxui::Component _cancelButton;
         ftxui::Component _renderer;
     };
 }
\ No newline at end of file
@@ -16,6 +16,15 @@
 #include <ftxui/screen/color.hpp>
 #pragma endregion
 
+#pragma region MY_FILES_CORE_LIB
+#include <ResourceEstimate.hpp>
+#include <Shape.hpp>
+#pragma endregion
+
+#pragma region MY_FILES_UTILS_LIB
+#include <Config.hpp>
+#pragma endregion
+
 #pragma region MY_FILES
 #include "ParametersView.hpp"
 #include "ViewHelpers.hpp"
@@ -27,11 +36,11 @@ tui::ParametersView::ParametersView(int& rangeIndex, std::function<void()> onGen
     : _rangeIndex(rangeIndex), _onGenerate(std::move(onGenerate)), _onBack(std::move(onBack))
 {
     _generateButtonBase = Button("Generate", [&] {
-        if (AreAllInputsValid()) _onGenerate();
+        if (AreAllInputsValid() && IsWithinLimits()) _onGenerate();
     });
 
     _generateButton = Renderer(_generateButtonBase, [this] {
-        const bool allValid = AreAllInputsValid();
+        const bool allValid = AreAllInputsValid() && IsWithinLimits();
 
         auto btn = _generateButtonBase->Render();
 
@@ -64,6 +73,48 @@ bool tui::ParametersView::OnEvent(Event event)
     return false;
 }
 
+void tui::ParametersView::SetResourceLimits(const ShapeConfig& shapeConfig, const utils::Config& config)
+{
+    _shapeConfig = &shapeConfig;
+    _config = &config;
+}
+
+bool tui::ParametersView::IsWithinLimits() const
+{
+    if (!AreAllInputsValid()) return true;
+
+    const MeshCounts counts = GetMeshCounts();
+    if (!counts.fitsIndexType()) return false;
+    return _config == nullptr || ResourceEstimator::fitsBudget(ResourceEstimator::estimateGeneration(counts).peakBytes, _config->memoryBudget);
+}
+
+Element tui::ParametersView::RenderEstimate() const
+{
+    if (_config == nullptr || _shapeConfig == nullptr || !AreAllInputsValid()) return text("");
+
+    const MeshCounts counts = GetMeshCounts();
+    if (!counts.fitsIndexType()) {
+        return text(" Over " + std::to_string(MeshCounts::MAX_VERTICES) + " vertices or indices, 32-bit indices can't address it") | color(Color::Red);
+    }
+
+    const ResourceEstimate estimate = ResourceEstimator::estimateGeneration(counts);
+    const ExportEstimate binary = ResourceEstimator::estimateExport(estimate.counts, FormatType::BINARY, *_shapeConfig);
+    const ExportEstimate source = ResourceEstimator::estimateExport(estimate.counts, FormatType::CPP_ARRAY_INDICES_STRUCT, *_shapeConfig);
+
+    Elements lines = {
+        hbox({ text(" Vertices: ") | bold, text(std::to_string(estimate.counts.vertices)),
+               text("  Indices: ") | bold, text(std::to_string(estimate.counts.indices)) }),
+        hbox({ text(" Memory:   ") | bold, text(ResourceEstimator::formatBytes(estimate.meshBytes) + " (peak ~" + ResourceEstimator::formatBytes(estimate.peakBytes) + ")") }),
+        hbox({ text(" File:     ") | bold, text(ResourceEstimator::formatBytes(binary.fileBytes) + " binary, ~" + ResourceEstimator::formatBytes(source.fileBytes) + " C++") })
+    };
+
+    if (!ResourceEstimator::fitsBudget(estimate.peakBytes, _config->memoryBudget)) {
+        lines.push_back(text(" Over memory budget (" + std::to_string(_config->memoryBudget) + " MB), lower parameters or raise it in settings") | color(Color::Red));
+    }
+
+    return vbox(std::move(lines));
+}
+
 Element tui::ParametersView::RenderBase()
 {
     Elements content;
@@ -84,6 +135,8 @@ Element tui::ParametersView::RenderBase()
         content.push_back(separator());
     }
 
+    content.push_back(RenderEstimate());
+    content.push_back(separator());
     content.push_back(_generateButton->Render() | center);
 
     return vbox({
@@ -102,6 +155,11 @@ bool tui::ParametersView::AreAllInputsValid() const
     return true;
 }
 
+MeshCounts tui::ParametersView::GetMeshCounts() const
+{
+    return {};
+}
+
 Element tui::ParametersView::AsciiArt() const
 {
     return vbox({
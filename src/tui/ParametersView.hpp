@@ -12,6 +12,14 @@
 #include <ftxui/component/event.hpp>
 #pragma endregion
 
+#pragma region MY_FILES_CORE_LIB
+#include <Shape.hpp>
+#pragma endregion
+
+#pragma region MY_FILES_UTILS_LIB
+#include <Config.hpp>
+#pragma endregion
+
 #pragma region MY_FILES
 #include "View.hpp"
 #pragma endregion
@@ -25,11 +33,16 @@ namespace tui {
 
         bool OnEvent(ftxui::Event event) override;
 
+        // Estimate under parameters uses tangent settings of shapeConfig, shapes over config.memoryBudget (or unsigned int indices) can't be generated
+        void SetResourceLimits(const ShapeConfig& shapeConfig, const utils::Config& config);
+
     protected:
         ftxui::Element RenderBase();
 
         virtual bool AreAllInputsValid() const;
         virtual ftxui::Element AsciiArt() const;
+        // Counts of shape with current parameters, called only when all inputs are valid
+        virtual MeshCounts GetMeshCounts() const;
 
     protected:
         std::function<void()> _onGenerate;
@@ -52,8 +65,15 @@ namespace tui {
         const std::vector<std::string> _shadingOptions = { "Flat", "Smooth" };
 
     private:
+        // Shape fits unsigned int indices and memory budget
+        bool IsWithinLimits() const;
+        ftxui::Element RenderEstimate() const;
+
         int& _rangeIndex;
 
+        const ShapeConfig* _shapeConfig = nullptr;
+        const utils::Config* _config = nullptr;
+
         ftxui::Component _generateButtonBase;
 
         const std::vector<std::string> _rangeOptions = { "[-0.5, 0.5]", "[-1.0, 1.0]" };
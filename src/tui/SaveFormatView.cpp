@@ -8,6 +8,7 @@
 #include <string>
 #include <ratio>
 #include <type_traits>
+#include <utility>
 #include <vector>
 #pragma endregion
 
@@ -18,6 +19,14 @@
 #include <ftxui/screen/color.hpp>
 #pragma endregion
 
+#pragma region MY_FILES_CORE_LIB
+#include <ResourceEstimate.hpp>
+#pragma endregion
+
+#pragma region MY_FILES_UTILS_LIB
+#include <Config.hpp>
+#pragma endregion
+
 #pragma region MY_FILES
 #include "SaveFormatView.hpp"
 #include "ViewHelpers.hpp"
@@ -25,8 +34,9 @@
 
 using namespace ftxui;
 
-tui::SaveFormatView::SaveFormatView(std::string& shapeName, std::chrono::duration<double, std::milli>& time, std::function<void(int)> onSave, std::function<void()> onCancel)
-    : _shapeName(shapeName), _time(time), _onSave(std::move(onSave)), _onCancel(std::move(onCancel))
+tui::SaveFormatView::SaveFormatView(std::string& shapeName, std::chrono::duration<double, std::milli>& time, std::vector<std::pair<std::string, std::string>>& details,
+    const utils::Config& config, std::function<ExportEstimate(int)> estimateExport, std::function<void(int)> onSave, std::function<void()> onCancel)
+    : _shapeName(shapeName), _time(time), _details(details), _config(config), _estimateExport(std::move(estimateExport)), _onSave(std::move(onSave)), _onCancel(std::move(onCancel))
 {
     RadioboxOption r_options;
     r_options.entries = std::move(&_formatOptions);
@@ -71,6 +81,14 @@ tui::SaveFormatView::SaveFormatView(std::string& shapeName, std::chrono::duratio
                 row
             });
         }
+        else if (s.index == 12) {
+            return vbox({
+                separatorEmpty(),
+                text(" STRIP (Triangle Strips) ") | bold | color(Color::BlueLight),
+                separatorLight(),
+                row
+            });
+        }
 
         return row;
     };
@@ -86,7 +104,7 @@ tui::SaveFormatView::SaveFormatView(std::string& shapeName, std::chrono::duratio
     };
 
     _saveButton = Button("Save", [&] {
-        _onSave(_selectedFormat);
+        if (IsWithinBudget()) _onSave(_selectedFormat);
     }, b_options);
 
     _cancelButton = Button("Cancel", [&] {
@@ -102,6 +120,25 @@ tui::SaveFormatView::SaveFormatView(std::string& shapeName, std::chrono::duratio
     });
 
     _renderer = Renderer(_container, [this] {
+        Elements info = {
+            hbox({ text(" Shape:    ") | bold, text(_shapeName)}),
+            hbox({ text(" Time:     ") | bold, text(std::to_string(_time.count()) + " ms") })
+        };
+
+        for (const auto& [label, value] : _details) {
+            info.push_back(hbox({ text(" " + label + ":") | bold | size(WIDTH, EQUAL, 11), text(value) }));
+        }
+
+        const ExportEstimate estimate = _estimateExport(_selectedFormat);
+        const bool withinBudget = ResourceEstimator::fitsBudget(estimate.peakBytes, _config.memoryBudget);
+        Element estimateLine = hbox({ text(" File size: ") | bold, text("~" + ResourceEstimator::formatBytes(estimate.fileBytes) + " (peak memory ~" + ResourceEstimator::formatBytes(estimate.peakBytes) + ")") });
+        if (!withinBudget) {
+            estimateLine = vbox({
+                estimateLine,
+                text(" Over memory budget (" + std::to_string(_config.memoryBudget) + " MB), choose smaller format") | color(Color::Red)
+            });
+        }
+
         return vbox({
             filler(),
             vbox({
@@ -112,17 +149,16 @@ tui::SaveFormatView::SaveFormatView(std::string& shapeName, std::chrono::duratio
                 }),
                 separator(),
 
-                vbox({
-                    hbox({ text(" Shape:    ") | bold, text(_shapeName)}),
-                    hbox({ text(" Time:     ") | bold, text(std::to_string(_time.count()) + " ms") })
-                }) | center | size(WIDTH, GREATER_THAN, 40),
+                vbox(std::move(info)) | center | size(WIDTH, GREATER_THAN, 40),
 
                 separator(),
 
                 vbox({
                     text("SELECT FORMAT") | bold | center | color(Color::Magenta2),
                     separator(),
-                    _formatRadio->Render() | vscroll_indicator | yframe | size(HEIGHT, LESS_THAN, 12) | size(WIDTH, GREATER_THAN, 40)
+                    _formatRadio->Render() | vscroll_indicator | yframe | size(HEIGHT, LESS_THAN, 12) | size(WIDTH, GREATER_THAN, 40),
+                    separator(),
+                    estimateLine
                 }) | hcenter,
 
                 separator(),
@@ -130,7 +166,7 @@ tui::SaveFormatView::SaveFormatView(std::string& shapeName, std::chrono::duratio
                 hbox({
                     _cancelButton->Render() | flex,
                     text(" "),
-                    _saveButton->Render() | flex
+                    _saveButton->Render() | (withinBudget ? nothing : dim) | flex
                 })
             }) | borderRounded | center | size(WIDTH, GREATER_THAN, 60),
             filler(),
@@ -148,6 +184,11 @@ Component tui::SaveFormatView::GetComponent()
     return _renderer;
 }
 
+bool tui::SaveFormatView::IsWithinBudget() const
+{
+    return ResourceEstimator::fitsBudget(_estimateExport(_selectedFormat).peakBytes, _config.memoryBudget);
+}
+
 bool tui::SaveFormatView::OnEvent(Event event)
 {
     if (event == Event::Escape) {
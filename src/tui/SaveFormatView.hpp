@@ -5,6 +5,7 @@
 #include <functional>
 #include <string>
 #include <ratio>
+#include <utility>
 #include <vector>
 #pragma endregion
 
@@ -13,6 +14,14 @@
 #include <ftxui/component/event.hpp>
 #pragma endregion
 
+#pragma region MY_FILES_CORE_LIB
+#include <ResourceEstimate.hpp>
+#pragma endregion
+
+#pragma region MY_FILES_UTILS_LIB
+#include <Config.hpp>
+#pragma endregion
+
 #pragma region MY_FILES
 #include "View.hpp"
 #pragma endregion
@@ -20,15 +29,23 @@
 namespace tui {
     class SaveFormatView : public View {
     public:
-        SaveFormatView(std::string& shapeName, std::chrono::duration<double, std::milli>& time, std::function<void(int)> onSave, std::function<void()> onCancel);
+        // estimateExport - file size and memory of saving shape in given format, formats over config.memoryBudget can't be saved
+        SaveFormatView(std::string& shapeName, std::chrono::duration<double, std::milli>& time, std::vector<std::pair<std::string, std::string>>& details,
+            const utils::Config& config, std::function<ExportEstimate(int)> estimateExport, std::function<void(int)> onSave, std::function<void()> onCancel);
 
         ftxui::Component GetComponent() override;
 
         bool OnEvent(ftxui::Event event) override;
 
     private:
+        bool IsWithinBudget() const;
+
         std::string& _shapeName;
         std::chrono::duration<double, std::milli>& _time;
+        std::vector<std::pair<std::string, std::string>>& _details;
+        const utils::Config& _config;
+
+        std::function<ExportEstimate(int)> _estimateExport;
 
         std::function<void(int)> _onSave;
         std::function<void()> _onCancel;
@@ -47,7 +64,15 @@ namespace tui {
 
             "JSON - Vertices & Indices",
             "JSON - Vertices only",
-            "OBJ"
+            "OBJ",
+            "Binary",
+
+            "std::array - Vertices & Strip (struct)",
+            "C array    - Vertices & Strip (struct)",
+            "std::array - Vertices & Strip (float)",
+            "C array    - Vertices & Strip (float)",
+            "JSON - Vertices & Strip",
+            "Binary - Strip"
         };
 
         ftxui::Component _formatRadio;
@@ -8,6 +8,8 @@
 #include <string>
 #include <ratio>
 #include <type_traits>
+#include <utility>
+#include <vector>
 #pragma endregion
 
 #pragma region FTXUI_LIB
@@ -28,8 +30,8 @@
 
 using namespace ftxui;
 
-tui::SaveResultView::SaveResultView(int& fileSavedStatus, std::string exePath, std::string& filePath, std::chrono::duration<double, std::milli>& saveTime, std::function<void()> onNext, std::function<void()> onExit)
-    : _status(fileSavedStatus), _exePath(exePath), _path(filePath), _time(saveTime), _onNext(std::move(onNext)), _onExit(std::move(onExit))
+tui::SaveResultView::SaveResultView(int& fileSavedStatus, std::string exePath, std::string& filePath, std::chrono::duration<double, std::milli>& saveTime, std::vector<std::pair<std::string, std::string>>& details, std::function<void()> onNext, std::function<void()> onOtherFormat, std::function<void()> onExit)
+    : _status(fileSavedStatus), _exePath(exePath), _path(filePath), _time(saveTime), _details(details), _onNext(std::move(onNext)), _onOtherFormat(std::move(onOtherFormat)), _onExit(std::move(onExit))
 {
     _copyButton = Button("Copy", [this] { clip::set_text(_path); _wasCopied = true; }, ButtonOption::Ascii());
 
@@ -43,12 +45,15 @@ tui::SaveResultView::SaveResultView(int& fileSavedStatus, std::string exePath, s
     };
 
     _nextGenButton = Button("Generate Next", [this] { _wasCopied = false; _onNext(); }, b_options);
+    // Same shape, nothing is generated again
+    _otherFormatButton = Button("Save Other Format", [this] { _wasCopied = false; _onOtherFormat(); }, b_options);
     _exitButton = Button("Exit App", _onExit, b_options);
 
     _container = Container::Vertical({
         _copyButton,
         Container::Horizontal({
             _nextGenButton,
+            _otherFormatButton,
             _exitButton
         })
     });
@@ -74,6 +79,13 @@ tui::SaveResultView::SaveResultView(int& fileSavedStatus, std::string exePath, s
                 text(std::to_string(_time.count()) + " ms") | vcenter
             }));
 
+            for (const auto& [label, value] : _details) {
+                infoLines.push_back(hbox({
+                    text(" " + label + ": ") | bold | vcenter,
+                    text(value) | vcenter
+                }));
+            }
+
             if (_status == 1) {
                 infoLines.push_back(separatorEmpty());
                 infoLines.push_back(text(" Warning: Explorer could not be opened automatically.") | color(Color::Yellow) | dim | center);
@@ -96,6 +108,8 @@ tui::SaveResultView::SaveResultView(int& fileSavedStatus, std::string exePath, s
                 hbox({
                     _nextGenButton->Render() | flex,
                     text(" "),
+                    _otherFormatButton->Render() | flex,
+                    text(" "),
                     _exitButton->Render() | flex
                 }) | vcenter
             }) | borderRounded | center | size(WIDTH, GREATER_THAN, 50),
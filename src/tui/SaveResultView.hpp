@@ -5,6 +5,8 @@
 #include <functional>
 #include <string>
 #include <ratio>
+#include <utility>
+#include <vector>
 #pragma endregion
 
 #pragma region FTXUI_LIB
@@ -19,7 +21,7 @@
 namespace tui {
     class SaveResultView : public View {
     public:
-        SaveResultView(int& fileSavedStatus, std::string exePath, std::string& filePath, std::chrono::duration<double, std::milli>& saveTime, std::function<void()> onNext, std::function<void()> onExit);
+        SaveResultView(int& fileSavedStatus, std::string exePath, std::string& filePath, std::chrono::duration<double, std::milli>& saveTime, std::vector<std::pair<std::string, std::string>>& details, std::function<void()> onNext, std::function<void()> onOtherFormat, std::function<void()> onExit);
 
         ftxui::Component GetComponent() override;
 
@@ -30,14 +32,17 @@ namespace tui {
         std::string& _path;
         std::string _exePath;
         std::chrono::duration<double, std::milli>& _time;
+        std::vector<std::pair<std::string, std::string>>& _details;
 
         std::function<void()> _onNext;
+        std::function<void()> _onOtherFormat;
         std::function<void()> _onExit;
 
         bool _wasCopied = false;
 
         ftxui::Component _copyButton;
         ftxui::Component _nextGenButton;
+        ftxui::Component _otherFormatButton;
         ftxui::Component _exitButton;
 
         ftxui::Component _container;
@@ -18,28 +18,31 @@
 #include <ftxui/component/event.hpp>
 #pragma endregion
 
+#pragma region MY_FILES_CORE_LIB
+#include <ThreadPool.hpp>
+#pragma endregion
+
 #pragma region MY_FILES
 #include "SaveView.hpp"
+#include "ViewHelpers.hpp"
 #pragma endregion
 
 using namespace ftxui;
 
-tui::SaveView::SaveView(Shape*& shapeToSave, SaveDuration& outTime, std::string& saveLocation, std::function<void()> onFinish)
-    : _shapeToSave(shapeToSave), _outTime(outTime), _saveLocation(saveLocation), _onFinish(std::move(onFinish))
+tui::SaveView::SaveView(Shape*& shapeToSave, SaveDuration& outTime, std::string& saveLocation, ProgressToken& progress, PostEvent post, std::function<void()> onFinish)
+    : _shapeToSave(shapeToSave), _outTime(outTime), _saveLocation(saveLocation), _progress(progress), _post(std::move(post)), _onFinish(std::move(onFinish))
 {
-    _renderer = Renderer([this] {
-        if (_future.valid() && _future.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
-            auto [loc, t] = _future.get();
-            _saveLocation = loc;
-            _outTime = t;
-            _onFinish();
-        }
+    _cancelButton = TaskCancelButton(_progress);
 
+    _renderer = Renderer(_cancelButton, [this] {
         return vbox({
             filler(),
             vbox({
                 text("Saving to " + _fileTypeStr + " file\n\n") | center | bold,
-                spinner(18, (_frameIndex++) / 3) | center
+                TaskSpinner(_startTime) | center,
+                TaskProgress(_progress) | center,
+                text(""),
+                _cancelButton->Render() | center
             }) | center,
             filler()
         }) | borderRounded;
@@ -59,14 +62,31 @@ Component tui::SaveView::GetComponent()
     return _renderer;
 }
 
+tui::SaveView::~SaveView()
+{
+    if (_future.valid()) _future.wait();
+}
+
 bool tui::SaveView::OnEvent(Event event)
 {
+    if (event == Event::Escape) _progress.cancel();
+
+    // Result is taken once, on UI thread
+    if (event == TaskFinishedEvent() && _future.valid()) {
+        auto [loc, t] = _future.get();
+        _future = {};
+        _saveLocation = loc;
+        _outTime = t;
+        _onFinish();
+    }
     return true;
 }
 
 void tui::SaveView::StartWorker()
 {
-    _future = std::async(std::launch::async, [this]() {
+    _startTime = std::chrono::steady_clock::now();
+    _future = ThreadPool::get().submit([this]() {
         return _task();
-    });
+    }).share();
+    _ticker = TaskTicker(_future, _post);
 }
\ No newline at end of file
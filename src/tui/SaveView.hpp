@@ -5,8 +5,9 @@
 #include <cstdint>
 #include <functional>
 #include <future>
-#include <string>
 #include <ratio>
+#include <string>
+#include <thread>
 #include <utility>
 #pragma endregion
 
@@ -19,6 +20,7 @@
 #include "View.hpp"
 #pragma endregion
 
+class ProgressToken;
 class Shape;
 
 namespace tui {
@@ -28,7 +30,10 @@ namespace tui {
         using SaveResult = std::pair<std::string, SaveDuration>;
         using SaveTask = std::function<SaveResult()>;
 
-        SaveView(Shape*& shapeToSave, SaveDuration& outTime, std::string& saveLocation, std::function<void()> onFinish);
+        // progress - given to the task by owner, Cancel button and ESC cancel it. post - posts events to the screen from ticker thread
+        SaveView(Shape*& shapeToSave, SaveDuration& outTime, std::string& saveLocation, ProgressToken& progress, PostEvent post, std::function<void()> onFinish);
+        // Pool task uses this view, so it has to finish first
+        ~SaveView() override;
 
         void StartTask(std::string fileType, SaveTask task);
 
@@ -46,11 +51,17 @@ namespace tui {
         Shape*& _shapeToSave;
         SaveDuration& _outTime;
         std::string& _saveLocation;
-        std::future<SaveResult> _future;
+        std::shared_future<SaveResult> _future;
+        // Redraws the view while task runs and posts TaskFinishedEvent
+        std::jthread _ticker;
+        PostEvent _post;
 
         std::string _fileTypeStr = "Text";
 
-        size_t _frameIndex = 0;
+        ProgressToken& _progress;
+
+        std::chrono::steady_clock::time_point _startTime;
+        ftxui::Component _cancelButton;
         ftxui::Component _renderer;
     };
 }
\ No newline at end of file
@@ -14,6 +14,20 @@
 #include <ftxui/dom/elements.hpp>
 #pragma endregion
 
+#pragma region MY_FILES_CORE_LIB
+#include <Cone.hpp>
+#include <Cube.hpp>
+#include <Cylinder.hpp>
+#include <Hexagon.hpp>
+#include <IcoSphere.hpp>
+#include <Plane.hpp>
+#include <Pyramid.hpp>
+#include <Shape.hpp>
+#include <Sphere.hpp>
+#include <Tetrahedron.hpp>
+#include <Torus.hpp>
+#pragma endregion
+
 #pragma region MY_FILES
 #include "ShapesParametersViews.hpp"
 #include "ViewHelpers.hpp"
@@ -68,6 +82,11 @@ bool tui::PlaneParametersView::AreAllInputsValid() const
     return _rowsValid && _columnsValid;
 }
 
+MeshCounts tui::PlaneParametersView::GetMeshCounts() const
+{
+    return Plane::getMeshCounts(_rows, _columns, static_cast<PlaneNormalDir>(_planeDirIndex));
+}
+
 Element tui::PlaneParametersView::AsciiArt() const
 {
     return vbox({
@@ -105,6 +124,11 @@ tui::CubeParametersView::CubeParametersView(int& rangeIndex, std::function<void(
     _renderer = Renderer(_container, [this] { return RenderBase(); });
 }
 
+MeshCounts tui::CubeParametersView::GetMeshCounts() const
+{
+    return Cube::getMeshCounts();
+}
+
 Element tui::CubeParametersView::AsciiArt() const
 {
     return vbox({
@@ -144,6 +168,11 @@ tui::TetrahedronParametersView::TetrahedronParametersView(int& rangeIndex, std::
     _renderer = Renderer(_container, [this] { return RenderBase(); });
 }
 
+MeshCounts tui::TetrahedronParametersView::GetMeshCounts() const
+{
+    return Tetrahedron::getMeshCounts();
+}
+
 Element tui::TetrahedronParametersView::AsciiArt() const
 {
     return vbox({
@@ -181,6 +210,11 @@ tui::PyramidParametersView::PyramidParametersView(int& rangeIndex, std::function
     _renderer = Renderer(_container, [this] { return RenderBase(); });
 }
 
+MeshCounts tui::PyramidParametersView::GetMeshCounts() const
+{
+    return Pyramid::getMeshCounts();
+}
+
 Element tui::PyramidParametersView::AsciiArt() const
 {
     return vbox({
@@ -239,6 +273,11 @@ bool tui::CylinderParametersView::AreAllInputsValid() const
     return _horValid && _vertValid;
 }
 
+MeshCounts tui::CylinderParametersView::GetMeshCounts() const
+{
+    return Cylinder::getMeshCounts(_hor, _vert, ValuesRange::HALF_TO_HALF, static_cast<Shading>(_shadingIndex));
+}
+
 Element tui::CylinderParametersView::AsciiArt() const
 {
     return vbox({
@@ -300,6 +339,11 @@ bool tui::ConeParametersView::AreAllInputsValid() const
     return _segmentsValid && _heightValid && _radiusValid;
 }
 
+MeshCounts tui::ConeParametersView::GetMeshCounts() const
+{
+    return Cone::getMeshCounts(_segments, _height, _radius, ValuesRange::HALF_TO_HALF, static_cast<Shading>(_shadingIndex));
+}
+
 Element tui::ConeParametersView::AsciiArt() const
 {
     return vbox({
@@ -358,6 +402,11 @@ bool tui::SphereParametersView::AreAllInputsValid() const
     return _horValid && _vertValid;
 }
 
+MeshCounts tui::SphereParametersView::GetMeshCounts() const
+{
+    return Sphere::getMeshCounts(_hor, _vert, ValuesRange::HALF_TO_HALF, static_cast<Shading>(_shadingIndex));
+}
+
 Element tui::SphereParametersView::AsciiArt() const
 {
     return vbox({
@@ -374,6 +423,7 @@ tui::IcoSphereParametersView::IcoSphereParametersView(int& subdivisions, int& ra
     _subs(subdivisions), _shadingIndex(shadingIndex), _subsInput(Input(&_subsStr, "int"))
 {
     _header = "ICOSPHERE";
+    _maxSubs = static_cast<int>(IcoSphere::MAX_SUBDIVISIONS);
 
     _shadingRadio = Radiobox(&_shadingOptions, &_shadingIndex);
 
@@ -412,6 +462,11 @@ bool tui::IcoSphereParametersView::AreAllInputsValid() const
     return _subsValid;
 }
 
+MeshCounts tui::IcoSphereParametersView::GetMeshCounts() const
+{
+    return IcoSphere::getMeshCounts(_subs, ValuesRange::HALF_TO_HALF, static_cast<Shading>(_shadingIndex));
+}
+
 Element tui::IcoSphereParametersView::AsciiArt() const
 {
     return vbox({
@@ -476,6 +531,11 @@ bool tui::TorusParametersView::AreAllInputsValid() const
     return _maSegmentsValid && _miSegmentsValid && _maCircleRadiusValid && _miCircleRadiusValid;
 }
 
+MeshCounts tui::TorusParametersView::GetMeshCounts() const
+{
+    return Torus::getMeshCounts(_maSegments, _miSegments, _maCircleRadius, _miCircleRadius, ValuesRange::HALF_TO_HALF, static_cast<Shading>(_shadingIndex));
+}
+
 Element tui::TorusParametersView::AsciiArt() const
 {
     return vbox({
@@ -524,6 +584,11 @@ bool tui::HexagonParametersView::AreAllInputsValid() const
     return _horValid;
 }
 
+MeshCounts tui::HexagonParametersView::GetMeshCounts() const
+{
+    return Hexagon::getMeshCounts(_hor);
+}
+
 Element tui::HexagonParametersView::AsciiArt() const
 {
     return vbox({
@@ -25,6 +25,7 @@ namespace tui
 
     protected:
         bool AreAllInputsValid() const override;
+        MeshCounts GetMeshCounts() const override;
 
         ftxui::Element AsciiArt() const override;
 
@@ -52,6 +53,8 @@ namespace tui
         CubeParametersView(int& rangeIndex, std::function<void()> onGenerate, std::function<void()> onBack);
 
     protected:
+        MeshCounts GetMeshCounts() const override;
+
         ftxui::Element AsciiArt() const override;
     };
 
@@ -61,6 +64,8 @@ namespace tui
         TetrahedronParametersView(int& rangeIndex, std::function<void()> onGenerate, std::function<void()> onBack);
 
     protected:
+        MeshCounts GetMeshCounts() const override;
+
         ftxui::Element AsciiArt() const override;
     };
 
@@ -70,6 +75,8 @@ namespace tui
         PyramidParametersView(int& rangeIndex, std::function<void()> onGenerate, std::function<void()> onBack);
 
     protected:
+        MeshCounts GetMeshCounts() const override;
+
         ftxui::Element AsciiArt() const override;
     };
 
@@ -80,6 +87,7 @@ namespace tui
 
     protected:
         bool AreAllInputsValid() const override;
+        MeshCounts GetMeshCounts() const override;
 
         ftxui::Element AsciiArt() const override;
 
@@ -106,6 +114,7 @@ namespace tui
 
     protected:
         bool AreAllInputsValid() const override;
+        MeshCounts GetMeshCounts() const override;
 
         ftxui::Element AsciiArt() const override;
 
@@ -136,6 +145,7 @@ namespace tui
 
     protected:
         bool AreAllInputsValid() const override;
+        MeshCounts GetMeshCounts() const override;
 
         ftxui::Element AsciiArt() const override;
 
@@ -162,6 +172,7 @@ namespace tui
 
     protected:
         bool AreAllInputsValid() const override;
+        MeshCounts GetMeshCounts() const override;
 
         ftxui::Element AsciiArt() const override;
 
@@ -173,7 +184,7 @@ namespace tui
 
         bool _subsValid = true;
 
-        int _maxSubs = 10;
+        int _maxSubs = 0;
 
         ftxui::Component _subsInput;
         ftxui::Component _shadingRadio;
@@ -186,6 +197,7 @@ namespace tui
 
     protected:
         bool AreAllInputsValid() const override;
+        MeshCounts GetMeshCounts() const override;
 
         ftxui::Element AsciiArt() const override;
 
@@ -220,6 +232,7 @@ namespace tui
 
     protected:
         bool AreAllInputsValid() const override;
+        MeshCounts GetMeshCounts() const override;
 
         ftxui::Element AsciiArt() const override;
 
@@ -1,11 +1,18 @@
 #pragma once
 
+#pragma region STD_LIBS
+#include <functional>
+#pragma endregion
+
 #pragma region FTXUI_LIB
 #include <ftxui/component/component.hpp>
 #include <ftxui/component/event.hpp>
 #pragma endregion
 
 namespace tui {
+    // Posts event to the screen, safe to call from other threads
+    using PostEvent = std::function<void(ftxui::Event)>;
+
     class View {
     public:
         virtual ~View() = default;
@@ -4,7 +4,9 @@
 #include <chrono>
 #include <cstdint>
 #include <ctype.h>
+#include <future>
 #include <ratio>
+#include <stop_token>
 #include <string>
 #include <thread>
 #include <utility>
@@ -13,12 +15,20 @@
 
 #pragma region FTXUI_LIB
 #include <ftxui/component/component.hpp>
+#include <ftxui/component/event.hpp>
 #include <ftxui/dom/elements.hpp>
 #include <ftxui/screen/color.hpp>
 #pragma endregion
 
-class Shape;
-struct ShapeConfig;
+#pragma region MY_FILES_CORE_LIB
+#include <MeshCache.hpp>
+#include <ProgressToken.hpp>
+#include <Shape.hpp>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "View.hpp"
+#pragma endregion
 
 namespace tui
 {
@@ -277,15 +287,77 @@ namespace tui
         return vbox({ separator(), hbox(keyElements) | hcenter });
     }
 
+    // Spinner steps and progress of a running task are redrawn at this interval
+    static constexpr std::chrono::milliseconds TASK_TICK_INTERVAL{ 100 };
+
+    // Posted when the worker of a task view is done, the view takes its result on UI thread
+    static ftxui::Event TaskFinishedEvent()
+    {
+        return ftxui::Event::Special("TaskFinished");
+    }
+
+    // Thread posting Event::Custom every TASK_TICK_INTERVAL while the task runs and TaskFinishedEvent when it is done,
+    // so the screen is redrawn 10 times a second during tasks and not at all while idle
+    template<class Result>
+    static std::jthread TaskTicker(std::shared_future<Result> future, PostEvent post)
+    {
+        return std::jthread([future = std::move(future), post = std::move(post)](std::stop_token stop) {
+            while (future.wait_for(TASK_TICK_INTERVAL) != std::future_status::ready) {
+                if (stop.stop_requested()) return;
+                post(ftxui::Event::Custom);
+            }
+            post(TaskFinishedEvent());
+        });
+    }
+
+    // Spinner of a running task, its step depends on time and not on the number of frames
+    static ftxui::Element TaskSpinner(std::chrono::steady_clock::time_point start)
+    {
+        using namespace ftxui;
+
+        const auto step = (std::chrono::steady_clock::now() - start) / TASK_TICK_INTERVAL;
+        return spinner(18, static_cast<size_t>(step));
+    }
+
+    // Phase and done part of a running task, cancelled task only shows that it is stopping
+    static ftxui::Element TaskProgress(const ProgressToken& progress)
+    {
+        using namespace ftxui;
+
+        if (progress.isCancelled()) return text("Cancelling...") | dim;
+
+        const float fraction = progress.getProgress();
+        return vbox({
+            text(progress.getPhase()) | dim | hcenter,
+            hbox({ gauge(fraction) | size(WIDTH, EQUAL, 30), text(" " + std::to_string(static_cast<int>(fraction * 100.f)) + "%") })
+        });
+    }
+
+    // Task stops at its next progress report, task views cancel it with ESC too
+    static ftxui::Component TaskCancelButton(ProgressToken& progress)
+    {
+        using namespace ftxui;
+
+        ButtonOption option;
+        option.transform = [](const EntryState& s) {
+            auto element = vbox({ text(s.label) | hcenter }) | borderLight;
+            if (s.focused) {
+                element |= inverted;
+            }
+            return element;
+        };
+        return Button("Cancel", [&progress] { progress.cancel(); }, option);
+    }
+
     template<class ShapeType, class... Args>
     static std::pair<Shape*, std::chrono::duration<double, std::milli>> GenerateShape(const ShapeConfig& config, bool isFast, const Args&... args) {
         auto start = std::chrono::high_resolution_clock::now();
 
-        Shape* shape = new ShapeType(config, args...);
+        Shape* shape = MeshCache::get().getOrGenerate<ShapeType>(config, args...).first;
 
         auto end = std::chrono::high_resolution_clock::now();
 
-        if (isFast)
+        if (isFast && !shape->isCancelled())
         {
             // It is so fast that i didn't saw animation
             std::this_thread::sleep_for(std::chrono::milliseconds(50000 / 60));
@@ -41,6 +41,25 @@ utils::Config& utils::get_config(const std::string& exeDirPath)
     config.saveDir = exeDirPath + DIRSEP;
     config.fileName = "${TYPE}-%H-%M-%S";
     config.openDirOnSave = true;
+    config.optimizeVertexCache = false;
+    config.vertexCacheSize = 32u;
+    config.vertexCacheType = "FIFO";
+    config.optimizeVertexFetch = false;
+    config.optimizeOverdraw = false;
+    config.overdrawThreshold = 1.05f;
+    config.buildMeshlets = false;
+    config.meshletMaxVertices = 64u;
+    config.meshletMaxTriangles = 124u;
+    config.generateLods = false;
+    config.lodLevels = 3u;
+    config.lodReduction = 0.5f;
+    config.stripPrimitiveRestart = true;
+    config.threadPoolSize = 0u;
+    config.meshCache = true;
+    config.meshCacheDir = exeDirPath + DIRSEP + "cache";
+    config.meshCacheSize = 256u;
+    config.saveTrace = false;
+    config.memoryBudget = 4096u;
 
     init = true;
 
@@ -50,6 +69,25 @@ utils::Config& utils::get_config(const std::string& exeDirPath)
     bool hasSaveDir = false;
     bool hasFileName = false;
     bool hasOpenDirOnSave = false;
+    bool hasOptimizeVertexCache = false;
+    bool hasVertexCacheSize = false;
+    bool hasVertexCacheType = false;
+    bool hasOptimizeVertexFetch = false;
+    bool hasOptimizeOverdraw = false;
+    bool hasOverdrawThreshold = false;
+    bool hasBuildMeshlets = false;
+    bool hasMeshletMaxVertices = false;
+    bool hasMeshletMaxTriangles = false;
+    bool hasGenerateLods = false;
+    bool hasLodLevels = false;
+    bool hasLodReduction = false;
+    bool hasStripPrimitiveRestart = false;
+    bool hasThreadPoolSize = false;
+    bool hasMeshCache = false;
+    bool hasMeshCacheDir = false;
+    bool hasMeshCacheSize = false;
+    bool hasSaveTrace = false;
+    bool hasMemoryBudget = false;
 
     if (inFile.is_open()) {
         std::string line;
@@ -86,10 +124,92 @@ utils::Config& utils::get_config(const std::string& exeDirPath)
                 config.openDirOnSave = utils::parse_bool(value);
                 hasOpenDirOnSave = true;
             }
+            else if (key == "optimizeVertexCache") {
+                config.optimizeVertexCache = utils::parse_bool(value);
+                hasOptimizeVertexCache = true;
+            }
+            else if (key == "vertexCacheSize") {
+                config.vertexCacheSize = utils::parse_uint(value, config.vertexCacheSize);
+                hasVertexCacheSize = true;
+            }
+            else if (key == "vertexCacheType") {
+                config.vertexCacheType = value;
+                hasVertexCacheType = true;
+            }
+            else if (key == "optimizeVertexFetch") {
+                config.optimizeVertexFetch = utils::parse_bool(value);
+                hasOptimizeVertexFetch = true;
+            }
+            else if (key == "optimizeOverdraw") {
+                config.optimizeOverdraw = utils::parse_bool(value);
+                hasOptimizeOverdraw = true;
+            }
+            else if (key == "overdrawThreshold") {
+                config.overdrawThreshold = utils::parse_float(value, config.overdrawThreshold);
+                hasOverdrawThreshold = true;
+            }
+            else if (key == "buildMeshlets") {
+                config.buildMeshlets = utils::parse_bool(value);
+                hasBuildMeshlets = true;
+            }
+            else if (key == "meshletMaxVertices") {
+                config.meshletMaxVertices = utils::parse_uint(value, config.meshletMaxVertices);
+                hasMeshletMaxVertices = true;
+            }
+            else if (key == "meshletMaxTriangles") {
+                config.meshletMaxTriangles = utils::parse_uint(value, config.meshletMaxTriangles);
+                hasMeshletMaxTriangles = true;
+            }
+            else if (key == "generateLods") {
+                config.generateLods = utils::parse_bool(value);
+                hasGenerateLods = true;
+            }
+            else if (key == "lodLevels") {
+                config.lodLevels = utils::parse_uint(value, config.lodLevels);
+                hasLodLevels = true;
+            }
+            else if (key == "lodReduction") {
+                config.lodReduction = utils::parse_float(value, config.lodReduction);
+                hasLodReduction = true;
+            }
+            else if (key == "stripPrimitiveRestart") {
+                config.stripPrimitiveRestart = utils::parse_bool(value);
+                hasStripPrimitiveRestart = true;
+            }
+            else if (key == "threadPoolSize") {
+                config.threadPoolSize = utils::parse_uint(value, config.threadPoolSize);
+                hasThreadPoolSize = true;
+            }
+            else if (key == "meshCache") {
+                config.meshCache = utils::parse_bool(value);
+                hasMeshCache = true;
+            }
+            else if (key == "meshCacheDir") {
+                config.meshCacheDir = value;
+                hasMeshCacheDir = true;
+            }
+            else if (key == "meshCacheSize") {
+                config.meshCacheSize = utils::parse_uint(value, config.meshCacheSize);
+                hasMeshCacheSize = true;
+            }
+            else if (key == "saveTrace") {
+                config.saveTrace = utils::parse_bool(value);
+                hasSaveTrace = true;
+            }
+            else if (key == "memoryBudget") {
+                config.memoryBudget = utils::parse_uint(value, config.memoryBudget);
+                hasMemoryBudget = true;
+            }
         }
         inFile.close();
 
-        if (!hasGenTangents || !hasCalcBitangents || !hasTangentHandedness || !hasSaveDir || !hasFileName || !hasOpenDirOnSave) {
+        if (!hasGenTangents || !hasCalcBitangents || !hasTangentHandedness || !hasSaveDir || !hasFileName || !hasOpenDirOnSave ||
+            !hasOptimizeVertexCache || !hasVertexCacheSize || !hasVertexCacheType || !hasOptimizeVertexFetch ||
+            !hasOptimizeOverdraw || !hasOverdrawThreshold ||
+            !hasBuildMeshlets || !hasMeshletMaxVertices || !hasMeshletMaxTriangles ||
+            !hasGenerateLods || !hasLodLevels || !hasLodReduction ||
+            !hasStripPrimitiveRestart || !hasThreadPoolSize ||
+            !hasMeshCache || !hasMeshCacheDir || !hasMeshCacheSize || !hasSaveTrace || !hasMemoryBudget) {
             std::ofstream outFile(configFilePath, std::ios::app);
             if (outFile.is_open()) {
                 if (!hasGenTangents)
@@ -104,6 +224,44 @@ utils::Config& utils::get_config(const std::string& exeDirPath)
                     outFile << "\nfileName: " << config.fileName << "\n";
                 if (!hasOpenDirOnSave)
                     outFile << "\nopenDirOnSave: " << (config.openDirOnSave ? "true" : "false") << "\n";
+                if (!hasOptimizeVertexCache)
+                    outFile << "\noptimizeVertexCache: " << (config.optimizeVertexCache ? "true" : "false") << "\n";
+                if (!hasVertexCacheSize)
+                    outFile << "\nvertexCacheSize: " << config.vertexCacheSize << "\n";
+                if (!hasVertexCacheType)
+                    outFile << "\nvertexCacheType: " << config.vertexCacheType << "\n";
+                if (!hasOptimizeVertexFetch)
+                    outFile << "\noptimizeVertexFetch: " << (config.optimizeVertexFetch ? "true" : "false") << "\n";
+                if (!hasOptimizeOverdraw)
+                    outFile << "\noptimizeOverdraw: " << (config.optimizeOverdraw ? "true" : "false") << "\n";
+                if (!hasOverdrawThreshold)
+                    outFile << "\noverdrawThreshold: " << config.overdrawThreshold << "\n";
+                if (!hasBuildMeshlets)
+                    outFile << "\nbuildMeshlets: " << (config.buildMeshlets ? "true" : "false") << "\n";
+                if (!hasMeshletMaxVertices)
+                    outFile << "\nmeshletMaxVertices: " << config.meshletMaxVertices << "\n";
+                if (!hasMeshletMaxTriangles)
+                    outFile << "\nmeshletMaxTriangles: " << config.meshletMaxTriangles << "\n";
+                if (!hasGenerateLods)
+                    outFile << "\ngenerateLods: " << (config.generateLods ? "true" : "false") << "\n";
+                if (!hasLodLevels)
+                    outFile << "\nlodLevels: " << config.lodLevels << "\n";
+                if (!hasLodReduction)
+                    outFile << "\nlodReduction: " << config.lodReduction << "\n";
+                if (!hasStripPrimitiveRestart)
+                    outFile << "\nstripPrimitiveRestart: " << (config.stripPrimitiveRestart ? "true" : "false") << "\n";
+                if (!hasThreadPoolSize)
+                    outFile << "\nthreadPoolSize: " << config.threadPoolSize << "\n";
+                if (!hasMeshCache)
+                    outFile << "\nmeshCache: " << (config.meshCache ? "true" : "false") << "\n";
+                if (!hasMeshCacheDir)
+                    outFile << "\nmeshCacheDir: " << config.meshCacheDir << "\n";
+                if (!hasMeshCacheSize)
+                    outFile << "\nmeshCacheSize: " << config.meshCacheSize << "\n";
+                if (!hasSaveTrace)
+                    outFile << "\nsaveTrace: " << (config.saveTrace ? "true" : "false") << "\n";
+                if (!hasMemoryBudget)
+                    outFile << "\nmemoryBudget: " << config.memoryBudget << "\n";
                 outFile.close();
             }
             else {
@@ -163,6 +321,25 @@ void utils::internal::save_config_file(utils::Config& cfg, const std::string& co
         outFile << "saveDir: " << cfg.saveDir << "\n";
         outFile << "fileName: " << cfg.fileName << "\n";
         outFile << "openDirOnSave: " << (cfg.openDirOnSave ? "true" : "false") << "\n";
+        outFile << "optimizeVertexCache: " << (cfg.optimizeVertexCache ? "true" : "false") << "\n";
+        outFile << "vertexCacheSize: " << cfg.vertexCacheSize << "\n";
+        outFile << "vertexCacheType: " << cfg.vertexCacheType << "\n";
+        outFile << "optimizeVertexFetch: " << (cfg.optimizeVertexFetch ? "true" : "false") << "\n";
+        outFile << "optimizeOverdraw: " << (cfg.optimizeOverdraw ? "true" : "false") << "\n";
+        outFile << "overdrawThreshold: " << cfg.overdrawThreshold << "\n";
+        outFile << "buildMeshlets: " << (cfg.buildMeshlets ? "true" : "false") << "\n";
+        outFile << "meshletMaxVertices: " << cfg.meshletMaxVertices << "\n";
+        outFile << "meshletMaxTriangles: " << cfg.meshletMaxTriangles << "\n";
+        outFile << "generateLods: " << (cfg.generateLods ? "true" : "false") << "\n";
+        outFile << "lodLevels: " << cfg.lodLevels << "\n";
+        outFile << "lodReduction: " << cfg.lodReduction << "\n";
+        outFile << "stripPrimitiveRestart: " << (cfg.stripPrimitiveRestart ? "true" : "false") << "\n";
+        outFile << "threadPoolSize: " << cfg.threadPoolSize << "\n";
+        outFile << "meshCache: " << (cfg.meshCache ? "true" : "false") << "\n";
+        outFile << "meshCacheDir: " << cfg.meshCacheDir << "\n";
+        outFile << "meshCacheSize: " << cfg.meshCacheSize << "\n";
+        outFile << "saveTrace: " << (cfg.saveTrace ? "true" : "false") << "\n";
+        outFile << "memoryBudget: " << cfg.memoryBudget << "\n";
         outFile.close();
     }
     else {
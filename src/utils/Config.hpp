@@ -9,6 +9,29 @@ namespace utils {
 		bool calcBitangents;
 		bool tangentHandednessPositive;
 		bool openDirOnSave;
+		bool optimizeVertexCache;
+		unsigned int vertexCacheSize;
+		std::string vertexCacheType;
+		bool optimizeVertexFetch;
+		bool optimizeOverdraw;
+		float overdrawThreshold;
+		bool buildMeshlets;
+		unsigned int meshletMaxVertices;
+		unsigned int meshletMaxTriangles;
+		bool generateLods;
+		unsigned int lodLevels;
+		float lodReduction;
+		bool stripPrimitiveRestart;
+		// Workers of the shared thread pool, 0 uses hardware concurrency
+		unsigned int threadPoolSize;
+		// Generated meshes are reused from meshCacheDir, size limit in MB
+		bool meshCache;
+		std::string meshCacheDir;
+		unsigned int meshCacheSize;
+		// Phase timings of generation and save are written next to the saved file as <file>.trace.json
+		bool saveTrace;
+		// Shapes whose estimated memory use goes over this many MB are not generated or saved, 0 is unlimited
+		unsigned int memoryBudget;
 	};
 
 	Config& get_config(const std::string& exeDirPath = ".");
@@ -1,5 +1,6 @@
 #pragma once
 #include <algorithm>
+#include <charconv>
 #include <cstdint>
 #include <string>
 
@@ -35,4 +36,18 @@ namespace utils
         });
         return (value == "true" || value == "1");
     }
+
+    static unsigned int parse_uint(const std::string& str, unsigned int defaultValue)
+    {
+        unsigned int value = 0u;
+        auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+        return (ec == std::errc() && ptr == str.data() + str.size()) ? value : defaultValue;
+    }
+
+    static float parse_float(const std::string& str, float defaultValue)
+    {
+        float value = 0.f;
+        auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+        return (ec == std::errc() && ptr == str.data() + str.size()) ? value : defaultValue;
+    }
 }
\ No newline at end of file
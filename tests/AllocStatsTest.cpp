@@ -0,0 +1,206 @@
+#pragma region PCH
+#include "pch.hpp"
+#pragma endregion
+
+#pragma region STD_LIBS
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+#pragma endregion
+
+#pragma region CATCH2_LIB
+#include <catch2/catch_test_macros.hpp>
+#pragma endregion
+
+#pragma region MY_FILES_CORE_LIB
+#include <AllocStats.hpp>
+#include <Shape.hpp>
+#include <Torus.hpp>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "Helpers.hpp"
+#pragma endregion
+
+// Budgets of the reference torus below (32 x 16 segments, smooth, default config), about 10% above
+// measured counts and 50% above measured peaks. Build with SHAPES_GENERATOR_ALLOC_STATS to check them
+struct AllocBudget
+{
+    size_t maxCount;
+    size_t maxPeakBytes;
+};
+
+static Torus MakeReferenceTorus()
+{
+    ShapeConfig config{};
+    return Torus(config, 32u, 16u, 1.f, 0.5f, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+}
+
+static void CheckBudget(const AllocStats& stats, const AllocBudget& budget)
+{
+    REQUIRE(stats.count <= budget.maxCount);
+    REQUIRE(stats.peakBytes <= budget.maxPeakBytes);
+}
+
+TEST_CASE("ShapesGenerator.AllocStats.Scope") {
+    AllocStats stats;
+    {
+        AllocScope scope;
+        std::vector<int> values(1000);
+        values.shrink_to_fit();
+        stats = scope.stop();
+    }
+
+    if constexpr (AllocScope::isEnabled()) {
+        REQUIRE(stats.count >= 1);
+        REQUIRE(stats.bytes >= 1000 * sizeof(int));
+        REQUIRE(stats.peakBytes >= 1000 * sizeof(int));
+    }
+    else {
+        REQUIRE(stats.count == 0);
+        REQUIRE(stats.bytes == 0);
+        REQUIRE(stats.peakBytes == 0);
+    }
+}
+
+TEST_CASE("ShapesGenerator.AllocStats.NestedPeak") {
+    if constexpr (!AllocScope::isEnabled()) SKIP("Allocations are not counted in this build");
+
+    AllocScope outer;
+    std::vector<char> big(1 << 20);
+    AllocStats innerStats;
+    {
+        AllocScope inner;
+        std::vector<char> small(1 << 10);
+        innerStats = inner.stop();
+    }
+    const AllocStats outerStats = outer.stop();
+
+    // Inner peak starts above memory held by outer scope, outer peak includes inner one
+    REQUIRE(innerStats.peakBytes < (1 << 20));
+    REQUIRE(outerStats.peakBytes >= (1 << 20) + (1 << 10));
+}
+
+TEST_CASE("ShapesGenerator.AllocStats.InterleavedPeak") {
+    if constexpr (!AllocScope::isEnabled()) SKIP("Allocations are not counted in this build");
+
+    // Scope started while another one runs (e.g. on another batch worker) doesn't reset its peak
+    std::optional<AllocScope> first;
+    first.emplace();
+    {
+        std::vector<char> big(1 << 20);
+    }
+    AllocScope second;
+    const AllocStats firstStats = first->stop();
+    const AllocStats secondStats = second.stop();
+
+    REQUIRE(firstStats.peakBytes >= (1 << 20));
+    REQUIRE(secondStats.peakBytes < (1 << 20));
+}
+
+TEST_CASE("ShapesGenerator.AllocStats.Report") {
+    if constexpr (!AllocScope::isEnabled()) SKIP("Allocations are not counted in this build");
+
+    Torus torus = MakeReferenceTorus();
+
+    AllocScope::takeReport();
+    torus.toString(FormatType::BINARY);
+    REQUIRE(AllocScope::takeReport().empty());
+
+    AllocScope::collectReport(true);
+    torus.toString(FormatType::BINARY);
+    torus.optimizeVertexCache();
+    const AllocScope::Report report = AllocScope::takeReport();
+    AllocScope::collectReport(false);
+
+    REQUIRE(report.size() == 2);
+    REQUIRE(report[0].first == "export");
+    REQUIRE(report[0].second.bytes >= torus.getVerticesCount() * torus.getVertexStride());
+    REQUIRE(report[1].first == "optimize vertex cache");
+}
+
+TEST_CASE("ShapesGenerator.AllocStats.PhaseReport") {
+    if constexpr (!AllocScope::isEnabled()) SKIP("Allocations are not counted in this build");
+
+    AllocScope::takeReport();
+    AllocScope::collectReport(true);
+    {
+        AllocScope scope("generate");
+        Torus torus = MakeReferenceTorus();
+    }
+    const AllocScope::Report report = AllocScope::takeReport();
+    AllocScope::collectReport(false);
+
+    // Generation phases are nested scopes, reported before the one containing them
+    REQUIRE(report.size() > 1);
+    REQUIRE(report.back().first == "generate");
+
+    bool hasVertexPhase = false;
+    for (size_t i = 0; i + 1 < report.size(); ++i) {
+        if (report[i].first == std::string("vertex generation")) hasVertexPhase = true;
+        REQUIRE(report[i].second.count <= report.back().second.count);
+        REQUIRE(report[i].second.peakBytes <= report.back().second.peakBytes);
+    }
+    REQUIRE(hasVertexPhase);
+}
+
+TEST_CASE("ShapesGenerator.AllocStats.GenerationBudget") {
+    if constexpr (!AllocScope::isEnabled()) SKIP("Allocations are not counted in this build");
+
+    AllocScope scope;
+    Torus torus = MakeReferenceTorus();
+    CheckBudget(scope.stop(), { 40, 200000 });
+}
+
+TEST_CASE("ShapesGenerator.AllocStats.OptimizeBudget") {
+    if constexpr (!AllocScope::isEnabled()) SKIP("Allocations are not counted in this build");
+
+    Torus torus = MakeReferenceTorus();
+    {
+        AllocScope scope;
+        torus.optimizeVertexCache();
+        CheckBudget(scope.stop(), { 16, 70000 });
+    }
+    {
+        AllocScope scope;
+        torus.optimizeOverdraw();
+        CheckBudget(scope.stop(), { 20, 30000 });
+    }
+    {
+        AllocScope scope;
+        torus.optimizeVertexFetch();
+        CheckBudget(scope.stop(), { 4, 55000 });
+    }
+    {
+        AllocScope scope;
+        torus.buildMeshlets();
+        CheckBudget(scope.stop(), { 40, 55000 });
+    }
+    {
+        AllocScope scope;
+        torus.generateLods();
+        CheckBudget(scope.stop(), { 1900, 240000 });
+    }
+}
+
+TEST_CASE("ShapesGenerator.AllocStats.ExportBudget") {
+    if constexpr (!AllocScope::isEnabled()) SKIP("Allocations are not counted in this build");
+
+    // Same order as FormatType
+    const std::vector<AllocBudget> budgets = {
+        { 23000, 600000 }, { 23000, 600000 }, { 125000, 1800000 }, { 125000, 1800000 },
+        { 15000, 550000 }, { 15000, 550000 }, { 81500, 1650000 }, { 81500, 1650000 },
+        { 17500, 1900000 }, { 95000, 8500000 }, { 2400, 175000 }, { 1, 66000 },
+        { 23000, 600000 }, { 23000, 600000 }, { 15000, 550000 }, { 15000, 550000 }, { 17500, 1850000 }, { 8, 62000 }
+    };
+
+    Torus torus = MakeReferenceTorus();
+    for (size_t i = 0; i < budgets.size(); ++i) {
+        INFO("Format " << i);
+
+        AllocScope scope;
+        std::string text = torus.toString(static_cast<FormatType>(i));
+        CheckBudget(scope.stop(), budgets[i]);
+    }
+}
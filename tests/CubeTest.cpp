@@ -25,8 +25,8 @@
 class TestableCube : public Cube {
 public:
     using Cube::Cube;
-    const std::vector<Vertex>& getVertices() const { return _vertices; }
-    const std::vector<unsigned int>& getIndices() const { return _indices; }
+    const std::pmr::vector<Vertex>& getVertices() const { return _vertices; }
+    const std::pmr::vector<unsigned int>& getIndices() const { return _indices; }
 };
 
 TEST_CASE("ShapesGenerator.Cube.Minimal.Valid") {
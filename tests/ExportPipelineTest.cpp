@@ -0,0 +1,255 @@
+#pragma region PCH
+#include "pch.hpp"
+#pragma endregion
+
+#pragma region STD_LIBS
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <iterator>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <thread>
+#pragma endregion
+
+#pragma region CATCH2_LIB
+#include <catch2/catch_test_macros.hpp>
+#pragma endregion
+
+#pragma region MY_FILES_CORE_LIB
+#include <ExportPipeline.hpp>
+#include <ProgressToken.hpp>
+#include <Shape.hpp>
+#include <SpscQueue.hpp>
+#include <Sphere.hpp>
+#include <Torus.hpp>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "Helpers.hpp"
+#pragma endregion
+
+namespace fs = std::filesystem;
+
+static fs::path MakeSavePath(const std::string& name)
+{
+    const fs::path path = fs::temp_directory_path() / ("shapes_generator_pipeline_" + name);
+    fs::remove(path);
+    return path;
+}
+
+static std::string ReadFile(const fs::path& path)
+{
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+TEST_CASE("ShapesGenerator.ExportPipeline.SpscQueue") {
+    SpscQueue<size_t> queue(3ull);
+    REQUIRE(queue.getCapacity() == 4ull);
+
+    // Consumer sees every item in order, producer waits while queue is full
+    constexpr size_t count = 100000ull;
+    std::thread producer([&queue]() {
+        for (size_t i = 0ull; i < count; ++i) queue.push(i);
+        queue.close();
+    });
+
+    size_t expected = 0ull;
+    size_t item = 0ull;
+    while (queue.pop(item)) {
+        REQUIRE(item == expected);
+        ++expected;
+    }
+    producer.join();
+    REQUIRE(expected == count);
+
+    // Nothing is pushed after close
+    size_t late = 1ull;
+    REQUIRE_FALSE(queue.tryPush(late));
+    REQUIRE_FALSE(queue.push(late));
+}
+
+TEST_CASE("ShapesGenerator.ExportPipeline.Order") {
+    std::ostringstream out;
+    ExportPipeline pipeline(nullptr, 2ull);
+
+    const bool written = pipeline.run(out, [](ExportPipeline& stages) {
+        for (size_t i = 0ull; i < 1000ull; ++i) {
+            if (!stages.emit([i]() { return std::to_string(i) + ","; })) return false;
+        }
+        return true;
+    }, "test", 1000ull);
+
+    std::string expected;
+    for (size_t i = 0ull; i < 1000ull; ++i) expected += std::to_string(i) + ",";
+
+    REQUIRE(written);
+    REQUIRE(out.str() == expected);
+    REQUIRE(pipeline.getWrittenChunks() == 1000ull);
+    REQUIRE(pipeline.getWrittenBytes() == expected.size());
+}
+
+TEST_CASE("ShapesGenerator.ExportPipeline.Cancel") {
+    ProgressToken progress;
+    std::ostringstream out;
+    ExportPipeline pipeline(&progress, 2ull);
+
+    // Writer cancels after the first chunk, generator waiting on full queue is stopped
+    size_t emitted = 0ull;
+    const bool written = pipeline.run(out, [&progress, &emitted](ExportPipeline& stages) {
+        for (size_t i = 0ull; i < 1000ull; ++i) {
+            if (!stages.emit([&progress]() { progress.cancel(); return std::string("x"); })) return false;
+            ++emitted;
+        }
+        return true;
+    }, "test", 1000ull);
+
+    REQUIRE_FALSE(written);
+    REQUIRE(emitted < 1000ull);
+    REQUIRE(pipeline.getWrittenChunks() < 1000ull);
+}
+
+TEST_CASE("ShapesGenerator.ExportPipeline.Exception") {
+    std::ostringstream out;
+    ExportPipeline pipeline;
+
+    REQUIRE_THROWS_AS(pipeline.run(out, [](ExportPipeline& stages) {
+        return stages.emit([]() -> std::string { throw std::runtime_error("format"); });
+    }, "test", 1ull), std::runtime_error);
+}
+
+// Stream buffer which can't write anything
+class FailingBuffer : public std::streambuf
+{
+protected:
+    std::streamsize xsputn(const char*, std::streamsize) override { return 0; }
+    int_type overflow(int_type) override { return traits_type::eof(); }
+};
+
+TEST_CASE("ShapesGenerator.ExportPipeline.WriteThrows") {
+    FailingBuffer buffer;
+    std::ostream out(&buffer);
+    out.exceptions(std::ios::badbit);
+    ExportPipeline pipeline(nullptr, 2ull);
+
+    // Stages blocked on full queues are stopped and joined before the exception leaves run
+    REQUIRE_THROWS_AS(pipeline.run(out, [](ExportPipeline& stages) {
+        for (size_t i = 0ull; i < 1000ull; ++i) {
+            if (!stages.emit([]() { return std::string("x"); })) return false;
+        }
+        return true;
+    }, "test", 1000ull), std::ios_base::failure);
+    REQUIRE(pipeline.getWrittenChunks() == 0ull);
+}
+
+TEST_CASE("ShapesGenerator.ExportPipeline.BinarySameAsToString") {
+    REQUIRE(Shape::isStreamable(FormatType::BINARY));
+    REQUIRE(Shape::isStreamable(FormatType::BINARY_STRIP));
+    REQUIRE_FALSE(Shape::isStreamable(FormatType::OBJ));
+    REQUIRE_FALSE(Shape::isStreamable(FormatType::JSON_INDICES));
+
+    for (bool calcBitangents : { true, false }) {
+        ShapeConfig config{};
+        config.calcBitangents = calcBitangents;
+
+        // More vertices than one chunk, LOD and meshlet chunks are written after indices
+        Sphere sphere(config, 300u, 300u, ValuesRange::HALF_TO_HALF, Shading::SMOOTH);
+        REQUIRE(sphere.getVerticesCount() > Shape::SAVE_CHUNK_VERTICES);
+        sphere.generateLods(2u);
+        sphere.buildMeshlets();
+
+        for (FormatType format : { FormatType::BINARY, FormatType::BINARY_STRIP }) {
+            const fs::path path = MakeSavePath("sphere.bin");
+            REQUIRE(sphere.save(path.string(), format));
+
+            INFO(calcBitangents << " " << static_cast<int>(format));
+            REQUIRE(ReadFile(path) == sphere.toString(format));
+            fs::remove(path);
+        }
+    }
+}
+
+TEST_CASE("ShapesGenerator.ExportPipeline.ArraysSameAsToString") {
+    REQUIRE(Shape::isStreamable(FormatType::CPP_ARRAY_INDICES_STRUCT));
+    REQUIRE(Shape::isStreamable(FormatType::C_ARRAY_VERTICES_FLOAT));
+    REQUIRE(Shape::isStreamable(FormatType::C_ARRAY_STRIP_STRUCT));
+    REQUIRE_FALSE(Shape::isStreamable(FormatType::JSON_STRIP));
+
+    auto requireSaved = [](const Shape& shape, const FormatType format) {
+        const fs::path path = MakeSavePath("shape" + Shape::getFormatFileExtension(format));
+        REQUIRE(shape.save(path.string(), format));
+
+        INFO(static_cast<int>(format) << " " << shape.isPrimitiveRestartEnabled());
+        REQUIRE(ReadFile(path) == shape.toString(format));
+        fs::remove(path);
+    };
+
+    SECTION("Every array format") {
+        ShapeConfig config{};
+        Torus torus(config, 24u, 12u, 1.f, .5f, ValuesRange::HALF_TO_HALF, Shading::SMOOTH);
+        torus.generateLods(2u);
+        torus.buildMeshlets();
+
+        for (FormatType format : { FormatType::CPP_ARRAY_INDICES_STRUCT, FormatType::C_ARRAY_INDICES_STRUCT, FormatType::CPP_ARRAY_VERTICES_STRUCT, FormatType::C_ARRAY_VERTICES_STRUCT,
+                                   FormatType::CPP_ARRAY_INDICES_FLOAT, FormatType::C_ARRAY_INDICES_FLOAT, FormatType::CPP_ARRAY_VERTICES_FLOAT, FormatType::C_ARRAY_VERTICES_FLOAT,
+                                   FormatType::CPP_ARRAY_STRIP_STRUCT, FormatType::C_ARRAY_STRIP_STRUCT, FormatType::CPP_ARRAY_STRIP_FLOAT, FormatType::C_ARRAY_STRIP_FLOAT }) {
+            requireSaved(torus, format);
+        }
+
+        // Strip comment and separators depend on primitive restart
+        torus.setPrimitiveRestart(false);
+        requireSaved(torus, FormatType::CPP_ARRAY_STRIP_STRUCT);
+    }
+
+    SECTION("Several chunks") {
+        ShapeConfig config{};
+        config.calcBitangents = false;
+
+        // More vertices and indices than one chunk, meshlets and LODs follow the last index chunk
+        Sphere sphere(config, 380u, 380u, ValuesRange::HALF_TO_HALF, Shading::SMOOTH);
+        REQUIRE(sphere.getVerticesCount() > Shape::SAVE_CHUNK_VERTICES);
+        REQUIRE(sphere.getIndicesCount() > Shape::SAVE_CHUNK_INDICES);
+        sphere.generateLods(2u);
+        sphere.buildMeshlets();
+
+        requireSaved(sphere, FormatType::C_ARRAY_INDICES_FLOAT);
+        requireSaved(sphere, FormatType::CPP_ARRAY_STRIP_STRUCT);
+    }
+}
+
+TEST_CASE("ShapesGenerator.ExportPipeline.Fallback") {
+    ShapeConfig config{};
+    Torus torus(config, 24u, 12u, 1.f, .5f, ValuesRange::HALF_TO_HALF, Shading::FLAT);
+    torus.generateLods(2u);
+
+    // Formats built whole are formatted first and written the same
+    for (FormatType format : { FormatType::OBJ, FormatType::JSON_INDICES, FormatType::JSON_VERTICES, FormatType::JSON_STRIP }) {
+        REQUIRE_FALSE(Shape::isStreamable(format));
+
+        const fs::path path = MakeSavePath("torus" + Shape::getFormatFileExtension(format));
+        REQUIRE(torus.save(path.string(), format));
+
+        INFO(static_cast<int>(format));
+        REQUIRE(ReadFile(path) == torus.toString(format));
+        fs::remove(path);
+    }
+}
+
+TEST_CASE("ShapesGenerator.ExportPipeline.SaveCancelled") {
+    ShapeConfig config{};
+    Torus torus(config, 24u, 12u, 1.f, .5f, ValuesRange::HALF_TO_HALF, Shading::SMOOTH);
+
+    ProgressToken progress;
+    progress.cancel();
+
+    // Partly written file is removed
+    for (FormatType format : { FormatType::BINARY, FormatType::C_ARRAY_STRIP_FLOAT, FormatType::OBJ }) {
+        const fs::path path = MakeSavePath("cancel" + Shape::getFormatFileExtension(format));
+        REQUIRE_FALSE(torus.save(path.string(), format, nullptr, &progress));
+        REQUIRE_FALSE(fs::exists(path));
+    }
+}
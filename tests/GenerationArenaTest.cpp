@@ -0,0 +1,115 @@
+#pragma region PCH
+#include "pch.hpp"
+#pragma endregion
+
+#pragma region STD_LIBS
+#include <cstddef>
+#include <cstring>
+#include <memory_resource>
+#include <vector>
+#pragma endregion
+
+#pragma region CATCH2_LIB
+#include <catch2/catch_test_macros.hpp>
+#pragma endregion
+
+#pragma region MY_FILES_CORE_LIB
+#include <GenerationArena.hpp>
+#include <Shape.hpp>
+#include <Sphere.hpp>
+#include <Torus.hpp>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "Helpers.hpp"
+#pragma endregion
+
+// Counts allocations going to the shape containers
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+    size_t count = 0ull;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+        ++count;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override
+    {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+TEST_CASE("ShapesGenerator.GenerationArena.ReuseThreadBuffer") {
+    GenerationArena::releaseThreadBuffer();
+
+    ShapeConfig config{};
+    {
+        Sphere sphere(config, 64u, 64u, ValuesRange::ONE_TO_ONE, Shading::FLAT);
+    }
+    REQUIRE(GenerationArena::getThreadBufferSize() > GenerationArena::INITIAL_THREAD_BUFFER_SIZE);
+
+    // Same generation fits in the grown buffer
+    {
+        Sphere sphere(config, 64u, 64u, ValuesRange::ONE_TO_ONE, Shading::FLAT);
+    }
+    REQUIRE(GenerationArena::getLastOverflowCount() == 0);
+}
+
+TEST_CASE("ShapesGenerator.GenerationArena.TrimThreadBuffer") {
+    GenerationArena::releaseThreadBuffer();
+
+    {
+        GenerationArena arena;
+        std::pmr::vector<std::byte> big(4ull * 1024ull * 1024ull, std::byte{ 0 }, arena.resource());
+    }
+    const size_t grownSize = GenerationArena::getThreadBufferSize();
+    REQUIRE(grownSize > GenerationArena::INITIAL_THREAD_BUFFER_SIZE);
+    REQUIRE(grownSize <= GenerationArena::MAX_THREAD_BUFFER_SIZE);
+
+    // Small arenas in a row give the memory back
+    for (size_t i = 0ull; i < GenerationArena::TRIM_AFTER_ARENAS; ++i) {
+        GenerationArena arena;
+        std::pmr::vector<int> small(16, 1, arena.resource());
+    }
+    REQUIRE(GenerationArena::getThreadBufferSize() == grownSize / 2ull);
+}
+
+TEST_CASE("ShapesGenerator.GenerationArena.Nested") {
+    GenerationArena outer;
+    std::pmr::vector<int> outerValues({ 1, 2, 3 }, outer.resource());
+
+    {
+        GenerationArena inner;
+        std::pmr::vector<int> innerValues(1024, 7, inner.resource());
+        REQUIRE(inner.resource() != outer.resource());
+        REQUIRE(innerValues.back() == 7);
+    }
+
+    REQUIRE(outerValues[2] == 3);
+}
+
+TEST_CASE("ShapesGenerator.GenerationArena.ShapeMemoryResource") {
+    CountingResource counting;
+    ShapeConfig config{};
+    ShapeConfig countingConfig{};
+    countingConfig.memoryResource = &counting;
+
+    Torus reference(config, 32u, 16u, 1.f, 0.5f, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+    Torus torus(countingConfig, 32u, 16u, 1.f, 0.5f, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+
+    REQUIRE(counting.count > 0);
+    REQUIRE(torus.getVertices().get_allocator().resource() == &counting);
+
+    // Memory resource doesn't change the output
+    REQUIRE(std::memcmp(torus.getVertices().data(), reference.getVertices().data(), reference.getVerticesCount() * sizeof(Vertex)) == 0);
+    REQUIRE(torus.getIndices() == reference.getIndices());
+}
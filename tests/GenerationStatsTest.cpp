@@ -0,0 +1,139 @@
+#pragma region PCH
+#include "pch.hpp"
+#pragma endregion
+
+#pragma region STD_LIBS
+#include <filesystem>
+#include <memory>
+#include <string>
+#pragma endregion
+
+#pragma region JSON_LIB
+#include <nlohmann/json.hpp>
+#pragma endregion
+
+#pragma region CATCH2_LIB
+#include <catch2/catch_test_macros.hpp>
+#pragma endregion
+
+#pragma region MY_FILES_CORE_LIB
+#include <Cube.hpp>
+#include <GenerationStats.hpp>
+#include <MeshCache.hpp>
+#include <Shape.hpp>
+#include <Sphere.hpp>
+#include <Torus.hpp>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "Helpers.hpp"
+#pragma endregion
+
+static bool HasPhase(const GenerationStats& stats, const std::string& name)
+{
+    for (const PhaseTiming& phase : stats.phases) {
+        if (phase.name == name) return true;
+    }
+    return false;
+}
+
+TEST_CASE("ShapesGenerator.GenerationStats.Timer") {
+    GenerationStats stats;
+    {
+        PhaseTimer outer(&stats, "outer");
+        PhaseTimer inner(&stats, "inner");
+        inner.stop();
+        // Second stop doesn't record it again
+        inner.stop();
+    }
+
+    REQUIRE(stats.phases.size() == 2);
+    REQUIRE(stats.phases[0].name == "inner");
+    REQUIRE(stats.phases[1].name == "outer");
+    REQUIRE(stats.phases[1].startMs <= stats.phases[0].startMs);
+    REQUIRE(stats.phases[1].durationMs >= stats.phases[0].durationMs);
+
+    // Summary is in order of start
+    const auto summary = stats.getSummary();
+    REQUIRE(summary.size() == 2);
+    REQUIRE(summary[0].first == "outer");
+    REQUIRE(summary[1].first == "inner");
+
+    PhaseTimer ignored(nullptr, "ignored");
+    ignored.stop();
+    REQUIRE(stats.phases.size() == 2);
+}
+
+TEST_CASE("ShapesGenerator.GenerationStats.SmoothPhases") {
+    ShapeConfig config{};
+    Torus torus(config, 32u, 16u, 1.f, 0.5f, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+    const GenerationStats& stats = torus.getGenerationStats();
+
+    for (const char* name : { "vertex generation", "index generation", "tangent accumulation", "tangent normalisation" }) {
+        INFO(name);
+        REQUIRE(HasPhase(stats, name));
+    }
+    REQUIRE_FALSE(HasPhase(stats, "flat shading"));
+
+    config.genTangents = false;
+    Torus noTangents(config, 32u, 16u, 1.f, 0.5f, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+    REQUIRE(HasPhase(noTangents.getGenerationStats(), "index generation"));
+    REQUIRE_FALSE(HasPhase(noTangents.getGenerationStats(), "tangent accumulation"));
+}
+
+TEST_CASE("ShapesGenerator.GenerationStats.FlatPhases") {
+    ShapeConfig config{};
+    Sphere sphere(config, 8u, 16u, ValuesRange::ONE_TO_ONE, Shading::FLAT);
+
+    REQUIRE(HasPhase(sphere.getGenerationStats(), "vertex generation"));
+    REQUIRE(HasPhase(sphere.getGenerationStats(), "flat shading"));
+}
+
+TEST_CASE("ShapesGenerator.GenerationStats.Export") {
+    ShapeConfig config{};
+    Cube cube(config, ValuesRange::ONE_TO_ONE);
+
+    GenerationStats stats;
+    const std::string text = cube.toString(FormatType::OBJ, &stats);
+    REQUIRE(HasPhase(stats, "dedup"));
+    REQUIRE(HasPhase(stats, "formatting"));
+
+    // Not measured without stats, output is the same
+    REQUIRE(cube.toString(FormatType::OBJ) == text);
+}
+
+TEST_CASE("ShapesGenerator.GenerationStats.ChromeTrace") {
+    ShapeConfig config{};
+    Torus torus(config, 16u, 8u, 1.f, 0.5f, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+
+    GenerationStats stats = torus.getGenerationStats();
+    torus.toString(FormatType::JSON_INDICES, &stats);
+
+    const nlohmann::json trace = nlohmann::json::parse(stats.toChromeTrace());
+    REQUIRE(trace["traceEvents"].size() == stats.phases.size());
+    for (const nlohmann::json& event : trace["traceEvents"]) {
+        REQUIRE(event["ph"] == "X");
+        REQUIRE(event["dur"].get<double>() >= 0.0);
+    }
+}
+
+TEST_CASE("ShapesGenerator.GenerationStats.CacheLoad") {
+    const std::filesystem::path dir = std::filesystem::temp_directory_path() / "shapes_generator_stats_cache";
+    std::filesystem::remove_all(dir);
+    MeshCache cache(dir.string());
+
+    ShapeConfig config{};
+    auto [fresh, freshHit] = cache.getOrGenerate<Torus>(config, 16u, 8u, 1.f, 0.5f, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+    auto [cached, cachedHit] = cache.getOrGenerate<Torus>(config, 16u, 8u, 1.f, 0.5f, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+    std::unique_ptr<Shape> a(fresh), b(cached);
+
+    REQUIRE_FALSE(freshHit);
+    REQUIRE(HasPhase(a->getGenerationStats(), "vertex generation"));
+    REQUIRE(HasPhase(a->getGenerationStats(), "cache store"));
+
+    REQUIRE(cachedHit);
+    REQUIRE(HasPhase(b->getGenerationStats(), "cache load"));
+    REQUIRE_FALSE(HasPhase(b->getGenerationStats(), "vertex generation"));
+
+    std::filesystem::remove_all(dir);
+}
\ No newline at end of file
@@ -24,8 +24,8 @@
 class TestableHexagon : public Hexagon {
 public:
     using Hexagon::Hexagon;
-    const std::vector<Vertex>& getVertices() const { return _vertices; }
-    const std::vector<unsigned int>& getIndices() const { return _indices; }
+    const std::pmr::vector<Vertex>& getVertices() const { return _vertices; }
+    const std::pmr::vector<unsigned int>& getIndices() const { return _indices; }
 };
 
 TEST_CASE("ShapesGenerator.Hexagon.Minimal.Valid") {
@@ -0,0 +1,89 @@
+#pragma region PCH
+#include "pch.hpp"
+#pragma endregion
+
+#pragma region STD_LIBS
+#include <cstdint>
+#pragma endregion
+
+#pragma region CATCH2_LIB
+#include <catch2/catch_test_macros.hpp>
+#pragma endregion
+
+#pragma region MY_FILES_CORE_LIB
+#include <BitMathOperators.hpp>
+#include <Cone.hpp>
+#include <Cylinder.hpp>
+#include <Hexagon.hpp>
+#include <IcoSphere.hpp>
+#include <Plane.hpp>
+#include <Shape.hpp>
+#include <Sphere.hpp>
+#include <Torus.hpp>
+#include <Vertex.hpp>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "Helpers.hpp"
+#pragma endregion
+
+template<class ShapeType, class... Args>
+static void CheckRefused(const Args&... args)
+{
+    REQUIRE_FALSE(ShapeType::getMeshCounts(args...).fitsIndexType());
+
+    ShapeConfig config{};
+    ShapeType shape(config, args...);
+
+    INFO(ShapeType::getClassName());
+    REQUIRE(shape.exceedsIndexType());
+    REQUIRE_FALSE(shape.isCancelled());
+    REQUIRE(shape.getVerticesCount() == 0ull);
+    REQUIRE(shape.getIndicesCount() == 0ull);
+}
+
+TEST_CASE("ShapesGenerator.IndexType.Saturation") {
+    REQUIRE(mul_sat<size_t>(SIZE_MAX / 2ull, 3ull) == SIZE_MAX);
+    REQUIRE(mul_sat<size_t>(6ull, 7ull) == 42ull);
+    REQUIRE(mul_sat<size_t>(SIZE_MAX, 0ull) == 0ull);
+    REQUIRE(add_sat<size_t>(SIZE_MAX, 1ull) == SIZE_MAX);
+    REQUIRE(add_sat<size_t>(40ull, 2ull) == 42ull);
+}
+
+TEST_CASE("ShapesGenerator.IndexType.Counts") {
+    REQUIRE(MeshCounts{ MeshCounts::MAX_VERTICES, MeshCounts::MAX_INDICES }.fitsIndexType());
+    REQUIRE_FALSE(MeshCounts{ MeshCounts::MAX_VERTICES + 1ull, 0ull }.fitsIndexType());
+    REQUIRE_FALSE(MeshCounts{ 0ull, MeshCounts::MAX_INDICES + 1ull }.fitsIndexType());
+
+    // Largest parameters saturate instead of wrapping around to small counts
+    REQUIRE(Plane::getMeshCounts(UINT32_MAX, UINT32_MAX).indices == SIZE_MAX);
+    REQUIRE(Torus::getMeshCounts(UINT32_MAX, UINT32_MAX, 1.f, .5f, ValuesRange::HALF_TO_HALF, Shading::SMOOTH).vertices == SIZE_MAX);
+    REQUIRE(Cylinder::getMeshCounts(UINT32_MAX, UINT32_MAX, ValuesRange::HALF_TO_HALF, Shading::FLAT).vertices == SIZE_MAX);
+    REQUIRE(IcoSphere::getMeshCounts(40u, ValuesRange::HALF_TO_HALF, Shading::SMOOTH).indices == SIZE_MAX);
+    REQUIRE_FALSE(IcoSphere::getMeshCounts(29u, ValuesRange::HALF_TO_HALF, Shading::FLAT).fitsIndexType());
+}
+
+TEST_CASE("ShapesGenerator.IndexType.Refused") {
+    // Vertices over 32-bit indices
+    CheckRefused<Plane>(70000u, 70000u, PlaneNormalDir::UP, ValuesRange::HALF_TO_HALF);
+    // Vertices fit, indices don't
+    CheckRefused<Plane>(40000u, 40000u, PlaneNormalDir::UP, ValuesRange::HALF_TO_HALF);
+    CheckRefused<Cylinder>(70000u, 70000u, ValuesRange::HALF_TO_HALF, Shading::FLAT);
+    CheckRefused<Hexagon>(UINT32_MAX, ValuesRange::HALF_TO_HALF);
+    CheckRefused<Cone>(UINT32_MAX, 1.f, 1.f, ValuesRange::HALF_TO_HALF, Shading::FLAT);
+    CheckRefused<Sphere>(70000u, 70000u, ValuesRange::HALF_TO_HALF, Shading::SMOOTH);
+    CheckRefused<IcoSphere>(16u, ValuesRange::HALF_TO_HALF, Shading::SMOOTH);
+    CheckRefused<IcoSphere>(40u, ValuesRange::HALF_TO_HALF, Shading::FLAT);
+    CheckRefused<Torus>(UINT32_MAX, UINT32_MAX, 1.f, .5f, ValuesRange::HALF_TO_HALF, Shading::FLAT);
+}
+
+TEST_CASE("ShapesGenerator.IndexType.Generated") {
+    ShapeConfig config{};
+    Torus torus(config, 24u, 12u, 1.f, .5f, ValuesRange::HALF_TO_HALF, Shading::SMOOTH);
+    REQUIRE_FALSE(torus.exceedsIndexType());
+    REQUIRE(torus.getVerticesCount() == Torus::getMeshCounts(24u, 12u, 1.f, .5f, ValuesRange::HALF_TO_HALF, Shading::SMOOTH).vertices);
+
+    for (unsigned int index : torus.getIndices()) {
+        REQUIRE(index < torus.getVerticesCount());
+    }
+}
@@ -0,0 +1,258 @@
+#pragma region PCH
+#include "pch.hpp"
+#pragma endregion
+
+#pragma region STD_LIBS
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#pragma endregion
+
+#pragma region CATCH2_LIB
+#include <catch2/catch_test_macros.hpp>
+#pragma endregion
+
+#pragma region MY_FILES_CORE_LIB
+#include <MeshCache.hpp>
+#include <Plane.hpp>
+#include <Shape.hpp>
+#include <Sphere.hpp>
+#include <Torus.hpp>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "Helpers.hpp"
+#pragma endregion
+
+namespace fs = std::filesystem;
+
+static fs::path MakeCacheDir(const std::string& name)
+{
+    const fs::path dir = fs::temp_directory_path() / ("shapes_generator_" + name);
+    fs::remove_all(dir);
+    return dir;
+}
+
+static size_t CountEntries(const fs::path& dir)
+{
+    size_t count = 0;
+    for (const fs::directory_entry& entry : fs::directory_iterator(dir)) {
+        if (entry.path().extension() == MeshCache::FILE_EXTENSION) ++count;
+    }
+    return count;
+}
+
+TEST_CASE("ShapesGenerator.MeshCache.SameOutput") {
+    const fs::path dir = MakeCacheDir("cache_output");
+    MeshCache cache(dir.string());
+
+    ShapeConfig config{};
+    config.calcBitangents = false;
+
+    auto [fresh, freshHit] = cache.getOrGenerate<Torus>(config, 32u, 16u, 1.f, 0.5f, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+    auto [cached, cachedHit] = cache.getOrGenerate<Torus>(config, 32u, 16u, 1.f, 0.5f, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+    std::unique_ptr<Shape> a(fresh), b(cached);
+
+    REQUIRE_FALSE(freshHit);
+    REQUIRE(cachedHit);
+    REQUIRE(CountEntries(dir) == 1);
+    REQUIRE(b->getObjectClassName() == Torus::getClassName());
+
+    for (FormatType type : { FormatType::CPP_ARRAY_INDICES_STRUCT, FormatType::C_ARRAY_VERTICES_FLOAT, FormatType::JSON_INDICES, FormatType::OBJ, FormatType::BINARY, FormatType::BINARY_STRIP }) {
+        REQUIRE(a->toString(type) == b->toString(type));
+    }
+
+    SECTION("Optimization passes") {
+        MeshOptimizeOptions options;
+        options.optimizeVertexCache = true;
+        options.optimizeVertexFetch = true;
+        options.generateLods = true;
+        a->optimize(options);
+        b->optimize(options);
+
+        REQUIRE(a->toString(FormatType::BINARY) == b->toString(FormatType::BINARY));
+    }
+
+    fs::remove_all(dir);
+}
+
+TEST_CASE("ShapesGenerator.MeshCache.Key") {
+    const fs::path dir = MakeCacheDir("cache_key");
+    MeshCache cache(dir.string());
+
+    ShapeConfig config{};
+    ShapeConfig noTangents{};
+    noTangents.genTangents = false;
+
+    delete cache.getOrGenerate<Sphere>(config, 8u, 8u, ValuesRange::ONE_TO_ONE, Shading::SMOOTH).first;
+
+    // Any parameter, range, shading or config change is another mesh
+    auto [flat, flatHit] = cache.getOrGenerate<Sphere>(config, 8u, 8u, ValuesRange::ONE_TO_ONE, Shading::FLAT);
+    auto [range, rangeHit] = cache.getOrGenerate<Sphere>(config, 8u, 8u, ValuesRange::HALF_TO_HALF, Shading::SMOOTH);
+    auto [segments, segmentsHit] = cache.getOrGenerate<Sphere>(config, 8u, 9u, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+    auto [other, otherHit] = cache.getOrGenerate<Sphere>(noTangents, 8u, 8u, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+    auto [plane, planeHit] = cache.getOrGenerate<Plane>(config, 8u, 8u, PlaneNormalDir::UP, ValuesRange::ONE_TO_ONE);
+    auto [same, sameHit] = cache.getOrGenerate<Sphere>(config, 8u, 8u, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+
+    for (Shape* shape : { flat, range, segments, other, plane, same }) delete shape;
+
+    REQUIRE_FALSE(flatHit);
+    REQUIRE_FALSE(rangeHit);
+    REQUIRE_FALSE(segmentsHit);
+    REQUIRE_FALSE(otherHit);
+    REQUIRE_FALSE(planeHit);
+    REQUIRE(sameHit);
+    REQUIRE(CountEntries(dir) == 6);
+
+    fs::remove_all(dir);
+}
+
+TEST_CASE("ShapesGenerator.MeshCache.Disabled") {
+    const fs::path dir = MakeCacheDir("cache_disabled");
+    MeshCache cache(dir.string(), MeshCache::DEFAULT_MAX_SIZE, false);
+
+    ShapeConfig config{};
+    for (int i = 0; i < 2; ++i) {
+        auto [shape, hit] = cache.getOrGenerate<Plane>(config, 4u, 4u, PlaneNormalDir::UP, ValuesRange::ONE_TO_ONE);
+        delete shape;
+        REQUIRE_FALSE(hit);
+    }
+
+    REQUIRE_FALSE(fs::exists(dir));
+}
+
+TEST_CASE("ShapesGenerator.MeshCache.Eviction") {
+    const fs::path dir = MakeCacheDir("cache_eviction");
+    ShapeConfig config{};
+
+    // Size limit for two entries of the same size
+    uint64_t entrySize = 0;
+    {
+        MeshCache probe(dir.string());
+        delete probe.getOrGenerate<Plane>(config, 16u, 16u, PlaneNormalDir::UP, ValuesRange::ONE_TO_ONE).first;
+        entrySize = probe.getSize();
+        probe.clear();
+    }
+    REQUIRE(entrySize > 0);
+
+    MeshCache cache(dir.string(), entrySize * 2 + entrySize / 2);
+    auto generate = [&cache, &config](PlaneNormalDir dir, ValuesRange range) {
+        auto [shape, hit] = cache.getOrGenerate<Plane>(config, 16u, 16u, dir, range);
+        delete shape;
+        // Keeps modification times apart
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        return hit;
+    };
+
+    generate(PlaneNormalDir::UP, ValuesRange::ONE_TO_ONE);
+    generate(PlaneNormalDir::FRONT, ValuesRange::ONE_TO_ONE);
+    // Use makes first entry the most recent one
+    REQUIRE(generate(PlaneNormalDir::UP, ValuesRange::ONE_TO_ONE));
+    generate(PlaneNormalDir::UP, ValuesRange::HALF_TO_HALF);
+
+    REQUIRE(CountEntries(dir) == 2);
+    REQUIRE(cache.getSize() <= entrySize * 2 + entrySize / 2);
+    REQUIRE(generate(PlaneNormalDir::UP, ValuesRange::ONE_TO_ONE));
+    REQUIRE(generate(PlaneNormalDir::UP, ValuesRange::HALF_TO_HALF));
+    REQUIRE_FALSE(generate(PlaneNormalDir::FRONT, ValuesRange::ONE_TO_ONE));
+
+    fs::remove_all(dir);
+}
+
+TEST_CASE("ShapesGenerator.MeshCache.DamagedEntry") {
+    const fs::path dir = MakeCacheDir("cache_damaged");
+    MeshCache cache(dir.string());
+
+    ShapeConfig config{};
+    auto [fresh, freshHit] = cache.getOrGenerate<Torus>(config, 8u, 8u, 1.f, 0.5f, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+    std::unique_ptr<Shape> a(fresh);
+
+    // Cut entry in half
+    for (const fs::directory_entry& entry : fs::directory_iterator(dir)) {
+        fs::resize_file(entry.path(), fs::file_size(entry.path()) / 2);
+    }
+
+    auto [restored, restoredHit] = cache.getOrGenerate<Torus>(config, 8u, 8u, 1.f, 0.5f, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+    std::unique_ptr<Shape> b(restored);
+
+    REQUIRE_FALSE(restoredHit);
+    REQUIRE(a->toString(FormatType::BINARY) == b->toString(FormatType::BINARY));
+
+    // Damaged entry was replaced
+    auto [again, againHit] = cache.getOrGenerate<Torus>(config, 8u, 8u, 1.f, 0.5f, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+    delete again;
+    REQUIRE(againHit);
+
+    fs::remove_all(dir);
+}
+
+static fs::path GetEntryPath(const fs::path& dir)
+{
+    for (const fs::directory_entry& entry : fs::directory_iterator(dir)) {
+        if (entry.path().extension() == MeshCache::FILE_EXTENSION) return entry.path();
+    }
+    return {};
+}
+
+// Offset of vertex count, which follows magic, version, key size, key and flags
+static std::streamoff GetCountsOffset(const fs::path& path)
+{
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    uint32_t keySize = 0u;
+    file.seekg(8);
+    file.read(reinterpret_cast<char*>(&keySize), sizeof(keySize));
+    return 12 + static_cast<std::streamoff>(keySize) + 4;
+}
+
+TEST_CASE("ShapesGenerator.MeshCache.CorruptCounts") {
+    const fs::path dir = MakeCacheDir("cache_corrupt");
+    MeshCache cache(dir.string());
+
+    ShapeConfig config{};
+    auto generate = [&cache, &config]() {
+        auto [shape, hit] = cache.getOrGenerate<Torus>(config, 8u, 8u, 1.f, 0.5f, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+        return std::make_pair(std::unique_ptr<Shape>(shape), hit);
+    };
+    const std::string expected = generate().first->toString(FormatType::BINARY);
+
+    SECTION("Index count wrapping around in size check") {
+        const fs::path path = GetEntryPath(dir);
+        const std::streamoff indexCountOffset = GetCountsOffset(path) + 8;
+
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        uint64_t indexCount = 0ull;
+        file.seekg(indexCountOffset);
+        file.read(reinterpret_cast<char*>(&indexCount), sizeof(indexCount));
+        indexCount += 1ull << 62;
+        file.seekp(indexCountOffset);
+        file.write(reinterpret_cast<const char*>(&indexCount), sizeof(indexCount));
+    }
+
+    SECTION("Index past the vertices") {
+        const fs::path path = GetEntryPath(dir);
+        const uint32_t index = 0xFFFFFFF0u;
+
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(static_cast<std::streamoff>(fs::file_size(path)) - static_cast<std::streamoff>(sizeof(index)));
+        file.write(reinterpret_cast<const char*>(&index), sizeof(index));
+    }
+
+    auto [restored, restoredHit] = generate();
+    REQUIRE_FALSE(restoredHit);
+    REQUIRE(restored->toString(FormatType::BINARY) == expected);
+
+    // Corrupt entry was replaced
+    auto [again, againHit] = generate();
+    REQUIRE(againHit);
+    REQUIRE(again->toString(FormatType::BINARY) == expected);
+    REQUIRE(CountEntries(dir) == 1);
+
+    fs::remove_all(dir);
+}
@@ -0,0 +1,127 @@
+#pragma region PCH
+#include "pch.hpp"
+#pragma endregion
+
+#pragma region STD_LIBS
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory_resource>
+#include <vector>
+#pragma endregion
+
+#pragma region CATCH2_LIB
+#include <catch2/catch_test_macros.hpp>
+#pragma endregion
+
+#pragma region MY_FILES_CORE_LIB
+#include <Cone.hpp>
+#include <Cube.hpp>
+#include <Cylinder.hpp>
+#include <Hexagon.hpp>
+#include <IcoSphere.hpp>
+#include <Plane.hpp>
+#include <Pyramid.hpp>
+#include <Shape.hpp>
+#include <Sphere.hpp>
+#include <Tetrahedron.hpp>
+#include <Torus.hpp>
+#include <Vertex.hpp>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "Helpers.hpp"
+#pragma endregion
+
+template<class ShapeType, class... Args>
+static void CheckCounts(const Args&... args)
+{
+    for (bool genTangents : { true, false }) {
+        ShapeConfig config{};
+        config.genTangents = genTangents;
+
+        ShapeType shape(config, args...);
+        const MeshCounts counts = ShapeType::getMeshCounts(args...);
+
+        INFO(ShapeType::getClassName());
+        REQUIRE(counts.vertices == shape.getVerticesCount());
+        REQUIRE(counts.indices == shape.getIndicesCount());
+    }
+}
+
+TEST_CASE("ShapesGenerator.MeshData.Counts") {
+    CheckCounts<Cube>(ValuesRange::ONE_TO_ONE);
+    CheckCounts<Tetrahedron>(ValuesRange::ONE_TO_ONE);
+    CheckCounts<Pyramid>(ValuesRange::ONE_TO_ONE);
+
+    // Includes values below minimum, counts have to be clamped like in constructors
+    for (unsigned int a : { 0u, 1u, 2u, 3u, 7u, 16u }) {
+        for (unsigned int b : { 0u, 1u, 3u, 4u, 9u }) {
+            CheckCounts<Plane>(a, b, PlaneNormalDir::UP, ValuesRange::ONE_TO_ONE);
+            for (Shading shading : { Shading::FLAT, Shading::SMOOTH }) {
+                CheckCounts<Cylinder>(a, b, ValuesRange::ONE_TO_ONE, shading);
+                CheckCounts<Sphere>(a, b, ValuesRange::ONE_TO_ONE, shading);
+                CheckCounts<Torus>(a, b, 1.f, 0.5f, ValuesRange::ONE_TO_ONE, shading);
+            }
+        }
+
+        CheckCounts<Hexagon>(a, ValuesRange::ONE_TO_ONE);
+        for (Shading shading : { Shading::FLAT, Shading::SMOOTH }) {
+            CheckCounts<Cone>(a, 1.f, 1.f, ValuesRange::ONE_TO_ONE, shading);
+        }
+    }
+
+    for (unsigned int subdivisions = 0u; subdivisions < 5u; ++subdivisions) {
+        CheckCounts<IcoSphere>(subdivisions, ValuesRange::ONE_TO_ONE, Shading::FLAT);
+        CheckCounts<IcoSphere>(subdivisions, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+    }
+}
+
+TEST_CASE("ShapesGenerator.MeshData.Release") {
+    ShapeConfig config{};
+    Torus torus(config, 16u, 8u, 1.f, 0.5f, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+    torus.buildMeshlets();
+    torus.generateLods();
+
+    const std::vector<Vertex> expectedVertices(torus.getVertices().begin(), torus.getVertices().end());
+    const std::vector<unsigned int> expectedIndices(torus.getIndices().begin(), torus.getIndices().end());
+    const Vertex* vertexData = torus.getVertices().data();
+    const unsigned int* indexData = torus.getIndices().data();
+
+    MeshData data = torus.release();
+
+    // Same buffers, nothing was copied
+    REQUIRE(data.vertices.data() == vertexData);
+    REQUIRE(data.indices.data() == indexData);
+    REQUIRE(std::equal(data.indices.begin(), data.indices.end(), expectedIndices.begin(), expectedIndices.end()));
+    REQUIRE(data.vertices.size() == expectedVertices.size());
+    REQUIRE(std::memcmp(data.vertices.data(), expectedVertices.data(), expectedVertices.size() * sizeof(Vertex)) == 0);
+
+    REQUIRE(torus.getVerticesCount() == 0);
+    REQUIRE(torus.getIndicesCount() == 0);
+    REQUIRE(torus.getMeshlets().meshlets.empty());
+    REQUIRE(torus.getLods().levels.empty());
+}
+
+TEST_CASE("ShapesGenerator.MeshData.CallerMemory") {
+    Sphere reference(ShapeConfig{}, 8u, 12u, ValuesRange::ONE_TO_ONE, Shading::FLAT);
+
+    // Shape generated straight into caller buffer, released vectors still point into it
+    std::vector<std::byte> buffer(1ull << 20);
+    std::pmr::monotonic_buffer_resource resource(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+    ShapeConfig config{};
+    config.memoryResource = &resource;
+
+    Sphere sphere(config, 8u, 12u, ValuesRange::ONE_TO_ONE, Shading::FLAT);
+    MeshData data = sphere.release();
+
+    auto isInBuffer = [&buffer](const void* pointer) {
+        const std::byte* bytes = static_cast<const std::byte*>(pointer);
+        return bytes >= buffer.data() && bytes < buffer.data() + buffer.size();
+    };
+    REQUIRE(isInBuffer(data.vertices.data()));
+    REQUIRE(isInBuffer(data.indices.data()));
+    REQUIRE(data.indices == reference.getIndices());
+    REQUIRE(data.vertices.size() == reference.getVerticesCount());
+    REQUIRE(std::memcmp(data.vertices.data(), reference.getVertices().data(), data.vertices.size() * sizeof(Vertex)) == 0);
+}
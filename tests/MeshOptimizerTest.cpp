@@ -0,0 +1,254 @@
+#pragma region PCH
+#include "pch.hpp"
+#pragma endregion
+
+#pragma region STD_LIBS
+#include <algorithm>
+#include <array>
+#include <span>
+#include <vector>
+#pragma endregion
+
+#pragma region CATCH2_LIB
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#pragma endregion
+
+#pragma region MY_FILES_CORE_LIB
+#include <IcoSphere.hpp>
+#include <MeshOptimizer.hpp>
+#include <Plane.hpp>
+#include <Shape.hpp>
+#include <Torus.hpp>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "Helpers.hpp"
+#pragma endregion
+
+// Triangles rotated so that the smallest index is first (winding preserved)
+static std::vector<std::array<unsigned int, 3>> NormalizedTriangles(std::span<const unsigned int> indices)
+{
+    std::vector<std::array<unsigned int, 3>> tris;
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        std::array<unsigned int, 3> t = { indices[i], indices[i + 1], indices[i + 2] };
+        while (t[0] != std::min({ t[0], t[1], t[2] })) {
+            std::rotate(t.begin(), t.begin() + 1, t.end());
+        }
+        tris.push_back(t);
+    }
+    std::sort(tris.begin(), tris.end());
+    return tris;
+}
+
+TEST_CASE("ShapesGenerator.MeshOptimizer.VertexCache.Analyze.FIFO") {
+    // Strip-like order, every triangle reuses two vertices of the previous one
+    const std::vector<unsigned int> indices = { 0, 1, 2, 2, 1, 3, 2, 3, 4, 4, 3, 5 };
+
+    VertexCacheStats stats = MeshOptimizer::analyzeVertexCache(indices, 6, 16, VertexCacheType::FIFO);
+    REQUIRE(stats.misses == 6);
+    REQUIRE(stats.acmr == Catch::Approx(1.5f));
+    REQUIRE(stats.atvr == Catch::Approx(1.f));
+
+    // Strip order needs no more than the last triangle in the cache
+    stats = MeshOptimizer::analyzeVertexCache(indices, 6, 3, VertexCacheType::FIFO);
+    REQUIRE(stats.misses == 6);
+}
+
+TEST_CASE("ShapesGenerator.MeshOptimizer.VertexCache.Analyze.LRU") {
+    const std::vector<unsigned int> indices = { 0, 1, 2, 0, 2, 3, 0, 3, 4, 0, 4, 1 };
+
+    // LRU keeps the fan center alive, FIFO evicts it
+    VertexCacheStats lru = MeshOptimizer::analyzeVertexCache(indices, 5, 3, VertexCacheType::LRU);
+    VertexCacheStats fifo = MeshOptimizer::analyzeVertexCache(indices, 5, 3, VertexCacheType::FIFO);
+
+    REQUIRE(lru.misses == 6);
+    REQUIRE(fifo.misses > lru.misses);
+}
+
+TEST_CASE("ShapesGenerator.MeshOptimizer.VertexCache.Optimize.KeepsTriangles") {
+    ShapeConfig config{};
+    IcoSphere ico(config, 3u, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+
+    const auto before = NormalizedTriangles(ico.getIndices());
+    ico.optimizeVertexCache(32u);
+    const auto after = NormalizedTriangles(ico.getIndices());
+
+    REQUIRE(before == after);
+}
+
+TEST_CASE("ShapesGenerator.MeshOptimizer.VertexCache.Optimize.ImprovesACMR") {
+    ShapeConfig config{};
+
+    SECTION("Plane") {
+        Plane plane(config, 128u, 128u, PlaneNormalDir::UP, ValuesRange::ONE_TO_ONE);
+
+        MeshOptimizeOptions options;
+        options.optimizeVertexCache = true;
+        options.vertexCacheSize = 16u;
+
+        MeshOptimizeReport report = plane.optimize(options);
+
+        REQUIRE(report.vertexCacheOptimized);
+        REQUIRE(report.vertexCacheAfter.acmr < report.vertexCacheBefore.acmr);
+        REQUIRE(report.vertexCacheAfter.acmr < 0.8f);
+    }
+
+    SECTION("IcoSphere") {
+        IcoSphere ico(config, 5u, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+
+        MeshOptimizeOptions options;
+        options.optimizeVertexCache = true;
+        options.vertexCacheType = VertexCacheType::LRU;
+
+        MeshOptimizeReport report = ico.optimize(options);
+
+        REQUIRE(report.vertexCacheAfter.acmr < report.vertexCacheBefore.acmr);
+        REQUIRE(report.vertexCacheAfter.atvr < report.vertexCacheBefore.atvr);
+    }
+}
+
+TEST_CASE("ShapesGenerator.MeshOptimizer.VertexCache.Optimize.FlatShading") {
+    // Flat shaded shapes do not share vertices, cache can't do better than 3.0
+    ShapeConfig config{};
+    Torus torus(config, 16u, 16u, 1.f, 0.5f, ValuesRange::ONE_TO_ONE, Shading::FLAT);
+
+    MeshOptimizeOptions options;
+    options.optimizeVertexCache = true;
+
+    MeshOptimizeReport report = torus.optimize(options);
+
+    REQUIRE(report.vertexCacheBefore.acmr == Catch::Approx(3.f));
+    REQUIRE(report.vertexCacheAfter.acmr == Catch::Approx(3.f));
+}
+
+TEST_CASE("ShapesGenerator.MeshOptimizer.VertexFetch.Analyze") {
+    // 16 byte vertices, 4 per cache line
+    std::vector<unsigned int> sequential(64);
+    for (unsigned int i = 0u; i < 64u; ++i) sequential[i] = i;
+
+    VertexFetchStats stats = MeshOptimizer::analyzeVertexFetch(sequential, 64, 16);
+    REQUIRE(stats.bytesFetched == 64ull * 16ull);
+    REQUIRE(stats.overfetch == Catch::Approx(1.f));
+
+    // Every vertex in its own line, far enough to evict previous lines
+    std::vector<unsigned int> scattered;
+    for (unsigned int i = 0u; i < 4u; ++i) {
+        for (unsigned int j = 0u; j < 4096u; j += 4u) scattered.push_back(j + i);
+    }
+
+    stats = MeshOptimizer::analyzeVertexFetch(scattered, 4096, 16);
+    REQUIRE(stats.overfetch == Catch::Approx(4.f));
+}
+
+TEST_CASE("ShapesGenerator.MeshOptimizer.VertexFetch.Optimize.FirstUseOrder") {
+    std::vector<unsigned int> indices = { 4, 2, 0, 0, 2, 5 };
+
+    std::vector<unsigned int> remap = MeshOptimizer::optimizeVertexFetch(indices, 6);
+
+    REQUIRE(indices == std::vector<unsigned int>{ 0, 1, 2, 2, 1, 3 });
+    // Unreferenced vertices 1 and 3 keep their relative order at the end
+    REQUIRE(remap == std::vector<unsigned int>{ 2, 4, 1, 5, 0, 3 });
+}
+
+TEST_CASE("ShapesGenerator.MeshOptimizer.VertexFetch.Optimize.KeepsVertexData") {
+    ShapeConfig config{};
+    IcoSphere ico(config, 3u, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+    IcoSphere reference(config, 3u, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+
+    MeshOptimizeOptions options;
+    options.optimizeVertexCache = true;
+    options.optimizeVertexFetch = true;
+
+    MeshOptimizeReport report = ico.optimize(options);
+
+    REQUIRE(report.vertexFetchOptimized);
+    REQUIRE(report.vertexFetchAfter.overfetch <= report.vertexFetchBefore.overfetch + TEST_EPSILON);
+    REQUIRE(ico.getVerticesCount() == reference.getVerticesCount());
+
+    // Every triangle still references the same positions
+    std::vector<std::array<float, 9>> before, after;
+    auto collect = [](const IcoSphere& s, std::vector<std::array<float, 9>>& out) {
+        const auto& idx = s.getIndices();
+        for (size_t i = 0; i + 2 < idx.size(); i += 3) {
+            std::array<float, 9> t{};
+            for (size_t k = 0; k < 3; ++k) {
+                const glm::vec3 p = s.getVertices()[idx[i + k]].Position;
+                t[k * 3] = p.x; t[k * 3 + 1] = p.y; t[k * 3 + 2] = p.z;
+            }
+            out.push_back(t);
+        }
+        std::sort(out.begin(), out.end());
+    };
+    collect(reference, before);
+    collect(ico, after);
+
+    REQUIRE(before.size() == after.size());
+    for (size_t i = 0; i < before.size(); ++i) {
+        for (size_t k = 0; k < 9; ++k) REQUIRE(before[i][k] == Catch::Approx(after[i][k]).margin(TEST_EPSILON));
+    }
+
+    // First use order
+    unsigned int next = 0u;
+    for (unsigned int idx : ico.getIndices()) {
+        REQUIRE(idx <= next);
+        if (idx == next) ++next;
+    }
+}
+
+
+TEST_CASE("ShapesGenerator.MeshOptimizer.Overdraw.Analyze") {
+    // Two parallel quads facing +Z, the one at z = 0 hides the one at z = -1
+    std::vector<Vertex> vertices;
+    for (const float z : { 0.f, -1.f }) {
+        for (const glm::vec2 p : { glm::vec2(-1.f, -1.f), glm::vec2(1.f, -1.f), glm::vec2(1.f, 1.f), glm::vec2(-1.f, 1.f) }) {
+            Vertex v{};
+            v.Position = glm::vec3(p.x, p.y, z);
+            v.Normal = glm::vec3(0.f, 0.f, 1.f);
+            vertices.push_back(v);
+        }
+    }
+
+    const std::vector<unsigned int> frontToBack = { 0, 1, 2, 0, 2, 3, 4, 5, 6, 4, 6, 7 };
+    const std::vector<unsigned int> backToFront = { 4, 5, 6, 4, 6, 7, 0, 1, 2, 0, 2, 3 };
+
+    OverdrawStats front = MeshOptimizer::analyzeOverdraw(frontToBack, vertices);
+    OverdrawStats back = MeshOptimizer::analyzeOverdraw(backToFront, vertices);
+
+    REQUIRE(front.pixelsCovered == back.pixelsCovered);
+    REQUIRE(front.overdraw == Catch::Approx(1.f).margin(0.01f));
+    REQUIRE(back.overdraw > front.overdraw + 0.1f);
+}
+
+TEST_CASE("ShapesGenerator.MeshOptimizer.Overdraw.Optimize") {
+    ShapeConfig config{};
+    Torus torus(config, 64u, 32u, 1.f, 0.5f, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+
+    torus.optimizeVertexCache();
+    const float cacheOnlyAcmr = torus.getVertexCacheStats().acmr;
+    const OverdrawStats before = torus.getOverdrawStats();
+
+    torus.optimizeOverdraw(1.05f);
+    const OverdrawStats after = torus.getOverdrawStats();
+
+    REQUIRE(after.pixelsCovered == before.pixelsCovered);
+    REQUIRE(after.overdraw <= before.overdraw);
+    // Clusters are split only while they stay close to the threshold
+    REQUIRE(torus.getVertexCacheStats().acmr < cacheOnlyAcmr * 1.2f);
+}
+
+TEST_CASE("ShapesGenerator.MeshOptimizer.Overdraw.Optimize.KeepsTriangles") {
+    ShapeConfig config{};
+    IcoSphere ico(config, 3u, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+
+    const auto before = NormalizedTriangles(ico.getIndices());
+
+    MeshOptimizeOptions options;
+    options.optimizeOverdraw = true;
+    MeshOptimizeReport report = ico.optimize(options);
+
+    REQUIRE(report.overdrawOptimized);
+    // Overdraw pass works on cache optimized order
+    REQUIRE(report.vertexCacheOptimized);
+    REQUIRE(before == NormalizedTriangles(ico.getIndices()));
+}
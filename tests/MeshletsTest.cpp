@@ -0,0 +1,234 @@
+#pragma region PCH
+#include "pch.hpp"
+#pragma endregion
+
+#pragma region STD_LIBS
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <vector>
+#pragma endregion
+
+#pragma region CATCH2_LIB
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#pragma endregion
+
+#pragma region MY_FILES_CORE_LIB
+#include <IcoSphere.hpp>
+#include <Meshlets.hpp>
+#include <Plane.hpp>
+#include <Shape.hpp>
+#include <Torus.hpp>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "Helpers.hpp"
+#pragma endregion
+
+static void CheckMeshlets(const MeshletData& data, std::span<const unsigned int> indices, std::span<const Vertex> vertices)
+{
+    std::vector<unsigned int> rebuilt;
+    rebuilt.reserve(indices.size());
+
+    for (size_t m = 0; m < data.meshlets.size(); ++m) {
+        const Meshlet& meshlet = data.meshlets[m];
+        const MeshletBounds& bounds = data.bounds[m];
+
+        REQUIRE(meshlet.vertexCount <= data.maxVertices);
+        REQUIRE(meshlet.triangleCount <= data.maxTriangles);
+        REQUIRE(meshlet.triangleCount > 0u);
+
+        for (uint32_t t = 0; t < meshlet.triangleCount; ++t) {
+            uint32_t a, b, c;
+            MeshletBuilder::unpackTriangle(data.triangles[meshlet.triangleOffset + t], a, b, c);
+
+            REQUIRE(a < meshlet.vertexCount);
+            REQUIRE(b < meshlet.vertexCount);
+            REQUIRE(c < meshlet.vertexCount);
+
+            rebuilt.push_back(data.vertices[meshlet.vertexOffset + a]);
+            rebuilt.push_back(data.vertices[meshlet.vertexOffset + b]);
+            rebuilt.push_back(data.vertices[meshlet.vertexOffset + c]);
+
+            // Every triangle normal is inside the normal cone
+            if (bounds.coneCutoff < 1.f) {
+                const glm::vec3& pa = vertices[rebuilt[rebuilt.size() - 3]].Position;
+                const glm::vec3& pb = vertices[rebuilt[rebuilt.size() - 2]].Position;
+                const glm::vec3& pc = vertices[rebuilt[rebuilt.size() - 1]].Position;
+                const glm::vec3 n = glm::normalize(glm::cross(pb - pa, pc - pa));
+                REQUIRE(glm::dot(n, bounds.coneAxis) >= std::sqrt(1.f - bounds.coneCutoff * bounds.coneCutoff) - TEST_EPSILON);
+            }
+        }
+
+        // Bounding sphere contains every vertex
+        for (uint32_t v = 0; v < meshlet.vertexCount; ++v) {
+            const glm::vec3& p = vertices[data.vertices[meshlet.vertexOffset + v]].Position;
+            REQUIRE(glm::length(p - bounds.center) <= bounds.radius + TEST_EPSILON);
+        }
+    }
+
+    // Triangles keep index order and winding
+    REQUIRE(std::equal(rebuilt.begin(), rebuilt.end(), indices.begin(), indices.end()));
+}
+
+TEST_CASE("ShapesGenerator.Meshlets.PackTriangle") {
+    uint32_t a, b, c;
+    MeshletBuilder::unpackTriangle(MeshletBuilder::packTriangle(0u, 127u, 255u), a, b, c);
+
+    REQUIRE(a == 0u);
+    REQUIRE(b == 127u);
+    REQUIRE(c == 255u);
+}
+
+TEST_CASE("ShapesGenerator.Meshlets.Build") {
+    ShapeConfig config{};
+    Torus torus(config, 32u, 16u, 1.f, 0.5f, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+    torus.optimizeVertexCache();
+
+    SECTION("Default limits") {
+        MeshletData data = MeshletBuilder::build(torus.getIndices(), torus.getVertices());
+
+        REQUIRE(data.maxVertices == 64u);
+        REQUIRE(data.maxTriangles == 124u);
+        CheckMeshlets(data, torus.getIndices(), torus.getVertices());
+
+        MeshletStats stats = MeshletBuilder::analyze(data);
+        REQUIRE(stats.meshletCount == data.meshlets.size());
+        // Cache optimized order fills meshlets reasonably well
+        REQUIRE(stats.avgTriangles > 62.f);
+        REQUIRE(stats.coneCullable > 0ull);
+    }
+
+    SECTION("Small limits") {
+        MeshletData data = MeshletBuilder::build(torus.getIndices(), torus.getVertices(), 16u, 8u);
+
+        REQUIRE(data.maxVertices == 16u);
+        REQUIRE(data.maxTriangles == 8u);
+        CheckMeshlets(data, torus.getIndices(), torus.getVertices());
+    }
+
+    SECTION("Limits are clamped") {
+        MeshletData data = MeshletBuilder::build(torus.getIndices(), torus.getVertices(), 1000u, 0u);
+
+        REQUIRE(data.maxVertices == MeshletBuilder::MAX_VERTICES);
+        REQUIRE(data.maxTriangles == 1u);
+        REQUIRE(data.meshlets.size() == torus.getIndices().size() / 3);
+    }
+}
+
+TEST_CASE("ShapesGenerator.Meshlets.Export") {
+    ShapeConfig config{};
+    Torus torus(config, 16u, 8u, 1.f, 0.5f, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+
+    REQUIRE(torus.toString(FormatType::CPP_ARRAY_INDICES_STRUCT).find("meshletTriangles") == std::string::npos);
+
+    MeshOptimizeOptions options;
+    options.buildMeshlets = true;
+    MeshOptimizeReport report = torus.optimize(options);
+
+    REQUIRE(report.meshletsBuilt);
+    REQUIRE(report.meshlets.meshletCount == torus.getMeshlets().meshlets.size());
+
+    SECTION("Arrays") {
+        for (FormatType type : { FormatType::CPP_ARRAY_INDICES_STRUCT, FormatType::C_ARRAY_INDICES_STRUCT, FormatType::CPP_ARRAY_INDICES_FLOAT, FormatType::C_ARRAY_INDICES_FLOAT }) {
+            const std::string text = torus.toString(type);
+            REQUIRE(text.find("meshlets") != std::string::npos);
+            REQUIRE(text.find("meshletVertices") != std::string::npos);
+            REQUIRE(text.find("meshletTriangles") != std::string::npos);
+            REQUIRE(text.find("meshletBounds") != std::string::npos);
+        }
+
+        REQUIRE(torus.toString(FormatType::CPP_ARRAY_INDICES_STRUCT).find("struct MeshletBounds") != std::string::npos);
+        REQUIRE(torus.toString(FormatType::CPP_ARRAY_VERTICES_STRUCT).find("meshlets") == std::string::npos);
+    }
+
+    SECTION("Binary") {
+        const std::string data = torus.toString(FormatType::BINARY);
+        const MeshletData& meshlets = torus.getMeshlets();
+
+        REQUIRE(data.compare(0, 4, "SGMB") == 0);
+
+        uint32_t chunkCount = 0u;
+        std::memcpy(&chunkCount, data.data() + 12, sizeof(uint32_t));
+        REQUIRE(chunkCount == 6u);
+
+        // Walk chunks and compare element counts
+        const std::vector<std::pair<std::string, size_t>> expected = {
+            { "VERT", torus.getVerticesCount() },
+            { "INDX", torus.getIndicesCount() },
+            { "MSHL", meshlets.meshlets.size() },
+            { "MSHB", meshlets.bounds.size() },
+            { "MSHV", meshlets.vertices.size() },
+            { "MSHT", meshlets.triangles.size() }
+        };
+
+        size_t offset = 16;
+        for (const auto& [id, count] : expected) {
+            REQUIRE(data.compare(offset, 4, id) == 0);
+
+            uint32_t elements = 0u;
+            uint64_t bytes = 0ull;
+            std::memcpy(&elements, data.data() + offset + 4, sizeof(uint32_t));
+            std::memcpy(&bytes, data.data() + offset + 8, sizeof(uint64_t));
+
+            REQUIRE(elements == count);
+            offset += 16 + bytes;
+        }
+
+        REQUIRE(offset == data.size());
+        REQUIRE(Shape::getFormatFileExtension(FormatType::BINARY) == ".bin");
+    }
+}
+
+TEST_CASE("ShapesGenerator.Meshlets.ClearedByPasses") {
+    ShapeConfig config{};
+    Torus torus(config, 16u, 8u, 1.f, 0.5f, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+
+    torus.buildMeshlets();
+    REQUIRE_FALSE(torus.getMeshlets().empty());
+
+    torus.optimizeVertexFetch();
+    REQUIRE(torus.getMeshlets().empty());
+}
+
+TEST_CASE("ShapesGenerator.Meshlets.Build.LargeIcoSphere") {
+    ShapeConfig config{ false, false, true };
+    IcoSphere ico(config, 7u, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+
+    MeshOptimizeOptions options;
+    options.buildMeshlets = true;
+    MeshOptimizeReport report = ico.optimize(options);
+
+    const MeshletData& data = ico.getMeshlets();
+    size_t triangles = 0;
+    for (const Meshlet& m : data.meshlets) triangles += m.triangleCount;
+
+    REQUIRE(triangles == ico.getIndicesCount() / 3);
+    REQUIRE(report.meshlets.avgVertices <= 64.f);
+}
+TEST_CASE("ShapesGenerator.Meshlets.IcoSphere.MaxSubdivisions") {
+    // Batch and CLI clamp matches the index type check of the constructor
+    for (Shading shading : { Shading::FLAT, Shading::SMOOTH }) {
+        REQUIRE(IcoSphere::getMeshCounts(IcoSphere::MAX_SUBDIVISIONS, ValuesRange::ONE_TO_ONE, shading).fitsIndexType());
+        REQUIRE_FALSE(IcoSphere::getMeshCounts(IcoSphere::MAX_SUBDIVISIONS + 1u, ValuesRange::ONE_TO_ONE, shading).fitsIndexType());
+    }
+}
+
+// About 21M triangles and a few GB of memory, run with "[long]" tag
+TEST_CASE("ShapesGenerator.Meshlets.Build.IcoSphereLevel10", "[.][long]") {
+    ShapeConfig config{ false, false, true };
+    IcoSphere ico(config, 10u, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+    REQUIRE(ico.getIndicesCount() == IcoSphere::getMeshCounts(10u, ValuesRange::ONE_TO_ONE, Shading::SMOOTH).indices);
+
+    ico.optimizeVertexCache();
+    MeshletData data = MeshletBuilder::build(ico.getIndices(), ico.getVertices());
+    CheckMeshlets(data, ico.getIndices(), ico.getVertices());
+
+    MeshletStats stats = MeshletBuilder::analyze(data);
+    REQUIRE(stats.meshletCount == data.meshlets.size());
+    REQUIRE(stats.avgVertices <= 64.f);
+}
@@ -13,6 +13,7 @@
 
 #pragma region MY_FILES_CORE_LIB
 #include <Plane.hpp>
+#include <ProgressToken.hpp>
 #include <Shape.hpp>
 #include <Vertex.hpp>
 #pragma endregion
@@ -24,8 +25,8 @@
 class TestablePlane : public Plane {
 public:
     using Plane::Plane;
-    const std::vector<Vertex>& getVertices() const { return _vertices; }
-    const std::vector<unsigned int>& getIndices() const { return _indices; }
+    const std::pmr::vector<Vertex>& getVertices() const { return _vertices; }
+    const std::pmr::vector<unsigned int>& getIndices() const { return _indices; }
 };
 
 TEST_CASE("ShapesGenerator.Plane.Minimal.Valid") {
@@ -271,4 +272,53 @@ TEST_CASE("ShapesGenerator.Plane.Generation(R[3]C[3].FRONT.TBP)") {
     for (size_t idx = 0; idx < i.size(); ++idx) {
         REQUIRE(i[idx] == expectedIndices[idx]);
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("ShapesGenerator.Plane.LargeGrid.RowBands") {
+    // Many bands of rows, every vertex and quad is checked against its place in the grid
+    constexpr unsigned int rows = 300u;
+    constexpr unsigned int columns = 257u;
+
+    ShapeConfig config{};
+    TestablePlane plane(config, rows, columns, PlaneNormalDir::UP, ValuesRange::ONE_TO_ONE);
+
+    const auto& v = plane.getVertices();
+    const auto& i = plane.getIndices();
+    REQUIRE(v.size() == Plane::getMeshCounts(rows, columns).vertices);
+    REQUIRE(i.size() == Plane::getMeshCounts(rows, columns).indices);
+
+    for (unsigned int row = 0u; row < rows; ++row) {
+        for (unsigned int col = 0u; col < columns; ++col) {
+            const size_t idx = (size_t)row * columns + col;
+            const glm::vec3 expected(-1.f + 2.f * (float)col / (float)(columns - 1u), 0.f, -1.f + 2.f * (float)row / (float)(rows - 1u));
+            CheckVec3Equal(v[idx].Position, expected, TEST_EPSILON, "Position", idx);
+            CheckVec3Equal(v[idx].Tangent, glm::vec3(1.f, 0.f, 0.f), TEST_EPSILON, "Tangent", idx);
+        }
+    }
+
+    for (unsigned int row = 0u; row + 1u < rows; ++row) {
+        for (unsigned int col = 0u; col + 1u < columns; ++col) {
+            const size_t quad = 6ull * ((size_t)row * (columns - 1u) + col);
+            const unsigned int first = row * columns + col;
+            REQUIRE(i[quad] == first + columns);
+            REQUIRE(i[quad + 1ull] == first + 1u);
+            REQUIRE(i[quad + 2ull] == first);
+            REQUIRE(i[quad + 3ull] == first + columns);
+            REQUIRE(i[quad + 4ull] == first + columns + 1u);
+            REQUIRE(i[quad + 5ull] == first + 1u);
+        }
+    }
+}
+
+TEST_CASE("ShapesGenerator.Plane.LargeGrid.Cancel") {
+    ProgressToken progress;
+    progress.cancel();
+
+    ShapeConfig config{};
+    config.progress = &progress;
+    TestablePlane plane(config, 300u, 257u, PlaneNormalDir::UP, ValuesRange::ONE_TO_ONE);
+
+    REQUIRE(plane.isCancelled());
+    REQUIRE(plane.getVertices().empty());
+    REQUIRE(plane.getIndices().empty());
+}
@@ -0,0 +1,131 @@
+#pragma region PCH
+#include "pch.hpp"
+#pragma endregion
+
+#pragma region STD_LIBS
+#include <cstring>
+#include <string>
+#pragma endregion
+
+#pragma region CATCH2_LIB
+#include <catch2/catch_test_macros.hpp>
+#pragma endregion
+
+#pragma region MY_FILES_CORE_LIB
+#include <Cone.hpp>
+#include <Cylinder.hpp>
+#include <Hexagon.hpp>
+#include <IcoSphere.hpp>
+#include <Plane.hpp>
+#include <ProgressToken.hpp>
+#include <Shape.hpp>
+#include <Sphere.hpp>
+#include <Torus.hpp>
+#include <Vertex.hpp>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "Helpers.hpp"
+#pragma endregion
+
+template<class ShapeType, class... Args>
+static void CheckCancelled(const Args&... args)
+{
+    for (bool genTangents : { true, false }) {
+        ProgressToken progress;
+        progress.cancel();
+
+        ShapeConfig config{};
+        config.genTangents = genTangents;
+        config.progress = &progress;
+
+        ShapeType shape(config, args...);
+
+        INFO(ShapeType::getClassName());
+        REQUIRE(shape.isCancelled());
+        REQUIRE(shape.getVerticesCount() == 0);
+        REQUIRE(shape.getIndicesCount() == 0);
+        REQUIRE(shape.getVertices().capacity() == 0);
+        REQUIRE(shape.getIndices().capacity() == 0);
+    }
+}
+
+TEST_CASE("ShapesGenerator.ProgressToken.Report") {
+    ProgressToken progress;
+    REQUIRE(std::string(progress.getPhase()).empty());
+    REQUIRE(progress.getProgress() == 0.f);
+
+    REQUIRE_FALSE(progress.report("vertex generation", 1, 4));
+    REQUIRE(std::string(progress.getPhase()) == "vertex generation");
+    REQUIRE(progress.getProgress() == .25f);
+
+    // Empty phase is done, fraction never goes over one
+    progress.report("dedup", 0, 0);
+    REQUIRE(progress.getProgress() == 1.f);
+    progress.report("dedup", 5, 4);
+    REQUIRE(progress.getProgress() == 1.f);
+
+    progress.cancel();
+    REQUIRE(progress.isCancelled());
+    REQUIRE(progress.report("dedup", 1, 4));
+
+    progress.reset();
+    REQUIRE_FALSE(progress.isCancelled());
+    REQUIRE(std::string(progress.getPhase()).empty());
+    REQUIRE(progress.getProgress() == 0.f);
+}
+
+TEST_CASE("ShapesGenerator.ProgressToken.CancelGeneration") {
+    CheckCancelled<Plane>(16u, 24u, PlaneNormalDir::UP, ValuesRange::HALF_TO_HALF);
+    CheckCancelled<Cylinder>(4u, 12u, ValuesRange::HALF_TO_HALF, Shading::SMOOTH);
+    CheckCancelled<Cylinder>(4u, 12u, ValuesRange::HALF_TO_HALF, Shading::FLAT);
+    CheckCancelled<Cone>(12u, 1.f, 1.f, ValuesRange::HALF_TO_HALF, Shading::SMOOTH);
+    CheckCancelled<Sphere>(8u, 12u, ValuesRange::HALF_TO_HALF, Shading::SMOOTH);
+    CheckCancelled<Sphere>(8u, 12u, ValuesRange::HALF_TO_HALF, Shading::FLAT);
+    CheckCancelled<IcoSphere>(3u, ValuesRange::HALF_TO_HALF, Shading::SMOOTH);
+    CheckCancelled<IcoSphere>(3u, ValuesRange::HALF_TO_HALF, Shading::FLAT);
+    CheckCancelled<Torus>(12u, 8u, 1.f, .5f, ValuesRange::HALF_TO_HALF, Shading::SMOOTH);
+    CheckCancelled<Torus>(12u, 8u, 1.f, .5f, ValuesRange::HALF_TO_HALF, Shading::FLAT);
+    CheckCancelled<Hexagon>(4u, ValuesRange::HALF_TO_HALF);
+}
+
+TEST_CASE("ShapesGenerator.ProgressToken.SameShape") {
+    ProgressToken progress;
+    ShapeConfig config{};
+    Torus reference(config, 24u, 12u, 1.f, .5f, ValuesRange::HALF_TO_HALF, Shading::SMOOTH);
+
+    config.progress = &progress;
+    Torus torus(config, 24u, 12u, 1.f, .5f, ValuesRange::HALF_TO_HALF, Shading::SMOOTH);
+
+    REQUIRE_FALSE(torus.isCancelled());
+    REQUIRE(torus.getIndices() == reference.getIndices());
+    REQUIRE(torus.getVerticesCount() == reference.getVerticesCount());
+    REQUIRE(std::memcmp(torus.getVertices().data(), reference.getVertices().data(), torus.getVerticesCount() * sizeof(Vertex)) == 0);
+
+    // Tangents are the last phase
+    REQUIRE(std::string(progress.getPhase()) == "tangent normalisation");
+    REQUIRE(progress.getProgress() == 1.f);
+
+    for (FormatType format : { FormatType::CPP_ARRAY_INDICES_STRUCT, FormatType::C_ARRAY_VERTICES_FLOAT, FormatType::JSON_INDICES,
+        FormatType::OBJ, FormatType::BINARY, FormatType::CPP_ARRAY_STRIP_STRUCT }) {
+        INFO(static_cast<int>(format));
+        REQUIRE(reference.toString(format, nullptr, &progress) == reference.toString(format));
+    }
+}
+
+TEST_CASE("ShapesGenerator.ProgressToken.CancelExport") {
+    ShapeConfig config{};
+    Sphere sphere(config, 8u, 12u, ValuesRange::HALF_TO_HALF, Shading::FLAT);
+
+    ProgressToken progress;
+    progress.cancel();
+
+    for (int format = static_cast<int>(FormatType::CPP_ARRAY_INDICES_STRUCT); format <= static_cast<int>(FormatType::BINARY_STRIP); ++format) {
+        INFO(format);
+        REQUIRE(sphere.toString(static_cast<FormatType>(format), nullptr, &progress).empty());
+    }
+
+    // Shape itself isn't changed by cancelled export
+    REQUIRE(sphere.getVerticesCount() > 0);
+    REQUIRE_FALSE(sphere.toString(FormatType::OBJ).empty());
+}
\ No newline at end of file
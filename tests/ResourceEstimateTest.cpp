@@ -0,0 +1,122 @@
+#pragma region PCH
+#include "pch.hpp"
+#pragma endregion
+
+#pragma region STD_LIBS
+#include <string>
+#pragma endregion
+
+#pragma region CATCH2_LIB
+#include <catch2/catch_test_macros.hpp>
+#pragma endregion
+
+#pragma region MY_FILES_CORE_LIB
+#include <ExportPipeline.hpp>
+#include <IcoSphere.hpp>
+#include <Plane.hpp>
+#include <ResourceEstimate.hpp>
+#include <Shape.hpp>
+#include <Sphere.hpp>
+#include <Torus.hpp>
+#include <Vertex.hpp>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "Helpers.hpp"
+#pragma endregion
+
+TEST_CASE("ShapesGenerator.ResourceEstimate.Generation") {
+    ShapeConfig config{};
+    Torus torus(config, 24u, 12u, 1.f, .5f, ValuesRange::HALF_TO_HALF, Shading::FLAT);
+
+    const ResourceEstimate estimate = ResourceEstimator::estimateGeneration(Torus::getMeshCounts(24u, 12u, 1.f, .5f, ValuesRange::HALF_TO_HALF, Shading::FLAT));
+    REQUIRE(estimate.counts.vertices == torus.getVerticesCount());
+    REQUIRE(estimate.counts.indices == torus.getIndicesCount());
+    REQUIRE(estimate.meshBytes == torus.getVerticesCount() * sizeof(Vertex) + torus.getIndicesCount() * sizeof(unsigned int));
+    REQUIRE(estimate.peakBytes > estimate.meshBytes);
+}
+
+TEST_CASE("ShapesGenerator.ResourceEstimate.BinaryIsExact") {
+    for (bool genTangents : { true, false }) {
+        for (bool calcBitangents : { true, false }) {
+            ShapeConfig config{};
+            config.genTangents = genTangents;
+            config.calcBitangents = calcBitangents;
+
+            Sphere sphere(config, 8u, 12u, ValuesRange::HALF_TO_HALF, Shading::SMOOTH);
+            const MeshCounts counts = Sphere::getMeshCounts(8u, 12u, ValuesRange::HALF_TO_HALF, Shading::SMOOTH);
+
+            INFO(genTangents << " " << calcBitangents);
+            REQUIRE(ResourceEstimator::estimateExport(counts, FormatType::BINARY, config).fileBytes == sphere.toString(FormatType::BINARY).size());
+            // Strips are estimated with the worst case
+            REQUIRE(ResourceEstimator::estimateExport(counts, FormatType::BINARY_STRIP, config).fileBytes >= sphere.toString(FormatType::BINARY_STRIP).size());
+        }
+    }
+}
+
+TEST_CASE("ShapesGenerator.ResourceEstimate.Streamed") {
+    ShapeConfig config{};
+    const MeshCounts counts = Plane::getMeshCounts(2000u, 2000u);
+    const size_t meshBytes = ResourceEstimator::estimateGeneration(counts).meshBytes;
+
+    // Saving binary holds chunks in flight, not the whole file
+    const ExportEstimate binary = ResourceEstimator::estimateExport(counts, FormatType::BINARY, config);
+    REQUIRE(binary.peakBytes == meshBytes + ExportPipeline::getChunksInFlight() * Shape::SAVE_CHUNK_VERTICES * Shape::getVertexStride(config));
+    REQUIRE(binary.peakBytes < meshBytes + binary.fileBytes);
+
+    // Small file is never exceeded
+    const MeshCounts small = Plane::getMeshCounts(4u, 4u);
+    const ExportEstimate smallBinary = ResourceEstimator::estimateExport(small, FormatType::BINARY, config);
+    REQUIRE(smallBinary.peakBytes == ResourceEstimator::estimateGeneration(small).meshBytes + smallBinary.fileBytes);
+
+    // Strips are saved in chunks too, strip and stripifier memory are held besides them
+    const ExportEstimate strip = ResourceEstimator::estimateExport(counts, FormatType::BINARY_STRIP, config);
+    REQUIRE(strip.peakBytes > binary.peakBytes);
+    REQUIRE(strip.peakBytes < meshBytes + 2ull * strip.fileBytes);
+
+    for (FormatType format : { FormatType::CPP_ARRAY_INDICES_STRUCT, FormatType::C_ARRAY_VERTICES_FLOAT, FormatType::C_ARRAY_STRIP_FLOAT }) {
+        const ExportEstimate text = ResourceEstimator::estimateExport(counts, format, config);
+        INFO(static_cast<int>(format));
+        REQUIRE(text.peakBytes < meshBytes + text.fileBytes);
+    }
+
+    // OBJ and JSON hold the whole text
+    const ExportEstimate obj = ResourceEstimator::estimateExport(counts, FormatType::OBJ, config);
+    REQUIRE(obj.peakBytes >= meshBytes + 2ull * obj.fileBytes);
+}
+
+TEST_CASE("ShapesGenerator.ResourceEstimate.TextFormats") {
+    ShapeConfig config{};
+    IcoSphere ico(config, 3u, ValuesRange::HALF_TO_HALF, Shading::SMOOTH);
+    const MeshCounts counts = IcoSphere::getMeshCounts(3u, ValuesRange::HALF_TO_HALF, Shading::SMOOTH);
+
+    // Text estimates assume average number length, they only have to be in the right range
+    for (FormatType format : { FormatType::CPP_ARRAY_INDICES_STRUCT, FormatType::C_ARRAY_VERTICES_FLOAT, FormatType::JSON_INDICES, FormatType::OBJ }) {
+        const ExportEstimate estimate = ResourceEstimator::estimateExport(counts, format, config);
+        const size_t actual = ico.toString(format).size();
+
+        INFO(static_cast<int>(format) << ": " << estimate.fileBytes << " / " << actual);
+        REQUIRE(estimate.fileBytes * 3ull >= actual);
+        REQUIRE(estimate.fileBytes <= actual * 3ull);
+        REQUIRE(estimate.peakBytes >= estimate.fileBytes + ico.getVerticesCount() * sizeof(Vertex));
+    }
+}
+
+TEST_CASE("ShapesGenerator.ResourceEstimate.Budget") {
+    REQUIRE(ResourceEstimator::fitsBudget(ResourceEstimator::BYTES_IN_MB, 1u));
+    REQUIRE_FALSE(ResourceEstimator::fitsBudget(ResourceEstimator::BYTES_IN_MB + 1ull, 1u));
+    // Zero is unlimited
+    REQUIRE(ResourceEstimator::fitsBudget(~0ull, 0u));
+
+    // Large grid goes over budget before anything is generated
+    const MeshCounts counts = Plane::getMeshCounts(20000u, 20000u);
+    REQUIRE_FALSE(ResourceEstimator::fitsBudget(ResourceEstimator::estimateGeneration(counts).peakBytes, 4096u));
+    REQUIRE(ResourceEstimator::estimatePeak(counts, FormatType::BINARY, ShapeConfig{}) >= ResourceEstimator::estimateGeneration(counts).peakBytes);
+}
+
+TEST_CASE("ShapesGenerator.ResourceEstimate.FormatBytes") {
+    REQUIRE(ResourceEstimator::formatBytes(0ull) == "0 B");
+    REQUIRE(ResourceEstimator::formatBytes(1023ull) == "1023 B");
+    REQUIRE(ResourceEstimator::formatBytes(1536ull) == "1.5 KB");
+    REQUIRE(ResourceEstimator::formatBytes(3ull * ResourceEstimator::BYTES_IN_MB) == "3.0 MB");
+}
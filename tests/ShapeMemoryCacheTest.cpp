@@ -0,0 +1,104 @@
+#pragma region PCH
+#include "pch.hpp"
+#pragma endregion
+
+#pragma region STD_LIBS
+#include <memory>
+#include <string>
+#pragma endregion
+
+#pragma region CATCH2_LIB
+#include <catch2/catch_test_macros.hpp>
+#pragma endregion
+
+#pragma region MY_FILES_CORE_LIB
+#include <Plane.hpp>
+#include <Shape.hpp>
+#include <ShapeMemoryCache.hpp>
+#include <Torus.hpp>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "Helpers.hpp"
+#pragma endregion
+
+static std::shared_ptr<Shape> MakePlane(const ValuesRange range = ValuesRange::ONE_TO_ONE)
+{
+    ShapeConfig config{};
+    return std::make_shared<Plane>(config, 8u, 8u, PlaneNormalDir::UP, range);
+}
+
+TEST_CASE("ShapesGenerator.ShapeMemoryCache.FindInsert") {
+    ShapeMemoryCache cache;
+    std::shared_ptr<Shape> plane = MakePlane();
+
+    REQUIRE_FALSE(cache.find("plane").has_value());
+
+    cache.insert("plane", plane, { { "Reordered", "yes" } });
+    auto entry = cache.find("plane");
+
+    REQUIRE(entry.has_value());
+    REQUIRE(entry->shape == plane);
+    REQUIRE(entry->details.size() == 1);
+    REQUIRE(entry->details[0].second == "yes");
+    REQUIRE(cache.getCount() == 1);
+    REQUIRE(cache.getSize() == plane->getMemorySize());
+
+    // Same key replaces previous entry
+    cache.insert("plane", MakePlane(ValuesRange::HALF_TO_HALF));
+    REQUIRE(cache.getCount() == 1);
+    REQUIRE(cache.find("plane")->shape != plane);
+
+    cache.erase("plane");
+    REQUIRE(cache.getCount() == 0);
+    REQUIRE(cache.getSize() == 0);
+}
+
+TEST_CASE("ShapesGenerator.ShapeMemoryCache.Eviction") {
+    const size_t entrySize = MakePlane()->getMemorySize();
+    ShapeMemoryCache cache(entrySize * 2 + entrySize / 2);
+
+    std::shared_ptr<Shape> first = MakePlane();
+    cache.insert("first", first);
+    cache.insert("second", MakePlane());
+    // Use makes first entry the most recent one
+    REQUIRE(cache.find("first").has_value());
+    cache.insert("third", MakePlane());
+
+    REQUIRE(cache.getCount() == 2);
+    REQUIRE(cache.getSize() <= cache.getMaxSize());
+    REQUIRE(cache.find("first").has_value());
+    REQUIRE(cache.find("third").has_value());
+    REQUIRE_FALSE(cache.find("second").has_value());
+
+    // Evicted shape stays valid for its holder
+    cache.clear();
+    REQUIRE(first.use_count() == 1);
+    REQUIRE(first->getVerticesCount() > 0);
+}
+
+TEST_CASE("ShapesGenerator.ShapeMemoryCache.Oversized") {
+    std::shared_ptr<Shape> plane = MakePlane();
+    ShapeMemoryCache cache(plane->getMemorySize() - 1);
+
+    cache.insert("plane", plane);
+
+    REQUIRE(cache.getCount() == 0);
+    REQUIRE(cache.getSize() == 0);
+    REQUIRE_FALSE(cache.find("plane").has_value());
+}
+
+TEST_CASE("ShapesGenerator.ShapeMemoryCache.MemorySize") {
+    ShapeConfig config{};
+    Torus torus(config, 32u, 16u, 1.f, 0.5f, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+
+    const size_t baseSize = torus.getMemorySize();
+    REQUIRE(baseSize >= torus.getVerticesCount() * sizeof(Vertex) + torus.getIndicesCount() * sizeof(unsigned int));
+
+    torus.buildMeshlets();
+    const size_t meshletsSize = torus.getMemorySize();
+    REQUIRE(meshletsSize > baseSize);
+
+    torus.generateLods();
+    REQUIRE(torus.getMemorySize() > meshletsSize);
+}
\ No newline at end of file
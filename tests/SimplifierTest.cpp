@@ -0,0 +1,248 @@
+#pragma region PCH
+#include "pch.hpp"
+#pragma endregion
+
+#pragma region STD_LIBS
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#pragma endregion
+
+#pragma region CATCH2_LIB
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#pragma endregion
+
+#pragma region MY_FILES_CORE_LIB
+#include <Plane.hpp>
+#include <Shape.hpp>
+#include <Simplifier.hpp>
+#include <Sphere.hpp>
+#include <Torus.hpp>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "Helpers.hpp"
+#pragma endregion
+
+// Edges without a twin when vertices are compared by position only
+static std::vector<std::pair<unsigned int, unsigned int>> OpenPositionEdges(std::span<const unsigned int> indices, const size_t offset, const size_t count, std::span<const Vertex> vertices)
+{
+    std::unordered_map<glm::vec3, unsigned int, Vec3Hash, Vec3Equal> firstVertex;
+    std::vector<unsigned int> remap(vertices.size());
+    for (unsigned int i = 0u; i < (unsigned int)vertices.size(); ++i) {
+        remap[i] = firstVertex.try_emplace(vertices[i].Position, i).first->second;
+    }
+
+    std::map<std::pair<unsigned int, unsigned int>, int> edges;
+    for (size_t i = offset; i < offset + count; i += 3) {
+        for (size_t k = 0; k < 3; ++k) {
+            ++edges[{ remap[indices[i + k]], remap[indices[i + (k + 1) % 3]] }];
+        }
+    }
+
+    std::vector<std::pair<unsigned int, unsigned int>> open;
+    for (const auto& [edge, uses] : edges) {
+        if (edges.find({ edge.second, edge.first }) == edges.end()) open.push_back(edge);
+    }
+    return open;
+}
+
+TEST_CASE("ShapesGenerator.Simplifier.Simplify.ReachesTarget") {
+    ShapeConfig config{};
+    Torus torus(config, 32u, 16u, 1.f, 0.5f, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+
+    const size_t target = torus.getIndices().size() / 4;
+    float error = -1.f;
+    std::vector<unsigned int> result = Simplifier::simplify(torus.getIndices(), torus.getVertices(), target, 1.f, &error);
+
+    REQUIRE(result.size() % 3 == 0);
+    REQUIRE(result.size() <= target);
+    REQUIRE(result.size() > target / 2);
+    REQUIRE(error > 0.f);
+    REQUIRE(error < 0.05f);
+
+    for (unsigned int idx : result) REQUIRE(idx < torus.getVerticesCount());
+}
+
+TEST_CASE("ShapesGenerator.Simplifier.Simplify.ErrorLimit") {
+    ShapeConfig config{};
+    Torus torus(config, 32u, 16u, 1.f, 0.5f, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+
+    float error = -1.f;
+    std::vector<unsigned int> result = Simplifier::simplify(torus.getIndices(), torus.getVertices(), 0, 0.001f, &error);
+
+    // Curved surface can't lose many triangles within tight error
+    REQUIRE(error <= 0.001f);
+    REQUIRE(result.size() > torus.getIndices().size() / 2);
+}
+
+TEST_CASE("ShapesGenerator.Simplifier.Simplify.KeepsSeams") {
+    ShapeConfig config{};
+
+    SECTION("Torus") {
+        // UV seams in both directions, closed surface has to stay closed
+        Torus torus(config, 32u, 16u, 1.f, 0.5f, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+        std::vector<unsigned int> result = Simplifier::simplify(torus.getIndices(), torus.getVertices(), torus.getIndices().size() / 8);
+
+        REQUIRE(result.size() < torus.getIndices().size() / 4);
+        REQUIRE(OpenPositionEdges(result, 0, result.size(), torus.getVertices()).empty());
+    }
+
+    SECTION("Sphere") {
+        Sphere sphere(config, 16u, 32u, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+        std::vector<unsigned int> result = Simplifier::simplify(sphere.getIndices(), sphere.getVertices(), sphere.getIndices().size() / 4);
+
+        REQUIRE(result.size() < sphere.getIndices().size() / 2);
+        REQUIRE(OpenPositionEdges(result, 0, result.size(), sphere.getVertices()).empty());
+    }
+}
+
+TEST_CASE("ShapesGenerator.Simplifier.Simplify.KeepsBorder") {
+    ShapeConfig config{};
+    Plane plane(config, 32u, 32u, PlaneNormalDir::UP, ValuesRange::ONE_TO_ONE);
+
+    std::vector<unsigned int> result = Simplifier::simplify(plane.getIndices(), plane.getVertices(), plane.getIndices().size() / 8);
+
+    // Flat plane simplifies without error and keeps its outline
+    auto perimeter = [&plane](const std::vector<std::pair<unsigned int, unsigned int>>& edges) {
+        float length = 0.f;
+        for (const auto& [a, b] : edges) length += glm::length(plane.getVertices()[a].Position - plane.getVertices()[b].Position);
+        return length;
+    };
+
+    REQUIRE(result.size() <= plane.getIndices().size() / 8);
+    REQUIRE(perimeter(OpenPositionEdges(result, 0, result.size(), plane.getVertices())) == Catch::Approx(8.f).margin(TEST_EPSILON));
+}
+
+TEST_CASE("ShapesGenerator.Simplifier.Simplify.FlatShadingIsLocked") {
+    // Every vertex has an attribute set per face, so nothing can be collapsed
+    ShapeConfig config{};
+    Torus torus(config, 16u, 8u, 1.f, 0.5f, ValuesRange::ONE_TO_ONE, Shading::FLAT);
+
+    std::vector<unsigned int> result = Simplifier::simplify(torus.getIndices(), torus.getVertices(), 0);
+    REQUIRE(std::equal(result.begin(), result.end(), torus.getIndices().begin(), torus.getIndices().end()));
+}
+
+TEST_CASE("ShapesGenerator.Simplifier.LodChain") {
+    ShapeConfig config{};
+    Torus torus(config, 32u, 16u, 1.f, 0.5f, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+
+    MeshOptimizeOptions options;
+    options.generateLods = true;
+    options.lodLevels = 3u;
+    options.lodReduction = 0.5f;
+    MeshOptimizeReport report = torus.optimize(options);
+
+    const LodChain& chain = torus.getLods();
+
+    REQUIRE(report.lodsGenerated);
+    REQUIRE(report.lods.size() == 4);
+    REQUIRE(chain.levels.size() == 4);
+
+    // LOD 0 is the shape itself
+    REQUIRE(chain.levels[0].indexOffset == 0u);
+    REQUIRE(chain.levels[0].indexCount == torus.getIndicesCount());
+    REQUIRE(chain.levels[0].error == 0.f);
+
+    for (size_t i = 1; i < chain.levels.size(); ++i) {
+        const LodLevel& level = chain.levels[i];
+        const LodLevel& previous = chain.levels[i - 1];
+
+        REQUIRE(level.indexOffset == previous.indexOffset + previous.indexCount);
+        REQUIRE(level.indexCount < previous.indexCount);
+        REQUIRE(level.targetRatio == Catch::Approx(previous.targetRatio * 0.5f));
+        REQUIRE(level.error >= previous.error);
+        REQUIRE(level.absoluteError >= previous.absoluteError);
+        REQUIRE(OpenPositionEdges(chain.indices, level.indexOffset, level.indexCount, torus.getVertices()).empty());
+    }
+
+    REQUIRE(chain.indices.size() == (size_t)chain.levels.back().indexOffset + chain.levels.back().indexCount);
+}
+
+TEST_CASE("ShapesGenerator.Simplifier.Export") {
+    ShapeConfig config{};
+    Torus torus(config, 16u, 8u, 1.f, 0.5f, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+
+    REQUIRE(torus.toString(FormatType::JSON_INDICES).find("lodIndices") == std::string::npos);
+
+    torus.generateLods(2u, 0.5f);
+    const LodChain& chain = torus.getLods();
+    REQUIRE(chain.levels.size() == 3);
+
+    SECTION("Arrays") {
+        for (FormatType type : { FormatType::CPP_ARRAY_INDICES_STRUCT, FormatType::C_ARRAY_INDICES_STRUCT, FormatType::CPP_ARRAY_INDICES_FLOAT, FormatType::C_ARRAY_INDICES_FLOAT }) {
+            const std::string text = torus.toString(type);
+            REQUIRE(text.find("lods") != std::string::npos);
+            REQUIRE(text.find("lodIndices") != std::string::npos);
+        }
+
+        REQUIRE(torus.toString(FormatType::C_ARRAY_INDICES_STRUCT).find("} Lod;") != std::string::npos);
+        REQUIRE(torus.toString(FormatType::CPP_ARRAY_INDICES_FLOAT).find("lodErrors") != std::string::npos);
+        REQUIRE(torus.toString(FormatType::CPP_ARRAY_VERTICES_STRUCT).find("lods") == std::string::npos);
+    }
+
+    SECTION("JSON") {
+        const std::string text = torus.toString(FormatType::JSON_INDICES);
+        REQUIRE(text.find("\"lods\"") != std::string::npos);
+        REQUIRE(text.find("\"lodIndices\"") != std::string::npos);
+        REQUIRE(torus.toString(FormatType::JSON_VERTICES).find("lodIndices") == std::string::npos);
+    }
+
+    SECTION("OBJ") {
+        const std::string text = torus.toString(FormatType::OBJ);
+        REQUIRE(text.find("o Torus_LOD1\n") != std::string::npos);
+        REQUIRE(text.find("o Torus_LOD2\n") != std::string::npos);
+
+        size_t faces = 0;
+        for (size_t pos = text.find("\nf "); pos != std::string::npos; pos = text.find("\nf ", pos + 1)) ++faces;
+        REQUIRE(faces == chain.indices.size() / 3);
+    }
+
+    SECTION("Binary") {
+        const std::string data = torus.toString(FormatType::BINARY);
+
+        uint32_t chunkCount = 0u;
+        std::memcpy(&chunkCount, data.data() + 12, sizeof(uint32_t));
+        REQUIRE(chunkCount == 4u);
+
+        const std::vector<std::pair<std::string, size_t>> expected = {
+            { "VERT", torus.getVerticesCount() },
+            { "INDX", torus.getIndicesCount() },
+            { "LODS", chain.levels.size() },
+            { "LODI", chain.indices.size() }
+        };
+
+        size_t offset = 16;
+        for (const auto& [id, count] : expected) {
+            REQUIRE(data.compare(offset, 4, id) == 0);
+
+            uint32_t elements = 0u;
+            uint64_t bytes = 0ull;
+            std::memcpy(&elements, data.data() + offset + 4, sizeof(uint32_t));
+            std::memcpy(&bytes, data.data() + offset + 8, sizeof(uint64_t));
+
+            REQUIRE(elements == count);
+            offset += 16 + bytes;
+        }
+
+        REQUIRE(offset == data.size());
+    }
+}
+
+TEST_CASE("ShapesGenerator.Simplifier.ClearedByPasses") {
+    ShapeConfig config{};
+    Torus torus(config, 16u, 8u, 1.f, 0.5f, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+
+    torus.generateLods();
+    REQUIRE_FALSE(torus.getLods().empty());
+
+    torus.optimizeVertexCache();
+    REQUIRE(torus.getLods().empty());
+}
\ No newline at end of file
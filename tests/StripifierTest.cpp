@@ -0,0 +1,154 @@
+#pragma region PCH
+#include "pch.hpp"
+#pragma endregion
+
+#pragma region STD_LIBS
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <vector>
+#pragma endregion
+
+#pragma region CATCH2_LIB
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#pragma endregion
+
+#pragma region MY_FILES_CORE_LIB
+#include <IcoSphere.hpp>
+#include <Plane.hpp>
+#include <Shape.hpp>
+#include <Sphere.hpp>
+#include <Stripifier.hpp>
+#include <Torus.hpp>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "Helpers.hpp"
+#pragma endregion
+
+// Triangles rotated so that the smallest index is first (winding preserved)
+static std::vector<std::array<unsigned int, 3>> SortedTriangles(std::span<const unsigned int> indices)
+{
+    std::vector<std::array<unsigned int, 3>> tris;
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        std::array<unsigned int, 3> t = { indices[i], indices[i + 1], indices[i + 2] };
+        while (t[0] != std::min({ t[0], t[1], t[2] })) {
+            std::rotate(t.begin(), t.begin() + 1, t.end());
+        }
+        tris.push_back(t);
+    }
+    std::sort(tris.begin(), tris.end());
+    return tris;
+}
+
+TEST_CASE("ShapesGenerator.Stripifier.Quad") {
+    // Two triangles sharing edge 1 - 2
+    const std::vector<unsigned int> indices = { 0, 1, 2, 2, 1, 3 };
+
+    StripStats stats;
+    std::vector<unsigned int> strip = Stripifier::stripify(indices, 4, true, &stats);
+
+    REQUIRE(strip.size() == 4);
+    REQUIRE(stats.stripCount == 1);
+    REQUIRE(SortedTriangles(Stripifier::unstripify(strip)) == SortedTriangles(indices));
+}
+
+TEST_CASE("ShapesGenerator.Stripifier.Unstripify") {
+    SECTION("Primitive restart") {
+        const std::vector<unsigned int> strip = { 0, 1, 2, 3, Stripifier::RESTART_INDEX, 4, 5, 6 };
+        REQUIRE(Stripifier::unstripify(strip, true) == std::vector<unsigned int>{ 0, 1, 2, 2, 1, 3, 4, 5, 6 });
+    }
+
+    SECTION("Degenerate triangles") {
+        const std::vector<unsigned int> strip = { 0, 1, 2, 3, 3, 4, 4, 5, 6 };
+        REQUIRE(Stripifier::unstripify(strip, false) == std::vector<unsigned int>{ 0, 1, 2, 2, 1, 3, 4, 5, 6 });
+    }
+}
+
+TEST_CASE("ShapesGenerator.Stripifier.KeepsTriangles") {
+    ShapeConfig config{};
+    Torus smooth(config, 32u, 16u, 1.f, 0.5f, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+    Torus flat(config, 16u, 8u, 1.f, 0.5f, ValuesRange::ONE_TO_ONE, Shading::FLAT);
+    IcoSphere ico(config, 3u, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+
+    for (const bool restart : { true, false }) {
+        for (const std::pmr::vector<unsigned int>* indices : { &smooth.getIndices(), &flat.getIndices(), &ico.getIndices() }) {
+            const unsigned int vertexCount = *std::max_element(indices->begin(), indices->end()) + 1u;
+            std::vector<unsigned int> strip = Stripifier::stripify(*indices, vertexCount, restart);
+
+            REQUIRE(SortedTriangles(Stripifier::unstripify(strip, restart)) == SortedTriangles(*indices));
+            if (!restart) REQUIRE(std::find(strip.begin(), strip.end(), Stripifier::RESTART_INDEX) == strip.end());
+        }
+    }
+}
+
+TEST_CASE("ShapesGenerator.Stripifier.Savings") {
+    ShapeConfig config{};
+
+    SECTION("Plane") {
+        Plane plane(config, 64u, 64u, PlaneNormalDir::UP, ValuesRange::ONE_TO_ONE);
+        StripStats stats = plane.getStripStats();
+
+        REQUIRE(stats.listIndexCount == plane.getIndicesCount());
+        REQUIRE(stats.stripIndexCount == plane.getStripIndices().size());
+        // Grid needs a bit more than one index per triangle
+        REQUIRE(stats.ratio < 0.4f);
+    }
+
+    SECTION("Torus") {
+        Torus torus(config, 64u, 32u, 1.f, 0.5f, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+        torus.setPrimitiveRestart(false);
+        StripStats stats = torus.getStripStats();
+
+        REQUIRE(stats.ratio < 0.4f);
+    }
+}
+
+TEST_CASE("ShapesGenerator.Stripifier.Export") {
+    ShapeConfig config{};
+    Torus torus(config, 16u, 8u, 1.f, 0.5f, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+    const std::vector<unsigned int> strip = torus.getStripIndices();
+
+    SECTION("Arrays") {
+        for (FormatType type : { FormatType::CPP_ARRAY_STRIP_STRUCT, FormatType::C_ARRAY_STRIP_STRUCT, FormatType::CPP_ARRAY_STRIP_FLOAT, FormatType::C_ARRAY_STRIP_FLOAT }) {
+            const std::string text = torus.toString(type);
+            const bool hasStrip = text.find("indices[" + std::to_string(strip.size()) + "]") != std::string::npos ||
+                                  text.find("std::array<unsigned int, " + std::to_string(strip.size()) + "> indices") != std::string::npos;
+            REQUIRE(hasStrip);
+            REQUIRE(text.find("Triangle strip") != std::string::npos);
+        }
+    }
+
+    SECTION("JSON") {
+        const std::string text = torus.toString(FormatType::JSON_STRIP);
+        REQUIRE(text.find("\"format\": \"strip\"") != std::string::npos);
+        REQUIRE(text.find("\"restartIndex\"") != std::string::npos);
+        REQUIRE(Shape::getFormatFileExtension(FormatType::JSON_STRIP) == ".json");
+    }
+
+    SECTION("Binary") {
+        torus.setPrimitiveRestart(false);
+        const std::vector<unsigned int> degenerateStrip = torus.getStripIndices();
+        const std::string data = torus.toString(FormatType::BINARY_STRIP);
+
+        uint32_t flags = 0u;
+        std::memcpy(&flags, data.data() + 8, sizeof(uint32_t));
+        REQUIRE((flags & 8u) != 0u);
+        REQUIRE((flags & 16u) == 0u);
+
+        // Strip chunk follows the vertex chunk
+        uint64_t vertexBytes = 0ull;
+        std::memcpy(&vertexBytes, data.data() + 16 + 8, sizeof(uint64_t));
+        const size_t offset = 16 + 16 + vertexBytes;
+
+        uint32_t count = 0u;
+        REQUIRE(data.compare(offset, 4, "STRP") == 0);
+        std::memcpy(&count, data.data() + offset + 4, sizeof(uint32_t));
+        REQUIRE(count == degenerateStrip.size());
+        REQUIRE(Shape::getFormatFileExtension(FormatType::BINARY_STRIP) == ".bin");
+    }
+}
\ No newline at end of file
@@ -0,0 +1,135 @@
+#pragma region PCH
+#include "pch.hpp"
+#pragma endregion
+
+#pragma region STD_LIBS
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#pragma endregion
+
+#pragma region CATCH2_LIB
+#include <catch2/catch_test_macros.hpp>
+#pragma endregion
+
+#pragma region MY_FILES_CORE_LIB
+#include <Shape.hpp>
+#include <ThreadPool.hpp>
+#include <Torus.hpp>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "Helpers.hpp"
+#pragma endregion
+
+TEST_CASE("ShapesGenerator.ThreadPool.ParallelFor") {
+    ThreadPool pool(4ull);
+    REQUIRE(pool.getThreadsCount() == 4ull);
+
+    std::vector<int> values(100000, 0);
+    pool.parallelFor(0ull, values.size(), 1000ull, [&values](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) values[i] += (int)i;
+    });
+
+    // Every index visited exactly once
+    for (size_t i = 0; i < values.size(); ++i) REQUIRE(values[i] == (int)i);
+
+    SECTION("Small range runs on calling thread") {
+        std::thread::id id;
+        pool.parallelFor(0ull, 10ull, 1000ull, [&id](size_t, size_t) { id = std::this_thread::get_id(); });
+        REQUIRE(id == std::this_thread::get_id());
+    }
+}
+
+TEST_CASE("ShapesGenerator.ThreadPool.Submit") {
+    ThreadPool pool(2ull);
+
+    std::future<int> a = pool.submit([]() { return 20; });
+    std::future<std::string> b = pool.submit([]() { return std::string("done"); });
+
+    REQUIRE(a.get() == 20);
+    REQUIRE(b.get() == "done");
+}
+
+TEST_CASE("ShapesGenerator.ThreadPool.NestedForkJoin") {
+    // More nested groups than threads, waiting workers have to run queued tasks themselves
+    ThreadPool pool(2ull);
+
+    std::atomic<int> leaves = 0;
+    TaskGroup outer(pool);
+    for (int i = 0; i < 8; ++i) {
+        outer.run([&pool, &leaves]() {
+            TaskGroup inner(pool);
+            for (int j = 0; j < 8; ++j) {
+                inner.run([&pool, &leaves]() {
+                    pool.parallelFor(0ull, 64ull, 1ull, [&leaves](size_t begin, size_t end) { leaves += (int)(end - begin); });
+                });
+            }
+            inner.wait();
+        });
+    }
+    outer.wait();
+
+    REQUIRE(leaves == 8 * 8 * 64);
+}
+
+TEST_CASE("ShapesGenerator.ThreadPool.Exception") {
+    ThreadPool pool(2ull);
+
+    TaskGroup group(pool);
+    std::atomic<int> finished = 0;
+    for (int i = 0; i < 16; ++i) {
+        group.run([i, &finished]() {
+            if (i == 5) throw std::runtime_error("task failed");
+            ++finished;
+        });
+    }
+
+    REQUIRE_THROWS_AS(group.wait(), std::runtime_error);
+    // Other tasks still run
+    REQUIRE(finished == 15);
+}
+
+TEST_CASE("ShapesGenerator.ThreadPool.WaitOutsidePool") {
+    ThreadPool pool(1ull);
+
+    // Only worker is busy until released
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::future<void> blocker = pool.submit([released]() { released.wait(); });
+    std::future<std::thread::id> unrelated = pool.submit([]() { return std::this_thread::get_id(); });
+
+    // Calling thread runs its own tasks, not the unrelated one queued before them
+    TaskGroup group(pool);
+    std::atomic<int> finished = 0;
+    for (int i = 0; i < 4; ++i) group.run([&finished]() { ++finished; });
+    group.wait();
+
+    REQUIRE(finished == 4);
+    REQUIRE(unrelated.wait_for(std::chrono::seconds(0)) == std::future_status::timeout);
+
+    release.set_value();
+    REQUIRE(unrelated.get() != std::this_thread::get_id());
+    blocker.get();
+}
+
+TEST_CASE("ShapesGenerator.ThreadPool.SameOutput") {
+    // Parallel tangents and formatting give the same result as a single thread would
+    ShapeConfig config{};
+    Torus a(config, 256u, 128u, 1.f, 0.5f, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+    Torus b(config, 256u, 128u, 1.f, 0.5f, ValuesRange::ONE_TO_ONE, Shading::SMOOTH);
+
+    REQUIRE(a.getVerticesCount() > ThreadPool::DEFAULT_GRAIN_SIZE);
+    REQUIRE(a.toString(FormatType::CPP_ARRAY_INDICES_STRUCT) == b.toString(FormatType::CPP_ARRAY_INDICES_STRUCT));
+
+    // Unindexed vertices written once each, only the last one without comma
+    const std::string text = a.toString(FormatType::C_ARRAY_VERTICES_FLOAT);
+    size_t lines = 0;
+    for (size_t pos = text.find("f,\n"); pos != std::string::npos; pos = text.find("f,\n", pos + 1)) ++lines;
+    REQUIRE(lines == a.getIndicesCount() - 1);
+    REQUIRE(text.substr(text.size() - 4) == "f\n};");
+}
\ No newline at end of file
@@ -0,0 +1,144 @@
+#pragma region PCH
+#include "pch.hpp"
+#pragma endregion
+
+#pragma region STD_LIBS
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#pragma endregion
+
+#pragma region CATCH2_LIB
+#include <catch2/catch_test_macros.hpp>
+#pragma endregion
+
+#pragma region MY_FILES_CORE_LIB
+#include <Plane.hpp>
+#include <ProgressToken.hpp>
+#include <ResourceEstimate.hpp>
+#include <Shape.hpp>
+#include <TiledPlane.hpp>
+#pragma endregion
+
+#pragma region MY_FILES
+#include "Helpers.hpp"
+#pragma endregion
+
+namespace fs = std::filesystem;
+
+static fs::path MakeTiledPath(const std::string& name)
+{
+    const fs::path path = fs::temp_directory_path() / ("shapes_generator_tiled_" + name);
+    fs::remove(path);
+    return path;
+}
+
+static std::string ReadFile(const fs::path& path)
+{
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+TEST_CASE("ShapesGenerator.TiledPlane.SameAsPlane") {
+    for (bool genTangents : { true, false }) {
+        for (PlaneNormalDir dir : { PlaneNormalDir::UP, PlaneNormalDir::FRONT }) {
+            ShapeConfig config{};
+            config.genTangents = genTangents;
+
+            // Two rows per tile, so every tile shares its edge rows with neighbours
+            TiledPlane tiled(config, 9u, 6u, dir, ValuesRange::ONE_TO_ONE, 12ull);
+            REQUIRE(tiled.getTileRows() == 2u);
+            REQUIRE(tiled.getTilesCount(FormatType::BINARY) == 5ull);
+            REQUIRE(tiled.getSubMeshesCount(FormatType::BINARY) == 1ull);
+
+            const fs::path path = MakeTiledPath("same.bin");
+            REQUIRE(tiled.save(path.string(), FormatType::BINARY));
+
+            Plane plane(config, 9u, 6u, dir, ValuesRange::ONE_TO_ONE);
+            INFO(genTangents << " " << static_cast<int>(dir));
+            REQUIRE(ReadFile(path) == plane.toString(FormatType::BINARY));
+
+            const MeshCounts counts = tiled.getMeshCounts(FormatType::BINARY);
+            REQUIRE(counts.vertices == plane.getVerticesCount());
+            REQUIRE(counts.indices == plane.getIndicesCount());
+            fs::remove(path);
+        }
+    }
+}
+
+TEST_CASE("ShapesGenerator.TiledPlane.OBJ") {
+    ShapeConfig config{};
+    TiledPlane tiled(config, 7u, 5u, PlaneNormalDir::UP, ValuesRange::HALF_TO_HALF, 10ull);
+
+    const fs::path path = MakeTiledPath("grid.obj");
+    REQUIRE(tiled.save(path.string(), FormatType::OBJ));
+
+    std::istringstream lines(ReadFile(path));
+    std::string line;
+    size_t v = 0ull, vt = 0ull, vn = 0ull, f = 0ull;
+    size_t maxIndex = 0ull;
+    while (std::getline(lines, line)) {
+        if (line.rfind("v ", 0) == 0) ++v;
+        else if (line.rfind("vt ", 0) == 0) ++vt;
+        else if (line.rfind("vn ", 0) == 0) ++vn;
+        else if (line.rfind("f ", 0) == 0) {
+            ++f;
+            std::istringstream face(line.substr(2));
+            std::string corner;
+            while (face >> corner) maxIndex = std::max<size_t>(maxIndex, std::stoull(corner.substr(0, corner.find('/'))));
+        }
+    }
+
+    REQUIRE(v == 35ull);
+    REQUIRE(vt == 35ull);
+    REQUIRE(vn == 1ull);
+    REQUIRE(f == 2ull * 6ull * 4ull);
+    REQUIRE(maxIndex == 35ull);
+    fs::remove(path);
+}
+
+TEST_CASE("ShapesGenerator.TiledPlane.SubMeshes") {
+    ShapeConfig config{};
+    // Terrain-sized grid, nothing is generated
+    TiledPlane tiled(config, 50000u, 50000u);
+
+    REQUIRE_FALSE(Plane::getMeshCounts(50000u, 50000u).fitsIndexType());
+    REQUIRE(tiled.getSubMeshesCount(FormatType::BINARY) > 1ull);
+    REQUIRE(tiled.getSubMeshesCount(FormatType::OBJ) == 1ull);
+
+    // Every sub-mesh fits 32-bit indices, shared rows are written twice
+    const MeshCounts counts = tiled.getMeshCounts(FormatType::BINARY);
+    REQUIRE(counts.vertices == 50000ull * 50000ull + (tiled.getSubMeshesCount(FormatType::BINARY) - 1ull) * 50000ull);
+    REQUIRE(counts.indices == Plane::getMeshCounts(50000u, 50000u).indices);
+    REQUIRE(counts.indices / tiled.getSubMeshesCount(FormatType::BINARY) <= MeshCounts::MAX_INDICES);
+
+    // Memory of tiles in flight is far below the whole mesh
+    REQUIRE(tiled.getPeakBytes(FormatType::BINARY) < ResourceEstimator::estimateGeneration(Plane::getMeshCounts(50000u, 50000u)).meshBytes / 100ull);
+}
+
+TEST_CASE("ShapesGenerator.TiledPlane.Unsupported") {
+    ShapeConfig config{};
+    TiledPlane tiled(config, 4u, 4u);
+
+    const fs::path path = MakeTiledPath("unsupported.json");
+    REQUIRE_FALSE(TiledPlane::isFormatSupported(FormatType::JSON_INDICES));
+    REQUIRE_FALSE(tiled.save(path.string(), FormatType::JSON_INDICES));
+    REQUIRE_FALSE(fs::exists(path));
+}
+
+TEST_CASE("ShapesGenerator.TiledPlane.Cancel") {
+    ProgressToken progress;
+    progress.cancel();
+
+    ShapeConfig config{};
+    config.progress = &progress;
+    TiledPlane tiled(config, 64u, 64u, PlaneNormalDir::UP, ValuesRange::HALF_TO_HALF, 256ull);
+
+    // Partial file is removed
+    const fs::path path = MakeTiledPath("cancel.bin");
+    REQUIRE_FALSE(tiled.save(path.string(), FormatType::BINARY));
+    REQUIRE_FALSE(fs::exists(path));
+}